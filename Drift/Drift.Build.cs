@@ -74,6 +74,7 @@ public class Drift : ModuleRules
                 "DriftHttp",
                 "ErrorReporter",
                 "Icmp",
+                "WebSockets",
             }
             );
         
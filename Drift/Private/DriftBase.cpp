@@ -29,6 +29,11 @@
 #include "Auth/DriftUuidAuthProviderFactory.h"
 #include "Auth/DriftUserPassAuthProviderFactory.h"
 #include "RetryConfig.h"
+#include "DriftStaticData.h"
+#include "DriftStaticDataLoader.h"
+#include "DriftCdnScoreboard.h"
+#include "DriftCounterAggregator.h"
+#include "PrefetchHttpCache.h"
 
 #include "SocketSubsystem.h"
 #include "GeneralProjectSettings.h"
@@ -41,6 +46,7 @@
 #include "Internationalization/Internationalization.h"
 #include "Misc/EngineVersionComparison.h"
 #include "GenericPlatform/GenericPlatformOutputDevices.h"
+#include "HAL/FileManager.h"
 
 #if PLATFORM_APPLE
 #include "Apple/AppleUtility.h"
@@ -80,7 +86,8 @@ FDriftBase::FDriftBase(const TSharedPtr<IHttpCache>& cache, const FName& instanc
     , instanceIndex_(instanceIndex)
     , state_(DriftSessionState::Undefined)
     , rootRequestManager_(MakeShareable(new JsonRequestManager()))
-    , httpCache_(cache)
+    , prefetchCache_(MakeShared<PrefetchHttpCache>(cache))
+    , httpCache_(prefetchCache_)
 {
     ConfigureSettingsSection(config);
 
@@ -90,6 +97,11 @@ FDriftBase::FDriftBase(const TSharedPtr<IHttpCache>& cache, const FName& instanc
     GConfig->GetBool(*settingsSection_, TEXT("IgnoreCommandLineArguments"), ignoreCommandLineArguments_, GGameIni);
     GConfig->GetString(*settingsSection_, TEXT("ProjectName"), projectName_, GGameIni);
     GConfig->GetString(*settingsSection_, TEXT("StaticDataReference"), staticDataReference, GGameIni);
+    GConfig->GetArray(*settingsSection_, TEXT("PrefetchEndpoints"), prefetchEndpoints_, GGameIni);
+
+    int32 maxGameStateSizeMB = 0;
+    GConfig->GetInt(*settingsSection_, TEXT("MaxGameStateSizeMB"), maxGameStateSizeMB, GGameIni);
+    maxGameStateBytes_ = FMath::Max(maxGameStateSizeMB, 0) * 1024ll * 1024ll;
 
     if (!ignoreCommandLineArguments_)
     {
@@ -140,9 +152,11 @@ FDriftBase::FDriftBase(const TSharedPtr<IHttpCache>& cache, const FName& instanc
     rootRequestManager_->SetCache(httpCache_);
 
     CreatePlayerCounterManager();
+    CreateServerCounterAggregator();
     CreateEventManager();
     CreateLogForwarder();
     CreateMessageQueue();
+    CreateSocialSession();
     CreatePartyManager();
     CreateMatchmaker();
     CreateLobbyManager();
@@ -163,6 +177,21 @@ void FDriftBase::CreatePlayerCounterManager()
 }
 
 
+void FDriftBase::CreateServerCounterAggregator()
+{
+    serverCounterAggregator = MakeShared<FDriftCounterAggregator>();
+    serverCounterAggregator->OnCollect().AddLambda([this]()
+    {
+        for (auto& counterManager : serverCounterManagers)
+        {
+            counterManager.Value->FlushCounters();
+        }
+    });
+
+    GConfig->GetBool(*settingsSection_, TEXT("bServerCounterBulkFlush"), serverCounterBulkFlush_, GGameIni);
+}
+
+
 void FDriftBase::CreateEventManager()
 {
     eventManager = MakeShared<FDriftEventManager>();
@@ -179,35 +208,94 @@ void FDriftBase::CreateMessageQueue()
 {
     messageQueue = MakeShared<FDriftMessageQueue>();
 
+    FString messageQueueTransport;
+    if (GConfig->GetString(*settingsSection_, TEXT("MessageQueueTransport"), messageQueueTransport, GGameIni))
+    {
+        messageQueue->SetPreferredTransport(messageQueueTransport);
+    }
+
+    bool batchSend = false;
+    GConfig->GetBool(*settingsSection_, TEXT("bMessageQueueBatchSend"), batchSend, GGameIni);
+    messageQueue->SetBatchSend(batchSend);
+
     messageQueue->OnMessageQueueMessage(MatchQueue).AddRaw(this, &FDriftBase::HandleMatchQueueMessage);
     messageQueue->OnMessageQueueMessage(FriendEvent).AddRaw(this, &FDriftBase::HandleFriendEventMessage);
 	messageQueue->OnMessageQueueMessage(FriendMessage).AddRaw(this, &FDriftBase::HandleFriendMessage);
 }
 
 
+void FDriftBase::CreateSocialSession()
+{
+    socialSession = MakeShared<FDriftSocialSession>(messageQueue);
+}
+
+
 void FDriftBase::CreatePartyManager()
 {
-	partyManager = MakeShared<FDriftPartyManager>(messageQueue);
+	partyManager = MakeShared<FDriftPartyManager>(socialSession);
 }
 
 void FDriftBase::CreateMatchmaker()
 {
     matchmaker = MakeShared<FDriftFlexmatch>(messageQueue);
+
+    // A local echo server can stand in for the regions by pointing the probe targets at it
+    FDriftLatencyProbeSettings latencyProbeSettings;
+    GConfig->GetString(*settingsSection_, TEXT("LatencyProbeIcmpHost"), latencyProbeSettings.Targets.IcmpHostTemplate, GGameIni);
+    GConfig->GetString(*settingsSection_, TEXT("LatencyProbeUdpAddress"), latencyProbeSettings.Targets.UdpAddressTemplate, GGameIni);
+    GConfig->GetString(*settingsSection_, TEXT("LatencyProbeHttpUrl"), latencyProbeSettings.Targets.HttpUrlTemplate, GGameIni);
+    GConfig->GetInt(*settingsSection_, TEXT("LatencyProbeSamplesPerRegion"), latencyProbeSettings.SamplesPerRegion, GGameIni);
+    GConfig->GetInt(*settingsSection_, TEXT("LatencyProbeMaxConcurrent"), latencyProbeSettings.MaxConcurrentProbes, GGameIni);
+    GConfig->GetFloat(*settingsSection_, TEXT("LatencyProbeTimeout"), latencyProbeSettings.ProbeTimeout, GGameIni);
+    matchmaker->SetLatencyProbeSettings(latencyProbeSettings);
+
+    FDriftLatencyReportSettings latencyReportSettings;
+    GConfig->GetInt(*settingsSection_, TEXT("LatencyReportThresholdMs"), latencyReportSettings.ThresholdMs, GGameIni);
+    GConfig->GetFloat(*settingsSection_, TEXT("LatencyReportFreshnessSeconds"), latencyReportSettings.FreshnessSeconds, GGameIni);
+    matchmaker->SetLatencyReportSettings(latencyReportSettings);
+
+    FDriftRegionScoringSettings regionScoringSettings;
+    GConfig->GetFloat(*settingsSection_, TEXT("RegionLatencyCeilingMs"), regionScoringSettings.LatencyCeilingMs, GGameIni);
+    GConfig->GetFloat(*settingsSection_, TEXT("RegionJitterWeight"), regionScoringSettings.JitterWeight, GGameIni);
+    GConfig->GetFloat(*settingsSection_, TEXT("RegionPacketLossPenaltyMs"), regionScoringSettings.PacketLossPenaltyMs, GGameIni);
+    GConfig->GetFloat(*settingsSection_, TEXT("RegionMaxPacketLoss"), regionScoringSettings.MaxPacketLoss, GGameIni);
+    // As +RegionWeights=eu-west-1:0.8
+    TArray<FString> regionWeights;
+    GConfig->GetArray(*settingsSection_, TEXT("RegionWeights"), regionWeights, GGameIni);
+    for (const auto& regionWeight : regionWeights)
+    {
+        FString region, weight;
+        if (regionWeight.Split(TEXT(":"), &region, &weight) && weight.TrimStartAndEnd().IsNumeric())
+        {
+            regionScoringSettings.RegionWeights.Add(region.TrimStartAndEnd(), FCString::Atof(*weight.TrimStartAndEnd()));
+        }
+        else
+        {
+            DRIFT_LOG(Base, Warning, TEXT("Ignoring malformed region weight '%s'"), *regionWeight);
+        }
+    }
+    matchmaker->SetRegionScoringSettings(regionScoringSettings);
 }
 
 void FDriftBase::CreateLobbyManager()
 {
-	lobbyManager = MakeShared<FDriftLobbyManager>(messageQueue);
+	lobbyManager = MakeShared<FDriftLobbyManager>(socialSession);
 }
 
 void FDriftBase::CreateMatchPlacementManager()
 {
     matchPlacementManager = MakeShared<FDriftMatchPlacementManager>(messageQueue);
+
+    float publicMatchPlacementTimeToLive;
+    if (GConfig->GetFloat(*settingsSection_, TEXT("PublicMatchPlacementTimeToLive"), publicMatchPlacementTimeToLive, GGameIni))
+    {
+        matchPlacementManager->SetPublicMatchPlacementTimeToLive(publicMatchPlacementTimeToLive);
+    }
 }
 
 void FDriftBase::CreateSandboxManager()
 {
-    sandboxManager = MakeShared<FDriftSandboxManager>(messageQueue);
+    sandboxManager = MakeShared<FDriftSandboxManager>(socialSession);
 }
 
 void FDriftBase::ConfigurePlacement()
@@ -240,6 +328,8 @@ void FDriftBase::ConfigureBuildReference()
 
 FDriftBase::~FDriftBase()
 {
+    StopHeartbeat();
+
     DRIFT_LOG(Base, Verbose, TEXT("Drift instance %s (%d) destroyed"), *instanceName_.ToString(), instanceIndex_);
 }
 
@@ -258,6 +348,44 @@ TSharedPtr<JsonRequestManager> FDriftBase::GetRootRequestManager() const
 }
 
 
+void FDriftBase::SetGameRequestManager(TSharedPtr<JsonRequestManager> manager)
+{
+    authenticatedRequestManager = manager;
+    if (heartbeatMultiplexerHandle_ != INDEX_NONE)
+    {
+        heartbeatMultiplexer_->SetRequestManager(heartbeatMultiplexerHandle_, manager);
+    }
+    if (manager.IsValid())
+    {
+        // Any successful authenticated request keeps the connection alive as far as the heartbeat is concerned
+        manager->OnServerResponded().AddLambda([this](float roundTripSeconds)
+        {
+            heartbeatScheduler_.RecordActivity(FPlatformTime::Seconds(), roundTripSeconds);
+        });
+    }
+}
+
+
+void FDriftBase::SetHeartbeatMultiplexer(TSharedPtr<FDriftHeartbeatMultiplexer> multiplexer)
+{
+    heartbeatMultiplexer_ = multiplexer;
+
+    GConfig->GetBool(*settingsSection_, TEXT("bHeartbeatBatching"), heartbeatBatching_, GGameIni);
+}
+
+
+void FDriftBase::SetStaticDataStore(TSharedPtr<FDriftStaticDataStore> store)
+{
+    staticDataStore_ = store;
+}
+
+
+void FDriftBase::SetCdnScoreboard(TSharedPtr<FDriftCdnScoreboard> scoreboard)
+{
+    cdnScoreboard_ = scoreboard;
+}
+
+
 TSharedPtr<JsonRequestManager> FDriftBase::GetGameRequestManager() const
 {
     if (!authenticatedRequestManager.IsValid())
@@ -275,9 +403,7 @@ void FDriftBase::TickHeartbeat(float deltaTime)
         return;
     }
 
-	const auto bHeartbeatInitialized = heartbeatTimeout_ != FDateTime::MinValue();
-	const auto bHeartbeatTimedOut = FDateTime::UtcNow() >= heartbeatTimeout_ - FTimespan::FromSeconds(5.0);
-    if (bHeartbeatInitialized && bHeartbeatTimedOut)
+    if (heartbeatScheduler_.IsTimedOut(FPlatformTime::Seconds()))
     {
         DRIFT_LOG(Base, Error, TEXT("Heartbeat timed out"));
 
@@ -287,12 +413,57 @@ void FDriftBase::TickHeartbeat(float deltaTime)
         return;
     }
 
-    heartbeatDueInSeconds_ -= deltaTime;
-    if (heartbeatDueInSeconds_ > 0.0)
+    // The multiplexer sends the heartbeat along with those of the other instances
+    if (heartbeatMultiplexerHandle_ != INDEX_NONE)
+    {
+        return;
+    }
+
+    if (!heartbeatScheduler_.IsHeartbeatDue(FPlatformTime::Seconds()))
+    {
+        return;
+    }
+
+    SendHeartbeat();
+}
+
+
+void FDriftBase::StartHeartbeat(float firstHeartbeatSeconds, float timeoutSeconds)
+{
+    heartbeatScheduler_.Start(FPlatformTime::Seconds(), firstHeartbeatSeconds, timeoutSeconds);
+
+    if (!heartbeatBatching_ || !heartbeatMultiplexer_.IsValid() || driftEndpoints.heartbeats.IsEmpty())
     {
         return;
     }
-    heartbeatDueInSeconds_ = FLT_MAX; // Prevent re-entrance
+
+    FDriftHeartbeatParticipant participant;
+    participant.scheduler = &heartbeatScheduler_;
+    participant.heartbeatUrl = heartbeatUrl;
+    participant.batchUrl = driftEndpoints.heartbeats;
+    participant.requestManager = GetGameRequestManager();
+    participant.batchRequestManager = rootRequestManager_;
+    participant.onResult.BindRaw(this, &FDriftBase::HandleHeartbeatResult);
+    heartbeatMultiplexerHandle_ = heartbeatMultiplexer_->Register(MoveTemp(participant));
+}
+
+
+void FDriftBase::StopHeartbeat()
+{
+    if (heartbeatMultiplexerHandle_ != INDEX_NONE)
+    {
+        heartbeatMultiplexer_->Unregister(heartbeatMultiplexerHandle_);
+        heartbeatMultiplexerHandle_ = INDEX_NONE;
+    }
+
+    heartbeatScheduler_.Reset();
+	heartbeatRetryAttempt_ = 0;
+}
+
+
+void FDriftBase::SendHeartbeat()
+{
+    heartbeatScheduler_.HeartbeatSent(); // Prevent re-entrance
 
     DRIFT_LOG(Base, Verbose, TEXT("[%s] Drift heartbeat..."), *FDateTime::UtcNow().ToIso8601());
 
@@ -319,90 +490,130 @@ void FDriftBase::TickHeartbeat(float deltaTime)
     auto request = GetGameRequestManager()->Put(heartbeatUrl, FString());
     request->OnResponse.BindLambda([this](ResponseContext& context, JsonDocument& doc)
     {
+        FDriftHeartbeatResult result;
+        result.status = EDriftHeartbeatStatus::Succeeded;
+        result.roundTripSeconds = static_cast<float>(context.request.Get()->GetElapsedTime());
         FDriftHeartBeatResponse response;
         if (JsonUtils::ParseResponseNoLog(context.response, response))
         {
-            const auto heartbeatRoundTrip = FTimespan::FromSeconds(context.request.Get()->GetElapsedTime());
-            heartbeatDueInSeconds_ = response.next_heartbeat_seconds;
-            /**
-             * We don't know if making the call, or returning it, takes a long time,
-             * and the client clock might be off compared with the server's, so we
-             * can't use the actual timeout time returned. Local time minus roundtrip
-             * plus timeout, should be on the safe side.
-             */
-            heartbeatTimeout_ = FDateTime::UtcNow() + FTimespan::FromSeconds(response.heartbeat_timeout_seconds) - heartbeatRoundTrip;
+            result.nextHeartbeatSeconds = response.next_heartbeat_seconds;
+            result.timeoutSeconds = response.heartbeat_timeout_seconds;
         }
     	else
     	{
     		// Older versions of the server heartbeat endpoint don't return all the details
-            heartbeatDueInSeconds_ = doc[TEXT("next_heartbeat_seconds")].GetInt32();
+            result.nextHeartbeatSeconds = doc[TEXT("next_heartbeat_seconds")].GetInt32();
         }
-
-    	if (heartbeatRetryAttempt_ > 0)
-    	{
-    		DRIFT_LOG(Base, Log, TEXT("[%s] Drift heartbeat recovered after %d retries.")
-					, *FDateTime::UtcNow().ToIso8601(), heartbeatRetryAttempt_);
-		}
-    	heartbeatRetryAttempt_ = 0;
-
-        DRIFT_LOG(Base, Verbose, TEXT("[%s] Drift heartbeat done. Next one in %.1f secs. Timeout at: %s")
-                  , *FDateTime::UtcNow().ToIso8601(), heartbeatDueInSeconds_, *heartbeatTimeout_.ToIso8601());
+        HandleHeartbeatResult(result);
     });
     request->OnError.BindLambda([this](ResponseContext& context)
     {
+        FDriftHeartbeatResult result;
         if (context.successful && context.response.IsValid())
         {
             GenericRequestErrorResponse response;
-            if (JsonUtils::ParseResponse(context.response, response))
+            if (!JsonUtils::ParseResponse(context.response, response))
+            {
+                return;
+            }
+            if (context.responseCode == static_cast<int32>(HttpStatusCodes::NotFound) && response.GetErrorCode() == TEXT("user_error"))
+            {
+                result.status = EDriftHeartbeatStatus::Expired;
+                result.error = GetDebugText(context.response);
+                context.errorHandled = true;
+            }
+            else
             {
-                if (context.responseCode == static_cast<int32>(HttpStatusCodes::NotFound) && response.GetErrorCode() == TEXT("user_error"))
-                {
-                    // Heartbeat timed out
-                    DRIFT_LOG(Base, Error, TEXT("Failed to heartbeat\n%s"), *GetDebugText(context.response));
-
-                    state_ = DriftSessionState::Timedout;
-                    BroadcastConnectionStateChange(state_);
-                    context.errorHandled = true;
-                    Reset();
-                    return;
-                }
                 // Some other reason
-                FString Error;
-                context.errorHandled = GetResponseError(context, Error);
-                DRIFT_LOG(Base, Error, TEXT("Failed to heartbeat\n%s"), *Error);
-                Disconnect();
+                result.status = EDriftHeartbeatStatus::Rejected;
+                context.errorHandled = GetResponseError(context, result.error);
             }
         }
         else
         {
+            result.status = EDriftHeartbeatStatus::Failed;
+            result.error = GetDebugText(context.response);
             context.errorHandled = true;
-        	const auto now = FDateTime::UtcNow();
+        }
+        HandleHeartbeatResult(result);
+    });
+    request->Dispatch();
+}
 
-        	// It'd be pointless to retry outside of the timeout
-        	if (now > heartbeatTimeout_)
-        	{
-        		DRIFT_LOG(Base, Error, TEXT("Failed to heartbeat\n%s"), *GetDebugText(context.response));
 
-                state_ = DriftSessionState::Timedout;
-                BroadcastConnectionStateChange(state_);
-	            Reset();
-        		return;
-        	}
+void FDriftBase::HandleHeartbeatResult(const FDriftHeartbeatResult& result)
+{
+    const auto now = FPlatformTime::Seconds();
+    switch (result.status)
+    {
+    case EDriftHeartbeatStatus::Succeeded:
+    {
+        heartbeatScheduler_.HeartbeatSucceeded(now, result.roundTripSeconds, result.nextHeartbeatSeconds, result.timeoutSeconds);
+
+    	if (heartbeatRetryAttempt_ > 0)
+    	{
+    		DRIFT_LOG(Base, Log, TEXT("[%s] Drift heartbeat recovered after %d retries.")
+					, *FDateTime::UtcNow().ToIso8601(), heartbeatRetryAttempt_);
+		}
+    	heartbeatRetryAttempt_ = 0;
+
+        DRIFT_LOG(Base, Verbose, TEXT("[%s] Drift heartbeat done. Next one in %.1f secs at the latest. Timeout in %.1f secs")
+                  , *FDateTime::UtcNow().ToIso8601(), heartbeatScheduler_.GetNextHeartbeatAt() - now, heartbeatScheduler_.GetTimeoutAt() - now);
+        break;
+    }
+
+    case EDriftHeartbeatStatus::Expired:
+        // Heartbeat timed out
+        DRIFT_LOG(Base, Error, TEXT("Failed to heartbeat\n%s"), *result.error);
 
-        	heartbeatRetryAttempt_ += 1;
-        	// Delay the retry for an exponentially expanding random amount of time, up to the cap, and within the timeout
-        	const auto retryDelayCap = FMath::Min(heartbeatRetryDelayCap_, static_cast<float>((heartbeatTimeout_ - now).GetTotalSeconds()));
-        	const auto maxRetryDelay = FMath::Min(retryDelayCap, FMath::Pow(heartbeatRetryDelay_ * 2, heartbeatRetryAttempt_));
-        	heartbeatDueInSeconds_ = FMath::RandRange(
-        		heartbeatRetryDelay_ / 2.0f,
-        		maxRetryDelay
-        		);
-
-            DRIFT_LOG(Base, Warning, TEXT("[%s] Drift heartbeat failed. Retrying in %.1f secs. Timeout at: %s")
-                      , *FDateTime::UtcNow().ToIso8601(), heartbeatDueInSeconds_, *heartbeatTimeout_.ToIso8601());
+        state_ = DriftSessionState::Timedout;
+        BroadcastConnectionStateChange(state_);
+        Reset();
+        break;
+
+    case EDriftHeartbeatStatus::Rejected:
+        DRIFT_LOG(Base, Error, TEXT("Failed to heartbeat\n%s"), *result.error);
+        Disconnect();
+        break;
+
+    case EDriftHeartbeatStatus::Unsupported:
+        // Carry on alone, right away
+        DRIFT_LOG(Base, Log, TEXT("Batched heartbeats are not available, sending them individually"));
+        heartbeatMultiplexer_->Unregister(heartbeatMultiplexerHandle_);
+        heartbeatMultiplexerHandle_ = INDEX_NONE;
+        heartbeatScheduler_.HeartbeatFailed(now, 0.0f);
+        break;
+
+    case EDriftHeartbeatStatus::Failed:
+    {
+        const auto secondsToTimeout = heartbeatScheduler_.GetTimeoutAt() - now;
+
+        // It'd be pointless to retry outside of the timeout
+        if (secondsToTimeout < 0.0)
+        {
+            DRIFT_LOG(Base, Error, TEXT("Failed to heartbeat\n%s"), *result.error);
+
+            state_ = DriftSessionState::Timedout;
+            BroadcastConnectionStateChange(state_);
+            Reset();
+            return;
         }
-    });
-    request->Dispatch();
+
+        heartbeatRetryAttempt_ += 1;
+        // Delay the retry for an exponentially expanding random amount of time, up to the cap, and within the timeout
+        const auto retryDelayCap = FMath::Min(heartbeatRetryDelayCap_, static_cast<float>(secondsToTimeout));
+        const auto maxRetryDelay = FMath::Min(retryDelayCap, FMath::Pow(heartbeatRetryDelay_ * 2, heartbeatRetryAttempt_));
+        const auto retryDelay = FMath::RandRange(
+            heartbeatRetryDelay_ / 2.0f,
+            maxRetryDelay
+            );
+        heartbeatScheduler_.HeartbeatFailed(now, retryDelay);
+
+        DRIFT_LOG(Base, Warning, TEXT("[%s] Drift heartbeat failed. Retrying in %.1f secs. Timeout in %.1f secs")
+                  , *FDateTime::UtcNow().ToIso8601(), retryDelay, secondsToTimeout);
+        break;
+    }
+    }
 }
 
 
@@ -412,10 +623,8 @@ void FDriftBase::FlushCounters()
 
     playerCounterManager->FlushCounters();
 
-    for (auto& counterManager : serverCounterManagers)
-    {
-        counterManager.Value->FlushCounters();
-    }
+    // Collects from all the server counter managers
+    serverCounterAggregator->Flush();
 }
 
 
@@ -545,7 +754,11 @@ void FDriftBase::Disconnect()
         state_ = DriftSessionState::Disconnecting;
         BroadcastConnectionStateChange(state_);
 
-        // Any messages in flight may block shutdown, so it needs to be terminated
+        // Any messages in flight may block shutdown, so it needs to be terminated, but what's waiting to be sent goes out first
+        if (messageQueue.IsValid())
+        {
+            messageQueue->Flush();
+        }
         messageQueue.Reset();
 
         FlushCounters();
@@ -608,17 +821,20 @@ void FDriftBase::Reset()
     CreateEventManager();
     CreateLogForwarder();
     CreateMessageQueue();
+    CreateSocialSession();
     CreatePartyManager();
     CreateMatchmaker();
 	CreateLobbyManager();
+    CreateSandboxManager();
 
     heartbeatUrl.Empty();
 
+    prefetchCache_->Clear();
+    prefetchedUrls_.Empty();
+
     userIdentities = FDriftCreatePlayerGroupResponse{};
 
-    heartbeatDueInSeconds_ = FLT_MAX;
-    heartbeatTimeout_ = FDateTime::MinValue();
-	heartbeatRetryAttempt_ = 0;
+    StopHeartbeat();
 
     countersLoaded = false;
     playerGameStateInfosLoaded = false;
@@ -645,7 +861,7 @@ void FDriftBase::LoadStaticData(const FString& name, const FString& ref)
     {
         DRIFT_LOG(Base, Warning, TEXT("Attempting to load static data before static routes have been initialized"));
 
-        onStaticDataLoaded.Broadcast(false, TEXT(""));
+        BroadcastStaticDataLoaded(false, nullptr);
         return;
     }
 
@@ -675,107 +891,99 @@ void FDriftBase::LoadStaticData(const FString& name, const FString& ref)
             return;
         }
 
-        DRIFT_LOG(Base, Log, TEXT("Downloading static data file: '%s'"), *name);
+        DRIFT_LOG(Base, Log, TEXT("Loading static data file: '%s'"), *name);
 
-        struct StaticDataSync
-        {
-            bool succeeded = false;
-            int32 remaining = 0;
-            int32 bytesRead = 0;
-        };
+        const auto& resource = static_data.static_data_urls[0];
+        const auto commit = resource.commit_id;
+        const auto index_sent = context.sent;
+        const auto index_received = context.received;
 
-        auto commit = static_data.static_data_urls[0].commit_id;
-        auto index_sent = context.sent;
-        auto index_received = context.received;
-        TSharedPtr<StaticDataSync> sync = MakeShareable(new StaticDataSync);
-
-        const auto loader = [this, commit, pin, index_sent, index_received, sync](const FString& data_url, const FString& data_name, const FString& cdn_name)
+        TArray<FDriftStaticDataSource> sources;
+        if (resource.cdn_list.Num() == 0)
         {
-            auto data_request = GetRootRequestManager()->Get(data_url + data_name);
-            data_request->OnRequestProgress().BindLambda([this, data_name, sync](FHttpRequestPtr req, int32 bytesWritten, int32 bytesRead)
+            sources.Add(FDriftStaticDataSource{ TEXT("default"), resource.data_root_url });
+        }
+        else
+        {
+            for (const auto& cdn : resource.cdn_list)
             {
-                if (!sync->succeeded)
-                {
-                    const auto lastBytesRead = sync->bytesRead;
-                    if (bytesRead > lastBytesRead)
-                    {
-                        sync->bytesRead = bytesRead;
+                sources.Add(FDriftStaticDataSource{ cdn.cdn, cdn.data_root_url });
+            }
+        }
 
-                        DRIFT_LOG(Base, Verbose, TEXT("Downloading static data file from: '%s' %d bytes"), *data_name, bytesRead);
+        auto loader = MakeShared<FDriftStaticDataLoader>(GetRootRequestManager(), staticDataStore_, cdnScoreboard_, name, commit, MoveTemp(sources));
+        loader->OnProgress.BindLambda([this](const FString& data_name, int32 bytesRead)
+        {
+            DRIFT_LOG(Base, Verbose, TEXT("Downloading static data file from: '%s' %d bytes"), *data_name, bytesRead);
 
-                        onStaticDataProgress.Broadcast(data_name, bytesRead);
-                    }
-                }
-            });
-            data_request->OnResponse.BindLambda([this, data_name, commit, pin, cdn_name, index_sent, index_received, sync](ResponseContext& data_context, JsonDocument& data_doc)
+            onStaticDataProgress.Broadcast(data_name, bytesRead);
+        });
+        loader->OnSourceFailed.BindLambda([this, name, commit, pin](const FDriftStaticDataSource& source, const FString& error)
+        {
+            auto event = MakeEvent(TEXT("drift.static_data_download_failed"));
+            event->Add(TEXT("filename"), *name);
+            event->Add(TEXT("pin"), *pin);
+            event->Add(TEXT("commit"), *commit);
+            event->Add(TEXT("cdn"), *source.Cdn);
+            event->Add(TEXT("error"), error);
+            AddAnalyticsEvent(MoveTemp(event));
+        });
+        loader->OnCompleted.BindLambda([this, name, commit, pin, index_sent, index_received](const FDriftStaticDataLoadResult& result, const TSharedPtr<FDriftStaticDataView>& view)
+        {
+            if (!result.bSuccess)
             {
-                DRIFT_LOG(Base, Log, TEXT("Download of static data file: '%s' done"), *data_name);
-
-                sync->remaining -= 1;
-                if (!sync->succeeded)
-                {
-                    sync->succeeded = true;
-                    auto data = data_context.response->GetContentAsString();
-                    onStaticDataLoaded.Broadcast(true, data);
-                }
+                DRIFT_LOG(Base, Error, TEXT("Failed to download static data file: '%s'. Error: %s"), *name, *result.Error);
+                BroadcastStaticDataLoaded(false, nullptr);
+                return;
+            }
 
-                auto event = MakeEvent(TEXT("drift.static_data_downloaded"));
-                event->Add(TEXT("filename"), *data_name);
-                event->Add(TEXT("pin"), *pin);
-                event->Add(TEXT("commit"), *commit);
-                event->Add(TEXT("bytes"), data_context.response->GetContentLength());
-                event->Add(TEXT("cdn"), *cdn_name);
-                event->Add(TEXT("index_request_time"), (index_received - index_sent).GetTotalSeconds());
-                event->Add(TEXT("data_request_time"), (data_context.received - data_context.sent).GetTotalSeconds());
-                event->Add(TEXT("total_time"), (data_context.received - index_sent).GetTotalSeconds());
-                AddAnalyticsEvent(MoveTemp(event));
-            });
-            data_request->OnError.BindLambda([this, data_name, commit, pin, cdn_name, sync](ResponseContext& data_context)
-            {
-                sync->remaining -= 1;
-                if (!sync->succeeded && sync->remaining <= 0)
-                {
-                    FString Error;
-                    data_context.errorHandled = GetResponseError(data_context, Error);
-                    DRIFT_LOG(Base, Error, TEXT("Failed to download static data file: '%s'. Error: %s"), *data_name, *Error);
-                    onStaticDataLoaded.Broadcast(false, TEXT(""));
-                }
+            DRIFT_LOG(Base, Log, TEXT("Loading of static data file: '%s' done"), *name);
 
-                auto event = MakeEvent(TEXT("drift.static_data_download_failed"));
-                event->Add(TEXT("filename"), *data_name);
-                event->Add(TEXT("pin"), *pin);
-                event->Add(TEXT("commit"), *commit);
-                event->Add(TEXT("cdn"), *cdn_name);
-                event->Add(TEXT("error"), data_context.error);
-                AddAnalyticsEvent(MoveTemp(event));
-            });
-            data_request->Dispatch();
-        };
+            BroadcastStaticDataLoaded(true, view);
 
-        sync->remaining = FMath::Max(static_data.static_data_urls[0].cdn_list.Num(), 1);
-        if (static_data.static_data_urls[0].cdn_list.Num() == 0)
-        {
-            loader(static_data.static_data_urls[0].data_root_url, name, TEXT("default"));
-        }
-        else
-        {
-            for (const auto& cdn : static_data.static_data_urls[0].cdn_list)
+            if (result.bFromStore)
             {
-                loader(cdn.data_root_url, name, cdn.cdn);
+                return;
             }
-        }
+
+            const auto now = FDateTime::UtcNow();
+            auto event = MakeEvent(TEXT("drift.static_data_downloaded"));
+            event->Add(TEXT("filename"), *name);
+            event->Add(TEXT("pin"), *pin);
+            event->Add(TEXT("commit"), *commit);
+            event->Add(TEXT("bytes"), result.Bytes);
+            event->Add(TEXT("resumed_bytes"), result.ResumedBytes);
+            event->Add(TEXT("cdn"), *result.Cdn);
+            event->Add(TEXT("index_request_time"), (index_received - index_sent).GetTotalSeconds());
+            event->Add(TEXT("data_request_time"), result.DownloadSeconds);
+            event->Add(TEXT("total_time"), (now - index_sent).GetTotalSeconds());
+            AddAnalyticsEvent(MoveTemp(event));
+        });
+        loader->Start();
     });
     request->OnError.BindLambda([this](ResponseContext& context)
     {
         FString Error;
         context.errorHandled = GetResponseError(context, Error);
         DRIFT_LOG(Base, Error, TEXT("Failed to get static data endpoints. Error: %s"), *Error);
-        onStaticDataLoaded.Broadcast(false, TEXT(""));
+        BroadcastStaticDataLoaded(false, nullptr);
     });
     request->Dispatch();
 }
 
 
+void FDriftBase::BroadcastStaticDataLoaded(bool success, const TSharedPtr<FDriftStaticDataView>& view)
+{
+    onStaticDataViewLoaded.Broadcast(success, view);
+
+    // Converting to a string copies the whole file, only do it for those who still want one
+    if (onStaticDataLoaded.IsBound())
+    {
+        onStaticDataLoaded.Broadcast(success, success && view.IsValid() ? view->ToString() : FString{});
+    }
+}
+
+
 void FDriftBase::LoadPlayerStats()
 {
     check(playerCounterManager.IsValid());
@@ -857,13 +1065,64 @@ void FDriftBase::LoadPlayerGameStateImpl(const FString& name, const FDriftGameSt
     InternalLoadPlayerGameState(name, GameStateInfo->gamestate_url, delegate);
 }
 
+/**
+ * A game state body spooled to a temporary file as it downloads, so only one copy of it is
+ * ever in memory, and only once it's complete. The file goes away with the download.
+ */
+struct FGameStateDownload
+{
+    FGameStateDownload()
+        : Path{ FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Drift"), TEXT("GameStates"), FGuid::NewGuid().ToString() + TEXT(".json")) }
+        , File{ IFileManager::Get().CreateFileWriter(*Path) }
+    {
+    }
+
+    ~FGameStateDownload()
+    {
+        File.Reset();
+        IFileManager::Get().Delete(*Path, false, false, true);
+    }
+
+    FString Path;
+    TUniquePtr<FArchive> File;
+    int64 Bytes = 0;
+};
+
 void FDriftBase::InternalLoadPlayerGameState(const FString& name, const FString& url, const FDriftGameStateLoadedDelegate& delegate)
 {
     const auto Request = GetGameRequestManager()->Get(url);
-    Request->OnResponse.BindLambda([this, name, delegate](ResponseContext& Context, JsonDocument& Doc)
+
+    // Game states can be large, so inflate the body as it arrives and spool it to disk instead
+    // of keeping both the response and its string conversion around
+    const auto Download = MakeShared<FGameStateDownload, ESPMode::ThreadSafe>();
+    Request->SetAcceptGzip(true);
+    Request->SetResponseChunkHandler(FHttpResponseChunkDelegate::CreateLambda([Download, MaxBytes = maxGameStateBytes_](const uint8* Data, int64 Size)
     {
+        if (!Download->File.IsValid() || (MaxBytes > 0 && Download->Bytes + Size > MaxBytes))
+        {
+            return false;
+        }
+        Download->File->Serialize(const_cast<uint8*>(Data), Size);
+        Download->Bytes += Size;
+        return !Download->File->IsError();
+    }));
+    Request->OnResponse.BindLambda([this, name, delegate, Download](ResponseContext& Context, JsonDocument& Doc)
+    {
+        const auto Bytes = Download->Bytes;
+        Download->File.Reset();
+
+        // Parsed as it's read, so the body is never in memory as a string as well as a document
+        const TUniquePtr<FArchive> Reader{ IFileManager::Get().CreateFileReader(*Download->Path) };
+        if (!Reader.IsValid())
+        {
+            Context.error = TEXT("Failed to read downloaded game state");
+            return;
+        }
+
+        const auto bParsed = JsonArchive::LoadDocument(*Reader, Doc);
+
         FPlayerGameStateResponse Response;
-        if (!JsonArchive::LoadObject(Doc, Response) || Response.data.IsNull() || !Response.data.HasField(TEXT("data")))
+        if (!bParsed || !JsonArchive::LoadObject(Doc, Response) || Response.data.IsNull() || !Response.data.HasField(TEXT("data")))
         {
             Context.error = TEXT("Failed to parse game state response");
             return;
@@ -874,7 +1133,7 @@ void FDriftBase::InternalLoadPlayerGameState(const FString& name, const FString&
 
         auto Event = MakeEvent(TEXT("drift.gamestate_loaded"));
         Event->Add(TEXT("namespace"), *name);
-        Event->Add(TEXT("bytes"), Context.response->GetContentLength());
+        Event->Add(TEXT("bytes"), Bytes);
         Event->Add(TEXT("request_time"), (Context.received - Context.sent).GetTotalSeconds());
         AddAnalyticsEvent(MoveTemp(Event));
     });
@@ -2632,6 +2891,7 @@ void FDriftBase::AuthenticatePlayer(IDriftAuthProvider* provider)
 
     state_ = DriftSessionState::Connecting;
     BroadcastConnectionStateChange(state_);
+    connectStartTime_ = FDateTime::UtcNow();
 
     auto request = GetRootRequestManager()->Post(driftEndpoints.auth, payload, HttpStatusCodes::Ok);
     request->OnResponse.BindLambda([this](ResponseContext& context, JsonDocument& doc)
@@ -2768,23 +3028,24 @@ void FDriftBase::RegisterClient()
             return;
         }
         heartbeatUrl = driftClient.url;
-        heartbeatDueInSeconds_ = driftClient.next_heartbeat_seconds;
+        StartHeartbeat(driftClient.next_heartbeat_seconds, driftClient.heartbeat_timeout_seconds);
         TSharedRef<JsonRequestManager> manager = MakeShareable(new JWTRequestManager(driftClient.jwt));
         manager->DefaultErrorHandler.BindRaw(this, &FDriftBase::DefaultErrorHandler);
         manager->DefaultDriftDeprecationMessageHandler.BindRaw(this, &FDriftBase::DriftDeprecationMessageHandler);
         manager->SetApiKey(GetApiKeyHeader());
         manager->SetCache(httpCache_);
+        // The client JWT changes every session, so cache authenticated reads per player instead
+        manager->SetCachePartition(FString::Printf(TEXT("player:%d"), driftClient.player_id));
         SetGameRequestManager(manager);
+        playerCounterManager->ConfigureSession(driftClient.player_id);
         playerCounterManager->SetRequestManager(manager);
         eventManager->SetRequestManager(manager);
         logForwarder->SetRequestManager(manager);
+        messageQueue->ConfigureSession(driftClient.player_id);
         messageQueue->SetRequestManager(manager);
-        partyManager->SetRequestManager(manager);
+        socialSession->SetRequestManager(manager);
         matchmaker->SetRequestManager(manager);
-        lobbyManager->SetRequestManager(manager);
         matchPlacementManager->SetRequestManager(manager);
-        sandboxManager->SetRequestManager(manager);
-        partyManager->ConfigureSession(driftClient.player_id, driftEndpoints.party_invites, driftEndpoints.parties);
         GetPlayerEndpoints();
     });
     request->OnError.BindLambda([this](ResponseContext& context)
@@ -2819,9 +3080,9 @@ void FDriftBase::GetPlayerEndpoints()
             return;
         }
         matchmaker->ConfigureSession(driftEndpoints, driftClient.player_id);
-        lobbyManager->ConfigureSession(driftEndpoints, driftClient.player_id);
+        socialSession->ConfigureSession(driftEndpoints, driftClient.player_id);
         matchPlacementManager->ConfigureSession(driftEndpoints, driftClient.player_id);
-        sandboxManager->ConfigureSession(driftEndpoints, driftClient.player_id);
+        PrefetchUrls(doc[TEXT("endpoints")]);
         GetPlayerInfo();
     });
     request->OnError.BindLambda([this](ResponseContext& context)
@@ -2851,10 +3112,16 @@ void FDriftBase::GetPlayerInfo()
         }
         playerCounterManager->SetCounterUrl(myPlayer.counter_url);
         messageQueue->SetMessageQueueUrl(myPlayer.messages_url);
+        PrefetchUrls(doc);
         state_ = DriftSessionState::Connected;
         FetchDriftClientConfigs({});
         BroadcastConnectionStateChange(state_);
 
+        auto event = MakeEvent(TEXT("drift.connected"));
+        event->Add(TEXT("time_to_connected"), (FDateTime::UtcNow() - connectStartTime_).GetTotalSeconds());
+        event->Add(TEXT("prefetched"), prefetchedUrls_.Num());
+        AddAnalyticsEvent(MoveTemp(event));
+
         // TODO: Let user determine if the name should be set or not
         if (authProvider.IsValid())
         {
@@ -2880,6 +3147,57 @@ void FDriftBase::GetPlayerInfo()
 }
 
 
+void FDriftBase::PrefetchUrls(const JsonValue& urls)
+{
+    if (!urls.IsObject())
+    {
+        return;
+    }
+
+    for (const auto& name : prefetchEndpoints_)
+    {
+        const auto value = urls.FindField(name);
+        if (!value.IsString())
+        {
+            continue;
+        }
+
+        const FString url = value.GetString();
+        if (url.IsEmpty() || prefetchedUrls_.Contains(url))
+        {
+            continue;
+        }
+        prefetchedUrls_.Add(url);
+
+        DRIFT_LOG(Base, Verbose, TEXT("Prefetching '%s' from %s"), *name, *url);
+
+        const auto manager = GetGameRequestManager();
+        const auto partition = manager->GetCachePartition();
+        const auto bCompleted = MakeShared<bool>(false);
+        auto request = manager->Get(url, HttpStatusCodes::Ok);
+        request->OnResponse.BindLambda([this, partition, bCompleted](ResponseContext& context, JsonDocument& doc)
+        {
+            *bCompleted = true;
+            prefetchCache_->Park(context, partition);
+        });
+        request->OnError.BindLambda([this, url, partition, bCompleted](ResponseContext& context)
+        {
+            *bCompleted = true;
+            // Requests waiting for this go over the wire, and will report any problem themselves
+            prefetchCache_->Abandon(url, partition);
+            context.errorHandled = true;
+        });
+
+        // Requests made from here on wait for this one instead of being sent again. Anything
+        // answered from the cache straight away has completed by now and isn't parked.
+        if (request->Dispatch() && !*bCompleted)
+        {
+            prefetchCache_->BeginPrefetch(url, partition);
+        }
+    }
+}
+
+
 FString FDriftBase::GetPlayerName()
 {
     return myPlayer.player_name;
@@ -3637,7 +3955,7 @@ void FDriftBase::FinalizeRegisteringServer()
 			return;
 		}
 		heartbeatUrl = drift_server.heartbeat_url;
-		heartbeatDueInSeconds_ = -1.0;
+		StartHeartbeat(0.0f);
 		state_ = DriftSessionState::Connected;
 		onServerRegistered.Broadcast(true);
 		UpdateServer(TEXT("ready"), TEXT(""), FDriftServerStatusUpdatedDelegate{});
@@ -4013,7 +4331,7 @@ void FDriftBase::CachePlayerInfo(int32 playerID)
         return;
     }
 
-    serverCounterManagers.Add(playerID, MakeUnique<FDriftCounterManager>());
+    serverCounterManagers.Add(playerID, MakeUnique<FDriftCounterManager>())->SetAggregator(serverCounterAggregator, playerID);
 
     FString url = driftEndpoints.players;
     internal::UrlHelper::AddUrlOption(url, TEXT("player_id"), FString::Printf(TEXT("%d"), playerID));
@@ -4037,6 +4355,9 @@ void FDriftBase::CachePlayerInfo(int32 playerID)
         manager->SetCounterUrl(playerInfo.counter_url);
         manager->LoadCounters();
 
+        serverCounterAggregator->SetRequestManager(GetGameRequestManager());
+        serverCounterAggregator->SetBulkUrl(serverCounterBulkFlush_ ? driftEndpoints.counters : FString{});
+
         DRIFT_LOG(Base, Verbose, TEXT("Server cached info for player: %s (%d)"), *playerInfo.player_name, playerInfo.player_id);
     });
     request->OnError.BindLambda([this, playerID](ResponseContext& context)
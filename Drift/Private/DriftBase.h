@@ -16,14 +16,18 @@
 #include "DriftSchemas.h"
 #include "JsonRequestManager.h"
 #include "DriftCounterManager.h"
+#include "DriftHeartbeatScheduler.h"
+#include "DriftHeartbeatMultiplexer.h"
 #include "DriftEventManager.h"
 #include "DriftMessageQueue.h"
+#include "DriftSocialSession.h"
 #include "DriftPartyManager.h"
 #include "DriftFlexmatch.h"
 #include "DriftLobbyManager.h"
 #include "DriftMatchPlacementManager.h"
 #include "DriftSandboxManager.h"
 #include "LogForwarder.h"
+#include "DriftStaticDataStore.h"
 
 #include "Tickable.h"
 #include "VisualLogger/VisualLoggerTypes.h"
@@ -60,6 +64,9 @@ enum class DriftSessionState
 };
 
 class IDriftAuthProviderFactory;
+class FDriftCdnScoreboard;
+class FDriftCounterAggregator;
+class PrefetchHttpCache;
 class IDriftAuthProvider;
 
 
@@ -164,6 +171,7 @@ public:
     FDriftFriendPresenceChangedDelegate& OnFriendPresenceChanged() override { return onFriendPresenceChanged; }
     FDriftRecievedMatchInviteDelegate& OnReceivedMatchInvite() override { return onReceivedMatchInvite; }
     FDriftStaticDataLoadedDelegate& OnStaticDataLoaded() override { return onStaticDataLoaded; }
+    FDriftStaticDataViewLoadedDelegate& OnStaticDataViewLoaded() override { return onStaticDataViewLoaded; }
     FDriftStaticDataProgressDelegate& OnStaticDataProgress() override { return onStaticDataProgress; }
     FDriftPlayerStatsLoadedDelegate& OnPlayerStatsLoaded() override { return onPlayerStatsLoaded; }
     FDriftPlayerGameStateLoadedDelegate& OnPlayerGameStateLoaded() override { return onPlayerGameStateLoaded; }
@@ -226,6 +234,13 @@ public:
 
     static bool GetResponseError(const ResponseContext& Context, FString& Error);
 
+    /** Shared by all instances in the process, to batch their heartbeats when the backend supports it */
+    void SetHeartbeatMultiplexer(TSharedPtr<FDriftHeartbeatMultiplexer> multiplexer);
+
+    /** Shared by all instances in the process, as they all download static data to the same place */
+    void SetStaticDataStore(TSharedPtr<FDriftStaticDataStore> store);
+    void SetCdnScoreboard(TSharedPtr<FDriftCdnScoreboard> scoreboard);
+
 private:
     void ConfigureSettingsSection(const FString& config);
 
@@ -235,6 +250,7 @@ private:
     void RegisterClient();
     void GetPlayerEndpoints();
     void GetPlayerInfo();
+    void PrefetchUrls(const JsonValue& urls);
 
     void AuthenticatePlayer(IDriftAuthProvider* provider);
 
@@ -282,6 +298,7 @@ private:
     FDriftFriendPresenceChangedDelegate onFriendPresenceChanged;
     FDriftRecievedMatchInviteDelegate onReceivedMatchInvite;
     FDriftStaticDataLoadedDelegate onStaticDataLoaded;
+    FDriftStaticDataViewLoadedDelegate onStaticDataViewLoaded;
     FDriftStaticDataProgressDelegate onStaticDataProgress;
     FDriftPlayerStatsLoadedDelegate onPlayerStatsLoaded;
     FDriftPlayerGameStateLoadedDelegate onPlayerGameStateLoaded;
@@ -310,12 +327,13 @@ private:
 
     TSharedPtr<JsonRequestManager> GetRootRequestManager() const;
     TSharedPtr<JsonRequestManager> GetGameRequestManager() const;
-    void SetGameRequestManager(TSharedPtr<JsonRequestManager> manager)
-    {
-        authenticatedRequestManager = manager;
-    }
+    void SetGameRequestManager(TSharedPtr<JsonRequestManager> manager);
 
 	void TickHeartbeat(float deltaTime);
+    void StartHeartbeat(float firstHeartbeatSeconds, float timeoutSeconds = 0.0f);
+    void StopHeartbeat();
+    void SendHeartbeat();
+    void HandleHeartbeatResult(const FDriftHeartbeatResult& result);
     void TickMatchInvites();
     void TickFriendUpdates(float deltaTime);
 
@@ -330,6 +348,8 @@ private:
 
     void LoadPlayerGameStateInfos(TFunction<void(bool)> next);
 
+    void BroadcastStaticDataLoaded(bool success, const TSharedPtr<FDriftStaticDataView>& view);
+
     void InternalGetUserIdentities(const FString& url, const FDriftGetUserIdentitiesDelegate& delegate);
 
     void JoinMatchQueueImpl(const FString& ref, const FString& placement, const FString& token, const FDriftJoinedMatchQueueDelegate& delegate);
@@ -342,9 +362,11 @@ private:
     bool IsPreRegistered() const;
 
     void CreatePlayerCounterManager();
+    void CreateServerCounterAggregator();
     void CreateEventManager();
     void CreateLogForwarder();
     void CreateMessageQueue();
+    void CreateSocialSession();
     void CreatePartyManager();
     void CreateMatchmaker();
     void CreateLobbyManager();
@@ -416,11 +438,14 @@ private:
     const FString instanceDisplayName_;
     const int32 instanceIndex_;
 
-    float heartbeatDueInSeconds_{ FLT_MAX };
+    FDriftHeartbeatScheduler heartbeatScheduler_;
 	float heartbeatRetryDelay_{ 1.0f };
 	int32 heartbeatRetryAttempt_{ 0 };
 	float heartbeatRetryDelayCap_{ 10.0f };
-    FDateTime heartbeatTimeout_{ FDateTime::MinValue() };
+
+    TSharedPtr<FDriftHeartbeatMultiplexer> heartbeatMultiplexer_;
+    int32 heartbeatMultiplexerHandle_ = INDEX_NONE;
+    bool heartbeatBatching_ = false;
 
     DriftSessionState state_;
 
@@ -437,11 +462,15 @@ private:
 
     TUniquePtr<FDriftCounterManager> playerCounterManager;
     TMap<int32, TUniquePtr<FDriftCounterManager>> serverCounterManagers;
+    TSharedPtr<FDriftCounterAggregator> serverCounterAggregator;
+    bool serverCounterBulkFlush_ = false;
 
     TSharedPtr<FDriftEventManager> eventManager;
 
     TSharedPtr<FDriftMessageQueue> messageQueue;
 
+    TSharedPtr<FDriftSocialSession> socialSession;
+
     TUniquePtr<FLogForwarder> logForwarder;
 
 	TSharedPtr<FDriftPartyManager> partyManager;
@@ -497,13 +526,25 @@ private:
     TUniquePtr<IDriftAuthProviderFactory> userPassAuthProviderFactory_;
     TSharedPtr<IDriftAuthProvider> authProvider;
 
+    TSharedPtr<PrefetchHttpCache> prefetchCache_;
     TSharedPtr<IHttpCache> httpCache_;
 
+    /** Names of endpoints to fetch ahead of time during login, from the PrefetchEndpoints setting */
+    TArray<FString> prefetchEndpoints_;
+    TSet<FString> prefetchedUrls_;
+    FDateTime connectStartTime_;
+
+    TSharedPtr<FDriftStaticDataStore> staticDataStore_;
+    TSharedPtr<FDriftCdnScoreboard> cdnScoreboard_;
+
     TMap<FString, FDateTime> deprecations_;
     FString previousDeprecationHeader_;
 
     bool ignoreCommandLineArguments_ = false;
 
+    /** Game states larger than this many bytes are refused while downloading, zero for no limit */
+    int64 maxGameStateBytes_ = 0;
+
 	FString serverJTI_;
 	FString serverBearerToken_;
 
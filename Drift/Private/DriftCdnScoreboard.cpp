@@ -0,0 +1,218 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftCdnScoreboard.h"
+
+#include "DriftStaticDataLoader.h"
+#include "DriftStaticDataStore.h"
+#include "JsonArchive.h"
+
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+
+/** Weight of the newest sample in the moving averages */
+static constexpr float CDN_STATS_SMOOTHING = 0.25f;
+
+/** Used to turn throughput into an expected download time when ranking */
+static constexpr float CDN_REFERENCE_DOWNLOAD_BYTES = 1024.0f * 1024.0f;
+
+static constexpr float CDN_DEFAULT_HEDGE_DELAY = 1.0f;
+static constexpr float CDN_MIN_HEDGE_DELAY = 0.2f;
+static constexpr float CDN_MAX_HEDGE_DELAY = 5.0f;
+
+/** Changes are collected for this long before being written to disk */
+static constexpr float CDN_STATS_SAVE_DELAY = 5.0f;
+
+
+bool FDriftCdnStats::Serialize(SerializationContext& context)
+{
+    return SERIALIZE_PROPERTY(context, cdn)
+        && SERIALIZE_PROPERTY(context, latency)
+        && SERIALIZE_PROPERTY(context, latency_deviation)
+        && SERIALIZE_PROPERTY(context, throughput)
+        && SERIALIZE_PROPERTY(context, failure_rate)
+        && SERIALIZE_PROPERTY(context, samples)
+        && SERIALIZE_PROPERTY(context, last_updated);
+}
+
+
+FDriftCdnScoreboard::FDriftCdnScoreboard()
+    : FDriftCdnScoreboard(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("DriftStaticData"), TEXT("CdnStats.json")))
+{
+}
+
+
+FDriftCdnScoreboard::FDriftCdnScoreboard(const FString& InFilePath)
+    : FilePath{ InFilePath }
+{
+    Load();
+}
+
+
+FDriftCdnScoreboard::~FDriftCdnScoreboard()
+{
+    if (bDirty)
+    {
+        Save();
+    }
+}
+
+
+void FDriftCdnScoreboard::Tick(float DeltaTime)
+{
+    SaveDueInSeconds -= DeltaTime;
+    if (SaveDueInSeconds <= 0.0f)
+    {
+        Save();
+    }
+}
+
+
+TStatId FDriftCdnScoreboard::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(FDriftCdnScoreboard, STATGROUP_Tickables);
+}
+
+
+TArray<FDriftStaticDataSource> FDriftCdnScoreboard::Rank(const TArray<FDriftStaticDataSource>& Sources) const
+{
+    auto Ranked = Sources;
+    Ranked.StableSort([this](const FDriftStaticDataSource& A, const FDriftStaticDataSource& B)
+    {
+        const auto StatsA = Find(A.Cdn);
+        const auto StatsB = Find(B.Cdn);
+
+        // CDNs we know nothing about go first, so that every CDN gets measured at least once
+        if (!StatsA || !StatsB)
+        {
+            return !StatsA && StatsB;
+        }
+        return GetExpectedSeconds(*StatsA) < GetExpectedSeconds(*StatsB);
+    });
+    return Ranked;
+}
+
+
+float FDriftCdnScoreboard::GetHedgeDelay(const FString& Cdn) const
+{
+    const auto Stats = Find(Cdn);
+    if (!Stats || Stats->latency <= 0.0f)
+    {
+        return CDN_DEFAULT_HEDGE_DELAY;
+    }
+
+    // Same idea as a TCP retransmission timeout: only hedge when the CDN is slower than it normally is
+    return FMath::Clamp(Stats->latency + 4.0f * Stats->latency_deviation, CDN_MIN_HEDGE_DELAY, CDN_MAX_HEDGE_DELAY);
+}
+
+
+void FDriftCdnScoreboard::RecordFirstByte(const FString& Cdn, float LatencySeconds)
+{
+    auto& Stats = FindOrAdd(Cdn);
+    if (Stats.latency <= 0.0f)
+    {
+        Stats.latency = LatencySeconds;
+        Stats.latency_deviation = LatencySeconds / 2.0f;
+    }
+    else
+    {
+        Stats.latency_deviation = FMath::Lerp(Stats.latency_deviation, FMath::Abs(LatencySeconds - Stats.latency), CDN_STATS_SMOOTHING);
+        Stats.latency = FMath::Lerp(Stats.latency, LatencySeconds, CDN_STATS_SMOOTHING);
+    }
+    MarkDirty();
+}
+
+
+void FDriftCdnScoreboard::RecordTransfer(const FString& Cdn, int64 Bytes, float Seconds)
+{
+    auto& Stats = FindOrAdd(Cdn);
+    if (Bytes > 0 && Seconds > 0.0f)
+    {
+        const auto Throughput = Bytes / Seconds;
+        Stats.throughput = Stats.throughput <= 0.0f ? Throughput : FMath::Lerp(Stats.throughput, Throughput, CDN_STATS_SMOOTHING);
+    }
+    RecordOutcome(Stats, false);
+    MarkDirty();
+}
+
+
+void FDriftCdnScoreboard::RecordFailure(const FString& Cdn)
+{
+    RecordOutcome(FindOrAdd(Cdn), true);
+    MarkDirty();
+}
+
+
+const FDriftCdnStats* FDriftCdnScoreboard::Find(const FString& Cdn) const
+{
+    return Entries.FindByPredicate([&Cdn](const FDriftCdnStats& Stats)
+    {
+        return Stats.cdn == Cdn;
+    });
+}
+
+
+FDriftCdnStats& FDriftCdnScoreboard::FindOrAdd(const FString& Cdn)
+{
+    if (const auto Stats = Find(Cdn))
+    {
+        return const_cast<FDriftCdnStats&>(*Stats);
+    }
+    auto& Stats = Entries.AddDefaulted_GetRef();
+    Stats.cdn = Cdn;
+    return Stats;
+}
+
+
+void FDriftCdnScoreboard::RecordOutcome(FDriftCdnStats& Stats, bool bFailed)
+{
+    Stats.failure_rate = FMath::Lerp(Stats.failure_rate, bFailed ? 1.0f : 0.0f, CDN_STATS_SMOOTHING);
+    Stats.samples += 1;
+    Stats.last_updated = FDateTime::UtcNow();
+}
+
+
+float FDriftCdnScoreboard::GetExpectedSeconds(const FDriftCdnStats& Stats) const
+{
+    const auto TransferSeconds = Stats.throughput > 0.0f ? CDN_REFERENCE_DOWNLOAD_BYTES / Stats.throughput : 0.0f;
+    const auto Reliability = FMath::Max(1.0f - Stats.failure_rate, 0.05f);
+    return (Stats.latency + TransferSeconds) / Reliability;
+}
+
+
+void FDriftCdnScoreboard::MarkDirty()
+{
+    if (!bDirty)
+    {
+        bDirty = true;
+        SaveDueInSeconds = CDN_STATS_SAVE_DELAY;
+    }
+}
+
+
+void FDriftCdnScoreboard::Load()
+{
+    FString Content;
+    if (!FFileHelper::LoadFileToString(Content, *FilePath))
+    {
+        return;
+    }
+
+    if (!JsonArchive::LoadObject(*Content, Entries))
+    {
+        UE_LOG(LogDriftStaticData, Warning, TEXT("Failed to parse CDN stats, starting over"));
+        Entries.Empty();
+    }
+}
+
+
+void FDriftCdnScoreboard::Save()
+{
+    bDirty = false;
+
+    FString Content;
+    if (!JsonArchive::SaveObject(Entries, Content) || !FFileHelper::SaveStringToFile(Content, *FilePath))
+    {
+        UE_LOG(LogDriftStaticData, Warning, TEXT("Failed to save CDN stats to '%s'"), *FilePath);
+    }
+}
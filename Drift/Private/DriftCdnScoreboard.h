@@ -0,0 +1,76 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+
+
+class SerializationContext;
+struct FDriftStaticDataSource;
+
+
+/** Exponentially weighted performance history of a single CDN */
+struct FDriftCdnStats
+{
+    FString cdn;
+    /** Time to first byte, in seconds */
+    float latency = 0.0f;
+    /** Mean deviation of the time to first byte, in seconds */
+    float latency_deviation = 0.0f;
+    /** Bytes per second once the transfer has started */
+    float throughput = 0.0f;
+    /** Fraction of recent attempts that failed */
+    float failure_rate = 0.0f;
+    int32 samples = 0;
+    FDateTime last_updated{ 0 };
+
+    bool Serialize(SerializationContext& context);
+};
+
+
+/**
+ * Keeps track of how well each static data CDN has performed, across sessions,
+ * and ranks them so that downloads start with the one most likely to be fastest.
+ *
+ * There should only be one per process, as the history is saved to a single file.
+ * Changes are saved a little while after they're made, and on destruction.
+ */
+class FDriftCdnScoreboard : public FTickableGameObject
+{
+public:
+    FDriftCdnScoreboard();
+    explicit FDriftCdnScoreboard(const FString& InFilePath);
+    ~FDriftCdnScoreboard();
+
+    // FTickableGameObject API
+    void Tick(float DeltaTime) override;
+    bool IsTickable() const override { return bDirty; }
+    TStatId GetStatId() const override;
+
+    /** Return the sources ordered from most to least preferred */
+    TArray<FDriftStaticDataSource> Rank(const TArray<FDriftStaticDataSource>& Sources) const;
+
+    /** How long to wait for the first byte from a CDN before also trying the next one */
+    float GetHedgeDelay(const FString& Cdn) const;
+
+    void RecordFirstByte(const FString& Cdn, float LatencySeconds);
+    void RecordTransfer(const FString& Cdn, int64 Bytes, float Seconds);
+    void RecordFailure(const FString& Cdn);
+
+    const FDriftCdnStats* Find(const FString& Cdn) const;
+
+private:
+    FDriftCdnStats& FindOrAdd(const FString& Cdn);
+    void RecordOutcome(FDriftCdnStats& Stats, bool bFailed);
+    float GetExpectedSeconds(const FDriftCdnStats& Stats) const;
+
+    void MarkDirty();
+    void Load();
+    void Save();
+
+    FString FilePath;
+    TArray<FDriftCdnStats> Entries;
+    bool bDirty = false;
+    float SaveDueInSeconds = 0.0f;
+};
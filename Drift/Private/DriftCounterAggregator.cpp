@@ -0,0 +1,212 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftCounterAggregator.h"
+
+#include "DriftCounterManager.h"
+#include "JsonRequestManager.h"
+#include "RetryConfig.h"
+
+#include "Misc/Guid.h"
+
+
+static const float SERVER_FLUSH_COUNTERS_INTERVAL = 10.0f;
+
+/** Bulk requests are split so that none carries more than this many modifications */
+static const int32 MAX_COUNTERS_PER_BATCH = 2000;
+
+/** Limit on concurrent requests, mostly relevant when sending one request per player */
+static const int32 MAX_BATCHES_IN_FLIGHT = 4;
+
+/** Number of flushes a batch is tried in before it's dropped */
+static const int32 MAX_FLUSH_ATTEMPTS = 5;
+
+
+bool FDriftCounterBatchEntry::Serialize(SerializationContext& context)
+{
+    return SERIALIZE_PROPERTY(context, player_id)
+        && SERIALIZE_PROPERTY(context, counter_url)
+        && SERIALIZE_PROPERTY(context, counters);
+}
+
+
+bool FDriftCounterBatchPayload::Serialize(SerializationContext& context)
+{
+    return SERIALIZE_PROPERTY(context, players);
+}
+
+
+FDriftCounterAggregator::FDriftCounterAggregator()
+{
+}
+
+
+void FDriftCounterAggregator::Tick(float DeltaTime)
+{
+    flushCountersInSeconds -= DeltaTime;
+    if (flushCountersInSeconds > 0.0f)
+    {
+        return;
+    }
+
+    Flush();
+}
+
+
+TStatId FDriftCounterAggregator::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(FDriftCounterAggregator, STATGROUP_Tickables);
+}
+
+
+void FDriftCounterAggregator::SetRequestManager(TSharedPtr<JsonRequestManager> newRequestManager)
+{
+    if (!requestManager.IsValid())
+    {
+        flushCountersInSeconds = SERVER_FLUSH_COUNTERS_INTERVAL;
+    }
+    requestManager = newRequestManager;
+}
+
+
+void FDriftCounterAggregator::SetBulkUrl(const FString& newBulkUrl)
+{
+    bulkUrl = newBulkUrl;
+}
+
+
+void FDriftCounterAggregator::Add(int32 playerId, const FString& counterUrl, TArray<FCounterModification> counters)
+{
+    if (counters.Num() == 0)
+    {
+        return;
+    }
+
+    auto& entry = collected.FindOrAdd(playerId);
+    entry.player_id = playerId;
+    entry.counter_url = counterUrl;
+    entry.counters.Append(MoveTemp(counters));
+}
+
+
+void FDriftCounterAggregator::Flush()
+{
+    flushCountersInSeconds = SERVER_FLUSH_COUNTERS_INTERVAL;
+
+    for (const auto& batch : batches)
+    {
+        batch->awaitingFlush = false;
+    }
+
+    onCollect.Broadcast();
+    CreateBatches();
+    SendBatches();
+}
+
+
+void FDriftCounterAggregator::CreateBatches()
+{
+    if (collected.Num() == 0)
+    {
+        return;
+    }
+
+    UE_LOG(LogDriftCounters, Verbose, TEXT("Aggregating counters for %d players"), collected.Num());
+
+    TSharedPtr<FCounterBatch> current;
+    int32 currentCounters = 0;
+    for (auto& pair : collected)
+    {
+        auto& entry = pair.Value;
+
+        const auto startNewBatch = !current.IsValid() || bulkUrl.IsEmpty()
+            || (currentCounters > 0 && currentCounters + entry.counters.Num() > MAX_COUNTERS_PER_BATCH);
+        if (startNewBatch)
+        {
+            current = MakeShared<FCounterBatch>();
+            current->idempotencyKey = FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphens);
+            current->bulk = !bulkUrl.IsEmpty();
+            current->url = current->bulk ? bulkUrl : entry.counter_url;
+            batches.Add(current.ToSharedRef());
+            currentCounters = 0;
+        }
+
+        currentCounters += entry.counters.Num();
+        current->payload.players.Add(MoveTemp(entry));
+    }
+    collected.Reset();
+}
+
+
+void FDriftCounterAggregator::SendBatches()
+{
+    for (const auto& batch : batches)
+    {
+        if (batchesInFlight >= MAX_BATCHES_IN_FLIGHT)
+        {
+            // The rest go out as soon as a slot frees up
+            return;
+        }
+        if (!batch->inFlight && !batch->awaitingFlush)
+        {
+            SendBatch(batch);
+        }
+    }
+}
+
+
+void FDriftCounterAggregator::SendBatch(const TSharedRef<FCounterBatch>& batch)
+{
+    auto rm = requestManager.Pin();
+    if (!rm.IsValid())
+    {
+        return;
+    }
+
+    UE_LOG(LogDriftCounters, Verbose, TEXT("Flushing counters for %d players to '%s', attempt %d"),
+        batch->payload.players.Num(), *batch->url, batch->attempts + 1);
+
+    auto request = batch->bulk
+        ? rm->Patch(batch->url, batch->payload)
+        : rm->Put(batch->url, batch->payload.players[0].counters);
+    request->SetHeader(TEXT("Idempotency-Key"), batch->idempotencyKey);
+    request->SetRetryConfig(FRetryOnServerError{});
+    request->OnResponse.BindLambda([this, batch](ResponseContext& context, JsonDocument& doc)
+    {
+        batch->inFlight = false;
+        --batchesInFlight;
+        batches.Remove(batch);
+        SendBatches();
+    });
+    request->OnError.BindLambda([this, batch](ResponseContext& context)
+    {
+        context.errorHandled = true;
+        batch->inFlight = false;
+        --batchesInFlight;
+        HandleBatchFailure(batch, context);
+        SendBatches();
+    });
+
+    batch->inFlight = true;
+    ++batchesInFlight;
+    request->Dispatch();
+}
+
+
+void FDriftCounterAggregator::HandleBatchFailure(const TSharedRef<FCounterBatch>& batch, const ResponseContext& context)
+{
+    ++batch->attempts;
+    if (IsClientError(context.responseCode) || batch->attempts >= MAX_FLUSH_ATTEMPTS)
+    {
+        UE_LOG(LogDriftCounters, Error, TEXT("Dropping counters for %d players after %d attempts, status %d: %s"),
+            batch->payload.players.Num(), batch->attempts, context.responseCode, *context.error);
+
+        batches.Remove(batch);
+        return;
+    }
+
+    // Keep the batch and its idempotency key, it goes out again with the next flush
+    batch->awaitingFlush = true;
+
+    UE_LOG(LogDriftCounters, Warning, TEXT("Failed to flush counters for %d players, status %d, retrying with the next flush"),
+        batch->payload.players.Num(), context.responseCode);
+}
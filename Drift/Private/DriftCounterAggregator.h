@@ -0,0 +1,112 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#pragma once
+
+#include "DriftSchemas.h"
+
+#include "Tickable.h"
+
+
+class JsonRequestManager;
+class ResponseContext;
+
+
+/**
+ * One player's share of a bulk counter update
+ */
+struct FDriftCounterBatchEntry
+{
+    int32 player_id = 0;
+    FString counter_url;
+    TArray<FCounterModification> counters;
+
+    bool Serialize(SerializationContext& context);
+};
+
+
+/**
+ * Payload for PATCH endpoints.counters
+ */
+struct FDriftCounterBatchPayload
+{
+    TArray<FDriftCounterBatchEntry> players;
+
+    bool Serialize(SerializationContext& context);
+};
+
+
+DECLARE_MULTICAST_DELEGATE(FDriftCounterCollectDelegate);
+
+
+/**
+ * Flushes the counters of every player in a match on one shared schedule.
+ *
+ * Server counter managers hand their pending modifications to the aggregator instead of
+ * sending them, and all of them go out together, either in a few bulk requests or, when
+ * the backend doesn't support that, as per-player requests with a bounded number in flight.
+ *
+ * Every request carries an idempotency key which is kept when it's retried, so that a
+ * retried flush the backend already applied doesn't count relative updates twice.
+ */
+class FDriftCounterAggregator : public FTickableGameObject
+{
+public:
+    FDriftCounterAggregator();
+
+    /**
+     * FTickableGameObject overrides
+     */
+    void Tick(float DeltaTime) override;
+    bool IsTickable() const override { return requestManager.IsValid(); }
+
+    TStatId GetStatId() const override;
+
+    /**
+     * API
+     */
+    void SetRequestManager(TSharedPtr<JsonRequestManager> newRequestManager);
+
+    /** Send all players' counters to this URL in bulk, or one request per player if empty */
+    void SetBulkUrl(const FString& newBulkUrl);
+
+    /** Queue modifications for the next flush */
+    void Add(int32 playerId, const FString& counterUrl, TArray<FCounterModification> counters);
+
+    /** Collect from all counter managers and send everything now */
+    void Flush();
+
+    /** Called at the start of each flush, for counter managers to Add() their pending modifications */
+    FDriftCounterCollectDelegate& OnCollect() { return onCollect; }
+
+private:
+    struct FCounterBatch
+    {
+        FString idempotencyKey;
+        FString url;
+        FDriftCounterBatchPayload payload;
+        bool bulk = false;
+        int32 attempts = 0;
+        bool inFlight = false;
+        /** Failed batches wait for the next flush rather than being retried right away */
+        bool awaitingFlush = false;
+    };
+
+    void CreateBatches();
+    void SendBatches();
+    void SendBatch(const TSharedRef<FCounterBatch>& batch);
+    void HandleBatchFailure(const TSharedRef<FCounterBatch>& batch, const ResponseContext& context);
+
+    TWeakPtr<JsonRequestManager> requestManager;
+    FString bulkUrl;
+
+    FDriftCounterCollectDelegate onCollect;
+
+    /** Modifications waiting to be put in a batch, merged per player */
+    TMap<int32, FDriftCounterBatchEntry> collected;
+
+    /** Batches not yet acknowledged, in the order they were created */
+    TArray<TSharedRef<FCounterBatch>> batches;
+    int32 batchesInFlight = 0;
+
+    float flushCountersInSeconds = FLT_MAX;
+};
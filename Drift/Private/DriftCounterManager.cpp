@@ -2,7 +2,14 @@
 
 #include "DriftCounterManager.h"
 
+#include "DriftCounterAggregator.h"
 #include "DriftSchemas.h"
+#include "RetryConfig.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
 
 
 DEFINE_LOG_CATEGORY(LogDriftCounters);
@@ -10,12 +17,32 @@ DEFINE_LOG_CATEGORY(LogDriftCounters);
 
 static const float FLUSH_COUNTERS_INTERVAL = 10.0f;
 
+/** How long modifications are held in memory before they're appended to the log, at most what a crash can lose */
+static const float WRITE_LOG_INTERVAL = 1.0f;
+
+
+/**
+ * Counters can be updated before the server data has been cached. When the counters
+ * are loaded, every modification the server hasn't acknowledged yet is applied again
+ * on top of the loaded totals, so the cache matches what the server will end up with.
+ */
+
 
 /**
- * TODO: Counters being updated before server data has been cached
- * will currently be out of sync on the client. One solution is to
- * not flush any counters before the server state has been loaded.
+ * A line in the counter log, either a batch that has been sent but not acknowledged,
+ * or modifications that haven't been sent yet if it has no idempotency key
  */
+struct FCounterLogRecord
+{
+    FString idempotency_key;
+    TArray<FCounterModification> counters;
+
+    bool Serialize(SerializationContext& context)
+    {
+        return SERIALIZE_PROPERTY(context, idempotency_key)
+            && SERIALIZE_PROPERTY(context, counters);
+    }
+};
 
 
 FDriftCounterManager::FDriftCounterManager()
@@ -23,6 +50,12 @@ FDriftCounterManager::FDriftCounterManager()
 }
 
 
+FDriftCounterManager::~FDriftCounterManager()
+{
+    WriteLog();
+}
+
+
 FString FDriftCounterManager::MakeCounterName(const FString& counterName)
 {
     FString domain = TEXT("user");
@@ -38,32 +71,58 @@ void FDriftCounterManager::AddCount(const FString& counterName, float value, boo
     UE_LOG(LogDriftCounters, Verbose, TEXT("AddCount: '%s', %.2f, absolute = %s"), *canonicalName, value, absolute ? TEXT("true") : TEXT("false"));
 
     FCounterModification modification{ 0, value, canonicalName, absolute ? TEXT("absolute") : TEXT("count"), FDateTime::UtcNow(), absolute };
-    UpdateCachedCounter(modification);
+    AppendToLog(FCounterLogRecord{ FString{}, { modification } });
+    AddModification(MoveTemp(modification));
+}
+
+
+void FDriftCounterManager::AddModification(FCounterModification modification)
+{
+    const auto counterId = InternCounterName(modification.name);
+    UpdateCachedCounter(counterId, modification);
 
 	// if this is an absolute update, we have to remove any previous relative updates
 	//  otherwise future relative updates could be incorrectly consolidated into the obsolete one
 	if (modification.absolute)
 	{
-		pendingCounters.RemoveAll([canonicalName](const FCounterModification& m)
+		int32 relativeIndex;
+		if (pendingCounterIndices.RemoveAndCopyValue(MakePendingKey(counterId, false), relativeIndex))
 		{
-			return m.name == canonicalName && !m.absolute;
-		});
+			pendingCounters[relativeIndex].removed = true;
+		}
 	}
 	// if we have a previously existing update for the same counter and type...
-    int32 existingIndex;
-    if (pendingCounters.Find(modification, existingIndex))
+    const auto pendingKey = MakePendingKey(counterId, modification.absolute);
+    if (const auto existingIndex = pendingCounterIndices.Find(pendingKey))
     {
 		// ...we can simply update the pending modification, never sending the obsolete update to the server...
-        pendingCounters[existingIndex].Update(value, FDateTime::UtcNow());
+        pendingCounters[*existingIndex].modification.Update(modification.value, modification.timestamp);
     }
     else
     {
 		// ...otherwise we have to add a new pending update to the list
-        pendingCounters.Add(MoveTemp(modification));
+        pendingCounterIndices.Add(pendingKey, pendingCounters.Add(FPendingCounter{ MoveTemp(modification) }));
     }
 }
 
 
+TArray<FCounterModification> FDriftCounterManager::TakePendingCounters()
+{
+    TArray<FCounterModification> counters;
+    counters.Reserve(pendingCounterIndices.Num());
+    for (auto& pending : pendingCounters)
+    {
+        if (!pending.removed)
+        {
+            counters.Add(MoveTemp(pending.modification));
+        }
+    }
+    pendingCounters.Reset();
+    pendingCounterIndices.Reset();
+    return counters;
+}
+
+
 bool FDriftCounterManager::GetCount(const FString& counterName, float& value) const
 {
     FString canonicalName = MakeCounterName(*counterName);
@@ -75,14 +134,10 @@ bool FDriftCounterManager::GetCount(const FString& counterName, float& value) co
         return false;
     }
     
-    auto counter = playerCounters.FindByPredicate([canonicalName](const FDriftPlayerCounter& pc) -> bool
-    {
-        return pc.name == canonicalName;
-    });
-    
-    if (counter != nullptr)
+    const auto counterId = counterIds.Find(canonicalName);
+    if (counterId != nullptr && cachedCounters[*counterId])
     {
-        value = counter->total;
+        value = playerCounters[*counterId].total;
         return true;
     }
     return false;
@@ -120,14 +175,33 @@ void FDriftCounterManager::LoadCounters()
             return;
         }
 
-        playerCounters.Empty();
-        for (const auto& counter : counters)
+        cachedCounters.Init(false, playerCounters.Num());
+        for (auto& counter : counters)
+        {
+            const auto counterId = InternCounterName(counter.name);
+            playerCounters[counterId] = MoveTemp(counter);
+            cachedCounters[counterId] = true;
+        }
+
+        // The loaded totals don't include anything the server hasn't acknowledged yet
+        for (const auto& batch : unacknowledgedBatches)
+        {
+            for (const auto& modification : batch.counters)
+            {
+                UpdateCachedCounter(InternCounterName(modification.name), modification);
+            }
+        }
+        for (const auto& pending : pendingCounters)
         {
-            playerCounters.Add(counter);
+            if (!pending.removed)
+            {
+                UpdateCachedCounter(InternCounterName(pending.modification.name), pending.modification);
+            }
         }
+
         onPlayerStatsLoaded.Broadcast(true);
 
-        UE_LOG(LogDriftCounters, Verbose, TEXT("Got %d counters"), playerCounters.Num());
+        UE_LOG(LogDriftCounters, Verbose, TEXT("Got %d counters"), counters.Num());
     });
     request->OnError.BindLambda([this](ResponseContext& context)
     {
@@ -140,7 +214,16 @@ void FDriftCounterManager::LoadCounters()
 
 void FDriftCounterManager::Tick(float DeltaTime)
 {
-    if (counterUrl.IsEmpty() || !requestManager.IsValid())
+    if (!unwrittenLog.IsEmpty())
+    {
+        writeLogInSeconds -= DeltaTime;
+        if (writeLogInSeconds <= 0.0f)
+        {
+            WriteLog();
+        }
+    }
+
+    if (counterUrl.IsEmpty() || !requestManager.IsValid() || aggregator.IsValid())
     {
         return;
     }
@@ -168,26 +251,257 @@ void FDriftCounterManager::FlushCounters()
         return;
     }
 
-    if (pendingCounters.Num() != 0)
+    if (pendingCounterIndices.Num() != 0)
     {
-        auto rm = requestManager.Pin();
-        if (!rm.IsValid())
+        if (const auto ag = aggregator.Pin())
         {
+            ag->Add(playerId, counterUrl, TakePendingCounters());
+            WriteLog();
             return;
         }
-        
-        UE_LOG(LogDriftCounters, Verbose, TEXT("[%s] Drift flushing %i counters..."), *FDateTime::UtcNow().ToString(), pendingCounters.Num());
-        
-        // TODO: thread safety?
-        TArray<FCounterModification> counters{ pendingCounters };
-        pendingCounters.Empty();
-        auto request = rm->Put(counterUrl, counters);
-        request->Dispatch();
+
+        if (!requestManager.IsValid())
+        {
+            WriteLog();
+            return;
+        }
+
+        UE_LOG(LogDriftCounters, Verbose, TEXT("[%s] Drift flushing %i counters..."), *FDateTime::UtcNow().ToString(), pendingCounterIndices.Num());
+
+        // The batch keeps its idempotency key until it's acknowledged, so that retrying it is safe
+        unacknowledgedBatches.Add(FCounterBatch{ FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphens), TakePendingCounters() });
+        RewriteLog();
     }
+    WriteLog();
+    SendNextBatch();
     flushCountersInSeconds += FLUSH_COUNTERS_INTERVAL;
 }
 
 
+void FDriftCounterManager::SendNextBatch()
+{
+    if (batchInFlight || unacknowledgedBatches.Num() == 0)
+    {
+        return;
+    }
+
+    auto rm = requestManager.Pin();
+    if (!rm.IsValid())
+    {
+        return;
+    }
+
+    const auto& batch = unacknowledgedBatches[0];
+    auto request = rm->Put(counterUrl, batch.counters);
+    request->SetHeader(TEXT("Idempotency-Key"), batch.idempotencyKey);
+    request->SetRetryConfig(FRetryOnServerError{});
+    request->OnResponse.BindLambda([this, idempotencyKey = batch.idempotencyKey](ResponseContext& context, JsonDocument& doc)
+    {
+        batchInFlight = false;
+        RemoveBatch(idempotencyKey);
+        SendNextBatch();
+    });
+    request->OnError.BindLambda([this, idempotencyKey = batch.idempotencyKey](ResponseContext& context)
+    {
+        context.errorHandled = true;
+        batchInFlight = false;
+        HandleBatchFailure(idempotencyKey, context);
+    });
+
+    batchInFlight = true;
+    request->Dispatch();
+}
+
+
+void FDriftCounterManager::HandleBatchFailure(const FString& idempotencyKey, const ResponseContext& context)
+{
+    if (IsClientError(context.responseCode))
+    {
+        UE_LOG(LogDriftCounters, Error, TEXT("Counter update was rejected, status %d: %s"), context.responseCode, *context.error);
+
+        RemoveBatch(idempotencyKey);
+        SendNextBatch();
+        return;
+    }
+
+    UE_LOG(LogDriftCounters, Warning, TEXT("Failed to flush counters, status %d, retrying with the next flush"), context.responseCode);
+}
+
+
+void FDriftCounterManager::RemoveBatch(const FString& idempotencyKey)
+{
+    const auto removed = unacknowledgedBatches.RemoveAll([&idempotencyKey](const FCounterBatch& batch)
+    {
+        return batch.idempotencyKey == idempotencyKey;
+    });
+    if (removed > 0)
+    {
+        RewriteLog();
+    }
+}
+
+
+void FDriftCounterManager::ConfigureSession(int32 newPlayerId)
+{
+    // Whatever is held back belongs in the previous player's log
+    WriteLog();
+
+    playerId = newPlayerId;
+    logFilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("DriftCounters"), FString::Printf(TEXT("%d.log"), playerId));
+
+    // Batches from a previous session are still in that player's log.
+    // Modifications made before logging in belong to this player, and go after whatever is recovered.
+    unacknowledgedBatches.Reset();
+    auto earlyCounters = TakePendingCounters();
+
+    ReplayLog();
+
+    for (auto& modification : earlyCounters)
+    {
+        AddModification(MoveTemp(modification));
+    }
+    RewriteLog();
+}
+
+
+void FDriftCounterManager::ReplayLog()
+{
+    FString content;
+    if (!FFileHelper::LoadFileToString(content, *logFilePath))
+    {
+        return;
+    }
+
+    TArray<FString> lines;
+    content.ParseIntoArrayLines(lines);
+
+    auto recovered = 0;
+    for (const auto& line : lines)
+    {
+        FCounterLogRecord record;
+        if (!JsonArchive::LoadObject(*line, record))
+        {
+            // Most likely the last line, cut short by a crash
+            UE_LOG(LogDriftCounters, Warning, TEXT("Skipping unreadable record in counter log '%s'"), *logFilePath);
+            continue;
+        }
+
+        for (auto& modification : record.counters)
+        {
+            modification.absolute = modification.counter_type == TEXT("absolute");
+        }
+        recovered += record.counters.Num();
+
+        if (record.idempotency_key.IsEmpty())
+        {
+            for (auto& modification : record.counters)
+            {
+                AddModification(MoveTemp(modification));
+            }
+        }
+        else
+        {
+            unacknowledgedBatches.Add(FCounterBatch{ MoveTemp(record.idempotency_key), MoveTemp(record.counters) });
+        }
+    }
+
+    if (recovered > 0)
+    {
+        UE_LOG(LogDriftCounters, Log, TEXT("Recovered %d counter modifications the server hasn't acknowledged"), recovered);
+    }
+}
+
+
+static FString MakeLogLine(const FCounterLogRecord& record)
+{
+    FString line;
+    if (!JsonArchive::SaveObject(record, line))
+    {
+        return {};
+    }
+
+    // The only line breaks in the JSON are between tokens, strings have theirs escaped
+    line.ReplaceInline(TEXT("\r"), TEXT(""));
+    line.ReplaceInline(TEXT("\n"), TEXT(""));
+    return line + TEXT("\n");
+}
+
+
+void FDriftCounterManager::AppendToLog(const FCounterLogRecord& record)
+{
+    if (logFilePath.IsEmpty())
+    {
+        return;
+    }
+
+    if (unwrittenLog.IsEmpty())
+    {
+        writeLogInSeconds = WRITE_LOG_INTERVAL;
+    }
+    unwrittenLog += MakeLogLine(record);
+}
+
+
+void FDriftCounterManager::WriteLog()
+{
+    if (unwrittenLog.IsEmpty())
+    {
+        return;
+    }
+
+    if (!FFileHelper::SaveStringToFile(unwrittenLog, *logFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+    {
+        UE_LOG(LogDriftCounters, Warning, TEXT("Failed to append to counter log '%s'"), *logFilePath);
+    }
+    unwrittenLog.Reset();
+}
+
+
+void FDriftCounterManager::RewriteLog()
+{
+    // The rewritten log holds every pending modification, including the ones not appended yet
+    unwrittenLog.Reset();
+
+    if (logFilePath.IsEmpty())
+    {
+        return;
+    }
+
+    FString content;
+    for (const auto& batch : unacknowledgedBatches)
+    {
+        content += MakeLogLine(FCounterLogRecord{ batch.idempotencyKey, batch.counters });
+    }
+
+    FCounterLogRecord pending;
+    for (const auto& counter : pendingCounters)
+    {
+        if (!counter.removed)
+        {
+            pending.counters.Add(counter.modification);
+        }
+    }
+    if (pending.counters.Num() > 0)
+    {
+        content += MakeLogLine(pending);
+    }
+
+    if (content.IsEmpty())
+    {
+        IFileManager::Get().Delete(*logFilePath, false, false, true);
+        return;
+    }
+
+    // Write a new log next to the old one and swap it in, so that a crash leaves one or the other intact
+    const auto tempFilePath = logFilePath + TEXT(".tmp");
+    if (!FFileHelper::SaveStringToFile(content, *tempFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM)
+        || !IFileManager::Get().Move(*logFilePath, *tempFilePath, true, true))
+    {
+        UE_LOG(LogDriftCounters, Warning, TEXT("Failed to write counter log '%s'"), *logFilePath);
+    }
+}
+
+
 void FDriftCounterManager::SetRequestManager(TSharedPtr<JsonRequestManager> newRequestManager)
 {
     requestManager = newRequestManager;
@@ -201,29 +515,48 @@ void FDriftCounterManager::SetCounterUrl(const FString& newCounterUrl)
 }
 
 
+void FDriftCounterManager::SetAggregator(TSharedPtr<FDriftCounterAggregator> newAggregator, int32 newPlayerId)
+{
+    aggregator = newAggregator;
+    playerId = newPlayerId;
+}
+
+
 /**
  * Given a counter modification, update the matching cached counter for the player
  * so that we don't need to re-download the full set of counters for every single update.
  */
-void FDriftCounterManager::UpdateCachedCounter(const FCounterModification& update)
+void FDriftCounterManager::UpdateCachedCounter(int32 counterId, const FCounterModification& update)
 {
-    auto playerCounter = playerCounters.FindByPredicate([&update](FDriftPlayerCounter& pc)
-    {
-        return pc.name == update.name;
-    });
-    if (playerCounter != nullptr)
+    auto& playerCounter = playerCounters[counterId];
+    if (cachedCounters[counterId])
     {
         if (update.absolute)
         {
-            playerCounter->total = update.value;
+            playerCounter.total = update.value;
         }
         else
         {
-            playerCounter->total += update.value;
+            playerCounter.total += update.value;
         }
     }
     else
     {
-        playerCounters.Add(FDriftPlayerCounter(-1, update.value, update.name));
+        playerCounter = FDriftPlayerCounter(-1, update.value, update.name);
+        cachedCounters[counterId] = true;
     }
 }
+
+
+int32 FDriftCounterManager::InternCounterName(const FString& canonicalName)
+{
+    if (const auto counterId = counterIds.Find(canonicalName))
+    {
+        return *counterId;
+    }
+
+    const auto counterId = playerCounters.Add(FDriftPlayerCounter(-1, 0.0f, canonicalName));
+    cachedCounters.Add(false);
+    counterIds.Add(canonicalName, counterId);
+    return counterId;
+}
@@ -12,12 +12,17 @@
 DECLARE_LOG_CATEGORY_EXTERN(LogDriftCounters, Log, All);
 
 
+class FDriftCounterAggregator;
+struct FCounterLogRecord;
+
+
 class FDriftCounterManager : public FTickableGameObject
 {
 public:
     static FString MakeCounterName(const FString& counterName);
 
     FDriftCounterManager();
+    ~FDriftCounterManager();
 
     /**
      * FTickableGameObject overrides
@@ -37,13 +42,36 @@ public:
 
     void FlushCounters();
 
+    /** Recover modifications the server hasn't acknowledged from the player's log, and log new ones from now on */
+    void ConfigureSession(int32 newPlayerId);
+
     void SetRequestManager(TSharedPtr<JsonRequestManager> newRequestManager);
     void SetCounterUrl(const FString& newCounterUrl);
 
+    /** Hand pending modifications to the aggregator when it flushes, instead of sending them on our own schedule */
+    void SetAggregator(TSharedPtr<FDriftCounterAggregator> newAggregator, int32 newPlayerId);
+
     FDriftPlayerStatsLoadedDelegate& OnPlayerStatsLoaded() { return onPlayerStatsLoaded; }
 
 private:
-    void UpdateCachedCounter(const FCounterModification& update);
+    void AddModification(FCounterModification modification);
+    TArray<FCounterModification> TakePendingCounters();
+
+    void SendNextBatch();
+    void HandleBatchFailure(const FString& idempotencyKey, const ResponseContext& context);
+    void RemoveBatch(const FString& idempotencyKey);
+
+    void ReplayLog();
+    void AppendToLog(const FCounterLogRecord& record);
+    void WriteLog();
+    void RewriteLog();
+
+    void UpdateCachedCounter(int32 counterId, const FCounterModification& update);
+
+    /** Return a stable, dense ID for the counter name, adding it if it hasn't been seen before */
+    int32 InternCounterName(const FString& canonicalName);
+
+    static int32 MakePendingKey(int32 counterId, bool absolute) { return counterId * 2 + (absolute ? 1 : 0); }
 
     FDriftPlayerStatsLoadedDelegate onPlayerStatsLoaded;
 
@@ -51,8 +79,50 @@ private:
     TWeakPtr<JsonRequestManager> requestManager;
     FString counterUrl;
 
-    TArray<FCounterModification> pendingCounters;
+    TWeakPtr<FDriftCounterAggregator> aggregator;
+    int32 playerId = 0;
+
+    struct FPendingCounter
+    {
+        FCounterModification modification;
+        bool removed = false;
+    };
+
+    /**
+     * Pending modifications in the order they were made, and an index into them keyed by
+     * counter ID and type. Superseded modifications are only flagged as removed, so that
+     * the ones left keep their relative order until the next flush.
+     */
+    TArray<FPendingCounter> pendingCounters;
+    TMap<int32, int32> pendingCounterIndices;
     float flushCountersInSeconds = FLT_MAX;
 
+    struct FCounterBatch
+    {
+        FString idempotencyKey;
+        TArray<FCounterModification> counters;
+    };
+
+    /**
+     * Flushed modifications the server hasn't acknowledged yet, oldest first.
+     * They're sent one at a time, so that they're applied in the order they were made.
+     */
+    TArray<FCounterBatch> unacknowledgedBatches;
+    bool batchInFlight = false;
+
+    /**
+     * Write-ahead log of modifications and unacknowledged batches, one JSON record per line.
+     * Modifications are appended in bursts shortly after they're made, and on every flush,
+     * and the log is rewritten when batches are created or acknowledged.
+     */
+    FString logFilePath;
+    /** Log lines for modifications made since the log was last written */
+    FString unwrittenLog;
+    float writeLogInSeconds = 0.0f;
+
+    /** Counter names are interned once, the ID is the index into playerCounters */
+    TMap<FString, int32> counterIds;
     TArray<FDriftPlayerCounter> playerCounters;
+    /** Which entries in playerCounters hold a known total */
+    TBitArray<> cachedCounters;
 };
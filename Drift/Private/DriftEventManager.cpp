@@ -2,6 +2,7 @@
 
 #include "DriftEventManager.h"
 
+#include "DriftPayloadCompression.h"
 #include "DriftSchemas.h"
 #include "JsonArchive.h"
 
@@ -17,7 +18,6 @@ DECLARE_CYCLE_STAT(TEXT("UploadDriftEvents"), STAT_UploadDriftEvents, STATGROUP_
 
 static constexpr float FLUSH_EVENTS_INTERVAL = 10.0f;
 static constexpr int32 MAX_PENDING_EVENTS = 20;
-static constexpr int32 MIN_SIZE_PAYLOAD_TO_COMPRESS = 200;
 
 FDriftEventManager::FDriftEventManager()
 {
@@ -206,38 +206,14 @@ void FDriftEventManager::ProcessEvents(const TArray<TUniquePtr<IDriftEvent>>& Ev
 
     JsonArchive::SaveObject(Events, Payload);
 
-    Compressed.Empty();
-    bUseCompressed = false;
-    const FTCHARToUTF8 Converter(*Payload);
-    const auto UncompressedSize{ Converter.Length() };
-    if (UncompressedSize >= MIN_SIZE_PAYLOAD_TO_COMPRESS)
+    bUseCompressed = DriftPayloadCompression::Compress(Payload, Compressed);
+    if (bUseCompressed)
     {
-        UE_LOG(LogDriftEvent, Verbose, TEXT("Attempting to compress payload"));
-
-        auto CompressedSize = FCompression::CompressMemoryBound(NAME_Gzip, UncompressedSize);
-        Compressed.SetNumUninitialized(CompressedSize);
-
-        const auto Uncompressed = reinterpret_cast<const uint8*>(Converter.Get());
-
-        const auto CompressionResult = FCompression::CompressMemory(NAME_Gzip, Compressed.GetData(), CompressedSize, Uncompressed, UncompressedSize);
-        if (CompressionResult)
-        {
-            if (CompressedSize < UncompressedSize)
-            {
-                UE_LOG(LogDriftEvent, Verbose, TEXT("Payload compression size is smaller than uncompressed size. Using compressed payload."));
-
-                Compressed.SetNum(CompressedSize);
-                bUseCompressed = true;
-            }
-            else
-            {
-                UE_LOG(LogDriftEvent, Verbose, TEXT("Compression didn't reduce the size of the payload. Using uncompressed payload."));
-            }
-        }
-        else
-        {
-            UE_LOG(LogDriftEvent, Verbose, TEXT("Payload compression failed. Using uncompressed payload."));
-        }
+        UE_LOG(LogDriftEvent, Verbose, TEXT("Using compressed payload, %d bytes down from %d characters."), Compressed.Num(), Payload.Len());
+    }
+    else
+    {
+        UE_LOG(LogDriftEvent, Verbose, TEXT("Payload is too small or didn't compress. Using uncompressed payload."));
     }
 
     const auto EndTime = FPlatformTime::Seconds();
@@ -249,16 +225,6 @@ void FDriftEventManager::ProcessRequest(const TSharedPtr<JsonRequestManager> Req
 {
     const auto Request = RequestManager->CreateRequest(HttpMethods::XPOST, URL, HttpStatusCodes::Created);
 
-    if (bUseCompressed)
-    {
-        Request->SetContent(Compressed);
-        Request->SetHeader(TEXT("Content-Encoding"), TEXT("gzip"));
-    }
-    else
-    {
-        Request->SetPayload(Payload);
-    }
-
-    Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+    DriftPayloadCompression::SetContent(*Request, Payload, Compressed, bUseCompressed);
     Request->Dispatch();
 }
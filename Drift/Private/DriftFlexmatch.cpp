@@ -3,7 +3,8 @@
 #include "DriftFlexmatch.h"
 
 #include "DriftBase.h"
-#include "Icmp.h"
+
+#include "Algo/AnyOf.h"
 
 
 DEFINE_LOG_CATEGORY(LogDriftMatchmaking);
@@ -38,6 +39,21 @@ void FDriftFlexmatch::SetRequestManager(TSharedPtr<JsonRequestManager> RootReque
 	RequestManager = RootRequestManager;
 }
 
+void FDriftFlexmatch::SetLatencyProbeSettings(const FDriftLatencyProbeSettings& Settings)
+{
+	LatencyProber->SetSettings(Settings);
+}
+
+void FDriftFlexmatch::SetLatencyReportSettings(const FDriftLatencyReportSettings& Settings)
+{
+	LatencyReporter.SetSettings(Settings);
+}
+
+void FDriftFlexmatch::SetRegionScoringSettings(const FDriftRegionScoringSettings& Settings)
+{
+	RegionScoringSettings = Settings;
+}
+
 void FDriftFlexmatch::ConfigureSession(const FDriftEndpointsResponse& DriftEndpoints, int32 InPlayerId)
 {
 	FlexmatchLatencyURL = DriftEndpoints.my_flexmatch;
@@ -46,11 +62,17 @@ void FDriftFlexmatch::ConfigureSession(const FDriftEndpointsResponse& DriftEndpo
 	CurrentTicketUrl = DriftEndpoints.my_flexmatch_ticket;
 	PlayerId = InPlayerId;
 
+	// The backend knows nothing about this session yet
+	LatencyReporter.ResetReported();
+	bSeedReported = false;
+
 	InitializeLocalState();
 }
 
 void FDriftFlexmatch::Tick( float DeltaTime )
 {
+	LatencyProber->Tick(FPlatformTime::Seconds());
+
 	if ( PingRegions.Num() && bDoPings )
 	{
 		TimeToPing -= DeltaTime;
@@ -74,139 +96,57 @@ TStatId FDriftFlexmatch::GetStatId() const
 
 void FDriftFlexmatch::MeasureLatencies()
 {
+	// Once all regions have been probed, PATCH drift-flexmatch. The cycle may complete right away
 	bIsPinging = true;
-	// Accumulate a mapping of regions->ping and once all results are in, PATCH drift-flexmatch
-	auto LatenciesByRegion{ MakeShared<TMap<FString, int>>() };
-	for (auto Region: PingRegions)
+	const auto bStarted = LatencyProber->StartCycle(FDriftLatencyProber::FCycleCompleted::CreateLambda([WeakSelf = TWeakPtr<FDriftFlexmatch>(AsShared())](const TMap<FString, int32>& LatenciesByRegion)
 	{
-		static float PingTimeout = 2.0f;
-		const auto RegionHostname = FString::Format(*PingHostnameTemplate, {Region});
-		FIcmp::IcmpEcho(RegionHostname, PingTimeout, FIcmpEchoResultDelegate::CreateLambda([WeakSelf = TWeakPtr<FDriftFlexmatch>(this->AsShared()), Region, LatenciesByRegion, RegionHostname](const FIcmpEchoResult Result)
+		if (const auto Self = WeakSelf.Pin())
 		{
-		    const auto Self = WeakSelf.Pin();
-
-			// Default to -1 if we fail to ping, success case will override this
-			LatenciesByRegion->Add(Region, -1);
-
-			switch (Result.Status)
+			Self->bIsPinging = false;
+			if (Self->PingInterval < Self->MaxPingInterval)
 			{
-				case EIcmpResponseStatus::Success:
-				{
-					const auto ResponseTime = static_cast<int>(Result.Time * 1000);
-
-					UE_LOG(LogDriftMatchmaking, Verbose, TEXT("FDriftFlexmatch::MeasureLatencies - Success - Hostname: '%s', Host address: '%s', Reply address: '%s', Time: '%d' ms"), *RegionHostname, *Result.ResolvedAddress, *Result.ReplyFrom, ResponseTime);
-
-					LatenciesByRegion->Add(Region, ResponseTime);
-					break;
-				}
-
-				case EIcmpResponseStatus::Timeout:
-				{
-					UE_LOG(LogDriftMatchmaking, Error, TEXT("FDriftFlexmatch::MeasureLatencies - Timeout - Ping timeout after '%.2f' seconds for host '%s'"), PingTimeout, *RegionHostname);
-					break;
-				}
-
-				case EIcmpResponseStatus::Unreachable:
-				{
-					UE_LOG(LogDriftMatchmaking, Error, TEXT("FDriftFlexmatch::MeasureLatencies - Unreachable - Host '%s' is unreachable"), *RegionHostname);
-					break;
-				}
-
-				case EIcmpResponseStatus::Unresolvable:
-				{
-					UE_LOG(LogDriftMatchmaking, Error, TEXT("FDriftFlexmatch::MeasureLatencies - Unresolvable - Failed to resolve the target address '%s' to a valid IP address"), *RegionHostname);
-					break;
-				}
-
-				case EIcmpResponseStatus::InternalError:
-				{
-					UE_LOG(LogDriftMatchmaking, Error, TEXT("FDriftFlexmatch::MeasureLatencies - InternalError - An internal error occurred while attempting to ping the host '%s'"), *RegionHostname);
-					break;
-				}
-
-				case EIcmpResponseStatus::NotImplemented:
-				{
-					UE_LOG(LogDriftMatchmaking, Warning, TEXT("FDriftFlexmatch::MeasureLatencies - NotImplemented - ICMP pinging isn't implemented on this platform. Using HTTP as a fallback"));
-
-				    if (Self)
-				    {
-				        const auto HttpModule = &FHttpModule::Get();
-                        const auto Request = HttpModule->CreateRequest();
-                        Request->SetVerb("GET");
-                        Request->SetURL(FString::Format(*Self->PingUrlTemplate, {Region}));
-                        Request->OnProcessRequestComplete().BindLambda(
-                        [WeakSelf, Region, LatenciesByRegion](FHttpRequestPtr RequestPtr, FHttpResponsePtr Response, bool bConnectedSuccessfully)
-                        {
-                            if (const auto InnerSelf = WeakSelf.Pin())
-                            {
-                                if (!bConnectedSuccessfully)
-                                {
-                                    UE_LOG(LogDriftMatchmaking, Error, TEXT("FDriftFlexmatch::MeasureLatencies - Failed to connect to '%s'"), *RequestPtr->GetURL());
-                                    LatenciesByRegion->Add(Region, -1);
-                                }
-                                else
-                                {
-                                    LatenciesByRegion->Add(Region, static_cast<int>(RequestPtr->GetElapsedTime() * 1000));
-                                }
-
-                                // If all regions have been added to the map, report back to drift
-                                if (LatenciesByRegion->Num() == InnerSelf->PingRegions.Num())
-                                {
-                                    InnerSelf->bIsPinging = false;
-                                    if (InnerSelf->PingInterval < InnerSelf->MaxPingInterval)
-                                    {
-                                        InnerSelf->PingInterval += 0.5;
-                                    }
-                                    InnerSelf->ReportLatencies(LatenciesByRegion);
-                                }
-                            }
-                        });
-                        Request->ProcessRequest();
-				    }
-
-				    // Return here instead of break since we want the request complete handler to handle reporting the latencies when ICMP is not implemented
-					return;
-				}
+				Self->PingInterval += 0.5;
 			}
+			Self->ReportLatencies(MakeShared<TMap<FString, int>>(LatenciesByRegion));
+		}
+	}));
 
-		    if (Self)
-		    {
-                // If all regions have been added to the map, report back to drift
-                if (LatenciesByRegion->Num() == Self->PingRegions.Num())
-                {
-                    Self->bIsPinging = false;
-                    if (Self->PingInterval < Self->MaxPingInterval)
-                    {
-                        Self->PingInterval += 0.5;
-                    }
-                    Self->ReportLatencies(LatenciesByRegion);
-                }
-            }
-		}));
+	if (!bStarted)
+	{
+		bIsPinging = false;
 	}
 }
 
-void FDriftFlexmatch::ReportLatencies(const TSharedRef<TMap<FString, int>> LatenciesByRegion)
+void FDriftFlexmatch::ReportLatencies(const TSharedRef<TMap<FString, int>> LatenciesByRegion, bool bMeasured)
 {
 	// If we've lost connection, bail
 	if ( ! RequestManager )
 	{
 		return;
 	}
-	JsonValue LatenciesPayload{rapidjson::kObjectType};
-	for (auto entry: *LatenciesByRegion)
+	const auto bAnyValid = Algo::AnyOf(*LatenciesByRegion, [](const TPair<FString, int>& Entry)
 	{
-		if ( entry.Value == -1 ) // failed ping, skip it from the map
-		{
-			continue;
-		}
-		JsonArchive::AddMember(LatenciesPayload, entry.Key, entry.Value);
-	}
-	if (LatenciesPayload.MemberCount() == 0)
+		return Entry.Value != -1; // failed ping
+	});
+	if (!bAnyValid)
 	{
 		UE_LOG(LogDriftMatchmaking, Error, TEXT("FDriftFlexmatch::ReportLatencies - No valid values to report!"));
 		return;
 	}
+
+	// Only the regions that moved enough, or haven't been reported in a while
+	const auto ToReport = LatencyReporter.Update(*LatenciesByRegion, FDateTime::UtcNow(), bMeasured);
+	if (ToReport.Num() == 0)
+	{
+		UE_LOG(LogDriftMatchmaking, Verbose, TEXT("FDriftFlexmatch::ReportLatencies - Latencies haven't changed enough to report"));
+		return;
+	}
+
+	JsonValue LatenciesPayload{rapidjson::kObjectType};
+	for (const auto& entry: ToReport)
+	{
+		JsonArchive::AddMember(LatenciesPayload, entry.Key, entry.Value);
+	}
 	JsonValue PatchPayload{rapidjson::kObjectType};
 	JsonArchive::AddMember(PatchPayload, TEXT("latencies"), LatenciesPayload);
 	const auto PatchRequest = RequestManager->Patch(FlexmatchLatencyURL, PatchPayload, HttpStatusCodes::Ok);
@@ -215,31 +155,67 @@ void FDriftFlexmatch::ReportLatencies(const TSharedRef<TMap<FString, int>> Laten
 		UE_LOG(LogDriftMatchmaking, Error, TEXT("FDriftFlexmatch::ReportLatencies - Failed to report latencies to %s"
 			", Response code %d, error: '%s'"), *FlexmatchLatencyURL, Context.responseCode, *Context.error);
 	});
-	PatchRequest->OnResponse.BindLambda([WeakThis = TWeakPtr<FDriftFlexmatch>(AsShared())](const ResponseContext& Context, const JsonDocument& Doc)
+	PatchRequest->OnResponse.BindLambda([WeakThis = TWeakPtr<FDriftFlexmatch>(AsShared()), ToReport](const ResponseContext& Context, const JsonDocument& Doc)
 	{
+		const auto Pinned = WeakThis.Pin();
+		if (!Pinned)
+		{
+			return;
+		}
+
 		FDriftFlexmatchLatencySchema LatencyAverages;
 		if (!JsonArchive::LoadObject(Doc, LatencyAverages))
 		{
 			UE_LOG(LogDriftMatchmaking, Error, TEXT("FDriftFlexmatch::ReportLatencies - Error parsing reponse from PATCHing latencies"
 				", Response code %d, error: '%s'"), Context.responseCode, *Context.error);
+			Pinned->LatencyReporter.ReportSucceeded(ToReport, {}, FDateTime::UtcNow());
 			return;
 		}
-        if (auto Pinned = WeakThis.Pin())
-        {
-            for (auto Entry : LatencyAverages.latencies.GetObject())
-            {
-                Pinned->AverageLatencyMap.Add(Entry.Key, Entry.Value.GetInt32());
-            }
-        }
-		
+
+		FLatencyMap Averages;
+		for (auto Entry : LatencyAverages.latencies.GetObject())
+		{
+			Averages.Add(Entry.Key, Entry.Value.GetInt32());
+		}
+		Pinned->AverageLatencyMap.Append(Averages);
+		// The backend matches on its averages, so those are what the next estimates are compared with
+		Pinned->LatencyReporter.ReportSucceeded(ToReport, Averages, FDateTime::UtcNow());
 	});
 	PatchRequest->Dispatch();
 }
 
 
+void FDriftFlexmatch::ReportSeededLatencies()
+{
+	if (bSeedReported || !bDoPings || PingRegions.Num() == 0)
+	{
+		return;
+	}
+	bSeedReported = true;
+
+	// Start matchmaking off with what was measured in earlier sessions, until there are new measurements
+	const auto Seed = LatencyReporter.GetSeed(FDateTime::UtcNow());
+	const auto SeededLatencies = MakeShared<TMap<FString, int>>();
+	for (const auto& Region : PingRegions)
+	{
+		if (const auto Latency = Seed.Find(Region))
+		{
+			LatencyProber->SeedEstimate(Region, *Latency);
+			SeededLatencies->Add(Region, *Latency);
+		}
+	}
+
+	if (SeededLatencies->Num() > 0)
+	{
+		UE_LOG(LogDriftMatchmaking, Log, TEXT("FDriftFlexmatch::ReportSeededLatencies - Reporting saved latencies for '%d' regions"), SeededLatencies->Num());
+		ReportLatencies(SeededLatencies, false);
+	}
+}
+
 void FDriftFlexmatch::StartLatencyReporting()
 {
 	bDoPings = true;
+	ReportSeededLatencies();
 }
 
 void FDriftFlexmatch::StopLatencyReporting()
@@ -260,11 +236,41 @@ void FDriftFlexmatch::StartMatchmaking(const FString& MatchmakingConfiguration,
 		OnDriftMatchmakingFailed().Broadcast(TEXT("No Connection"));
 		return;
 	}
+
+	// Fail early rather than have the ticket time out on the server. Without any measurements, it's up to the server.
+	const auto Measurements = GetRegionMeasurements();
+	const auto RankedRegions = FDriftRegionScoring::Rank(Measurements, RegionScoringSettings);
+	if (Measurements.Num() > 0 && RankedRegions.Num() == 0)
+	{
+		UE_LOG(LogDriftMatchmaking, Error, TEXT("FDriftFlexmatch::StartMatchmaking - None of the '%d' regions are reachable within the latency ceiling of '%.0f' ms"),
+			Measurements.Num(), RegionScoringSettings.LatencyCeilingMs);
+		OnDriftMatchmakingFailed().Broadcast(TEXT("No Region Within Latency Ceiling"));
+		return;
+	}
+
+	// Copy the fields rather than the object, which belongs to the caller
+	JsonValue Extras{rapidjson::kObjectType};
+	for (const auto& Field : ExtraData.GetObject())
+	{
+		Extras.SetField(Field.Key, Field.Value);
+	}
+	if (RankedRegions.Num() > 0)
+	{
+		JsonValue RankedRegionNames{rapidjson::kArrayType};
+		for (const auto& RegionScore : RankedRegions)
+		{
+			JsonValue RegionName;
+			RegionName.SetString(RegionScore.Region);
+			RankedRegionNames.PushBack(RegionName);
+		}
+		Extras.SetField(TEXT("ranked_regions"), RankedRegionNames);
+	}
+
 	JsonValue Payload{rapidjson::kObjectType};
 	JsonArchive::AddMember(Payload, TEXT("matchmaker"), *MatchmakingConfiguration);
-	if (ExtraData.MemberCount())
+	if (Extras.MemberCount())
 	{
-		JsonArchive::AddMember(Payload, TEXT("extras"), ExtraData);
+		JsonArchive::AddMember(Payload, TEXT("extras"), Extras);
 	}
 	const auto Request = RequestManager->Post(FlexmatchTicketsURL, Payload, HttpStatusCodes::Created);
 	Request->OnError.BindLambda([this, MatchmakingConfiguration](ResponseContext& Context)
@@ -295,6 +301,20 @@ void FDriftFlexmatch::StartMatchmaking(const FString& MatchmakingConfiguration,
 	Status = EMatchmakingTicketStatus::None;
 }
 
+TArray<FDriftRegionMeasurement> FDriftFlexmatch::GetRegionMeasurements() const
+{
+	TArray<FDriftRegionMeasurement> Measurements;
+	for (const auto& Region : PingRegions)
+	{
+		// Prefer our own measurements, but the averages the server has will do
+		if (const auto Measurement = FDriftRegionScoring::Measure(Region, LatencyProber->GetEstimate(Region), AverageLatencyMap.Find(Region)))
+		{
+			Measurements.Add(Measurement.GetValue());
+		}
+	}
+	return Measurements;
+}
+
 void FDriftFlexmatch::StopMatchmaking()
 {
 	if (! RequestManager.IsValid() )
@@ -654,6 +674,8 @@ void FDriftFlexmatch::InitializeLocalState()
 			}
 
 			PingRegions = MoveTemp(RegionsResponse.regions);
+			LatencyProber->SetRegions(PingRegions);
+			ReportSeededLatencies();
 
 			const auto RegionsString = FString::Join(PingRegions, TEXT(","));
 			UE_LOG(LogDriftMatchmaking, Log, TEXT("FDriftFlexmatch::InitializeLocalState - Regions: '%s'"), *RegionsString);
@@ -4,6 +4,9 @@
 
 #include "IDriftMatchmaker.h"
 #include "DriftMessageQueue.h"
+#include "DriftLatencyProber.h"
+#include "DriftLatencyReporter.h"
+#include "DriftRegionScoring.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogDriftMatchmaking, Log, All);
 
@@ -28,6 +31,9 @@ public:
 
 	void SetRequestManager(TSharedPtr<JsonRequestManager> RootRequestManager);
 	void ConfigureSession(const FDriftEndpointsResponse& DriftEndpoints, int32 InPlayerId);
+	void SetLatencyProbeSettings(const FDriftLatencyProbeSettings& Settings);
+	void SetLatencyReportSettings(const FDriftLatencyReportSettings& Settings);
+	void SetRegionScoringSettings(const FDriftRegionScoringSettings& Settings);
 
 	// FTickableGameObject overrides
 	void Tick(float DeltaTime) override;
@@ -63,7 +69,10 @@ public:
 private:
 	void HandleMatchmakingEvent(const FMessageQueueEntry& Message);
 	void MeasureLatencies();
-	void ReportLatencies(const TSharedRef<TMap<FString, int>> LatenciesByRegion);
+	/* bMeasured is false for latencies from earlier sessions, which shouldn't be saved again as new */
+	void ReportLatencies(const TSharedRef<TMap<FString, int>> LatenciesByRegion, bool bMeasured = true);
+	void ReportSeededLatencies();
+	TArray<FDriftRegionMeasurement> GetRegionMeasurements() const;
 	void SetStatusFromString(const FString& StatusString);
 	FString GetStatusString() const;
 	void InitializeLocalState();
@@ -92,9 +101,11 @@ private:
 	const float MaxPingInterval = 15.0;
 	float TimeToPing = 0.0;
 	FLatencyMap AverageLatencyMap;
-    const FString PingUrlTemplate = TEXT("https://gamelift.{0}.amazonaws.com");
-	const FString PingHostnameTemplate = TEXT("gamelift.{0}.amazonaws.com");
 	TArray<FString> PingRegions;
+	TSharedRef<FDriftLatencyProber> LatencyProber = MakeShared<FDriftLatencyProber>();
+	FDriftLatencyReporter LatencyReporter;
+	bool bSeedReported = false;
+	FDriftRegionScoringSettings RegionScoringSettings;
 
 	// Current state
 	bool bIsInitialized = false;
@@ -0,0 +1,293 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftHeartbeatMultiplexer.h"
+
+#include "DriftHeartbeatScheduler.h"
+#include "JsonRequestManager.h"
+#include "JsonUtils.h"
+
+
+DEFINE_LOG_CATEGORY(LogDriftHeartbeat);
+
+
+/** Larger batches are split, to keep the request size reasonable */
+static const int32 MAX_HEARTBEATS_PER_BATCH = 1000;
+
+
+bool FDriftHeartbeatBatchEntry::Serialize(SerializationContext& context)
+{
+    return SERIALIZE_PROPERTY(context, heartbeat_url)
+        && SERIALIZE_PROPERTY(context, authorization);
+}
+
+
+bool FDriftHeartbeatBatchPayload::Serialize(SerializationContext& context)
+{
+    return SERIALIZE_PROPERTY(context, heartbeats);
+}
+
+
+bool FDriftHeartbeatBatchResponseEntry::Serialize(SerializationContext& context)
+{
+    return SERIALIZE_PROPERTY(context, status_code)
+        && SERIALIZE_OPTIONAL_PROPERTY(context, next_heartbeat_seconds)
+        && SERIALIZE_OPTIONAL_PROPERTY(context, heartbeat_timeout_seconds)
+        && SERIALIZE_OPTIONAL_PROPERTY(context, error_code)
+        && SERIALIZE_OPTIONAL_PROPERTY(context, error_description);
+}
+
+
+bool FDriftHeartbeatBatchResponse::Serialize(SerializationContext& context)
+{
+    return SERIALIZE_PROPERTY(context, heartbeats);
+}
+
+
+FDriftHeartbeatMultiplexer::FDriftHeartbeatMultiplexer()
+: batchSender{ &FDriftHeartbeatMultiplexer::SendBatchRequest }
+{
+}
+
+
+void FDriftHeartbeatMultiplexer::Tick(float DeltaTime)
+{
+    SendDueHeartbeats(FPlatformTime::Seconds());
+}
+
+
+TStatId FDriftHeartbeatMultiplexer::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(FDriftHeartbeatMultiplexer, STATGROUP_Tickables);
+}
+
+
+int32 FDriftHeartbeatMultiplexer::Register(FDriftHeartbeatParticipant participant)
+{
+    check(participant.scheduler);
+
+    const auto handle = nextHandle++;
+    participants.Add(handle, MoveTemp(participant));
+    return handle;
+}
+
+
+void FDriftHeartbeatMultiplexer::Unregister(int32 handle)
+{
+    participants.Remove(handle);
+}
+
+
+void FDriftHeartbeatMultiplexer::SetRequestManager(int32 handle, TWeakPtr<JsonRequestManager> requestManager)
+{
+    if (auto participant = participants.Find(handle))
+    {
+        participant->requestManager = requestManager;
+    }
+}
+
+
+void FDriftHeartbeatMultiplexer::SetBatchSender(FDriftHeartbeatBatchSender newBatchSender)
+{
+    batchSender = MoveTemp(newBatchSender);
+}
+
+
+void FDriftHeartbeatMultiplexer::SendDueHeartbeats(double now)
+{
+    // Only batch URLs where someone is actually due get a request
+    TSet<FString> dueBatchUrls;
+    for (const auto& pair : participants)
+    {
+        if (pair.Value.scheduler->IsHeartbeatDue(now))
+        {
+            dueBatchUrls.Add(pair.Value.batchUrl);
+        }
+    }
+    if (dueBatchUrls.Num() == 0)
+    {
+        return;
+    }
+
+    // Bring along everyone who'd be due within their next interval anyway, so that they all end up on the same cadence
+    TMap<FString, TArray<int32>> batches;
+    for (const auto& pair : participants)
+    {
+        const auto& participant = pair.Value;
+        if (!dueBatchUrls.Contains(participant.batchUrl))
+        {
+            continue;
+        }
+        const auto* scheduler = participant.scheduler;
+        if (scheduler->IsHeartbeatDue(now + scheduler->GetInterval()))
+        {
+            batches.FindOrAdd(participant.batchUrl).Add(pair.Key);
+        }
+    }
+
+    for (auto& batch : batches)
+    {
+        auto& handles = batch.Value;
+        for (int32 start = 0; start < handles.Num(); start += MAX_HEARTBEATS_PER_BATCH)
+        {
+            const auto count = FMath::Min(MAX_HEARTBEATS_PER_BATCH, handles.Num() - start);
+            SendBatch(batch.Key, TArray<int32>{ handles.GetData() + start, count });
+        }
+    }
+}
+
+
+void FDriftHeartbeatMultiplexer::SendBatch(const FString& batchUrl, TArray<int32>&& handles)
+{
+    FDriftHeartbeatBatchPayload payload;
+    payload.heartbeats.Reserve(handles.Num());
+
+    TSharedPtr<JsonRequestManager> batchRequestManager;
+    for (const auto handle : handles)
+    {
+        auto& participant = participants[handle];
+        participant.scheduler->HeartbeatSent();
+
+        FDriftHeartbeatBatchEntry entry;
+        entry.heartbeat_url = participant.heartbeatUrl;
+        if (const auto rm = participant.requestManager.Pin())
+        {
+            // The header the request manager would use for the instance's own heartbeat
+            entry.authorization = rm->GetDefaultHeaders().FindRef(TEXT("Authorization"));
+        }
+        if (!batchRequestManager.IsValid())
+        {
+            batchRequestManager = participant.batchRequestManager.Pin();
+        }
+        payload.heartbeats.Add(MoveTemp(entry));
+    }
+
+    UE_LOG(LogDriftHeartbeat, Verbose, TEXT("Sending %d heartbeats to '%s'"), handles.Num(), *batchUrl);
+
+    TWeakPtr<FDriftHeartbeatMultiplexer> weakSelf = AsShared();
+    batchSender(batchUrl, batchRequestManager, payload, [weakSelf, handles](TArray<FDriftHeartbeatResult>&& results)
+    {
+        if (const auto self = weakSelf.Pin())
+        {
+            self->HandleBatchResults(handles, MoveTemp(results));
+        }
+    });
+}
+
+
+void FDriftHeartbeatMultiplexer::HandleBatchResults(const TArray<int32>& handles, TArray<FDriftHeartbeatResult>&& results)
+{
+    check(handles.Num() == results.Num());
+
+    for (int32 index = 0; index < handles.Num(); ++index)
+    {
+        // Instances may have gone away while the batch was in flight
+        if (const auto participant = participants.Find(handles[index]))
+        {
+            // Copy, the delegate may unregister the participant
+            const auto onResult = participant->onResult;
+            onResult.ExecuteIfBound(results[index]);
+        }
+    }
+}
+
+
+void FDriftHeartbeatMultiplexer::SendBatchRequest(const FString& batchUrl, const TSharedPtr<JsonRequestManager>& requestManager,
+    const FDriftHeartbeatBatchPayload& payload, TFunction<void(TArray<FDriftHeartbeatResult>&&)> onComplete)
+{
+    const auto count = payload.heartbeats.Num();
+    const auto makeResults = [count](EDriftHeartbeatStatus status, const FString& error)
+    {
+        TArray<FDriftHeartbeatResult> results;
+        results.Init(FDriftHeartbeatResult{ status, -1.0f, 0, 0, error }, count);
+        return results;
+    };
+
+    if (!requestManager.IsValid())
+    {
+        onComplete(makeResults(EDriftHeartbeatStatus::Failed, TEXT("No request manager")));
+        return;
+    }
+
+    auto request = requestManager->Post(batchUrl, payload, HttpStatusCodes::Ok);
+    request->OnResponse.BindLambda([count, onComplete, makeResults](ResponseContext& context, JsonDocument& doc)
+    {
+        FDriftHeartbeatBatchResponse response;
+        if (!JsonUtils::ParseResponse(context.response, response) || response.heartbeats.Num() != count)
+        {
+            UE_LOG(LogDriftHeartbeat, Warning, TEXT("Unexpected response to a batch of %d heartbeats"), count);
+            onComplete(makeResults(EDriftHeartbeatStatus::Failed, TEXT("Malformed batch response")));
+            return;
+        }
+
+        const auto roundTripSeconds = static_cast<float>(context.request->GetElapsedTime());
+        TArray<FDriftHeartbeatResult> results;
+        results.Reserve(count);
+        for (const auto& entry : response.heartbeats)
+        {
+            auto& result = results.AddDefaulted_GetRef();
+            result.roundTripSeconds = roundTripSeconds;
+            result.nextHeartbeatSeconds = entry.next_heartbeat_seconds;
+            result.timeoutSeconds = entry.heartbeat_timeout_seconds;
+            result.error = entry.error_description;
+
+            if (entry.status_code >= static_cast<int32>(HttpStatusCodes::Ok) && entry.status_code < 300)
+            {
+                result.status = EDriftHeartbeatStatus::Succeeded;
+            }
+            else if (entry.status_code == static_cast<int32>(HttpStatusCodes::NotFound) && entry.error_code == TEXT("user_error"))
+            {
+                result.status = EDriftHeartbeatStatus::Expired;
+            }
+            else if (IsClientError(entry.status_code))
+            {
+                result.status = EDriftHeartbeatStatus::Rejected;
+            }
+            else
+            {
+                result.status = EDriftHeartbeatStatus::Failed;
+            }
+        }
+        onComplete(MoveTemp(results));
+    });
+    request->OnError.BindLambda([count, onComplete, makeResults](ResponseContext& context)
+    {
+        context.errorHandled = true;
+
+        const auto status = GetBatchFailureStatus(context.successful, context.responseCode);
+        if (status == EDriftHeartbeatStatus::Unsupported)
+        {
+            UE_LOG(LogDriftHeartbeat, Warning, TEXT("Batched heartbeats refused with status %d, falling back to individual heartbeats"),
+                context.responseCode);
+        }
+        else
+        {
+            UE_LOG(LogDriftHeartbeat, Warning, TEXT("Batch of %d heartbeats failed with status %d: %s"), count, context.responseCode, *context.error);
+        }
+        onComplete(makeResults(status, context.error));
+    });
+    request->Dispatch();
+}
+
+
+EDriftHeartbeatStatus FDriftHeartbeatMultiplexer::GetBatchFailureStatus(bool responded, int32 responseCode)
+{
+    if (!responded)
+    {
+        // Says nothing about any one instance, each retries within its own timeout
+        return EDriftHeartbeatStatus::Failed;
+    }
+
+    switch (static_cast<HttpStatusCodes>(responseCode))
+    {
+    // There's no batch route
+    case HttpStatusCodes::NotFound:
+    case HttpStatusCodes::NotAllowed:
+    // Or the backend won't take it from us, in which case each instance's own heartbeat tells it whether its session is still good
+    case HttpStatusCodes::Unauthorized:
+    case HttpStatusCodes::Forbidden:
+        return EDriftHeartbeatStatus::Unsupported;
+
+    default:
+        return EDriftHeartbeatStatus::Failed;
+    }
+}
@@ -0,0 +1,168 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#pragma once
+
+#include "JsonArchive.h"
+
+#include "Tickable.h"
+
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDriftHeartbeat, Log, All);
+
+
+class FDriftHeartbeatScheduler;
+class JsonRequestManager;
+
+
+/**
+ * One instance's heartbeat within a batch
+ */
+struct FDriftHeartbeatBatchEntry
+{
+    FString heartbeat_url;
+    /** The instance's own Authorization header, so the backend can check each session separately */
+    FString authorization;
+
+    bool Serialize(SerializationContext& context);
+};
+
+
+/**
+ * Payload for POST endpoints.heartbeats
+ */
+struct FDriftHeartbeatBatchPayload
+{
+    TArray<FDriftHeartbeatBatchEntry> heartbeats;
+
+    bool Serialize(SerializationContext& context);
+};
+
+
+/**
+ * Result for one entry of the batch, in the same order as the payload
+ */
+struct FDriftHeartbeatBatchResponseEntry
+{
+    int32 status_code = 0;
+    int32 next_heartbeat_seconds = 0;
+    int32 heartbeat_timeout_seconds = 0;
+    FString error_code;
+    FString error_description;
+
+    bool Serialize(SerializationContext& context);
+};
+
+
+struct FDriftHeartbeatBatchResponse
+{
+    TArray<FDriftHeartbeatBatchResponseEntry> heartbeats;
+
+    bool Serialize(SerializationContext& context);
+};
+
+
+enum class EDriftHeartbeatStatus : uint8
+{
+    Succeeded,
+    /** The session timed out on the server */
+    Expired,
+    /** The server refused the heartbeat for some other reason */
+    Rejected,
+    /** The heartbeat didn't get through, but might if retried */
+    Failed,
+    /** The backend has no batch route, the instance must heartbeat on its own */
+    Unsupported,
+};
+
+
+struct FDriftHeartbeatResult
+{
+    EDriftHeartbeatStatus status = EDriftHeartbeatStatus::Failed;
+    float roundTripSeconds = -1.0f;
+    int32 nextHeartbeatSeconds = 0;
+    int32 timeoutSeconds = 0;
+    FString error;
+};
+
+
+DECLARE_DELEGATE_OneParam(FDriftHeartbeatResultDelegate, const FDriftHeartbeatResult&);
+
+
+/**
+ * A Drift instance taking part in batched heartbeats
+ */
+struct FDriftHeartbeatParticipant
+{
+    /** Owned by the instance, which must unregister before destroying it */
+    FDriftHeartbeatScheduler* scheduler = nullptr;
+    FString heartbeatUrl;
+    /** Where the batch is posted, instances talking to different backends are batched separately */
+    FString batchUrl;
+    /** The session's own, only used for the Authorization header of its entry */
+    TWeakPtr<JsonRequestManager> requestManager;
+    /** Posts the batch. Not tied to any one session, so that an expired token doesn't fail everyone's heartbeats */
+    TWeakPtr<JsonRequestManager> batchRequestManager;
+    FDriftHeartbeatResultDelegate onResult;
+};
+
+
+/** Sends a batch, and calls back with one result per entry once it's done */
+using FDriftHeartbeatBatchSender = TFunction<void(const FString& batchUrl, const TSharedPtr<JsonRequestManager>& requestManager,
+    const FDriftHeartbeatBatchPayload& payload, TFunction<void(TArray<FDriftHeartbeatResult>&&)> onComplete)>;
+
+
+/**
+ * Sends the heartbeats of every Drift instance in the process together.
+ *
+ * Dedicated servers and bots can host hundreds of instances, and one request per instance
+ * per interval adds up. Whenever any registered instance is due a heartbeat, everyone else
+ * who would be due within their next interval comes along in the same request. Heartbeats
+ * are never sent later than their own scheduler asks for, only earlier, and after the first
+ * batch the instances share a cadence so there's about one request per interval.
+ *
+ * Results are dispatched back to each instance, which deals with them as it would with the
+ * response to its own heartbeat.
+ */
+class FDriftHeartbeatMultiplexer : public FTickableGameObject, public TSharedFromThis<FDriftHeartbeatMultiplexer>
+{
+public:
+    FDriftHeartbeatMultiplexer();
+
+    /**
+     * FTickableGameObject overrides
+     */
+    void Tick(float DeltaTime) override;
+    bool IsTickable() const override { return participants.Num() > 0; }
+
+    TStatId GetStatId() const override;
+
+    /**
+     * API
+     */
+    int32 Register(FDriftHeartbeatParticipant participant);
+    void Unregister(int32 handle);
+
+    /** For when the participant's session gets new credentials */
+    void SetRequestManager(int32 handle, TWeakPtr<JsonRequestManager> requestManager);
+
+    /** Send any heartbeats that are due */
+    void SendDueHeartbeats(double now);
+
+    /** Replace how batches are sent, mainly for testing without a backend */
+    void SetBatchSender(FDriftHeartbeatBatchSender newBatchSender);
+
+    /** What a batch request that failed as a whole means for every instance in it */
+    static EDriftHeartbeatStatus GetBatchFailureStatus(bool responded, int32 responseCode);
+
+private:
+    void SendBatch(const FString& batchUrl, TArray<int32>&& handles);
+    void HandleBatchResults(const TArray<int32>& handles, TArray<FDriftHeartbeatResult>&& results);
+
+    static void SendBatchRequest(const FString& batchUrl, const TSharedPtr<JsonRequestManager>& requestManager,
+        const FDriftHeartbeatBatchPayload& payload, TFunction<void(TArray<FDriftHeartbeatResult>&&)> onComplete);
+
+    TMap<int32, FDriftHeartbeatParticipant> participants;
+    int32 nextHandle = 0;
+
+    FDriftHeartbeatBatchSender batchSender;
+};
@@ -0,0 +1,141 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftHeartbeatScheduler.h"
+
+
+/** Used until there are round-trip samples */
+static constexpr float DEFAULT_HEARTBEAT_SAFETY_MARGIN = 5.0f;
+static constexpr float MIN_HEARTBEAT_SAFETY_MARGIN = 1.0f;
+static constexpr float MAX_HEARTBEAT_SAFETY_MARGIN = 15.0f;
+
+/** Gains for the round-trip averages, the same as for TCP */
+static constexpr float ROUND_TRIP_GAIN = 1.0f / 8.0f;
+static constexpr float ROUND_TRIP_DEVIATION_GAIN = 1.0f / 4.0f;
+
+
+void FDriftHeartbeatScheduler::Start(double now, float firstHeartbeatSeconds, float timeoutSeconds)
+{
+    Reset();
+
+    running_ = true;
+    interval_ = FMath::Max(firstHeartbeatSeconds, 0.0f);
+    regularDueAt_ = now + firstHeartbeatSeconds;
+    idleDueAt_ = regularDueAt_;
+    if (timeoutSeconds > 0.0f)
+    {
+        timeoutAt_ = now + timeoutSeconds;
+    }
+}
+
+
+void FDriftHeartbeatScheduler::Reset()
+{
+    *this = FDriftHeartbeatScheduler{};
+}
+
+
+bool FDriftHeartbeatScheduler::IsHeartbeatDue(double now) const
+{
+    return running_ && !inFlight_ && now >= GetNextHeartbeatAt();
+}
+
+
+bool FDriftHeartbeatScheduler::IsTimedOut(double now) const
+{
+    return running_ && timeoutAt_ != DBL_MAX && now >= timeoutAt_ - GetSafetyMargin();
+}
+
+
+void FDriftHeartbeatScheduler::HeartbeatSent()
+{
+    inFlight_ = true;
+}
+
+
+void FDriftHeartbeatScheduler::HeartbeatSucceeded(double now, float roundTripSeconds, float nextHeartbeatSeconds, float timeoutSeconds)
+{
+    inFlight_ = false;
+    retryAt_ = -1.0;
+
+    AddRoundTripSample(roundTripSeconds);
+
+    interval_ = FMath::Max(nextHeartbeatSeconds, 0.0f);
+    regularDueAt_ = now + interval_;
+    idleDueAt_ = regularDueAt_;
+    if (timeoutSeconds > 0.0f)
+    {
+        /**
+         * The request could have spent most of the round trip on the way there, so the
+         * server may have started the timeout that much earlier than we saw the response.
+         */
+        timeoutAt_ = now + timeoutSeconds - roundTripSeconds;
+    }
+}
+
+
+void FDriftHeartbeatScheduler::HeartbeatFailed(double now, float delaySeconds)
+{
+    inFlight_ = false;
+    retryAt_ = now + delaySeconds;
+}
+
+
+void FDriftHeartbeatScheduler::RecordActivity(double now, float roundTripSeconds)
+{
+    if (!running_)
+    {
+        return;
+    }
+
+    AddRoundTripSample(roundTripSeconds);
+
+    // Without a known timeout there's no telling how long the heartbeat can safely wait
+    if (!inFlight_ && timeoutAt_ != DBL_MAX)
+    {
+        idleDueAt_ = FMath::Max(idleDueAt_, now + interval_);
+    }
+}
+
+
+double FDriftHeartbeatScheduler::GetNextHeartbeatAt() const
+{
+    if (retryAt_ >= 0.0)
+    {
+        return retryAt_;
+    }
+    if (timeoutAt_ == DBL_MAX)
+    {
+        return regularDueAt_;
+    }
+    // Traffic can postpone the heartbeat until the deadline, but never bring it forward from the regular cadence
+    const auto deadline = timeoutAt_ - interval_ - GetSafetyMargin();
+    return FMath::Min(idleDueAt_, FMath::Max(deadline, regularDueAt_));
+}
+
+
+float FDriftHeartbeatScheduler::GetSafetyMargin() const
+{
+    if (smoothedRoundTrip_ < 0.0f)
+    {
+        return DEFAULT_HEARTBEAT_SAFETY_MARGIN;
+    }
+    return FMath::Clamp(smoothedRoundTrip_ + 4.0f * roundTripDeviation_, MIN_HEARTBEAT_SAFETY_MARGIN, MAX_HEARTBEAT_SAFETY_MARGIN);
+}
+
+
+void FDriftHeartbeatScheduler::AddRoundTripSample(float roundTripSeconds)
+{
+    if (roundTripSeconds < 0.0f)
+    {
+        return;
+    }
+
+    if (smoothedRoundTrip_ < 0.0f)
+    {
+        smoothedRoundTrip_ = roundTripSeconds;
+        roundTripDeviation_ = roundTripSeconds / 2.0f;
+        return;
+    }
+    roundTripDeviation_ = FMath::Lerp(roundTripDeviation_, FMath::Abs(roundTripSeconds - smoothedRoundTrip_), ROUND_TRIP_DEVIATION_GAIN);
+    smoothedRoundTrip_ = FMath::Lerp(smoothedRoundTrip_, roundTripSeconds, ROUND_TRIP_GAIN);
+}
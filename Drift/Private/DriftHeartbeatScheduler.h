@@ -0,0 +1,65 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+/**
+ * Decides when a session needs a dedicated heartbeat, and when it has timed out.
+ *
+ * Any successful response from the backend shows the connection is alive, so while there's
+ * other traffic the heartbeat is pushed back. It still goes out early enough for the server
+ * to see it before the session times out, with one interval to spare for retries. Until the
+ * server has said when the session times out, heartbeats keep to the regular cadence.
+ *
+ * The safety margin against the timeout follows the observed round-trip time and its
+ * variation, like a TCP retransmission timeout, rather than being a fixed number of seconds.
+ *
+ * All times are in seconds on a monotonic clock supplied by the caller.
+ */
+class FDriftHeartbeatScheduler
+{
+public:
+    /** Start a session, with the first heartbeat due after firstHeartbeatSeconds. timeoutSeconds is zero if not known yet */
+    void Start(double now, float firstHeartbeatSeconds, float timeoutSeconds = 0.0f);
+    void Reset();
+
+    bool IsRunning() const { return running_; }
+    bool IsHeartbeatDue(double now) const;
+    bool IsTimedOut(double now) const;
+
+    void HeartbeatSent();
+
+    /** timeoutSeconds is zero if the server didn't say when the session would time out */
+    void HeartbeatSucceeded(double now, float roundTripSeconds, float nextHeartbeatSeconds, float timeoutSeconds);
+
+    /** The heartbeat failed, but might succeed if retried after delaySeconds */
+    void HeartbeatFailed(double now, float delaySeconds);
+
+    /** Any other successful response from the backend */
+    void RecordActivity(double now, float roundTripSeconds);
+
+    double GetNextHeartbeatAt() const;
+    /** Seconds between heartbeats when there's no other traffic */
+    float GetInterval() const { return interval_; }
+    /** When the session times out on the server, as far as we can tell, or DBL_MAX if not known yet */
+    double GetTimeoutAt() const { return timeoutAt_; }
+    float GetSafetyMargin() const;
+
+private:
+    void AddRoundTripSample(float roundTripSeconds);
+
+    bool running_ = false;
+    bool inFlight_ = false;
+
+    float interval_ = 0.0f;
+    /** When a heartbeat is due on the regular cadence, and when it's due if there's no other traffic */
+    double regularDueAt_ = DBL_MAX;
+    double idleDueAt_ = DBL_MAX;
+    double retryAt_ = -1.0;
+    double timeoutAt_ = DBL_MAX;
+
+    float smoothedRoundTrip_ = -1.0f;
+    float roundTripDeviation_ = 0.0f;
+};
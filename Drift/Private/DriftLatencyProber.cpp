@@ -0,0 +1,475 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftLatencyProber.h"
+
+#include "Algo/Count.h"
+#include "HttpModule.h"
+#include "Icmp.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+
+
+DEFINE_LOG_CATEGORY(LogDriftLatency);
+
+
+/* Samples this many median absolute deviations from the median are outliers */
+static constexpr float OutlierDeviations = 3.0f;
+/* ...but samples this close to the median, as a fraction of it, never are */
+static constexpr float MinOutlierFraction = 0.1f;
+
+/* Cycles without a single reply before a method is set aside, and for how long */
+static constexpr int32 MaxFailedCycles = 3;
+static constexpr int32 RetryAfterCycles = 10;
+
+/* Extra time a probe gets to report its own timeout before it's written off */
+static constexpr float ProbeTimeoutGrace = 1.0f;
+
+static constexpr EDriftLatencyProbeMethod ProbeMethods[] =
+{
+	EDriftLatencyProbeMethod::Icmp,
+	EDriftLatencyProbeMethod::Udp,
+	EDriftLatencyProbeMethod::Http,
+};
+
+
+FString FDriftLatencyProbeTargets::GetTarget(EDriftLatencyProbeMethod Method, const FString& Region) const
+{
+	const FString* Template = nullptr;
+	switch (Method)
+	{
+		case EDriftLatencyProbeMethod::Icmp:
+			Template = &IcmpHostTemplate;
+			break;
+
+		case EDriftLatencyProbeMethod::Udp:
+			Template = &UdpAddressTemplate;
+			break;
+
+		case EDriftLatencyProbeMethod::Http:
+			Template = &HttpUrlTemplate;
+			break;
+	}
+
+	if (!Template || Template->IsEmpty())
+	{
+		return {};
+	}
+
+	return FString::Format(**Template, { Region });
+}
+
+
+void FDriftLatencyEstimate::AddSample(float Milliseconds)
+{
+	if (Samples.Num() < WindowSize)
+	{
+		Samples.Add(Milliseconds);
+	}
+	else
+	{
+		Samples[NextSample] = Milliseconds;
+	}
+	NextSample = (NextSample + 1) % WindowSize;
+
+	AddOutcome(false);
+	Update();
+}
+
+void FDriftLatencyEstimate::AddLoss()
+{
+	AddOutcome(true);
+}
+
+float FDriftLatencyEstimate::GetPacketLoss() const
+{
+	if (Outcomes.Num() == 0)
+	{
+		return 0.0f;
+	}
+
+	return static_cast<float>(Algo::Count(Outcomes, true)) / Outcomes.Num();
+}
+
+void FDriftLatencyEstimate::AddOutcome(bool bLost)
+{
+	if (Outcomes.Num() < WindowSize)
+	{
+		Outcomes.Add(bLost);
+	}
+	else
+	{
+		Outcomes[NextOutcome] = bLost;
+	}
+	NextOutcome = (NextOutcome + 1) % WindowSize;
+}
+
+void FDriftLatencyEstimate::Reset()
+{
+	Samples.Reset();
+	NextSample = 0;
+	Outcomes.Reset();
+	NextOutcome = 0;
+	Median = 0.0f;
+	Jitter = 0.0f;
+}
+
+void FDriftLatencyEstimate::Update()
+{
+	const auto MedianOf = [](TArray<float>& Values)
+	{
+		Values.Sort();
+		const auto Middle = Values.Num() / 2;
+		return Values.Num() % 2 ? Values[Middle] : (Values[Middle - 1] + Values[Middle]) * 0.5f;
+	};
+
+	auto Sorted = Samples;
+	Median = MedianOf(Sorted);
+
+	TArray<float> Deviations;
+	Deviations.Reserve(Samples.Num());
+	for (const auto Sample : Samples)
+	{
+		Deviations.Add(FMath::Abs(Sample - Median));
+	}
+	auto SortedDeviations = Deviations;
+	const auto MedianDeviation = MedianOf(SortedDeviations);
+
+	// The median deviation is zero when most samples are the same, so leave some room around the median
+	const auto MaxDeviation = FMath::Max(MedianDeviation * OutlierDeviations, Median * MinOutlierFraction);
+
+	auto DeviationSum = 0.0f;
+	auto Inliers = 0;
+	for (const auto Deviation : Deviations)
+	{
+		if (Deviation <= MaxDeviation)
+		{
+			DeviationSum += Deviation;
+			++Inliers;
+		}
+	}
+	Jitter = Inliers > 0 ? DeviationSum / Inliers : 0.0f;
+}
+
+
+FDriftLatencyProber::FDriftLatencyProber(const FDriftLatencyProbeSettings& InSettings)
+	: Settings{InSettings}
+{
+	UpdateMethod();
+}
+
+void FDriftLatencyProber::SetSettings(const FDriftLatencyProbeSettings& InSettings)
+{
+	Settings = InSettings;
+	UpdateMethod();
+}
+
+void FDriftLatencyProber::SetRegions(const TArray<FString>& InRegions)
+{
+	Regions = InRegions;
+
+	for (auto It = Estimates.CreateIterator(); It; ++It)
+	{
+		if (!Regions.Contains(It->Key))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FDriftLatencyProber::SeedEstimate(const FString& Region, float Milliseconds)
+{
+	auto& Estimate = Estimates.FindOrAdd(Region);
+	if (!Estimate.HasSamples())
+	{
+		Estimate.AddSample(Milliseconds);
+	}
+}
+
+bool FDriftLatencyProber::StartCycle(FCycleCompleted OnCompleted)
+{
+	if (bCycleRunning || Regions.Num() == 0)
+	{
+		return false;
+	}
+
+	UpdateMethod();
+
+	bCycleRunning = true;
+	OnCycleCompleted = MoveTemp(OnCompleted);
+	RegionsReplied.Reset();
+	CycleLosses.Reset();
+	CycleSuccesses = 0;
+
+	QueuedProbes.Reset(Regions.Num() * Settings.SamplesPerRegion);
+	for (auto Sample = 0; Sample < FMath::Max(Settings.SamplesPerRegion, 1); ++Sample)
+	{
+		QueuedProbes.Append(Regions);
+	}
+
+	UE_LOG(LogDriftLatency, Verbose, TEXT("FDriftLatencyProber::StartCycle - Sending '%d' probes over %s"), QueuedProbes.Num(), MethodToString(Method));
+
+	SendNextProbes();
+	return true;
+}
+
+void FDriftLatencyProber::Tick(double Now)
+{
+	TArray<int32> TimedOut;
+	for (const auto& Probe : PendingProbes)
+	{
+		if (Now - Probe.Value.StartedAt > Settings.ProbeTimeout + ProbeTimeoutGrace)
+		{
+			TimedOut.Add(Probe.Key);
+		}
+	}
+
+	for (const auto ProbeId : TimedOut)
+	{
+		UE_LOG(LogDriftLatency, Verbose, TEXT("FDriftLatencyProber::Tick - Probe to '%s' never reported back"), *PendingProbes[ProbeId].Region);
+		ProbeCompleted(ProbeId, EProbeResult::Failure, 0.0f);
+	}
+}
+
+const TCHAR* FDriftLatencyProber::MethodToString(EDriftLatencyProbeMethod InMethod)
+{
+	switch (InMethod)
+	{
+		case EDriftLatencyProbeMethod::Icmp: return TEXT("ICMP");
+		case EDriftLatencyProbeMethod::Udp: return TEXT("UDP");
+		case EDriftLatencyProbeMethod::Http: return TEXT("HTTP");
+	}
+
+	return TEXT("Unknown");
+}
+
+void FDriftLatencyProber::SendProbe(EDriftLatencyProbeMethod InMethod, const FString& Target, float Timeout, FProbeCompleted OnCompleted)
+{
+	const auto FromEchoResult = [OnCompleted](const FIcmpEchoResult& Result)
+	{
+		switch (Result.Status)
+		{
+			case EIcmpResponseStatus::Success:
+				OnCompleted(EProbeResult::Success, Result.Time);
+				break;
+
+			case EIcmpResponseStatus::NotImplemented:
+				OnCompleted(EProbeResult::NotImplemented, 0.0f);
+				break;
+
+			default:
+				OnCompleted(EProbeResult::Failure, 0.0f);
+		}
+	};
+
+	switch (InMethod)
+	{
+		case EDriftLatencyProbeMethod::Icmp:
+		{
+			FIcmp::IcmpEcho(Target, Timeout, FromEchoResult);
+			break;
+		}
+
+		case EDriftLatencyProbeMethod::Udp:
+		{
+			FUDPPing::UDPEcho(Target, Timeout, FromEchoResult);
+			break;
+		}
+
+		case EDriftLatencyProbeMethod::Http:
+		{
+			const auto Request = FHttpModule::Get().CreateRequest();
+			Request->SetVerb(TEXT("GET"));
+			Request->SetURL(Target);
+			Request->SetTimeout(Timeout);
+			Request->OnProcessRequestComplete().BindLambda([OnCompleted](FHttpRequestPtr RequestPtr, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+			{
+				// Any reply will do, the status code doesn't matter
+				if (bConnectedSuccessfully && Response.IsValid())
+				{
+					OnCompleted(EProbeResult::Success, RequestPtr->GetElapsedTime());
+				}
+				else
+				{
+					OnCompleted(EProbeResult::Failure, 0.0f);
+				}
+			});
+			Request->ProcessRequest();
+			break;
+		}
+	}
+}
+
+void FDriftLatencyProber::SendNextProbes()
+{
+	// A probe that completes right away lands back here, leave it to the loop below
+	if (bSendingProbes)
+	{
+		return;
+	}
+
+	{
+		TGuardValue<bool> SendingProbes{ bSendingProbes, true };
+		while (bCycleRunning && QueuedProbes.Num() > 0 && PendingProbes.Num() < FMath::Max(Settings.MaxConcurrentProbes, 1))
+		{
+			const auto Region = QueuedProbes.Pop();
+			const auto Target = Settings.Targets.GetTarget(Method, Region);
+			if (Target.IsEmpty())
+			{
+				continue;
+			}
+
+			const auto ProbeId = NextProbeId++;
+			PendingProbes.Add(ProbeId, FPendingProbe{ Region, Method, FPlatformTime::Seconds() });
+
+			SendProbe(Method, Target, Settings.ProbeTimeout, [WeakSelf = TWeakPtr<FDriftLatencyProber>(AsShared()), ProbeId](EProbeResult Result, float Seconds)
+			{
+				if (const auto Self = WeakSelf.Pin())
+				{
+					Self->ProbeCompleted(ProbeId, Result, Seconds);
+				}
+			});
+		}
+	}
+
+	if (bCycleRunning && QueuedProbes.Num() == 0 && PendingProbes.Num() == 0)
+	{
+		FinishCycle();
+	}
+}
+
+void FDriftLatencyProber::ProbeCompleted(int32 ProbeId, EProbeResult Result, float Seconds)
+{
+	FPendingProbe Probe;
+	if (!PendingProbes.RemoveAndCopyValue(ProbeId, Probe))
+	{
+		// Already written off
+		return;
+	}
+
+	switch (Result)
+	{
+		case EProbeResult::Success:
+		{
+			const auto Milliseconds = Seconds * 1000.0f;
+			UE_LOG(LogDriftLatency, VeryVerbose, TEXT("FDriftLatencyProber::ProbeCompleted - '%s' replied over %s in '%.1f' ms"), *Probe.Region, MethodToString(Probe.Method), Milliseconds);
+
+			Estimates.FindOrAdd(Probe.Region).AddSample(Milliseconds);
+			RegionsReplied.Add(Probe.Region);
+			++CycleSuccesses;
+			break;
+		}
+
+		case EProbeResult::NotImplemented:
+		{
+			auto& MethodAvailability = Availability[static_cast<uint8>(Probe.Method)];
+			if (MethodAvailability.bImplemented)
+			{
+				MethodAvailability.bImplemented = false;
+				UpdateMethod();
+				UE_LOG(LogDriftLatency, Warning, TEXT("FDriftLatencyProber::ProbeCompleted - %s probes aren't implemented on this platform. Using %s instead."),
+					MethodToString(Probe.Method), MethodToString(Method));
+			}
+
+			// Try again with whatever is used now
+			if (Probe.Method != Method)
+			{
+				QueuedProbes.Add(Probe.Region);
+			}
+			break;
+		}
+
+		case EProbeResult::Failure:
+		{
+			UE_LOG(LogDriftLatency, Verbose, TEXT("FDriftLatencyProber::ProbeCompleted - No reply from '%s' over %s"), *Probe.Region, MethodToString(Probe.Method));
+
+			CycleLosses.Add(Probe.Region);
+			break;
+		}
+	}
+
+	SendNextProbes();
+}
+
+void FDriftLatencyProber::FinishCycle()
+{
+	bCycleRunning = false;
+
+	for (auto& MethodAvailability : Availability)
+	{
+		MethodAvailability.CyclesUntilRetry = FMath::Max(MethodAvailability.CyclesUntilRetry - 1, 0);
+	}
+
+	auto& Current = Availability[static_cast<uint8>(Method)];
+	if (CycleSuccesses > 0)
+	{
+		Current.FailedCycles = 0;
+
+		for (const auto& Region : CycleLosses)
+		{
+			Estimates.FindOrAdd(Region).AddLoss();
+		}
+	}
+	else if (++Current.FailedCycles >= MaxFailedCycles)
+	{
+		UE_LOG(LogDriftLatency, Warning, TEXT("FDriftLatencyProber::FinishCycle - No replies over %s for '%d' cycles, trying something else for a while"),
+			MethodToString(Method), Current.FailedCycles);
+
+		Current.FailedCycles = 0;
+		Current.CyclesUntilRetry = RetryAfterCycles;
+	}
+
+	TMap<FString, int32> LatenciesByRegion;
+	for (const auto& Region : Regions)
+	{
+		const auto Estimate = Estimates.Find(Region);
+		LatenciesByRegion.Add(Region, RegionsReplied.Contains(Region) && Estimate ? FMath::RoundToInt(Estimate->GetMedian()) : -1);
+	}
+
+	// The callback may start the next cycle
+	const auto OnCompleted = MoveTemp(OnCycleCompleted);
+	OnCompleted.ExecuteIfBound(LatenciesByRegion);
+}
+
+void FDriftLatencyProber::UpdateMethod()
+{
+	for (const auto Candidate : ProbeMethods)
+	{
+		if (IsMethodUsable(Candidate) && Availability[static_cast<uint8>(Candidate)].CyclesUntilRetry == 0)
+		{
+			Method = Candidate;
+			return;
+		}
+	}
+
+	// Everything has been failing, go with the most preferred method that could work at all
+	for (const auto Candidate : ProbeMethods)
+	{
+		if (IsMethodUsable(Candidate))
+		{
+			Method = Candidate;
+			return;
+		}
+	}
+}
+
+bool FDriftLatencyProber::IsMethodUsable(EDriftLatencyProbeMethod InMethod) const
+{
+	if (!Availability[static_cast<uint8>(InMethod)].bImplemented)
+	{
+		return false;
+	}
+
+	switch (InMethod)
+	{
+		case EDriftLatencyProbeMethod::Icmp:
+			return !Settings.Targets.IcmpHostTemplate.IsEmpty();
+
+		case EDriftLatencyProbeMethod::Udp:
+			return !Settings.Targets.UdpAddressTemplate.IsEmpty();
+
+		case EDriftLatencyProbeMethod::Http:
+			return !Settings.Targets.HttpUrlTemplate.IsEmpty();
+	}
+
+	return false;
+}
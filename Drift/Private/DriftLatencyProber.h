@@ -0,0 +1,170 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDriftLatency, Log, All);
+
+
+/* In order of preference */
+enum class EDriftLatencyProbeMethod : uint8
+{
+	Icmp,
+	Udp,
+	Http,
+};
+
+
+/**
+ * Where each kind of probe goes for a region. '{0}' is replaced with the region name, and an
+ * empty template leaves the method out. The UDP probe expects an echo server at 'host:port'.
+ */
+struct FDriftLatencyProbeTargets
+{
+	FString IcmpHostTemplate = TEXT("gamelift.{0}.amazonaws.com");
+	FString UdpAddressTemplate;
+	FString HttpUrlTemplate = TEXT("https://gamelift.{0}.amazonaws.com");
+
+	FString GetTarget(EDriftLatencyProbeMethod Method, const FString& Region) const;
+};
+
+
+struct FDriftLatencyProbeSettings
+{
+	FDriftLatencyProbeTargets Targets;
+	int32 SamplesPerRegion = 3;
+	int32 MaxConcurrentProbes = 4;
+	float ProbeTimeout = 2.0f;
+};
+
+
+/**
+ * Rolling latency estimate for a single region.
+ *
+ * Keeps the most recent samples and reports their median, which a single slow reply
+ * doesn't move. Samples further from the median than a few median absolute deviations
+ * (and at least a tenth of the median) are outliers, and are left out of the jitter, which
+ * is the mean deviation of the rest. Packet loss is the fraction of the most recent probes
+ * that got no reply.
+ */
+class FDriftLatencyEstimate
+{
+public:
+	static constexpr int32 WindowSize = 15;
+
+	void AddSample(float Milliseconds);
+	void AddLoss();
+	void Reset();
+
+	bool HasSamples() const { return Samples.Num() > 0; }
+	float GetMedian() const { return Median; }
+	float GetJitter() const { return Jitter; }
+	float GetPacketLoss() const;
+
+private:
+	void AddOutcome(bool bLost);
+	void Update();
+
+	TArray<float> Samples;
+	int32 NextSample = 0;
+	TArray<bool> Outcomes;
+	int32 NextOutcome = 0;
+	float Median = 0.0f;
+	float Jitter = 0.0f;
+};
+
+
+/**
+ * Measures latency to a set of regions.
+ *
+ * Each cycle sends several probes to every region, a bounded number at a time, and feeds
+ * the replies into a rolling estimate per region. The cycle completes with the median of
+ * each region, or -1 for regions that never replied. A probe that went unanswered only
+ * counts as lost if other regions replied over the same method that cycle, otherwise it's
+ * the method that isn't getting through rather than the region.
+ *
+ * Probes use the most preferred method that is working. A method that the platform
+ * doesn't implement is dropped, and one that gets no replies for a few cycles in a row is
+ * set aside for a while before it's given another try.
+ */
+class FDriftLatencyProber : public TSharedFromThis<FDriftLatencyProber>
+{
+public:
+	DECLARE_DELEGATE_OneParam(FCycleCompleted, const TMap<FString, int32>& /* LatenciesByRegion */);
+
+	FDriftLatencyProber(const FDriftLatencyProbeSettings& InSettings = {});
+	virtual ~FDriftLatencyProber() = default;
+
+	void SetSettings(const FDriftLatencyProbeSettings& InSettings);
+	void SetRegions(const TArray<FString>& InRegions);
+
+	/* Start a region off with an earlier estimate, if nothing has been measured yet */
+	void SeedEstimate(const FString& Region, float Milliseconds);
+
+	/* Returns false if a cycle is already running, or there's nothing to probe */
+	bool StartCycle(FCycleCompleted OnCompleted);
+
+	/* Times out probes that never reported back */
+	void Tick(double Now);
+
+	bool IsProbing() const { return bCycleRunning; }
+	EDriftLatencyProbeMethod GetMethod() const { return Method; }
+	const FDriftLatencyEstimate* GetEstimate(const FString& Region) const { return Estimates.Find(Region); }
+
+	static const TCHAR* MethodToString(EDriftLatencyProbeMethod InMethod);
+
+protected:
+	enum class EProbeResult : uint8
+	{
+		Success,
+		Failure,
+		NotImplemented,
+	};
+
+	using FProbeCompleted = TFunction<void(EProbeResult /* Result */, float /* Seconds */)>;
+
+	/* Sends a single probe. OnCompleted must be called on the game thread */
+	virtual void SendProbe(EDriftLatencyProbeMethod InMethod, const FString& Target, float Timeout, FProbeCompleted OnCompleted);
+
+private:
+	struct FPendingProbe
+	{
+		FString Region;
+		EDriftLatencyProbeMethod Method;
+		double StartedAt;
+	};
+
+	struct FMethodAvailability
+	{
+		bool bImplemented = true;
+		int32 FailedCycles = 0;
+		int32 CyclesUntilRetry = 0;
+	};
+
+	void SendNextProbes();
+	void ProbeCompleted(int32 ProbeId, EProbeResult Result, float Seconds);
+	void FinishCycle();
+	void UpdateMethod();
+	bool IsMethodUsable(EDriftLatencyProbeMethod InMethod) const;
+
+	FDriftLatencyProbeSettings Settings;
+	TArray<FString> Regions;
+	TMap<FString, FDriftLatencyEstimate> Estimates;
+
+	EDriftLatencyProbeMethod Method = EDriftLatencyProbeMethod::Icmp;
+	FMethodAvailability Availability[3];
+
+	bool bCycleRunning = false;
+	FCycleCompleted OnCycleCompleted;
+	/* Regions still to be probed this cycle, interleaved so the samples of a region are spread out */
+	TArray<FString> QueuedProbes;
+	TMap<int32, FPendingProbe> PendingProbes;
+	bool bSendingProbes = false;
+	int32 NextProbeId = 0;
+	TSet<FString> RegionsReplied;
+	/* Regions that didn't reply to a probe this cycle, once for each probe */
+	TArray<FString> CycleLosses;
+	int32 CycleSuccesses = 0;
+};
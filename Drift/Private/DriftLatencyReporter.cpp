@@ -0,0 +1,139 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftLatencyReporter.h"
+
+#include "DriftFlexmatch.h"
+#include "JsonArchive.h"
+
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+
+bool FDriftRegionLatency::Serialize(SerializationContext& Context)
+{
+	return SERIALIZE_PROPERTY(Context, region)
+		&& SERIALIZE_PROPERTY(Context, latency)
+		&& SERIALIZE_PROPERTY(Context, last_updated);
+}
+
+
+FDriftLatencyReporter::FDriftLatencyReporter()
+	: FDriftLatencyReporter(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("DriftMatchmaking"), TEXT("Latencies.json")))
+{
+}
+
+FDriftLatencyReporter::FDriftLatencyReporter(const FString& InFilePath)
+	: FilePath{ InFilePath }
+{
+	Load();
+}
+
+TMap<FString, int32> FDriftLatencyReporter::GetSeed(const FDateTime& Now) const
+{
+	TMap<FString, int32> Seed;
+	for (const auto& Entry : Entries)
+	{
+		if ((Now - Entry.last_updated).GetTotalSeconds() <= Settings.MaxSeedAgeSeconds)
+		{
+			Seed.Add(Entry.region, Entry.latency);
+		}
+	}
+	return Seed;
+}
+
+TMap<FString, int32> FDriftLatencyReporter::Update(const TMap<FString, int32>& LatenciesByRegion, const FDateTime& Now, bool bMeasured)
+{
+	TMap<FString, int32> ToReport;
+	for (const auto& Latency : LatenciesByRegion)
+	{
+		if (Latency.Value < 0)
+		{
+			continue;
+		}
+
+		const auto Previous = Reported.Find(Latency.Key);
+		if (!Previous
+			|| FMath::Abs(Latency.Value - Previous->Average) > Settings.ThresholdMs
+			|| (Now - Previous->ReportedAt).GetTotalSeconds() >= Settings.FreshnessSeconds)
+		{
+			ToReport.Add(Latency.Key, Latency.Value);
+		}
+	}
+
+	if (ToReport.Num() == 0)
+	{
+		return ToReport;
+	}
+
+	// A report is going out anyway, so bring along regions that would be getting old soon, rather than sending them on their own
+	for (const auto& Latency : LatenciesByRegion)
+	{
+		const auto Previous = Reported.Find(Latency.Key);
+		if (Latency.Value >= 0 && Previous && (Now - Previous->ReportedAt).GetTotalSeconds() >= Settings.FreshnessSeconds * 0.5f)
+		{
+			ToReport.Add(Latency.Key, Latency.Value);
+		}
+	}
+
+	if (!bMeasured)
+	{
+		return ToReport;
+	}
+
+	// Only save when something moved, the file doesn't need to be more precise than the backend
+	for (const auto& Latency : ToReport)
+	{
+		auto Entry = Entries.FindByPredicate([&Latency](const FDriftRegionLatency& Candidate)
+		{
+			return Candidate.region == Latency.Key;
+		});
+		if (!Entry)
+		{
+			Entry = &Entries.AddDefaulted_GetRef();
+			Entry->region = Latency.Key;
+		}
+		Entry->latency = Latency.Value;
+		Entry->last_updated = Now;
+	}
+	Save();
+
+	return ToReport;
+}
+
+void FDriftLatencyReporter::ReportSucceeded(const TMap<FString, int32>& InReported, const TMap<FString, int32>& Averages, const FDateTime& Now)
+{
+	for (const auto& Latency : InReported)
+	{
+		const auto Average = Averages.Find(Latency.Key);
+		Reported.Add(Latency.Key, FReportedLatency{ Average ? *Average : Latency.Value, Now });
+	}
+}
+
+void FDriftLatencyReporter::ResetReported()
+{
+	Reported.Reset();
+}
+
+void FDriftLatencyReporter::Load()
+{
+	FString Content;
+	if (!FFileHelper::LoadFileToString(Content, *FilePath))
+	{
+		return;
+	}
+
+	if (!JsonArchive::LoadObject(*Content, Entries))
+	{
+		UE_LOG(LogDriftMatchmaking, Warning, TEXT("FDriftLatencyReporter::Load - Failed to parse saved latencies, starting over"));
+		Entries.Empty();
+	}
+}
+
+void FDriftLatencyReporter::Save() const
+{
+	FString Content;
+	if (!JsonArchive::SaveObject(Entries, Content) || !FFileHelper::SaveStringToFile(Content, *FilePath))
+	{
+		UE_LOG(LogDriftMatchmaking, Warning, TEXT("FDriftLatencyReporter::Save - Failed to save latencies to '%s'"), *FilePath);
+	}
+}
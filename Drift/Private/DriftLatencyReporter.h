@@ -0,0 +1,85 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+class SerializationContext;
+
+
+/* Latest latency estimate of a region, kept across sessions */
+struct FDriftRegionLatency
+{
+	FString region;
+	/* Milliseconds */
+	int32 latency = 0;
+	FDateTime last_updated{ 0 };
+
+	bool Serialize(SerializationContext& Context);
+};
+
+
+struct FDriftLatencyReportSettings
+{
+	/* Report a region again once its estimate has moved by more than this many milliseconds */
+	int32 ThresholdMs = 10;
+	/* ...or when it hasn't been reported for this long */
+	float FreshnessSeconds = 60.0f;
+	/* Estimates from earlier sessions older than this aren't used */
+	float MaxSeedAgeSeconds = 7.0f * 24.0f * 60.0f * 60.0f;
+};
+
+
+/**
+ * Decides which region latencies are worth reporting to the backend.
+ *
+ * The backend matches on the average of the latencies it has been sent for a region, which it
+ * returns with every report. A region is reported when it hasn't been yet, when its estimate is
+ * further than the threshold from that average, or when the last report is getting old. Regions
+ * that are halfway there go along with any report that is sent anyway. Everything else is left
+ * out, and a region that moved keeps being reported until the average has caught up with it.
+ *
+ * The estimates are also saved, so that the next session can start matchmaking with them
+ * while the first measurements are still being taken.
+ */
+class FDriftLatencyReporter
+{
+public:
+	FDriftLatencyReporter();
+	explicit FDriftLatencyReporter(const FString& InFilePath);
+
+	void SetSettings(const FDriftLatencyReportSettings& InSettings) { Settings = InSettings; }
+
+	/* Estimates from earlier sessions that are recent enough to start with */
+	TMap<FString, int32> GetSeed(const FDateTime& Now) const;
+
+	/**
+	 * Takes the latest estimates, -1 for regions that couldn't be measured, and returns the ones to report.
+	 * Estimates are saved if they were measured in this session.
+	 */
+	TMap<FString, int32> Update(const TMap<FString, int32>& LatenciesByRegion, const FDateTime& Now, bool bMeasured = true);
+
+	/* The backend has accepted the report, and returned its averages. Regions it has no average for count as reported as they were. */
+	void ReportSucceeded(const TMap<FString, int32>& Reported, const TMap<FString, int32>& Averages, const FDateTime& Now);
+
+	/* Forget what was reported, for a new session */
+	void ResetReported();
+
+private:
+	struct FReportedLatency
+	{
+		/* What the backend has for the region, milliseconds */
+		int32 Average;
+		FDateTime ReportedAt;
+	};
+
+	void Load();
+	void Save() const;
+
+	FDriftLatencyReportSettings Settings;
+	TMap<FString, FReportedLatency> Reported;
+
+	FString FilePath;
+	TArray<FDriftRegionLatency> Entries;
+};
@@ -0,0 +1,167 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftLobbyEventSequencer.h"
+
+#include "DriftLobbyManager.h"
+
+
+FDriftLobbyEventSequencer::FDriftLobbyEventSequencer(FApplyEvent InApplyEvent, FStartResync InStartResync)
+	: ApplyEvent{MoveTemp(InApplyEvent)}
+	, StartResync{MoveTemp(InStartResync)}
+{
+}
+
+void FDriftLobbyEventSequencer::Receive(const FDriftSocialEvent& Event)
+{
+	const auto& EventLobbyId = Event.Lobby.lobby_id;
+	const auto Revision = Event.Lobby.revision;
+
+	if (Revision == INDEX_NONE)
+	{
+		ApplyEvent(Event);
+		return;
+	}
+
+	if (bResyncInFlight)
+	{
+		// Whatever the snapshot turns out to be, these go on top of it
+		if (!BufferedEvents.Contains(Revision))
+		{
+			BufferedEvents.Add(Revision, Event);
+		}
+		return;
+	}
+
+	if (EventLobbyId != LobbyId || AppliedRevision == INDEX_NONE)
+	{
+		// Nothing to compare with, take the event as the starting point
+		LobbyId = EventLobbyId;
+		AppliedRevision = Revision;
+		ApplyEvent(Event);
+		return;
+	}
+
+	if (Revision <= AppliedRevision)
+	{
+		UE_LOG(LogDriftLobby, Verbose, TEXT("FDriftLobbyEventSequencer::Receive - Dropping event at revision '%lld', already at '%lld'"), Revision, AppliedRevision);
+		return;
+	}
+
+	if (Revision == AppliedRevision + 1)
+	{
+		AppliedRevision = Revision;
+		ApplyEvent(Event);
+		return;
+	}
+
+	UE_LOG(LogDriftLobby, Warning, TEXT("FDriftLobbyEventSequencer::Receive - Missed events between revision '%lld' and '%lld' of lobby '%s'. Syncing up the lobby state."),
+		AppliedRevision, Revision, *LobbyId);
+
+	BufferedEvents.Add(Revision, Event);
+	RequestResync();
+}
+
+void FDriftLobbyEventSequencer::RequestResync()
+{
+	if (bResyncInFlight)
+	{
+		UE_LOG(LogDriftLobby, Verbose, TEXT("FDriftLobbyEventSequencer::RequestResync - Already syncing up the lobby state"));
+		return;
+	}
+
+	bResyncInFlight = true;
+	StartResync();
+}
+
+void FDriftLobbyEventSequencer::SnapshotApplied(const FString& SnapshotLobbyId, int64 Revision)
+{
+	if (SnapshotLobbyId != LobbyId)
+	{
+		LobbyId = SnapshotLobbyId;
+		AppliedRevision = Revision;
+	}
+	else if (Revision != INDEX_NONE && Revision > AppliedRevision)
+	{
+		AppliedRevision = Revision;
+	}
+}
+
+void FDriftLobbyEventSequencer::ResyncFinished(bool bSuccess)
+{
+	if (!bResyncInFlight)
+	{
+		return;
+	}
+
+	bResyncInFlight = false;
+
+	if (!bSuccess)
+	{
+		// Nothing to apply the buffered events to, start over from whatever comes next
+		UE_LOG(LogDriftLobby, Warning, TEXT("FDriftLobbyEventSequencer::ResyncFinished - Failed to sync up the lobby state. Discarding '%d' buffered events."), BufferedEvents.Num());
+		BufferedEvents.Reset();
+		AppliedRevision = INDEX_NONE;
+		return;
+	}
+
+	ApplyBufferedEvents();
+}
+
+void FDriftLobbyEventSequencer::Reset()
+{
+	LobbyId.Empty();
+	AppliedRevision = INDEX_NONE;
+	BufferedEvents.Reset();
+}
+
+void FDriftLobbyEventSequencer::ApplyBufferedEvents()
+{
+	if (BufferedEvents.Num() == 0)
+	{
+		return;
+	}
+
+	BufferedEvents.KeySort(TLess<int64>());
+
+	// Anything the snapshot already covers, or that was meant for another lobby, is stale
+	for (auto It = BufferedEvents.CreateIterator(); It; ++It)
+	{
+		if (It->Value.Lobby.lobby_id != LobbyId || (AppliedRevision != INDEX_NONE && It->Key <= AppliedRevision))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	if (BufferedEvents.Num() == 0)
+	{
+		return;
+	}
+
+	if (AppliedRevision == INDEX_NONE)
+	{
+		// The snapshot had no revision, so the oldest buffered event has to do as the starting point
+		AppliedRevision = BufferedEvents.CreateConstIterator()->Key - 1;
+	}
+
+	// Applying an event can start another resync, in which case the rest wait for that one
+	while (!bResyncInFlight)
+	{
+		const auto Buffered = BufferedEvents.Find(AppliedRevision + 1);
+		if (!Buffered)
+		{
+			break;
+		}
+
+		const auto Event = MoveTemp(*Buffered);
+		BufferedEvents.Remove(AppliedRevision + 1);
+		++AppliedRevision;
+		ApplyEvent(Event);
+	}
+
+	if (!bResyncInFlight && BufferedEvents.Num() > 0)
+	{
+		UE_LOG(LogDriftLobby, Warning, TEXT("FDriftLobbyEventSequencer::ApplyBufferedEvents - Still missing events after revision '%lld' of lobby '%s'. Syncing up the lobby state again."),
+			AppliedRevision, *LobbyId);
+		RequestResync();
+	}
+}
@@ -0,0 +1,56 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#pragma once
+
+#include "DriftSocialSession.h"
+
+
+/**
+ * Puts versioned lobby events in order before they're applied to the cached lobby.
+ *
+ * Each event may carry the lobby revision it produces. Events at or below the revision already
+ * applied are dropped, and the next one in line is applied straight away. Anything further
+ * ahead means events went missing, so the lobby is queried again. Only one such resync is ever
+ * in flight: events arriving in the meantime, including ones revealing more gaps, are buffered
+ * and applied on top of the snapshot once it's in, in revision order.
+ *
+ * Events without a revision, from a backend that doesn't track them, are applied as they come.
+ */
+class FDriftLobbyEventSequencer
+{
+public:
+	using FApplyEvent = TFunction<void(const FDriftSocialEvent& /* Event */)>;
+	using FStartResync = TFunction<void()>;
+
+	FDriftLobbyEventSequencer(FApplyEvent InApplyEvent, FStartResync InStartResync);
+
+	/* Apply, buffer or drop an incoming lobby event, by the lobby and revision it's for */
+	void Receive(const FDriftSocialEvent& Event);
+
+	/* Query the lobby again, unless that's already under way */
+	void RequestResync();
+
+	/* The lobby has been replaced from a snapshot, at the given revision if the snapshot has one */
+	void SnapshotApplied(const FString& LobbyId, int64 Revision);
+
+	/* The resync query is done. Buffered events are applied on top of the snapshot if it succeeded */
+	void ResyncFinished(bool bSuccess);
+
+	/* Forget the lobby. A resync that is in flight still has to finish */
+	void Reset();
+
+	bool IsResyncInFlight() const { return bResyncInFlight; }
+	int64 GetAppliedRevision() const { return AppliedRevision; }
+
+private:
+	void ApplyBufferedEvents();
+
+	FApplyEvent ApplyEvent;
+	FStartResync StartResync;
+
+	FString LobbyId;
+	int64 AppliedRevision = INDEX_NONE;
+	bool bResyncInFlight = false;
+
+	TMap<int64, FDriftSocialEvent> BufferedEvents;
+};
@@ -5,8 +5,6 @@
 
 DEFINE_LOG_CATEGORY(LogDriftLobby);
 
-static const FString LobbyMessageQueue(TEXT("lobby"));
-
 struct FDriftLobbyMatchPlacementResponse : FJsonSerializable
 {
 	BEGIN_JSON_SERIALIZER;
@@ -26,17 +24,23 @@ struct FDriftLobbyMatchPlacementResponse : FJsonSerializable
 	FString MatchPlacementURL;
 };
 
-FDriftLobbyManager::FDriftLobbyManager(TSharedPtr<IDriftMessageQueue> InMessageQueue)
-	: MessageQueue{MoveTemp(InMessageQueue)}
+FDriftLobbyManager::FDriftLobbyManager(TSharedPtr<FDriftSocialSession> InSocialSession)
+	: SocialSession{InSocialSession}
+	, EventSequencer{[this](const FDriftSocialEvent& Event) { ApplyLobbyEvent(Event); }, [this]() { StartResync(); }}
 {
-	MessageQueue->OnMessageQueueMessage(LobbyMessageQueue).AddRaw(this, &FDriftLobbyManager::HandleLobbyEvent);
+	InSocialSession->RegisterSourceHandler(EDriftSocialEventSource::Lobby, FDriftSocialEventDelegate::CreateRaw(this, &FDriftLobbyManager::HandleLobbyEvent));
+	InSocialSession->RegisterParticipant(this);
 
 	ResetCurrentLobby();
 }
 
 FDriftLobbyManager::~FDriftLobbyManager()
 {
-	MessageQueue->OnMessageQueueMessage(LobbyMessageQueue).RemoveAll(this);
+	if (const auto Session = SocialSession.Pin())
+	{
+		Session->UnregisterHandlers(this);
+		Session->UnregisterParticipant(this);
+	}
 }
 
 void FDriftLobbyManager::SetRequestManager(TSharedPtr<JsonRequestManager> RootRequestManager)
@@ -47,6 +51,7 @@ void FDriftLobbyManager::SetRequestManager(TSharedPtr<JsonRequestManager> RootRe
 void FDriftLobbyManager::ConfigureSession(const FDriftEndpointsResponse& DriftEndpoints, int32 InPlayerId)
 {
 	PlayerId = InPlayerId;
+	LobbyState.SetLocalPlayerId(PlayerId);
 
 	MatchPlacementsURL = DriftEndpoints.match_placements;
 	LobbiesURL = DriftEndpoints.lobbies;
@@ -260,6 +265,7 @@ bool FDriftLobbyManager::QueryLobby(FQueryLobbyCompletedDelegate Delegate)
 		if (!LobbyResponse.FromJson(Doc.GetInternalValue()->AsObject()))
 		{
 			UE_LOG(LogDriftLobby, Error, TEXT("Failed to serialize get lobby response"));
+			(void)Delegate.ExecuteIfBound(false, "", "Failed to serialize get lobby response");
 			return;
 		}
 
@@ -268,15 +274,16 @@ bool FDriftLobbyManager::QueryLobby(FQueryLobbyCompletedDelegate Delegate)
 			return PlayerId == Member.PlayerId;
 		});
 
-		ResetCurrentLobby();
-
 		if (LobbyMember)
 		{
+			// Patched in place if it's the lobby we already have
 			CacheLobby(LobbyResponse);
 			(void)Delegate.ExecuteIfBound(true, CurrentLobbyId, "");
 		}
 		else
 		{
+			ResetCurrentLobby();
+
 			UE_LOG(LogDriftLobby, Error, TEXT("Found existing lobby but player is not a member"));
 			(void)Delegate.ExecuteIfBound(false, "", "Lobby found, but you're not registered as a member of the lobby");
 		}
@@ -526,7 +533,7 @@ bool FDriftLobbyManager::UpdatePlayer(FDriftLobbyMemberProperties PlayerProperti
 		return false;
 	}
 
-	if (!CurrentLobby.IsValid())
+	if (!CurrentLobby().IsValid())
 	{
 		UE_LOG(LogDriftLobby, Error, TEXT("Trying to join update player properties while not being in a lobby"));
 		(void)Delegate.ExecuteIfBound(false, CurrentLobbyId, "You are not in a lobby. Must be in a lobby to update your properties");
@@ -605,7 +612,7 @@ bool FDriftLobbyManager::KickLobbyMember(int32 MemberPlayerId, FKickMemberComple
 
 	FString URL = "";
 
-	const auto PlayerIndex = CurrentLobby->Members.IndexOfByPredicate([MemberPlayerId](const TSharedPtr<FDriftLobbyMember>& Member)
+	const auto PlayerIndex = CurrentLobby()->Members.IndexOfByPredicate([MemberPlayerId](const TSharedPtr<FDriftLobbyMember>& Member)
 	{
 		return Member->PlayerId == MemberPlayerId;
 	});
@@ -613,11 +620,11 @@ bool FDriftLobbyManager::KickLobbyMember(int32 MemberPlayerId, FKickMemberComple
 	if (PlayerIndex == INDEX_NONE)
 	{
 		UE_LOG(LogDriftLobby, Warning, TEXT("Player '%d' not found in locally cached lobby. Maybe out of sync with server. Will query just in case"), MemberPlayerId);
-		QueryLobby({});
+		RequestResync();
 	}
 	else
 	{
-		const auto Member = CurrentLobby->Members[PlayerIndex];
+		const auto Member = CurrentLobby()->Members[PlayerIndex];
 		if (Member.IsValid())
 		{
 			URL = Member->LobbyMemberURL;
@@ -625,13 +632,13 @@ bool FDriftLobbyManager::KickLobbyMember(int32 MemberPlayerId, FKickMemberComple
 		else
 		{
 			UE_LOG(LogDriftLobby, Warning, TEXT("Player '%d' invalid in locally cached lobby. Maybe out of sync with server. Will query just in case"), MemberPlayerId);
-			QueryLobby({});
+			RequestResync();
 		}
 
 		// Update local state for host now
-		CurrentLobby->Members.RemoveAt(PlayerIndex);
+		LobbyState.RemoveMember(MemberPlayerId, PendingMemberChanges);
 		OnLobbyMemberKickedDelegate.Broadcast(CurrentLobbyId);
-		OnLobbyUpdatedDelegate.Broadcast(CurrentLobbyId);
+		BroadcastMemberChanges();
 	}
 
 	if (URL.IsEmpty())
@@ -673,7 +680,7 @@ bool FDriftLobbyManager::StartLobbyMatch(FString Queue, FStartLobbyMatchComplete
 		return false;
 	}
 
-	if (CurrentLobby->LobbyStatus == EDriftLobbyStatus::Starting)
+	if (CurrentLobby()->LobbyStatus == EDriftLobbyStatus::Starting)
 	{
 		UE_LOG(LogDriftLobby, Warning, TEXT("Lobby match is already starting, ignoring start lobby match request"));
 		return true;
@@ -682,7 +689,7 @@ bool FDriftLobbyManager::StartLobbyMatch(FString Queue, FStartLobbyMatchComplete
 	UE_LOG(LogDriftLobby, Log, TEXT("Starting the lobby match for lobby '%s'"), *CurrentLobbyId);
 
 	// Update locally for host
-	CurrentLobby->LobbyStatus = EDriftLobbyStatus::Starting;
+	CurrentLobby()->LobbyStatus = EDriftLobbyStatus::Starting;
 
 	JsonValue Payload{rapidjson::kObjectType};
 	JsonArchive::AddMember(Payload, TEXT("queue"), Queue);
@@ -702,15 +709,15 @@ bool FDriftLobbyManager::StartLobbyMatch(FString Queue, FStartLobbyMatchComplete
 			return;
 		}
 
-		CurrentLobby->LobbyMatchPlacementURL = MatchPlacementResponse.MatchPlacementURL;
+		CurrentLobby()->LobbyMatchPlacementURL = MatchPlacementResponse.MatchPlacementURL;
 
 		(void)Delegate.ExecuteIfBound(true, "", "");
 
-		OnLobbyStatusChangedDelegate.Broadcast(CurrentLobbyId, CurrentLobby->LobbyStatus);
+		OnLobbyStatusChangedDelegate.Broadcast(CurrentLobbyId, CurrentLobby()->LobbyStatus);
 	});
 	Request->OnError.BindLambda([this, Delegate](ResponseContext& Context)
 	{
-	    CurrentLobby->LobbyStatus = EDriftLobbyStatus::Failed;
+	    CurrentLobby()->LobbyStatus = EDriftLobbyStatus::Failed;
 
 		FString Error;
 		Context.errorHandled = GetResponseError(Context, Error);
@@ -720,42 +727,36 @@ bool FDriftLobbyManager::StartLobbyMatch(FString Queue, FStartLobbyMatchComplete
 	return Request->Dispatch();
 }
 
-void FDriftLobbyManager::HandleLobbyEvent(const FMessageQueueEntry& Message)
+void FDriftLobbyManager::HandleLobbyEvent(const FDriftSocialEvent& Event)
 {
-	if (Message.sender_id != FDriftMessageQueue::SenderSystemID && Message.sender_id != PlayerId)
-	{
-		UE_LOG(LogDriftLobby, Error, TEXT("FDriftLobbyManager::HandleLobbyEvent - Ignoring message from sender '%d'"), Message.sender_id);
-		return;
-	}
+	// The social session has already checked the sender and decoded the data
+	const auto& EventData = Event.Lobby;
 
-	const auto Event = Message.payload.FindField("event").GetString();
-	const auto EventData = Message.payload.FindField("data");
+	UE_LOG(LogDriftLobby, Verbose, TEXT("FDriftLobbyManager::HandleLobbyEvent - Incoming event '%s'"), *Event.Name);
 
-	UE_LOG(LogDriftLobby, Verbose, TEXT("FDriftLobbyManager::HandleLobbyEvent - Incoming event '%s'"), *Event);
-
-	if (!EventData.HasField("lobby_id"))
+	if (EventData.lobby_id.IsEmpty())
 	{
 		UE_LOG(LogDriftLobby, Error, TEXT("FDriftLobbyManager::HandleLobbyEvent - Event data doesn't contain 'lobby_id'. Discarding the event. Current cached lobby id: '%s'. Querying for the current lobby to sync up just in case."), *CurrentLobbyId);
-		QueryLobby({});
+		RequestResync();
 		return;
 	}
 
-	const auto LobbyId = EventData.FindField("lobby_id").GetString();
+	const auto& LobbyId = EventData.lobby_id;
 
 	// Verify that this event is relevant to us
 	if (LobbyId != CurrentLobbyId)
 	{
 		UE_LOG(LogDriftLobby, Warning, TEXT("FDriftLobbyManager::HandleLobbyEvent - Cached lobby '%s' does not match the event lobby '%s'. Will determine if this event is relevant to us by checking the lobby members."), *CurrentLobbyId, *LobbyId);
 
-		if (!EventData.HasField("members"))
+		if (!EventData.members.IsArray())
 		{
 			UE_LOG(LogDriftLobby, Error, TEXT("FDriftLobbyManager::HandleLobbyEvent - Event data doesn't contain 'members'. Querying for the current lobby to sync up just in case."));
-			QueryLobby({});
+			RequestResync();
 			return;
 		}
 
 		bool bRelevantEvent = false;
-		for (const auto& Elem : EventData.FindField("members").GetArray())
+		for (const auto& Elem : EventData.members.GetArray())
 		{
 			if (!Elem.HasField("player_id"))
 			{
@@ -773,36 +774,35 @@ void FDriftLobbyManager::HandleLobbyEvent(const FMessageQueueEntry& Message)
 		if (!bRelevantEvent)
 		{
 			UE_LOG(LogDriftLobby, Error, TEXT("FDriftLobbyManager::HandleLobbyEvent - Player isn't a member of the lobby for this event. Why did we receive this event? Discarding and syncing up with server just in case."));
-			QueryLobby({});
+			RequestResync();
 			return;
 		}
 	}
 
-	switch (ParseEvent(Event))
+	EventSequencer.Receive(Event);
+}
+
+void FDriftLobbyManager::ApplyLobbyEvent(const FDriftSocialEvent& Event)
+{
+	const auto& EventData = Event.Lobby;
+	const auto& LobbyId = EventData.lobby_id;
+
+	switch (Event.Type)
 	{
-		case EDriftLobbyEvent::LobbyUpdated:
+		case EDriftSocialEvent::LobbyUpdated:
 		{
-			FDriftLobbyResponse LobbyResponse{};
-			if (!LobbyResponse.FromJson(EventData.ToString()))
-			{
-				UE_LOG(LogDriftLobby, Error, TEXT("FDriftLobbyManager::HandleLobbyEvent - Failed to serialize LobbyUpdated event data. Syncing up the lobby state just in case."));
-				QueryLobby({});
-				return;
-			}
-
-			CacheLobby(LobbyResponse, false);
-			OnLobbyUpdatedDelegate.Broadcast(CurrentLobbyId);
+			CacheLobby(EventData.Lobby, false);
 			break;
 		}
 
-		case EDriftLobbyEvent::LobbyDeleted:
+		case EDriftSocialEvent::LobbyDeleted:
 		{
 			ResetCurrentLobby();
 			OnLobbyDeletedDelegate.Broadcast(LobbyId);
 			break;
 		}
 
-		case EDriftLobbyEvent::LobbyMemberJoined:
+		case EDriftSocialEvent::LobbyMemberJoined:
 		{
 			if (CacheMembers(EventData))
 			{
@@ -811,11 +811,11 @@ void FDriftLobbyManager::HandleLobbyEvent(const FMessageQueueEntry& Message)
 			}
 
 			UE_LOG(LogDriftLobby, Error, TEXT("FDriftLobbyManager::HandleLobbyEvent - Failed to serialize one or more members for LobbyMemberJoined event data. Syncing up the lobby state just in case."));
-			QueryLobby({});
+			RequestResync();
 			break;
 		}
 
-		case EDriftLobbyEvent::LobbyMemberUpdated:
+		case EDriftSocialEvent::LobbyMemberUpdated:
 		{
 			if (CacheMembers(EventData))
 			{
@@ -824,11 +824,11 @@ void FDriftLobbyManager::HandleLobbyEvent(const FMessageQueueEntry& Message)
 			}
 
 			UE_LOG(LogDriftLobby, Error, TEXT("FDriftLobbyManager::HandleLobbyEvent - Failed to serialize one or more members for LobbyMemberUpdated event data. Syncing up the lobby state just in case."));
-			QueryLobby({});
+			RequestResync();
 			break;
 		}
 
-		case EDriftLobbyEvent::LobbyMemberLeft:
+		case EDriftSocialEvent::LobbyMemberLeft:
 		{
 			if (CacheMembers(EventData))
 			{
@@ -837,11 +837,11 @@ void FDriftLobbyManager::HandleLobbyEvent(const FMessageQueueEntry& Message)
 			}
 
 			UE_LOG(LogDriftLobby, Error, TEXT("FDriftLobbyManager::HandleLobbyEvent - Failed to serialize one or more members for LobbyMemberLeft event data. Syncing up the lobby state just in case."));
-			QueryLobby({});
+			RequestResync();
 			break;
 		}
 
-		case EDriftLobbyEvent::LobbyMemberKicked:
+		case EDriftSocialEvent::LobbyMemberKicked:
 		{
 			if (CacheMembers(EventData))
 			{
@@ -850,124 +850,120 @@ void FDriftLobbyManager::HandleLobbyEvent(const FMessageQueueEntry& Message)
 			}
 
 			UE_LOG(LogDriftLobby, Error, TEXT("FDriftLobbyManager::HandleLobbyEvent - Failed to serialize one or more members for LobbyMemberKicked event data. Syncing up the lobby state just in case."));
-			QueryLobby({});
+			RequestResync();
 			break;
 		}
 
-		case EDriftLobbyEvent::LobbyMatchStarting:
+		case EDriftSocialEvent::LobbyMatchStarting:
 		{
-			if (!EventData.HasField("status"))
+			if (EventData.status.IsEmpty())
 			{
 				UE_LOG(LogDriftLobby, Error, TEXT("FDriftLobbyManager::HandleLobbyEvent - LobbyMatchStarting - Event data missing 'status' field. Syncing up the lobby state just in case."));
-				QueryLobby({});
+				RequestResync();
 				return;
 			}
 
-			const auto Status = ParseStatus(EventData.FindField("status").GetString());
-			CurrentLobby->LobbyStatus = Status;
+			const auto Status = ParseStatus(EventData.status);
+			CurrentLobby()->LobbyStatus = Status;
 			OnLobbyStatusChangedDelegate.Broadcast(CurrentLobbyId, Status);
 			break;
 		}
 
-		case EDriftLobbyEvent::LobbyMatchStarted:
+		case EDriftSocialEvent::LobbyMatchStarted:
 		{
-			if (!EventData.HasField("status"))
+			if (EventData.status.IsEmpty())
 			{
 				UE_LOG(LogDriftLobby, Error, TEXT("FDriftLobbyManager::HandleLobbyEvent - LobbyMatchStarted - Event data missing 'status' field. Syncing up the lobby state just in case."));
-				QueryLobby({});
+				RequestResync();
 				return;
 			}
 
-			if (!EventData.HasField("connection_string"))
+			if (EventData.connection_string.IsEmpty())
 			{
 				UE_LOG(LogDriftLobby, Error, TEXT("FDriftLobbyManager::HandleLobbyEvent - LobbyMatchStarted - Event data missing 'connection_string' field. Syncing up the lobby state just in case."));
-				QueryLobby({});
+				RequestResync();
 				return;
 			}
 
-			if (!EventData.HasField("connection_options"))
+			if (EventData.connection_options.IsEmpty())
 			{
 				UE_LOG(LogDriftLobby, Error, TEXT("FDriftLobbyManager::HandleLobbyEvent - LobbyMatchStarted - Event data missing 'connection_options' field. Syncing up the lobby state just in case."));
-				QueryLobby({});
+				RequestResync();
 				return;
 			}
 
-			CurrentLobby->LobbyStatus = ParseStatus(EventData.FindField("status").GetString());
-			CurrentLobby->ConnectionString = EventData.FindField("connection_string").GetString();
-			CurrentLobby->ConnectionOptions = EventData.FindField("connection_options").GetString();
+			CurrentLobby()->LobbyStatus = ParseStatus(EventData.status);
+			CurrentLobby()->ConnectionString = EventData.connection_string;
+			CurrentLobby()->ConnectionOptions = EventData.connection_options;
 
-			OnLobbyStatusChangedDelegate.Broadcast(CurrentLobbyId, CurrentLobby->LobbyStatus);
-			OnLobbyMatchStartedDelegate.Broadcast(CurrentLobbyId, CurrentLobby->ConnectionString, CurrentLobby->ConnectionOptions);
+			OnLobbyStatusChangedDelegate.Broadcast(CurrentLobbyId, CurrentLobby()->LobbyStatus);
+			OnLobbyMatchStartedDelegate.Broadcast(CurrentLobbyId, CurrentLobby()->ConnectionString, CurrentLobby()->ConnectionOptions);
 			break;
 		}
 
-		case EDriftLobbyEvent::LobbyMatchCancelled:
+		case EDriftSocialEvent::LobbyMatchCancelled:
 		{
-			if (!EventData.HasField("status"))
+			if (EventData.status.IsEmpty())
 			{
 				UE_LOG(LogDriftLobby, Error, TEXT("FDriftLobbyManager::HandleLobbyEvent - LobbyMatchCancelled - Event data missing 'status' field. Syncing up the lobby state just in case."));
-				QueryLobby({});
+				RequestResync();
 				return;
 			}
 
-			const auto Status = ParseStatus(EventData.FindField("status").GetString());
-			CurrentLobby->LobbyStatus = Status;
+			const auto Status = ParseStatus(EventData.status);
+			CurrentLobby()->LobbyStatus = Status;
 			OnLobbyStatusChangedDelegate.Broadcast(CurrentLobbyId, Status);
 			break;
 		}
 
-		case EDriftLobbyEvent::LobbyMatchTimedOut:
+		case EDriftSocialEvent::LobbyMatchTimedOut:
 		{
-			if (!EventData.HasField("status"))
+			if (EventData.status.IsEmpty())
 			{
 				UE_LOG(LogDriftLobby, Error, TEXT("FDriftLobbyManager::HandleLobbyEvent - LobbyMatchTimedOut - Event data missing 'status' field. Syncing up the lobby state just in case."));
-				QueryLobby({});
+				RequestResync();
 				return;
 			}
 
-			const auto Status = ParseStatus(EventData.FindField("status").GetString());
-			CurrentLobby->LobbyStatus = Status;
+			const auto Status = ParseStatus(EventData.status);
+			CurrentLobby()->LobbyStatus = Status;
 			OnLobbyStatusChangedDelegate.Broadcast(CurrentLobbyId, Status);
 			break;
 		}
 
-		case EDriftLobbyEvent::LobbyMatchFailed:
+		case EDriftSocialEvent::LobbyMatchFailed:
 		{
-			if (!EventData.HasField("status"))
+			if (EventData.status.IsEmpty())
 			{
 				UE_LOG(LogDriftLobby, Error, TEXT("FDriftLobbyManager::HandleLobbyEvent - LobbyMatchFailed - Event data missing 'status' field. Syncing up the lobby state just in case."));
-				QueryLobby({});
+				RequestResync();
 				return;
 			}
 
-			const auto Status = ParseStatus(EventData.FindField("status").GetString());
-			CurrentLobby->LobbyStatus = Status;
+			const auto Status = ParseStatus(EventData.status);
+			CurrentLobby()->LobbyStatus = Status;
 			OnLobbyStatusChangedDelegate.Broadcast(CurrentLobbyId, Status);
 			break;
 		}
 
-		case EDriftLobbyEvent::Unknown:
+		case EDriftSocialEvent::Unknown:
 		default:
-			UE_LOG(LogDriftLobby, Error, TEXT("FDriftLobbyManager::HandleLobbyEvent - Unknown event '%s'. Syncing up the lobby state just in case."), *Event);
-			QueryLobby({});
+			UE_LOG(LogDriftLobby, Error, TEXT("FDriftLobbyManager::HandleLobbyEvent - Unknown event '%s'. Syncing up the lobby state just in case."), *Event.Name);
+			RequestResync();
 	}
 }
 
-EDriftLobbyEvent FDriftLobbyManager::ParseEvent(const FString& EventName)
+void FDriftLobbyManager::RequestResync()
 {
-	if (EventName == TEXT("LobbyUpdated")) { return EDriftLobbyEvent::LobbyUpdated; }
-	if (EventName == TEXT("LobbyDeleted")) { return EDriftLobbyEvent::LobbyDeleted; }
-	if (EventName == TEXT("LobbyMemberJoined")) { return EDriftLobbyEvent::LobbyMemberJoined; }
-	if (EventName == TEXT("LobbyMemberUpdated")) { return EDriftLobbyEvent::LobbyMemberUpdated; }
-	if (EventName == TEXT("LobbyMemberLeft")) { return EDriftLobbyEvent::LobbyMemberLeft; }
-	if (EventName == TEXT("LobbyMemberKicked")) { return EDriftLobbyEvent::LobbyMemberKicked; }
-	if (EventName == TEXT("LobbyMatchStarting")) { return EDriftLobbyEvent::LobbyMatchStarting; }
-	if (EventName == TEXT("LobbyMatchStarted")) { return EDriftLobbyEvent::LobbyMatchStarted; }
-	if (EventName == TEXT("LobbyMatchCancelled")) { return EDriftLobbyEvent::LobbyMatchCancelled; }
-	if (EventName == TEXT("LobbyMatchTimedOut")) { return EDriftLobbyEvent::LobbyMatchTimedOut; }
-	if (EventName == TEXT("LobbyMatchFailed")) { return EDriftLobbyEvent::LobbyMatchFailed; }
-
-	return EDriftLobbyEvent::Unknown;
+	EventSequencer.RequestResync();
+}
+
+void FDriftLobbyManager::StartResync()
+{
+	QueryLobby(FQueryLobbyCompletedDelegate::CreateLambda([this](bool bSuccess, const FString& LobbyId, const FString& ErrorMessage)
+	{
+		EventSequencer.ResyncFinished(bSuccess);
+	}));
 }
 
 EDriftLobbyStatus FDriftLobbyManager::ParseStatus(const FString& Status)
@@ -1002,118 +998,62 @@ void FDriftLobbyManager::CacheLobby(const FDriftLobbyResponse& LobbyResponse, bo
 		CurrentLobbyMemberURL = LobbyResponse.LobbyMemberURL;
 	}
 
-	bool bAllTeamMembersReady = true;
-	TSharedPtr<FDriftLobbyMember> LocalMember;
-	TArray<TSharedPtr<FDriftLobbyMember>> Members;
-	for (const auto& ResponseMember : LobbyResponse.Members)
-	{
-		const auto Member = MakeShared<FDriftLobbyMember>(
-			ResponseMember.PlayerId,
-			ResponseMember.PlayerName,
-			ResponseMember.TeamName,
-			ResponseMember.bReady,
-			ResponseMember.bHost,
-			ResponseMember.PlayerId == PlayerId,
-			ResponseMember.LobbyMemberURL
-		);
-
-		if (Member->bLocalPlayer)
-		{
-			LocalMember = Member;
-		}
+	LobbyState.ApplySnapshot(LobbyResponse, ParseStatus(LobbyResponse.LobbyStatus), PendingMemberChanges);
+	EventSequencer.SnapshotApplied(LobbyResponse.LobbyId, LobbyResponse.Revision);
 
-		if (!Member->bReady && Member->TeamName.IsSet() && !Member->TeamName->IsEmpty())
-		{
-			bAllTeamMembersReady = false;
-		}
-
-		Members.Emplace(Member);
-	}
-
-	CurrentLobby = MakeShared<FDriftLobby>(
-		CurrentLobbyId,
-		LobbyResponse.LobbyName,
-		LobbyResponse.MapName,
-		LobbyResponse.TeamNames,
-		LobbyResponse.TeamCapacity,
-		ParseStatus(LobbyResponse.LobbyStatus),
-		MoveTemp(Members),
-		LocalMember,
-		bAllTeamMembersReady,
-		LobbyResponse.CustomData,
-		LobbyResponse.LobbyURL,
-		LobbyResponse.LobbyMembersURL,
-		LobbyResponse.LobbyMemberURL,
-		LobbyResponse.LobbyMatchPlacementURL
-	);
-
-	if (!LobbyResponse.ConnectionString.IsEmpty())
-	{
-		CurrentLobby->ConnectionString = LobbyResponse.ConnectionString;
-		CurrentLobby->ConnectionOptions = LobbyResponse.ConnectionOptions.IsEmpty() ? "SpectatorOnly=1" : LobbyResponse.ConnectionOptions;
+	if (const auto Session = SocialSession.Pin())
+	{
+		Session->LobbySnapshot(true, CurrentLobby()->LobbyStatus);
 	}
 
 	UpdateCurrentPlayerProperties();
 
 	UE_LOG(LogDriftLobby, Log, TEXT("Current lobby updated: '%s'"), *CurrentLobbyId);
 	OnLobbyUpdatedDelegate.Broadcast(CurrentLobbyId);
+	BroadcastMemberChanges();
 }
 
-bool FDriftLobbyManager::CacheMembers(const JsonValue& EventData)
+bool FDriftLobbyManager::CacheMembers(const FDriftLobbyEventData& EventData)
 {
-	if (!CurrentLobby)
+	if (!CurrentLobby().IsValid())
 	{
-		UE_LOG(LogDriftLobby, Error, TEXT("Cannot cache members when no local lobby is present. EventData:\n'%s'"), *EventData.ToString());
+		UE_LOG(LogDriftLobby, Error, TEXT("Cannot cache members when no local lobby is present. Members:\n'%s'"), *EventData.members.ToString());
 		return false;
 	}
 
-	bool bAllTeamMembersReady = true;
-	TSharedPtr<FDriftLobbyMember> LocalMember;
-	TArray<TSharedPtr<FDriftLobbyMember>> Members;
-	for (const auto& Elem : EventData.FindField("members").GetArray())
+	if (!LobbyState.ApplyMembers(EventData.members, PendingMemberChanges))
 	{
-		FDriftLobbyResponseMember LobbyResponseMember{};
-		if (!LobbyResponseMember.FromJson(Elem.ToString()))
-		{
-			UE_LOG(LogDriftLobby, Error, TEXT("FDriftLobbyManager::CacheMembers - Failed to serialize member data. EventData:\n'%s'"), *EventData.ToString());
-			return false;
-		}
-
-		const auto Member = MakeShared<FDriftLobbyMember>(
-			LobbyResponseMember.PlayerId,
-			LobbyResponseMember.PlayerName,
-			LobbyResponseMember.TeamName,
-			LobbyResponseMember.bReady,
-			LobbyResponseMember.bHost,
-			LobbyResponseMember.PlayerId == PlayerId,
-			LobbyResponseMember.LobbyMemberURL
-		);
-
-		if (!LobbyResponseMember.bReady && !LobbyResponseMember.TeamName.IsEmpty())
-		{
-			bAllTeamMembersReady = false;
-		}
-
-		if (Member->bLocalPlayer)
-		{
-			LocalMember = Member;
-		}
-
-		Members.Emplace(Member);
+		UE_LOG(LogDriftLobby, Error, TEXT("FDriftLobbyManager::CacheMembers - Failed to serialize member data. Members:\n'%s'"), *EventData.members.ToString());
+		return false;
 	}
 
-	CurrentLobby->Members = MoveTemp(Members);
-	CurrentLobby->bAllTeamMembersReady = bAllTeamMembersReady;
-	CurrentLobby->LocalPlayerMember = LocalMember;
-
 	UpdateCurrentPlayerProperties();
+	BroadcastMemberChanges();
 
 	return true;
 }
 
+void FDriftLobbyManager::BroadcastMemberChanges()
+{
+	// Listeners may cause more changes, which go out in their own round
+	auto Changes = MoveTemp(PendingMemberChanges);
+	PendingMemberChanges.Reset();
+
+	for (const auto& Change : Changes)
+	{
+		OnLobbyMemberChangedDelegate.Broadcast(CurrentLobbyId, Change.PlayerId, Change.Change);
+	}
+}
+
 void FDriftLobbyManager::ResetCurrentLobby()
 {
-	CurrentLobby.Reset();
+	LobbyState.Reset();
+	EventSequencer.Reset();
+
+	if (const auto Session = SocialSession.Pin())
+	{
+		Session->LobbySnapshot(false, EDriftLobbyStatus::Unknown);
+	}
 	CurrentLobbyId.Empty();
 	CurrentLobbyURL.Empty();
 	CurrentLobbyMembersURL.Empty();
@@ -1127,72 +1067,72 @@ void FDriftLobbyManager::ResetCurrentLobby()
 
 bool FDriftLobbyManager::IsCurrentLobbyHost() const
 {
-	if (!CurrentLobby.IsValid())
+	if (!CurrentLobby().IsValid())
 	{
 		UE_LOG(LogDriftLobby, Error, TEXT("FDriftLobbyManager::IsCurrentLobbyHost - No locally cached lobby"));
 		return false;
 	}
 
-	if (!CurrentLobby->LocalPlayerMember.IsValid())
+	if (!CurrentLobby()->LocalPlayerMember.IsValid())
 	{
 		UE_LOG(LogDriftLobby, Error, TEXT("FDriftLobbyManager::IsCurrentLobbyHost - Player isn't a member of the locally cached lobby"));
 		return false;
 	}
 
-	UE_LOG(LogDriftLobby, Verbose, TEXT("FDriftLobbyManager::IsCurrentLobbyHost - Local player is host: '%s'"), CurrentLobby->LocalPlayerMember->bHost ? TEXT("Yes") : TEXT("No"));
+	UE_LOG(LogDriftLobby, Verbose, TEXT("FDriftLobbyManager::IsCurrentLobbyHost - Local player is host: '%s'"), CurrentLobby()->LocalPlayerMember->bHost ? TEXT("Yes") : TEXT("No"));
 
-	return CurrentLobby->LocalPlayerMember->bHost;
+	return CurrentLobby()->LocalPlayerMember->bHost;
 }
 
 bool FDriftLobbyManager::UpdateCurrentPlayerProperties()
 {
-	if (!CurrentLobby.IsValid())
+	if (!CurrentLobby().IsValid())
 	{
 		return false;
 	}
 
-	if (!CurrentLobby->LocalPlayerMember.IsValid())
+	if (!CurrentLobby()->LocalPlayerMember.IsValid())
 	{
 		UE_LOG(LogDriftLobby, Error, TEXT("Failed to apply current player properties. Player member pointer is invalid"));
 		return false;
 	}
 
-	CurrentPlayerProperties.TeamName = CurrentLobby->LocalPlayerMember->TeamName;
-	CurrentPlayerProperties.bReady = CurrentLobby->LocalPlayerMember->bReady;
+	CurrentPlayerProperties.TeamName = CurrentLobby()->LocalPlayerMember->TeamName;
+	CurrentPlayerProperties.bReady = CurrentLobby()->LocalPlayerMember->bReady;
 
 	return true;
 }
 
 bool FDriftLobbyManager::ApplyLobbyProperties(const FDriftLobbyProperties& LobbyProperties)
 {
-	if (!CurrentLobby.IsValid())
+	if (!CurrentLobby().IsValid())
 	{
 		return false;
 	}
 
 	if (LobbyProperties.LobbyName.IsSet())
 	{
-		CurrentLobby->LobbyName = LobbyProperties.LobbyName.GetValue();
+		CurrentLobby()->LobbyName = LobbyProperties.LobbyName.GetValue();
 	}
 
 	if (LobbyProperties.MapName.IsSet())
 	{
-		CurrentLobby->MapName = LobbyProperties.MapName.GetValue();
+		CurrentLobby()->MapName = LobbyProperties.MapName.GetValue();
 	}
 
 	if (LobbyProperties.TeamNames.IsSet())
 	{
-		CurrentLobby->TeamNames = LobbyProperties.TeamNames.GetValue();
+		CurrentLobby()->TeamNames = LobbyProperties.TeamNames.GetValue();
 	}
 
 	if (LobbyProperties.TeamCapacity.IsSet())
 	{
-		CurrentLobby->TeamCapacity = LobbyProperties.TeamCapacity.GetValue();
+		CurrentLobby()->TeamCapacity = LobbyProperties.TeamCapacity.GetValue();
 	}
 
 	if (LobbyProperties.CustomData.IsSet())
 	{
-		CurrentLobby->CustomData = LobbyProperties.CustomData.GetValue();
+		CurrentLobby()->CustomData = LobbyProperties.CustomData.GetValue();
 	}
 
 	return true;
@@ -1200,32 +1140,18 @@ bool FDriftLobbyManager::ApplyLobbyProperties(const FDriftLobbyProperties& Lobby
 
 bool FDriftLobbyManager::ApplyPlayerProperties(const FDriftLobbyMemberProperties& PlayerProperties)
 {
-	if (!CurrentLobby.IsValid())
+	if (!CurrentLobby().IsValid())
 	{
 		return false;
 	}
 
-	if (!CurrentLobby->LocalPlayerMember.IsValid())
+	if (!LobbyState.UpdateLocalMember(PlayerProperties, PendingMemberChanges))
 	{
 		UE_LOG(LogDriftLobby, Error, TEXT("Failed to apply player properties. Player member pointer is invalid"));
 		return false;
 	}
 
-	if (PlayerProperties.TeamName.IsSet())
-	{
-		CurrentLobby->LocalPlayerMember->TeamName = PlayerProperties.TeamName.GetValue();
-	}
-
-	if (PlayerProperties.bReady.IsSet())
-	{
-		CurrentLobby->LocalPlayerMember->bReady = PlayerProperties.bReady.GetValue();
-	}
-
-	// Local player isn't ready and in a team
-	if (!CurrentLobby->LocalPlayerMember->bReady && !CurrentLobby->LocalPlayerMember->TeamName.Get("").IsEmpty())
-	{
-		CurrentLobby->bAllTeamMembersReady = false;
-	}
+	BroadcastMemberChanges();
 
 	return true;
 }
@@ -0,0 +1,265 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftLobbyState.h"
+
+
+void FDriftLobbyState::ApplySnapshot(const FDriftLobbyResponse& Response, EDriftLobbyStatus Status, TArray<FDriftLobbyMemberChange>& OutChanges)
+{
+	if (!Lobby.IsValid() || Lobby->LobbyId != Response.LobbyId)
+	{
+		Reset();
+		Lobby = MakeShared<FDriftLobby>(
+			Response.LobbyId,
+			Response.LobbyName,
+			Response.MapName,
+			Response.TeamNames,
+			Response.TeamCapacity,
+			Status,
+			TArray<TSharedPtr<FDriftLobbyMember>>{},
+			nullptr,
+			true,
+			Response.CustomData,
+			Response.LobbyURL,
+			Response.LobbyMembersURL,
+			Response.LobbyMemberURL,
+			Response.LobbyMatchPlacementURL
+		);
+	}
+	else
+	{
+		Lobby->LobbyName = Response.LobbyName;
+		Lobby->MapName = Response.MapName;
+		Lobby->TeamNames = Response.TeamNames;
+		Lobby->TeamCapacity = Response.TeamCapacity;
+		Lobby->LobbyStatus = Status;
+		Lobby->CustomData = Response.CustomData;
+		Lobby->LobbyURL = Response.LobbyURL;
+		Lobby->LobbyMembersURL = Response.LobbyMembersURL;
+		Lobby->LobbyMemberURL = Response.LobbyMemberURL;
+		Lobby->LobbyMatchPlacementURL = Response.LobbyMatchPlacementURL;
+	}
+
+	if (!Response.ConnectionString.IsEmpty())
+	{
+		Lobby->ConnectionString = Response.ConnectionString;
+		Lobby->ConnectionOptions = Response.ConnectionOptions.IsEmpty() ? "SpectatorOnly=1" : Response.ConnectionOptions;
+	}
+
+	ApplyMemberList(Response.Members, OutChanges);
+}
+
+bool FDriftLobbyState::ApplyMembers(const JsonValue& MembersData, TArray<FDriftLobbyMemberChange>& OutChanges)
+{
+	if (!Lobby.IsValid() || !MembersData.IsArray())
+	{
+		return false;
+	}
+
+	// Read everything before touching the lobby, so a malformed event leaves it as it was
+	const auto Elements = MembersData.GetArray();
+	ScratchMembers.Reset(Elements.Num());
+	for (const auto& Element : Elements)
+	{
+		if (!ReadMember(Element, ScratchMembers.AddDefaulted_GetRef()))
+		{
+			return false;
+		}
+	}
+
+	ApplyMemberList(ScratchMembers, OutChanges);
+	return true;
+}
+
+bool FDriftLobbyState::RemoveMember(int32 PlayerId, TArray<FDriftLobbyMemberChange>& OutChanges)
+{
+	if (!Lobby.IsValid())
+	{
+		return false;
+	}
+
+	const auto Index = Lobby->Members.IndexOfByPredicate([PlayerId](const TSharedPtr<FDriftLobbyMember>& Member)
+	{
+		return Member->PlayerId == PlayerId;
+	});
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	RemoveMemberAt(Index, OutChanges);
+	UpdateAllTeamMembersReady();
+	return true;
+}
+
+bool FDriftLobbyState::UpdateLocalMember(const FDriftLobbyMemberProperties& Properties, TArray<FDriftLobbyMemberChange>& OutChanges)
+{
+	if (!Lobby.IsValid() || !Lobby->LocalPlayerMember.IsValid())
+	{
+		return false;
+	}
+
+	auto& Member = *Lobby->LocalPlayerMember;
+	UpdateMember(
+		Member,
+		Member.PlayerName,
+		Properties.TeamName.IsSet() ? Properties.TeamName : Member.TeamName,
+		Properties.bReady.Get(Member.bReady),
+		Member.bHost,
+		Member.LobbyMemberURL,
+		OutChanges
+	);
+	UpdateAllTeamMembersReady();
+	return true;
+}
+
+void FDriftLobbyState::Reset()
+{
+	Lobby.Reset();
+	MembersById.Reset();
+	NumUnreadyTeamMembers = 0;
+}
+
+void FDriftLobbyState::ApplyMemberList(TArrayView<const FDriftLobbyResponseMember> Members, TArray<FDriftLobbyMemberChange>& OutChanges)
+{
+	TSet<int32, DefaultKeyFuncs<int32>, TInlineSetAllocator<64>> PresentPlayerIds;
+	for (const auto& ResponseMember : Members)
+	{
+		PresentPlayerIds.Add(ResponseMember.PlayerId);
+	}
+
+	for (int32 Index = Lobby->Members.Num() - 1; Index >= 0; --Index)
+	{
+		if (!PresentPlayerIds.Contains(Lobby->Members[Index]->PlayerId))
+		{
+			RemoveMemberAt(Index, OutChanges);
+		}
+	}
+
+	for (const auto& ResponseMember : Members)
+	{
+		if (const auto Existing = MembersById.Find(ResponseMember.PlayerId))
+		{
+			UpdateMember(**Existing, ResponseMember.PlayerName, ResponseMember.TeamName, ResponseMember.bReady, ResponseMember.bHost,
+				ResponseMember.LobbyMemberURL, OutChanges);
+		}
+		else
+		{
+			AddMember(ResponseMember, OutChanges);
+		}
+	}
+
+	UpdateAllTeamMembersReady();
+}
+
+void FDriftLobbyState::AddMember(const FDriftLobbyResponseMember& ResponseMember, TArray<FDriftLobbyMemberChange>& OutChanges)
+{
+	const auto Member = MakeShared<FDriftLobbyMember>(
+		ResponseMember.PlayerId,
+		ResponseMember.PlayerName,
+		ResponseMember.TeamName,
+		ResponseMember.bReady,
+		ResponseMember.bHost,
+		ResponseMember.PlayerId == LocalPlayerId,
+		ResponseMember.LobbyMemberURL
+	);
+
+	if (Member->bLocalPlayer)
+	{
+		Lobby->LocalPlayerMember = Member;
+	}
+
+	if (IsUnreadyTeamMember(*Member))
+	{
+		++NumUnreadyTeamMembers;
+	}
+
+	Lobby->Members.Add(Member);
+	MembersById.Add(Member->PlayerId, Member);
+	OutChanges.Add({ Member->PlayerId, EDriftLobbyMemberChange::Joined });
+}
+
+void FDriftLobbyState::UpdateMember(FDriftLobbyMember& Member, const FString& PlayerName, const TOptional<FString>& TeamName, bool bReady, bool bHost,
+	const FString& LobbyMemberURL, TArray<FDriftLobbyMemberChange>& OutChanges)
+{
+	const auto bWasUnreadyTeamMember = IsUnreadyTeamMember(Member);
+
+	if (Member.TeamName != TeamName)
+	{
+		Member.TeamName = TeamName;
+		OutChanges.Add({ Member.PlayerId, EDriftLobbyMemberChange::TeamChanged });
+	}
+
+	if (Member.bReady != bReady)
+	{
+		Member.bReady = bReady;
+		OutChanges.Add({ Member.PlayerId, EDriftLobbyMemberChange::ReadyChanged });
+	}
+
+	if (Member.bHost != bHost)
+	{
+		Member.bHost = bHost;
+		OutChanges.Add({ Member.PlayerId, EDriftLobbyMemberChange::HostChanged });
+	}
+
+	// Not something anyone is notified about
+	Member.PlayerName = PlayerName;
+	Member.LobbyMemberURL = LobbyMemberURL;
+
+	NumUnreadyTeamMembers += static_cast<int32>(IsUnreadyTeamMember(Member)) - static_cast<int32>(bWasUnreadyTeamMember);
+}
+
+void FDriftLobbyState::RemoveMemberAt(int32 Index, TArray<FDriftLobbyMemberChange>& OutChanges)
+{
+	const auto Member = Lobby->Members[Index];
+
+	if (IsUnreadyTeamMember(*Member))
+	{
+		--NumUnreadyTeamMembers;
+	}
+
+	if (Lobby->LocalPlayerMember == Member)
+	{
+		Lobby->LocalPlayerMember.Reset();
+	}
+
+	Lobby->Members.RemoveAt(Index);
+	MembersById.Remove(Member->PlayerId);
+	OutChanges.Add({ Member->PlayerId, EDriftLobbyMemberChange::Left });
+}
+
+void FDriftLobbyState::UpdateAllTeamMembersReady()
+{
+	Lobby->bAllTeamMembersReady = NumUnreadyTeamMembers == 0;
+}
+
+bool FDriftLobbyState::ReadMember(const JsonValue& Data, FDriftLobbyResponseMember& OutMember)
+{
+	if (!Data.IsObject() || !Data.HasField(TEXT("player_id")))
+	{
+		return false;
+	}
+
+	const auto ReadString = [&Data](const TCHAR* Name)
+	{
+		const auto Field = Data.FindField(Name);
+		return Field.IsString() ? Field.GetString() : FString{};
+	};
+	const auto ReadBool = [&Data](const TCHAR* Name)
+	{
+		const auto Field = Data.FindField(Name);
+		return Field.IsBool() && Field.GetBool();
+	};
+
+	OutMember.PlayerId = Data.FindField(TEXT("player_id")).GetInt32();
+	OutMember.PlayerName = ReadString(TEXT("player_name"));
+	OutMember.TeamName = ReadString(TEXT("team_name"));
+	OutMember.bReady = ReadBool(TEXT("ready"));
+	OutMember.bHost = ReadBool(TEXT("host"));
+	OutMember.LobbyMemberURL = ReadString(TEXT("lobby_member_url"));
+	return true;
+}
+
+bool FDriftLobbyState::IsUnreadyTeamMember(const FDriftLobbyMember& Member)
+{
+	return !Member.bReady && Member.TeamName.IsSet() && !Member.TeamName->IsEmpty();
+}
@@ -0,0 +1,233 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#pragma once
+
+#include "IDriftLobbyManager.h"
+#include "JsonArchive.h"
+
+#include "Serialization/JsonSerializerMacros.h"
+
+struct FDriftLobbyMember : IDriftLobbyMember
+{
+	FDriftLobbyMember(
+		int32 InPlayerId,
+		FString InPlayerName,
+		TOptional<FString> InTeamName,
+		bool bInReady,
+		bool bInHost,
+		bool bInLocalPlayer,
+		FString InLobbyMemberURL)
+		:
+		PlayerId{ InPlayerId },
+		PlayerName{ InPlayerName },
+		TeamName{ InTeamName },
+		bReady{ bInReady },
+		bHost{ bInHost },
+		bLocalPlayer{ bInLocalPlayer },
+		LobbyMemberURL { InLobbyMemberURL }
+	{ }
+
+	int32 GetPlayerId() const override { return PlayerId; }
+	FString GetPlayerName() const override { return PlayerName; }
+	TOptional<FString> GetTeamName() const override { return TeamName; }
+	bool IsReady() const override { return bReady; }
+	bool IsHost() const override { return bHost; }
+	bool IsLocalPlayer() const override { return bLocalPlayer; }
+
+	int32 PlayerId = 0;
+	FString PlayerName = "";
+	TOptional<FString> TeamName;
+	bool bReady = false;
+	bool bHost = false;
+	bool bLocalPlayer = false;
+
+	FString LobbyMemberURL = "";
+};
+
+struct FDriftLobby : IDriftLobby
+{
+	FDriftLobby(
+		FString InLobbyId,
+		FString InLobbyName,
+		FString InMapName,
+		TArray<FString> InTeamNames,
+		int32 InTeamCapacity,
+		EDriftLobbyStatus InLobbyStatus,
+		TArray<TSharedPtr<FDriftLobbyMember>> Members,
+		TSharedPtr<FDriftLobbyMember> InLocalPlayerMember,
+		bool bInAllTeamMembersReady,
+		FString InCustomData,
+		FString InLobbyURL,
+		FString InLobbyMembersURL,
+		FString InLobbyMemberURL,
+		FString InLobbyMatchPlacementURL)
+		:
+		LobbyId{ InLobbyId },
+		LobbyName{ InLobbyName },
+		MapName{ InMapName },
+		TeamNames{ InTeamNames },
+		TeamCapacity{ InTeamCapacity },
+		LobbyStatus{ InLobbyStatus },
+		Members{ MoveTemp(Members) },
+		LocalPlayerMember{ InLocalPlayerMember },
+		bAllTeamMembersReady { bInAllTeamMembersReady },
+		CustomData { InCustomData },
+		LobbyURL{ InLobbyURL },
+		LobbyMembersURL{ InLobbyMembersURL },
+		LobbyMemberURL{ InLobbyMemberURL },
+		LobbyMatchPlacementURL{ InLobbyMatchPlacementURL }
+	{ }
+
+	FString GetLobbyId() const override { return LobbyId; }
+	FString GetLobbyName() const override { return LobbyName; }
+	FString GetMapName() const override { return MapName; }
+	TArray<FString> GetTeamNames() const override { return TeamNames; }
+	int32 GetTeamCapacity() const override { return TeamCapacity; }
+	EDriftLobbyStatus GetLobbyStatus() const override { return LobbyStatus; }
+	TArray<TSharedPtr<IDriftLobbyMember>> GetMembers() const override { return static_cast<TArray<TSharedPtr<IDriftLobbyMember>>>(Members); }
+	TSharedPtr<IDriftLobbyMember> GetLocalPlayerMember() const override { return LocalPlayerMember; }
+	bool AreAllTeamMembersReady() const override { return bAllTeamMembersReady; }
+	FString GetConnectionString() const override { return ConnectionString; }
+	FString GetConnectionOptions() const override { return ConnectionOptions; }
+	FString GetCustomData() const override { return CustomData; }
+
+	FString LobbyId = "";
+	FString LobbyName = "";
+	FString MapName = "";
+	TArray<FString> TeamNames;
+	int32 TeamCapacity = 0;
+	EDriftLobbyStatus LobbyStatus = EDriftLobbyStatus::Unknown;
+	TArray<TSharedPtr<FDriftLobbyMember>> Members;
+	TSharedPtr<FDriftLobbyMember> LocalPlayerMember;
+	bool bAllTeamMembersReady = false;
+	FString CustomData = "";
+
+	FString LobbyURL = "";
+	FString LobbyMembersURL = "";
+	FString LobbyMemberURL = "";
+	FString LobbyMatchPlacementURL = "";
+
+	FString ConnectionString = "";
+	FString ConnectionOptions = "";
+};
+
+struct FDriftLobbyResponseMember : FJsonSerializable
+{
+	BEGIN_JSON_SERIALIZER;
+	JSON_SERIALIZE("player_id", PlayerId);
+	JSON_SERIALIZE("player_name", PlayerName);
+	JSON_SERIALIZE("team_name", TeamName);
+	JSON_SERIALIZE("ready", bReady);
+	JSON_SERIALIZE("host", bHost);
+	JSON_SERIALIZE("lobby_member_url", LobbyMemberURL);
+	JSON_SERIALIZE("join_date", JoinDate);
+	END_JSON_SERIALIZER;
+
+	int32 PlayerId = 0;
+	FString PlayerName = "";
+	FString TeamName = "";
+	bool bReady = false;
+	bool bHost = false;
+	FString LobbyMemberURL = "";
+	FDateTime JoinDate;
+};
+
+struct FDriftLobbyResponse : FJsonSerializable
+{
+	BEGIN_JSON_SERIALIZER;
+	JSON_SERIALIZE("lobby_id", LobbyId);
+	JSON_SERIALIZE("lobby_name", LobbyName);
+	JSON_SERIALIZE("map_name", MapName);
+	JSON_SERIALIZE_ARRAY("team_names", TeamNames);
+	JSON_SERIALIZE("team_capacity", TeamCapacity);
+	JSON_SERIALIZE("status", LobbyStatus);
+	JSON_SERIALIZE_ARRAY_SERIALIZABLE("members", Members, FDriftLobbyResponseMember);
+	JSON_SERIALIZE("custom_data", CustomData);
+	JSON_SERIALIZE("create_date", CreateDate);
+	JSON_SERIALIZE("start_date", StartDate);
+	JSON_SERIALIZE("connection_string", ConnectionString);
+	JSON_SERIALIZE("connection_options", ConnectionOptions);
+	JSON_SERIALIZE("lobby_url", LobbyURL);
+	JSON_SERIALIZE("lobby_members_url", LobbyMembersURL);
+	JSON_SERIALIZE("lobby_member_url", LobbyMemberURL);
+	JSON_SERIALIZE("lobby_match_placement_url", LobbyMatchPlacementURL);
+	JSON_SERIALIZE("revision", Revision);
+	END_JSON_SERIALIZER;
+
+	FString LobbyId = "";
+	FString LobbyName = "";
+	FString MapName = "";
+	TArray<FString> TeamNames;
+	int32 TeamCapacity = 0;
+	FString LobbyStatus = "";
+	TArray<FDriftLobbyResponseMember> Members;
+	FString CustomData = "";
+
+	FString ConnectionString = "";
+	FString ConnectionOptions = "";
+
+	FDateTime CreateDate;
+	FDateTime StartDate;
+
+	FString LobbyURL = "";
+	FString LobbyMembersURL = "";
+	FString LobbyMemberURL = "";
+	FString LobbyMatchPlacementURL = "";
+
+	/* Bumped by the server on every change to the lobby, INDEX_NONE if it doesn't track revisions */
+	int64 Revision = INDEX_NONE;
+};
+
+struct FDriftLobbyMemberChange
+{
+	int32 PlayerId = INDEX_NONE;
+	EDriftLobbyMemberChange Change = EDriftLobbyMemberChange::Joined;
+};
+
+/**
+ * The locally cached lobby, patched in place as lobby events come in.
+ *
+ * Member objects stay the same for as long as the player is in the lobby, so anyone holding on
+ * to one sees it update. Each patch reports what actually changed for each member, and whether
+ * all team members are ready is kept up to date from a running count rather than recomputed.
+ */
+class FDriftLobbyState
+{
+public:
+	void SetLocalPlayerId(int32 InLocalPlayerId) { LocalPlayerId = InLocalPlayerId; }
+
+	const TSharedPtr<FDriftLobby>& GetLobby() const { return Lobby; }
+
+	/* Take the whole lobby from a response. Members still in the lobby keep their objects if it's the same lobby */
+	void ApplySnapshot(const FDriftLobbyResponse& Response, EDriftLobbyStatus Status, TArray<FDriftLobbyMemberChange>& OutChanges);
+
+	/* Apply the member list of a member event, read straight from the event data */
+	bool ApplyMembers(const JsonValue& MembersData, TArray<FDriftLobbyMemberChange>& OutChanges);
+
+	/* Remove a member ahead of the server confirming it */
+	bool RemoveMember(int32 PlayerId, TArray<FDriftLobbyMemberChange>& OutChanges);
+
+	/* Update the local player ahead of the server confirming it */
+	bool UpdateLocalMember(const FDriftLobbyMemberProperties& Properties, TArray<FDriftLobbyMemberChange>& OutChanges);
+
+	void Reset();
+
+private:
+	void ApplyMemberList(TArrayView<const FDriftLobbyResponseMember> Members, TArray<FDriftLobbyMemberChange>& OutChanges);
+	void AddMember(const FDriftLobbyResponseMember& ResponseMember, TArray<FDriftLobbyMemberChange>& OutChanges);
+	void UpdateMember(FDriftLobbyMember& Member, const FString& PlayerName, const TOptional<FString>& TeamName, bool bReady, bool bHost,
+		const FString& LobbyMemberURL, TArray<FDriftLobbyMemberChange>& OutChanges);
+	void RemoveMemberAt(int32 Index, TArray<FDriftLobbyMemberChange>& OutChanges);
+	void UpdateAllTeamMembersReady();
+
+	static bool ReadMember(const JsonValue& Data, FDriftLobbyResponseMember& OutMember);
+	static bool IsUnreadyTeamMember(const FDriftLobbyMember& Member);
+
+	TSharedPtr<FDriftLobby> Lobby;
+	TMap<int32, TSharedPtr<FDriftLobbyMember>> MembersById;
+	int32 NumUnreadyTeamMembers = 0;
+	int32 LocalPlayerId = INDEX_NONE;
+
+	/* Reused between events to avoid allocating for every member list */
+	TArray<FDriftLobbyResponseMember> ScratchMembers;
+};
@@ -0,0 +1,126 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftLongPollMessageTransport.h"
+
+#include "DriftAPI.h"
+#include "DriftMessageQueue.h"
+#include "Details/UrlHelper.h"
+#include "JsonArchive.h"
+#include "JsonRequestManager.h"
+
+
+const float DEFAULT_FETCH_THROTTLE_DELAY_SECONDS = 5.0f;
+const float MESSAGE_FETCH_TIMEOUT_SECONDS = 20.0f;
+
+
+FDriftLongPollMessageTransport::FDriftLongPollMessageTransport(TWeakPtr<JsonRequestManager> requestManager)
+    : requestManager{ requestManager }
+{
+}
+
+
+FDriftLongPollMessageTransport::~FDriftLongPollMessageTransport()
+{
+    Stop();
+}
+
+
+void FDriftLongPollMessageTransport::Start(const FString& newMessageQueueUrl, int32 newLastMessageNumber)
+{
+    messageQueueUrl = newMessageQueueUrl;
+    lastMessageNumber = newLastMessageNumber;
+    fetchDelay = 0.0f;
+}
+
+
+void FDriftLongPollMessageTransport::Stop()
+{
+    auto pendingPoll = currentPoll.Pin();
+    if (pendingPoll.IsValid())
+    {
+        pendingPoll->Destroy();
+    }
+    currentPoll.Reset();
+    messageQueueUrl.Empty();
+}
+
+
+void FDriftLongPollMessageTransport::SetCursor(int32 newLastMessageNumber)
+{
+    lastMessageNumber = newLastMessageNumber;
+}
+
+
+void FDriftLongPollMessageTransport::Tick(float deltaTime)
+{
+    if (messageQueueUrl.IsEmpty() || !requestManager.IsValid())
+    {
+        return;
+    }
+
+    if (fetchDelay > 0.0f)
+    {
+        fetchDelay -= deltaTime;
+        return;
+    }
+
+    if (!currentPoll.IsValid())
+    {
+        GetMessages();
+    }
+}
+
+
+void FDriftLongPollMessageTransport::GetMessages()
+{
+    auto rm = requestManager.Pin();
+    if (!rm.IsValid())
+    {
+        return;
+    }
+
+    UE_LOG(LogDriftMessages, Verbose, TEXT("Polling message queue..."));
+
+    auto url = messageQueueUrl;
+    internal::UrlHelper::AddUrlOption(url, TEXT("messages_after"), lastMessageNumber);
+    internal::UrlHelper::AddUrlOption(url, TEXT("timeout"), MESSAGE_FETCH_TIMEOUT_SECONDS);
+    auto request = rm->Get(url);
+    currentPoll = request;
+    request->OnResponse.BindLambda([this](ResponseContext& context, JsonDocument& doc)
+    {
+        UE_LOG(LogDriftMessages, VeryVerbose, TEXT("Message queue response: %s"), *JsonArchive::ToString(doc));
+
+        currentPoll.Reset();
+
+        FDriftMessageQueueBatch messages;
+        if (!ParseMessages(doc, messages))
+        {
+            context.error = TEXT("Failed to parse message queue response");
+            fetchDelay = DEFAULT_FETCH_THROTTLE_DELAY_SECONDS;
+            return;
+        }
+
+        if (messages.Num() == 0 && (FDateTime::UtcNow() - context.sent).GetTotalSeconds() < MESSAGE_FETCH_TIMEOUT_SECONDS)
+        {
+            /**
+             * Got an empty reply which was not a timeout; something might be off
+             * make sure we throttle the polling frequency for a while
+             */
+            fetchDelay = DEFAULT_FETCH_THROTTLE_DELAY_SECONDS;
+        }
+        else
+        {
+            // Getting proper data again, drop throttle
+            fetchDelay = 0.0f;
+        }
+
+        OnMessages.ExecuteIfBound(messages);
+    });
+    request->OnError.BindLambda([this](ResponseContext& context)
+    {
+        currentPoll.Reset();
+        fetchDelay = DEFAULT_FETCH_THROTTLE_DELAY_SECONDS;
+        context.errorHandled = true;
+    });
+    request->Dispatch();
+}
@@ -0,0 +1,39 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#pragma once
+
+#include "DriftMessageTransport.h"
+
+
+class HttpRequest;
+class JsonRequestManager;
+
+
+/**
+ * Fetches messages by repeatedly asking for anything newer than the last message,
+ * with the backend holding each request open until there is something to return.
+ */
+class FDriftLongPollMessageTransport : public IDriftMessageTransport
+{
+public:
+    explicit FDriftLongPollMessageTransport(TWeakPtr<JsonRequestManager> requestManager);
+    ~FDriftLongPollMessageTransport();
+
+    FString GetName() const override { return TEXT("longpoll"); }
+    void Start(const FString& messageQueueUrl, int32 lastMessageNumber) override;
+    void Stop() override;
+    void SetCursor(int32 lastMessageNumber) override;
+    void Tick(float deltaTime) override;
+
+private:
+    void GetMessages();
+
+    TWeakPtr<JsonRequestManager> requestManager;
+    FString messageQueueUrl;
+
+    TWeakPtr<HttpRequest> currentPoll;
+
+    int32 lastMessageNumber = 0;
+
+    float fetchDelay = 0.0f;
+};
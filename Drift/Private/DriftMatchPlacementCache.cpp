@@ -0,0 +1,169 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftMatchPlacementCache.h"
+
+#include "DriftMatchPlacementManager.h"
+#include "JsonArchive.h"
+
+
+bool FDriftPublicMatchPlacementResponse::Serialize(SerializationContext& Context)
+{
+	return SERIALIZE_PROPERTY(Context, placement_id)
+		&& SERIALIZE_PROPERTY(Context, status)
+		&& SERIALIZE_OPTIONAL_PROPERTY(Context, player_id)
+		&& SERIALIZE_OPTIONAL_PROPERTY(Context, custom_data)
+		&& SERIALIZE_OPTIONAL_PROPERTY(Context, map_name)
+		&& SERIALIZE_OPTIONAL_PROPERTY(Context, max_players)
+		&& SERIALIZE_OPTIONAL_PROPERTY(Context, match_placement_url)
+		&& SERIALIZE_OPTIONAL_PROPERTY(Context, player_ids);
+}
+
+
+bool FDriftPublicMatchPlacementsPage::Serialize(SerializationContext& Context)
+{
+	return SERIALIZE_PROPERTY(Context, placements)
+		&& SERIALIZE_OPTIONAL_PROPERTY(Context, next_cursor);
+}
+
+
+TSharedPtr<FDriftMatchPlacement> FDriftMatchPlacementCache::FindPlacement(const FString& MatchPlacementId) const
+{
+	const auto Cached = PlacementsById.Find(MatchPlacementId);
+	return Cached ? Cached->Placement : nullptr;
+}
+
+
+void FDriftMatchPlacementCache::BeginRefresh()
+{
+	++RefreshId;
+}
+
+
+void FDriftMatchPlacementCache::ApplyPage(TArrayView<const FDriftPublicMatchPlacementResponse> Page, const FDateTime& Now, TArray<FDriftPublicMatchPlacementChange>& OutChanges)
+{
+	TArray<FString, TInlineAllocator<8>> Unlisted;
+
+	for (const auto& Response : Page)
+	{
+		// Only fulfilled placements can be joined
+		const auto Status = FDriftMatchPlacementManager::ParseStatus(Response.status);
+		if (Status != EDriftMatchPlacementStatus::Fulfilled)
+		{
+			if (PlacementsById.Contains(Response.placement_id))
+			{
+				Unlisted.Add(Response.placement_id);
+			}
+			continue;
+		}
+
+		if (auto Cached = PlacementsById.Find(Response.placement_id))
+		{
+			Cached->LastListed = Now;
+			Cached->RefreshId = RefreshId;
+
+			auto& Placement = *Cached->Placement;
+			if (Placement.MapName == Response.map_name
+				&& Placement.PlayerId == Response.player_id
+				&& Placement.MaxPlayers == Response.max_players
+				&& Placement.CustomData == Response.custom_data
+				&& Placement.MatchPlacementURL == Response.match_placement_url
+				&& Placement.PlayerIds == Response.player_ids)
+			{
+				continue;
+			}
+
+			Placement.MapName = Response.map_name;
+			Placement.PlayerId = Response.player_id;
+			Placement.MaxPlayers = Response.max_players;
+			Placement.CustomData = Response.custom_data;
+			Placement.MatchPlacementURL = Response.match_placement_url;
+			Placement.PlayerIds = Response.player_ids;
+			OutChanges.Add({ Response.placement_id, EDriftPublicMatchPlacementChange::Updated });
+		}
+		else
+		{
+			const auto Placement = MakeShared<FDriftMatchPlacement>(
+				Response.placement_id,
+				Response.map_name,
+				Response.player_id,
+				Response.max_players,
+				Status,
+				Response.custom_data,
+				Response.match_placement_url
+			);
+			Placement->PlayerIds = Response.player_ids;
+
+			Placements.Add(Placement);
+			PlacementsById.Add(Response.placement_id, FCachedPlacement{ Placement, Now, RefreshId });
+			OutChanges.Add({ Response.placement_id, EDriftPublicMatchPlacementChange::Added });
+		}
+	}
+
+	Remove(Unlisted, OutChanges);
+}
+
+
+void FDriftMatchPlacementCache::EndRefresh(TArray<FDriftPublicMatchPlacementChange>& OutChanges)
+{
+	RemoveAll([this](const FCachedPlacement& Cached)
+	{
+		return Cached.RefreshId != RefreshId;
+	}, OutChanges);
+}
+
+
+void FDriftMatchPlacementCache::Expire(const FDateTime& Now, TArray<FDriftPublicMatchPlacementChange>& OutChanges)
+{
+	RemoveAll([this, &Now](const FCachedPlacement& Cached)
+	{
+		return Now - Cached.LastListed > TimeToLive;
+	}, OutChanges);
+}
+
+
+void FDriftMatchPlacementCache::Reset(TArray<FDriftPublicMatchPlacementChange>& OutChanges)
+{
+	RemoveAll([](const FCachedPlacement&)
+	{
+		return true;
+	}, OutChanges);
+}
+
+
+void FDriftMatchPlacementCache::Remove(TArrayView<const FString> MatchPlacementIds, TArray<FDriftPublicMatchPlacementChange>& OutChanges)
+{
+	TSet<const IDriftMatchPlacement*> Removed;
+	for (const auto& MatchPlacementId : MatchPlacementIds)
+	{
+		FCachedPlacement Cached;
+		if (PlacementsById.RemoveAndCopyValue(MatchPlacementId, Cached))
+		{
+			Removed.Add(Cached.Placement.Get());
+			OutChanges.Add({ MatchPlacementId, EDriftPublicMatchPlacementChange::Removed });
+		}
+	}
+
+	// A single pass over the list, however many were removed
+	if (Removed.Num() > 0)
+	{
+		Placements.RemoveAll([&Removed](const TSharedPtr<IDriftMatchPlacement>& Placement)
+		{
+			return Removed.Contains(Placement.Get());
+		});
+	}
+}
+
+
+void FDriftMatchPlacementCache::RemoveAll(TFunctionRef<bool(const FCachedPlacement&)> Predicate, TArray<FDriftPublicMatchPlacementChange>& OutChanges)
+{
+	TArray<FString> ToRemove;
+	for (const auto& Cached : PlacementsById)
+	{
+		if (Predicate(Cached.Value))
+		{
+			ToRemove.Add(Cached.Key);
+		}
+	}
+
+	Remove(ToRemove, OutChanges);
+}
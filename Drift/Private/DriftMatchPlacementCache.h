@@ -0,0 +1,142 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#pragma once
+
+#include "IDriftMatchPlacementManager.h"
+
+
+class SerializationContext;
+
+
+struct FDriftMatchPlacement : IDriftMatchPlacement
+{
+	FDriftMatchPlacement(
+		FString InMatchPlacementId,
+		FString InMapName,
+		int32 InPlayerId,
+		int32 InMaxPlayers,
+		EDriftMatchPlacementStatus InMatchPlacementStatus,
+		FString InCustomData,
+		FString InMatchPlacementURL)
+		:
+		MatchPlacementId{ InMatchPlacementId },
+		MapName{ InMapName },
+		PlayerId{ InPlayerId },
+		MaxPlayers{ InMaxPlayers },
+        MatchPlacementStatus { InMatchPlacementStatus },
+		CustomData { InCustomData },
+		MatchPlacementURL{ InMatchPlacementURL }
+	{ }
+
+    FString GetMatchPlacementId() const override { return MatchPlacementId; }
+    FString GetMapName() const override { return MapName; }
+    int32 GetMaxPlayers() const override { return MaxPlayers; }
+    int32 GetPlayerId() const override { return PlayerId; }
+    EDriftMatchPlacementStatus GetMatchPlacementStatus() const override { return MatchPlacementStatus; }
+    FString GetCustomData() const override { return CustomData; }
+    FString GetConnectionString() const override { return ConnectionString; }
+    FString GetConnectionOptions() const override { return ConnectionOptions; }
+    TArray<int32>& GetPlayerIds() override { return PlayerIds; }
+
+    FString ToString() const override
+	{
+	    return FString::Printf(TEXT("MatchPlacementId: %s, MapName: %s, PlayerId: %d, MaxPlayers: %d, MatchPlacementStatus: %d, CustomData: %s, ConnectionString: %s, ConnectionOptions: %s"),
+	        *MatchPlacementId, *MapName, PlayerId, MaxPlayers, MatchPlacementStatus, *CustomData, *ConnectionString, *ConnectionOptions);
+	}
+
+	FString MatchPlacementId;
+	FString MapName;
+	int32 PlayerId = 0;
+	int32 MaxPlayers = 0;
+	EDriftMatchPlacementStatus MatchPlacementStatus = EDriftMatchPlacementStatus::Unknown;
+	FString CustomData;
+    TArray<int32> PlayerIds;
+
+	FString MatchPlacementURL;
+
+	FString ConnectionString;
+	FString ConnectionOptions;
+};
+
+
+/* A public match placement as listed by the backend */
+struct FDriftPublicMatchPlacementResponse
+{
+	FString placement_id;
+	int32 player_id = 0;
+	FString status;
+	FString custom_data;
+	FString map_name;
+	int32 max_players = 0;
+	FString match_placement_url;
+	TArray<int32> player_ids;
+
+	bool Serialize(SerializationContext& Context);
+};
+
+
+/* One page of public match placements. The last page has no cursor */
+struct FDriftPublicMatchPlacementsPage
+{
+	TArray<FDriftPublicMatchPlacementResponse> placements;
+	FString next_cursor;
+
+	bool Serialize(SerializationContext& Context);
+};
+
+
+struct FDriftPublicMatchPlacementChange
+{
+	FString MatchPlacementId;
+	EDriftPublicMatchPlacementChange Change = EDriftPublicMatchPlacementChange::Added;
+};
+
+
+/**
+ * The locally cached public match placements, patched in place from each page of a refresh.
+ *
+ * Placements are looked up by id, so merging a page is linear in the size of the page, and
+ * placement objects stay the same for as long as the placement is listed. Only fulfilled
+ * placements are kept. Placements that a complete refresh didn't list are removed, as are
+ * placements that haven't been listed for longer than the time to live, which covers
+ * refreshes that never completed. Each change reports which placements were added, updated
+ * or removed.
+ */
+class FDriftMatchPlacementCache
+{
+public:
+	void SetTimeToLive(float Seconds) { TimeToLive = FTimespan::FromSeconds(Seconds); }
+
+	TArray<TSharedPtr<IDriftMatchPlacement>>& GetPlacements() { return Placements; }
+	TSharedPtr<FDriftMatchPlacement> FindPlacement(const FString& MatchPlacementId) const;
+
+	/* Start a refresh, pages that follow are part of it */
+	void BeginRefresh();
+
+	/* Merge a page of the current refresh */
+	void ApplyPage(TArrayView<const FDriftPublicMatchPlacementResponse> Page, const FDateTime& Now, TArray<FDriftPublicMatchPlacementChange>& OutChanges);
+
+	/* The current refresh has seen every page, remove what it didn't list */
+	void EndRefresh(TArray<FDriftPublicMatchPlacementChange>& OutChanges);
+
+	/* Remove placements that haven't been listed for longer than the time to live */
+	void Expire(const FDateTime& Now, TArray<FDriftPublicMatchPlacementChange>& OutChanges);
+
+	void Reset(TArray<FDriftPublicMatchPlacementChange>& OutChanges);
+
+private:
+	struct FCachedPlacement
+	{
+		TSharedPtr<FDriftMatchPlacement> Placement;
+		FDateTime LastListed;
+		uint32 RefreshId = 0;
+	};
+
+	void Remove(TArrayView<const FString> MatchPlacementIds, TArray<FDriftPublicMatchPlacementChange>& OutChanges);
+	void RemoveAll(TFunctionRef<bool(const FCachedPlacement&)> Predicate, TArray<FDriftPublicMatchPlacementChange>& OutChanges);
+
+	TMap<FString, FCachedPlacement> PlacementsById;
+	TArray<TSharedPtr<IDriftMatchPlacement>> Placements;
+	uint32 RefreshId = 0;
+	FTimespan TimeToLive = FTimespan::FromMinutes(2.0);
+};
@@ -2,13 +2,18 @@
 
 #include "DriftMatchPlacementManager.h"
 
+#include "JsonArchive.h"
+#include "Details/UrlHelper.h"
+
 
 DEFINE_LOG_CATEGORY(LogDriftMatchPlacement);
 
 static const FString MatchPlacementMessageQueue(TEXT("match_placements"));
+static constexpr int32 MaxPublicMatchPlacementPages = 100;
 
 FDriftMatchPlacementManager::FDriftMatchPlacementManager(TSharedPtr<IDriftMessageQueue> InMessageQueue)
 	: MessageQueue{MoveTemp(InMessageQueue)}
+	, PublicPlacementsPageFetcher{&FDriftMatchPlacementManager::SendPublicMatchPlacementsPageRequest}
 {
 	MessageQueue->OnMessageQueueMessage(MatchPlacementMessageQueue).AddRaw(this, &FDriftMatchPlacementManager::HandleMatchPlacementEvent);
 
@@ -32,6 +37,12 @@ void FDriftMatchPlacementManager::ConfigureSession(const FDriftEndpointsResponse
 	MatchPlacementsURL = DriftEndpoints.match_placements;
     PublicPlacementsURL = DriftEndpoints.public_match_placements;
 
+    TArray<FDriftPublicMatchPlacementChange> Changes;
+    PublicMatchPlacements.Reset(Changes);
+    BroadcastPublicMatchPlacementChanges(Changes);
+    PublicPlacementsQueryURL.Empty();
+    ++PublicPlacementsFetch;
+
 	if (HasSession())
 	{
 		InitializeLocalState();
@@ -408,6 +419,11 @@ bool FDriftMatchPlacementManager::RejoinMatchPlacement(const FString& MatchPlace
 }
 
 bool FDriftMatchPlacementManager::FetchPublicMatchPlacements(FFetchPublicMatchPlacementsCompletedDelegate Delegate)
+{
+    return FetchPublicMatchPlacements(FDriftPublicMatchPlacementsQuery{}, Delegate);
+}
+
+bool FDriftMatchPlacementManager::FetchPublicMatchPlacements(const FDriftPublicMatchPlacementsQuery& Query, FFetchPublicMatchPlacementsCompletedDelegate Delegate)
 {
     if (!HasSession())
     {
@@ -416,81 +432,142 @@ bool FDriftMatchPlacementManager::FetchPublicMatchPlacements(FFetchPublicMatchPl
         return false;
     }
 
+    auto QueryURL = PublicPlacementsURL;
+    if (Query.MapName.IsSet())
+    {
+        internal::UrlHelper::AddUrlOption(QueryURL, TEXT("map_name"), Query.MapName.GetValue());
+    }
+
+    // Sorted so that the same filters always make the same query
+    auto Filters = Query.Filters;
+    Filters.KeySort(TLess<FString>());
+    for (const auto& Filter : Filters)
+    {
+        internal::UrlHelper::AddUrlOption(QueryURL, Filter.Key, Filter.Value);
+    }
+
+    if (QueryURL != PublicPlacementsQueryURL)
+    {
+        TArray<FDriftPublicMatchPlacementChange> Changes;
+        PublicMatchPlacements.Reset(Changes);
+        BroadcastPublicMatchPlacementChanges(Changes);
+        PublicPlacementsQueryURL = QueryURL;
+    }
+    PublicPlacementsPageSize = Query.PageSize.Get(0);
+
     UE_LOG(LogDriftMatchPlacement, Log, TEXT("Querying for public match placements"));
 
-    const auto Request = RequestManager->Get(PublicPlacementsURL);
-    Request->OnResponse.BindLambda([this, Delegate](ResponseContext& Context, JsonDocument& Doc)
+    PublicMatchPlacements.BeginRefresh();
+    return FetchPublicMatchPlacementsPage(FString{}, 1, ++PublicPlacementsFetch, Delegate);
+}
+
+bool FDriftMatchPlacementManager::FetchPublicMatchPlacementsPage(const FString& Cursor, int32 PageNumber, uint32 Fetch, FFetchPublicMatchPlacementsCompletedDelegate Delegate)
+{
+    auto PageURL = PublicPlacementsQueryURL;
+    if (PublicPlacementsPageSize > 0)
+    {
+        internal::UrlHelper::AddUrlOption(PageURL, TEXT("page_size"), PublicPlacementsPageSize);
+    }
+    if (!Cursor.IsEmpty())
     {
-        UE_LOG(LogDriftMatchPlacement, Verbose, TEXT("FetchPublicMatchPlacements response:'n'%s'"), *Doc.ToString());
+        internal::UrlHelper::AddUrlOption(PageURL, TEXT("cursor"), Cursor);
+    }
+
+    return PublicPlacementsPageFetcher(RequestManager, PageURL, [this, PageNumber, Fetch, Delegate](bool bSuccess, const FDriftPublicMatchPlacementsPage& Page, const FString& Error)
+    {
+        HandlePublicMatchPlacementsPage(bSuccess, Page, Error, PageNumber, Fetch, Delegate);
+    });
+}
+
+void FDriftMatchPlacementManager::HandlePublicMatchPlacementsPage(bool bSuccess, const FDriftPublicMatchPlacementsPage& Page, const FString& Error, int32 PageNumber, uint32 Fetch, FFetchPublicMatchPlacementsCompletedDelegate Delegate)
+{
+    if (Fetch != PublicPlacementsFetch)
+    {
+        UE_LOG(LogDriftMatchPlacement, Verbose, TEXT("Ignoring public match placements from an earlier fetch"));
+        (void)Delegate.ExecuteIfBound(false, 0, TEXT("Superseded"));
+        return;
+    }
+
+    const auto Now = FDateTime::UtcNow();
+    TArray<FDriftPublicMatchPlacementChange> Changes;
+
+    if (!bSuccess)
+    {
+        UE_LOG(LogDriftMatchPlacement, Error, TEXT("Failed to fetch public match placements page %d, error: '%s'"), PageNumber, *Error);
+
+        // What the failed fetch would have listed expires in time
+        PublicMatchPlacements.Expire(Now, Changes);
+        BroadcastPublicMatchPlacementChanges(Changes);
+        (void)Delegate.ExecuteIfBound(false, PublicMatchPlacements.GetPlacements().Num(), Error);
+        return;
+    }
 
-        PublicMatchPlacements.Empty();
+    PublicMatchPlacements.ApplyPage(Page.placements, Now, Changes);
 
-        const TArray<TSharedPtr<FJsonValue>> *PlacementsJson = nullptr;
-        if (Doc.GetInternalValue()->TryGetArray(PlacementsJson))
+    if (!Page.next_cursor.IsEmpty() && PageNumber < MaxPublicMatchPlacementPages)
+    {
+        BroadcastPublicMatchPlacementChanges(Changes);
+        if (!FetchPublicMatchPlacementsPage(Page.next_cursor, PageNumber + 1, Fetch, Delegate))
         {
-            for (const auto& PlacementJson : *PlacementsJson)
-            {
-                FDriftMatchPlacementResponse MatchPlacementResponse{};
-                if (!MatchPlacementResponse.FromJson(PlacementJson->AsObject()))
-                {
-                    UE_LOG(LogDriftMatchPlacement, Error, TEXT("Failed to serialize get match placement response"));
-                    return;
-                }
+            HandlePublicMatchPlacementsPage(false, {}, TEXT("Failed to fetch the next page of public match placements"), PageNumber + 1, Fetch, Delegate);
+        }
+        return;
+    }
 
-                // Only react to Fulfilled as we use these for joining existing games
-                const auto Status = ParseStatus(MatchPlacementResponse.Status);
-                if (Status == EDriftMatchPlacementStatus::Fulfilled)
-                {
-                    TSharedPtr<FDriftMatchPlacement> PublicMatchPlacement = MakeShared<FDriftMatchPlacement>(
-                        MatchPlacementResponse.PlacementId,
-                        MatchPlacementResponse.MapName,
-                        MatchPlacementResponse.PlayerId,
-                        MatchPlacementResponse.MaxPlayers,
-                        ParseStatus(MatchPlacementResponse.Status),
-                        MatchPlacementResponse.CustomData,
-                        MatchPlacementResponse.MatchPlacementURL
-                    );
-
-                    const TArray<TSharedPtr<FJsonValue>> *PlayerIdsJson = nullptr;
-                    if (PlacementJson->AsObject()->TryGetArrayField(TEXT("player_ids"), PlayerIdsJson))
-                    {
-                        for (auto& PlacementPlayerIdValue : *PlayerIdsJson)
-                        {
-                            int32 PlacementPlayerId = 0;
-                            PlacementPlayerIdValue->TryGetNumber(PlacementPlayerId);
-                            PublicMatchPlacement->PlayerIds.Add(PlacementPlayerId);
-                        }
-                    }
-
-                    /*
-                    if (!MatchPlacementResponse.ConnectionString.IsEmpty())
-                    {
-                        PublicMatchPlacement.Get()->ConnectionString = MatchPlacementResponse.ConnectionString;
-                        PublicMatchPlacement.Get()->ConnectionOptions = MatchPlacementResponse.ConnectionOptions.IsEmpty() ? "SpectatorOnly=1" : MatchPlacementResponse.ConnectionOptions;
-                    }
-                    */
-
-                    PublicMatchPlacements.Add(PublicMatchPlacement);
-                }
-                else
-                {
-                    UE_LOG(LogDriftMatchPlacement, Log, TEXT("Match placement '%s' found, but the status is '%s'. Ignoring."), *MatchPlacementResponse.PlacementId, *MatchPlacementResponse.Status);
-                }
-            }
+    if (Page.next_cursor.IsEmpty())
+    {
+        PublicMatchPlacements.EndRefresh(Changes);
+    }
+    else
+    {
+        // What wasn't listed on the pages fetched expires in time
+        UE_LOG(LogDriftMatchPlacement, Warning, TEXT("Stopped fetching public match placements after %d pages"), PageNumber);
+    }
+    PublicMatchPlacements.Expire(Now, Changes);
+    BroadcastPublicMatchPlacementChanges(Changes);
+
+    const auto NumPlacements = PublicMatchPlacements.GetPlacements().Num();
+    UE_LOG(LogDriftMatchPlacement, Log, TEXT("Fetched %d public match placements in %d pages"), NumPlacements, PageNumber);
+    (void)Delegate.ExecuteIfBound(true, NumPlacements, "");
+}
+
+bool FDriftMatchPlacementManager::SendPublicMatchPlacementsPageRequest(const TSharedPtr<JsonRequestManager>& RootRequestManager, const FString& PageURL,
+    TFunction<void(bool, const FDriftPublicMatchPlacementsPage&, const FString&)> OnCompleted)
+{
+    const auto Request = RootRequestManager->Get(PageURL);
+    Request->OnResponse.BindLambda([PageURL, OnCompleted](ResponseContext& Context, JsonDocument& Doc)
+    {
+        UE_LOG(LogDriftMatchPlacement, Verbose, TEXT("FetchPublicMatchPlacements '%s' response:'n'%s'"), *PageURL, *Doc.ToString());
+
+        // Without pagination, the backend lists every placement at once
+        FDriftPublicMatchPlacementsPage Page;
+        const auto bParsed = Doc.IsArray() ? JsonArchive::LoadObject(Doc, Page.placements) : JsonArchive::LoadObject(Doc, Page);
+        if (!bParsed)
+        {
+            OnCompleted(false, {}, TEXT("Failed to parse public match placements"));
+            return;
         }
-        (void)Delegate.ExecuteIfBound(true, PublicMatchPlacements.Num(), "");
 
+        OnCompleted(true, Page, {});
     });
-    Request->OnError.BindLambda([Delegate](ResponseContext& Context)
+    Request->OnError.BindLambda([OnCompleted](ResponseContext& Context)
     {
         FString Error;
         Context.errorHandled = GetResponseError(Context, Error);
-        (void)Delegate.ExecuteIfBound(false, 0, Error);
+        OnCompleted(false, {}, Error);
     });
 
     return Request->Dispatch();
 }
 
+void FDriftMatchPlacementManager::BroadcastPublicMatchPlacementChanges(const TArray<FDriftPublicMatchPlacementChange>& Changes)
+{
+    for (const auto& Change : Changes)
+    {
+        OnPublicMatchPlacementChangedDelegate.Broadcast(Change.MatchPlacementId, Change.Change);
+    }
+}
+
 void FDriftMatchPlacementManager::HandleMatchPlacementEvent(const FMessageQueueEntry& Message)
 {
 	if (Message.sender_id != FDriftMessageQueue::SenderSystemID && Message.sender_id != PlayerId)
@@ -3,60 +3,11 @@
 #pragma once
 
 #include "IDriftMatchPlacementManager.h"
+#include "DriftMatchPlacementCache.h"
 #include "DriftMessageQueue.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogDriftMatchPlacement, Log, All);
 
-struct FDriftMatchPlacement : IDriftMatchPlacement
-{
-	FDriftMatchPlacement(
-		FString InMatchPlacementId,
-		FString InMapName,
-		int32 InPlayerId,
-		int32 InMaxPlayers,
-		EDriftMatchPlacementStatus InMatchPlacementStatus,
-		FString InCustomData,
-		FString InMatchPlacementURL)
-		:
-		MatchPlacementId{ InMatchPlacementId },
-		MapName{ InMapName },
-		PlayerId{ InPlayerId },
-		MaxPlayers{ InMaxPlayers },
-        MatchPlacementStatus { InMatchPlacementStatus },
-		CustomData { InCustomData },
-		MatchPlacementURL{ InMatchPlacementURL }
-	{ }
-
-    FString GetMatchPlacementId() const override { return MatchPlacementId; }
-    FString GetMapName() const override { return MapName; }
-    int32 GetMaxPlayers() const override { return MaxPlayers; }
-    int32 GetPlayerId() const override { return PlayerId; }
-    EDriftMatchPlacementStatus GetMatchPlacementStatus() const override { return MatchPlacementStatus; }
-    FString GetCustomData() const override { return CustomData; }
-    FString GetConnectionString() const override { return ConnectionString; }
-    FString GetConnectionOptions() const override { return ConnectionOptions; }
-    TArray<int32>& GetPlayerIds() override { return PlayerIds; }
-
-    FString ToString() const override
-	{
-	    return FString::Printf(TEXT("MatchPlacementId: %s, MapName: %s, PlayerId: %d, MaxPlayers: %d, MatchPlacementStatus: %d, CustomData: %s, ConnectionString: %s, ConnectionOptions: %s"),
-	        *MatchPlacementId, *MapName, PlayerId, MaxPlayers, MatchPlacementStatus, *CustomData, *ConnectionString, *ConnectionOptions);
-	}
-
-	FString MatchPlacementId;
-	FString MapName;
-	int32 PlayerId = 0;
-	int32 MaxPlayers = 0;
-	EDriftMatchPlacementStatus MatchPlacementStatus = EDriftMatchPlacementStatus::Unknown;
-	FString CustomData;
-    TArray<int32> PlayerIds;
-
-	FString MatchPlacementURL;
-
-	FString ConnectionString;
-	FString ConnectionOptions;
-};
-
 struct FDriftMatchPlacementResponse : FJsonSerializable
 {
     BEGIN_JSON_SERIALIZER;
@@ -90,6 +41,10 @@ struct FDriftMatchPlacementResponse : FJsonSerializable
     }
 };
 
+/* Fetches a page of public match placements, and calls back with it or with why it couldn't. Returns false if the request couldn't be sent */
+using FDriftPublicMatchPlacementsPageFetcher = TFunction<bool(const TSharedPtr<JsonRequestManager>& RequestManager, const FString& PageURL,
+    TFunction<void(bool /* bSuccess */, const FDriftPublicMatchPlacementsPage& /* Page */, const FString& /* Error */)> OnCompleted)>;
+
 class FDriftMatchPlacementManager : public IDriftMatchPlacementManager
 {
 public:
@@ -98,18 +53,26 @@ public:
 
 	void SetRequestManager(TSharedPtr<JsonRequestManager> RootRequestManager);
 	void ConfigureSession(const FDriftEndpointsResponse& DriftEndpoints, int32 InPlayerId);
+	void SetPublicMatchPlacementTimeToLive(float Seconds) { PublicMatchPlacements.SetTimeToLive(Seconds); }
+
+	/* Replace how public match placement pages are fetched, mainly for testing without a backend */
+	void SetPublicMatchPlacementsPageFetcher(FDriftPublicMatchPlacementsPageFetcher Fetcher) { PublicPlacementsPageFetcher = MoveTemp(Fetcher); }
 
 	// IDriftMatchPlacementManager overrides
     TSharedPtr<IDriftMatchPlacement> GetCachedMatchPlacement() const override { return CurrentMatchPlacement; }
-    TArray< TSharedPtr<IDriftMatchPlacement> >& GetCachedPublicMatchPlacements() override { return PublicMatchPlacements; }
+    TArray< TSharedPtr<IDriftMatchPlacement> >& GetCachedPublicMatchPlacements() override { return PublicMatchPlacements.GetPlacements(); }
 
     bool QueryMatchPlacement(FQueryMatchPlacementCompletedDelegate Delegate) override;
     bool CreateMatchPlacement(FDriftMatchPlacementProperties MatchPlacementProperties, FCreateMatchPlacementCompletedDelegate Delegate) override;
     bool JoinMatchPlacement(const FString& MatchPlacementID, FJoinMatchPlacementCompletedDelegate Delegate) override;
     bool RejoinMatchPlacement(const FString& MatchPlacementID, FJoinMatchPlacementCompletedDelegate Delegate) override;
     bool FetchPublicMatchPlacements(FFetchPublicMatchPlacementsCompletedDelegate Delegate) override;
+    bool FetchPublicMatchPlacements(const FDriftPublicMatchPlacementsQuery& Query, FFetchPublicMatchPlacementsCompletedDelegate Delegate) override;
 
     FOnMatchPlacementStatusChangedDelegate& OnMatchPlacementStatusChanged() override { return OnMatchPlacementStatusChangedDelegate; }
+    FOnPublicMatchPlacementChangedDelegate& OnPublicMatchPlacementChanged() override { return OnPublicMatchPlacementChangedDelegate; }
+
+    static EDriftMatchPlacementStatus ParseStatus(const FString& Status);
 
 private:
 	void InitializeLocalState();
@@ -120,7 +83,12 @@ private:
 	void HandleMatchPlacementEvent(const FMessageQueueEntry& Message);
 
     static EDriftMatchPlacementStatus ParseEvent(const FString& EventName);
-    static EDriftMatchPlacementStatus ParseStatus(const FString& Status);
+
+    bool FetchPublicMatchPlacementsPage(const FString& Cursor, int32 PageNumber, uint32 Fetch, FFetchPublicMatchPlacementsCompletedDelegate Delegate);
+    void HandlePublicMatchPlacementsPage(bool bSuccess, const FDriftPublicMatchPlacementsPage& Page, const FString& Error, int32 PageNumber, uint32 Fetch, FFetchPublicMatchPlacementsCompletedDelegate Delegate);
+    static bool SendPublicMatchPlacementsPageRequest(const TSharedPtr<JsonRequestManager>& RootRequestManager, const FString& PageURL,
+        TFunction<void(bool, const FDriftPublicMatchPlacementsPage&, const FString&)> OnCompleted);
+    void BroadcastPublicMatchPlacementChanges(const TArray<FDriftPublicMatchPlacementChange>& Changes);
 
 	bool HasSession() const;
 
@@ -141,8 +109,16 @@ private:
 	int32 PlayerId = INDEX_NONE;
 
 	TSharedPtr<FDriftMatchPlacement> CurrentMatchPlacement;
-    TArray< TSharedPtr<IDriftMatchPlacement> > PublicMatchPlacements;
 	FString CurrentMatchPlacementId;
 
+    FDriftMatchPlacementCache PublicMatchPlacements;
+    /* The query URL without a cursor. A different query starts over with an empty cache */
+    FString PublicPlacementsQueryURL;
+    int32 PublicPlacementsPageSize = 0;
+    /* Only responses to the latest fetch are used */
+    uint32 PublicPlacementsFetch = 0;
+    FDriftPublicMatchPlacementsPageFetcher PublicPlacementsPageFetcher;
+
 	FOnMatchPlacementStatusChangedDelegate OnMatchPlacementStatusChangedDelegate;
+	FOnPublicMatchPlacementChangedDelegate OnPublicMatchPlacementChangedDelegate;
 };
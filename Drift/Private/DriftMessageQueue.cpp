@@ -2,49 +2,87 @@
 
 #include "DriftMessageQueue.h"
 
+#include "DriftLongPollMessageTransport.h"
 #include "DriftSchemas.h"
-#include "Details/UrlHelper.h"
+#include "DriftWebSocketMessageTransport.h"
 #include "JsonArchive.h"
 
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
 
 DEFINE_LOG_CATEGORY(LogDriftMessages);
 
 
-const float DEFAULT_FETCH_THROTTLE_DELAY_SECONDS = 5.0f;
-const float MESSAGE_FETCH_TIMEOUT_SECONDS = 20.0f;
+/** How many message IDs to remember for dropping duplicates */
+const int32 MESSAGE_DEDUP_WINDOW = 256;
+
+const int32 MAX_SEND_ATTEMPTS = 5;
+const float MAX_SEND_RETRY_DELAY_SECONDS = 30.0f;
+
+/** Coalesce cursor writes during message bursts */
+const float CURSOR_SAVE_DELAY_SECONDS = 2.0f;
+
+
+struct FMessageQueueCursor
+{
+    int32 last_message_number = 0;
+    TArray<FString> recent_message_ids;
+
+    bool Serialize(SerializationContext& context)
+    {
+        return SERIALIZE_PROPERTY(context, last_message_number)
+            && SERIALIZE_PROPERTY(context, recent_message_ids);
+    }
+};
 
 
 FDriftMessageQueue::FDriftMessageQueue()
+: sender{ &FDriftMessageQueue::PostPayload }
 {
 }
 
 
 FDriftMessageQueue::~FDriftMessageQueue()
 {
-    auto pendingPoll = currentPoll.Pin();
-    if (pendingPoll.IsValid())
+    if (transport.IsValid())
+    {
+        transport->Stop();
+    }
+
+    Flush();
+
+    if (cursorDirty)
     {
-        pendingPoll->Destroy();
+        SaveCursor();
     }
 }
 
 
 void FDriftMessageQueue::Tick(float DeltaTime)
 {
-    if (messageQueueUrl.IsEmpty() || !requestManager.IsValid())
+    if (fallBackToLongPoll)
     {
-        return;
+        // Replaced here rather than in the failure callback, which is called by the transport itself
+        fallBackToLongPoll = false;
+        preferredTransport = TEXT("longpoll");
+        RestartTransport();
     }
 
-    if (fetchDelay > 0.0f)
+    if (transport.IsValid())
     {
-        fetchDelay -= DeltaTime;
-        return;
+        transport->Tick(DeltaTime);
     }
 
-    if (!currentPoll.IsValid())
+    FlushOutbox(DeltaTime);
+
+    if (cursorDirty)
     {
-        GetMessages();
+        cursorSaveDelay -= DeltaTime;
+        if (cursorSaveDelay <= 0.0f)
+        {
+            SaveCursor();
+        }
     }
 }
 
@@ -58,13 +96,83 @@ TStatId FDriftMessageQueue::GetStatId() const
 void FDriftMessageQueue::SetRequestManager(TSharedPtr<JsonRequestManager> newRequestManager)
 {
     requestManager = newRequestManager;
-    fetchDelay = 0.0f;
+    RestartTransport();
 }
 
 
 void FDriftMessageQueue::SetMessageQueueUrl(const FString& newMessageQueueUrl)
 {
     messageQueueUrl = newMessageQueueUrl;
+    RestartTransport();
+}
+
+
+void FDriftMessageQueue::ConfigureSession(int32 playerId)
+{
+    cursorFilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("DriftMessages"), FString::Printf(TEXT("%d.json"), playerId));
+    LoadCursor();
+    RestartTransport();
+}
+
+
+void FDriftMessageQueue::SetSender(FDriftMessageQueueSender newSender)
+{
+    sender = MoveTemp(newSender);
+}
+
+
+void FDriftMessageQueue::SetPreferredTransport(const FString& name)
+{
+    preferredTransport = name;
+    RestartTransport();
+}
+
+
+void FDriftMessageQueue::SetTransport(TUniquePtr<IDriftMessageTransport> newTransport)
+{
+    if (transport.IsValid())
+    {
+        transport->Stop();
+    }
+
+    transport = MoveTemp(newTransport);
+    if (!transport.IsValid())
+    {
+        return;
+    }
+
+    UE_LOG(LogDriftMessages, Log, TEXT("Receiving messages using %s"), *transport->GetName());
+
+    transport->OnMessages.BindRaw(this, &FDriftMessageQueue::HandleMessages);
+    transport->OnFailed.BindRaw(this, &FDriftMessageQueue::HandleTransportFailed);
+    transport->Start(messageQueueUrl, lastMessageNumber);
+}
+
+
+void FDriftMessageQueue::RestartTransport()
+{
+    if (messageQueueUrl.IsEmpty() || !requestManager.IsValid())
+    {
+        SetTransport({});
+        return;
+    }
+
+    if (preferredTransport == TEXT("websocket"))
+    {
+        SetTransport(MakeUnique<FDriftWebSocketMessageTransport>(requestManager));
+    }
+    else
+    {
+        SetTransport(MakeUnique<FDriftLongPollMessageTransport>(requestManager));
+    }
+}
+
+
+void FDriftMessageQueue::HandleTransportFailed(const FString& error)
+{
+    UE_LOG(LogDriftMessages, Warning, TEXT("Message transport '%s' failed, falling back to long polling: %s"), *transport->GetName(), *error);
+
+    fallBackToLongPoll = true;
 }
 
 
@@ -99,135 +207,258 @@ void FDriftMessageQueue::SendMessage(const FString& urlTemplate, const FString&
         return;
     }
 
-    auto url = urlTemplate.Replace(TEXT("{queue}"), *queue);
-    auto rm = requestManager.Pin();
-    if (rm.IsValid())
+    auto outbound = MakeShared<FOutboundMessage>();
+    outbound->url = urlTemplate.Replace(TEXT("{queue}"), *queue);
+    if (urlTemplate.EndsWith(TEXT("/{queue}")))
     {
-        FMessageQueueMessage payload{ Forward<JsonValue>(message), timeoutSeconds };
-        auto request = rm->Post(url, payload, HttpStatusCodes::Ok); // Backend currently returns 200 OK on success, not 201 Created
-        request->OnError.BindLambda([this](ResponseContext& context)
+        outbound->exchangeUrl = urlTemplate.LeftChop(8);
+    }
+    outbound->queue = queue;
+    outbound->message = Forward<JsonValue>(message);
+    outbound->timeoutSeconds = timeoutSeconds;
+    outbox.Add(outbound);
+}
+
+
+void FDriftMessageQueue::FlushOutbox(float deltaTime)
+{
+    if (outbox.Num() == 0)
+    {
+        return;
+    }
+
+    TMap<FString, TArray<TSharedRef<FOutboundMessage>>> ready;
+    for (auto it = outbox.CreateIterator(); it; ++it)
+    {
+        auto& message = *it;
+        message->delay -= deltaTime;
+        if (message->delay <= 0.0f)
         {
-            context.errorHandled = true;
-        });
-        request->Dispatch();
+            ready.FindOrAdd(message->exchangeUrl).Add(message);
+            it.RemoveCurrent();
+        }
     }
+
+    SendReady(ready, true);
 }
 
 
-struct FMessageQueue
+void FDriftMessageQueue::Flush()
 {
-    TMap<FString, TArray<FMessageQueueEntry>> queues;
+    if (outbox.Num() == 0)
+    {
+        return;
+    }
 
-    bool Serialize(SerializationContext& context)
+    UE_LOG(LogDriftMessages, Verbose, TEXT("Flushing %d outgoing messages"), outbox.Num());
+
+    TMap<FString, TArray<TSharedRef<FOutboundMessage>>> ready;
+    for (const auto& message : outbox)
+    {
+        ready.FindOrAdd(message->exchangeUrl).Add(message);
+    }
+    outbox.Reset();
+
+    SendReady(ready, false);
+}
+
+
+void FDriftMessageQueue::SendReady(TMap<FString, TArray<TSharedRef<FOutboundMessage>>>& ready, bool retry)
+{
+    for (auto& exchange : ready)
     {
-        if (context.IsLoading())
+        // Messages without an exchange are grouped under an empty URL, and can't be batched
+        if (batchSend && !exchange.Key.IsEmpty() && exchange.Value.Num() > 1)
         {
-            queues.Empty();
-            auto& jValue = context.GetValue();
-            if (!jValue.IsObject())
-            {
-                return false;
-            }
-            for (auto& member : jValue.GetObject())
+            SendBatch(exchange.Key, MoveTemp(exchange.Value), retry);
+        }
+        else
+        {
+            for (const auto& message : exchange.Value)
             {
-                const auto& queue = member.Key;
-                auto& entry = queues.Emplace(queue);
-                context.SerializeProperty(*queue, entry);
+                SendSingle(message, retry);
             }
-            return true;
         }
-        return false;
     }
-};
+}
 
 
-void FDriftMessageQueue::GetMessages()
+void FDriftMessageQueue::SendSingle(TSharedRef<FOutboundMessage> message, bool retry)
 {
-    if (messageQueueUrl.IsEmpty())
+    auto rm = requestManager.Pin();
+    if (!rm.IsValid())
     {
-        UE_LOG(LogDriftMessages, Error, TEXT("Trying to fetch messages without an endpoint"));
+        UE_LOG(LogDriftMessages, Warning, TEXT("Dropping message to queue '%s', not connected"), *message->queue);
         return;
     }
 
-    if (currentPoll.IsValid())
+    JsonValue payload;
+    JsonArchive::SaveObject(FMessageQueueMessage{ message->message, message->timeoutSeconds }, payload);
+    // Without a way back to the queue, failures are only logged
+    const auto weakSelf = retry ? TWeakPtr<FDriftMessageQueue>(AsShared()) : TWeakPtr<FDriftMessageQueue>();
+    sender(rm, message->url, payload, [weakSelf, message](int32 responseCode, const FString& error)
     {
-        UE_LOG(LogDriftMessages, Verbose, TEXT("Already waiting for a response, ignoring request to poll message queue"));
-        return;
+        HandleSendFailure(weakSelf.Pin(), message, responseCode, error);
+    });
+}
+
+
+struct FMessageQueueBatchEntry
+{
+    FString queue;
+    JsonValue message;
+    int expire;
+
+    bool Serialize(SerializationContext& context)
+    {
+        return SERIALIZE_PROPERTY(context, queue)
+            && SERIALIZE_PROPERTY(context, message)
+            && SERIALIZE_PROPERTY(context, expire);
     }
+};
+
 
+struct FMessageQueueBatchPayload
+{
+    TArray<FMessageQueueBatchEntry> messages;
+
+    bool Serialize(SerializationContext& context)
+    {
+        return SERIALIZE_PROPERTY(context, messages);
+    }
+};
+
+
+void FDriftMessageQueue::SendBatch(const FString& exchangeUrl, TArray<TSharedRef<FOutboundMessage>> messages, bool retry)
+{
     auto rm = requestManager.Pin();
-    if (rm.IsValid())
+    if (!rm.IsValid())
     {
-        UE_LOG(LogDriftMessages, Verbose, TEXT("Polling message queue..."));
+        UE_LOG(LogDriftMessages, Warning, TEXT("Dropping %d messages to '%s', not connected"), messages.Num(), *exchangeUrl);
+        return;
+    }
 
-        auto url = messageQueueUrl;
-        internal::UrlHelper::AddUrlOption(url, TEXT("messages_after"), lastMessageNumber);
-        internal::UrlHelper::AddUrlOption(url, TEXT("timeout"), MESSAGE_FETCH_TIMEOUT_SECONDS);
-        auto request = rm->Get(url);
-        currentPoll = request;
-        request->OnResponse.BindLambda([this](ResponseContext& context, JsonDocument& doc)
+    UE_LOG(LogDriftMessages, Verbose, TEXT("Sending %d messages to '%s' in one request"), messages.Num(), *exchangeUrl);
+
+    FMessageQueueBatchPayload batch;
+    batch.messages.Reserve(messages.Num());
+    for (const auto& message : messages)
+    {
+        batch.messages.Add(FMessageQueueBatchEntry{ message->queue, message->message, message->timeoutSeconds });
+    }
+    JsonValue payload;
+    JsonArchive::SaveObject(batch, payload);
+
+    const auto weakSelf = retry ? TWeakPtr<FDriftMessageQueue>(AsShared()) : TWeakPtr<FDriftMessageQueue>();
+    sender(rm, exchangeUrl, payload, [weakSelf, messages](int32 responseCode, const FString& error)
+    {
+        const auto self = weakSelf.Pin();
+        for (const auto& message : messages)
         {
-            UE_LOG(LogDriftMessages, VeryVerbose, TEXT("Message queue response: %s"), *JsonArchive::ToString(doc));
+            HandleSendFailure(self, message, responseCode, error);
+        }
+    });
+}
 
-            FMessageQueue messages;
-            if (!JsonArchive::LoadObject(doc, messages))
-            {
-                context.error = TEXT("Failed to parse message queue response");
-                fetchDelay = DEFAULT_FETCH_THROTTLE_DELAY_SECONDS;
-                return;
-            }
-            TArray<FMessageQueueEntry> Messages;
-            for (const auto& queue : messages.queues)
-            {
-                for (const auto& message : queue.Value)
-                {
-                    Messages.Add(message);
-                }
-            }
-            Messages.Sort([](const FMessageQueueEntry& lhs, const FMessageQueueEntry& rhs){return lhs.message_number < rhs.message_number; });
-            const auto oldLastMessage = lastMessageNumber;
-            for (const auto& Message: Messages)
-            {
-                ProcessMessage(Message.queue, Message);
-            }
-            if (Messages.Num())
-            {
-                lastMessageNumber = Messages[Messages.Num()-1].message_number;
-            }
 
-            if (oldLastMessage == lastMessageNumber && (FDateTime::UtcNow() - context.sent).GetTotalSeconds() < MESSAGE_FETCH_TIMEOUT_SECONDS)
-            {
-                /**
-                 * Got an empty reply which was not a timeout; something might be off
-                 * make sure we throttle the polling frequency for a while
-                 */
-                fetchDelay = DEFAULT_FETCH_THROTTLE_DELAY_SECONDS;
-            }
-            else
-            {
-                // Getting proper data again, drop throttle
-                fetchDelay = 0.0f;
-            }
+void FDriftMessageQueue::PostPayload(const TSharedPtr<JsonRequestManager>& requestManager, const FString& url, const JsonValue& payload,
+    TFunction<void(int32 responseCode, const FString& error)> onFailed)
+{
+    auto request = requestManager->Post(url, payload, HttpStatusCodes::Ok); // Backend currently returns 200 OK on success, not 201 Created
+    request->OnError.BindLambda([onFailed](ResponseContext& context)
+    {
+        context.errorHandled = true;
+        onFailed(context.responseCode, context.error);
+    });
+    request->Dispatch();
+}
+
+
+void FDriftMessageQueue::HandleSendFailure(const TSharedPtr<FDriftMessageQueue>& self, TSharedRef<FOutboundMessage> message, int32 responseCode, const FString& error)
+{
+    ++message->attempts;
+    if (!self.IsValid() || IsClientError(responseCode) || message->attempts >= MAX_SEND_ATTEMPTS)
+    {
+        UE_LOG(LogDriftMessages, Error, TEXT("Failed to send message to queue '%s' at '%s' after %d attempts, status %d: %s"),
+            *message->queue, *message->url, message->attempts, responseCode, *error);
+        return;
+    }
+
+    message->delay = FMath::Min(FMath::Pow(2.0f, message->attempts - 1), MAX_SEND_RETRY_DELAY_SECONDS);
+
+    UE_LOG(LogDriftMessages, Warning, TEXT("Failed to send message to queue '%s', status %d, retrying in %.0f seconds"),
+        *message->queue, responseCode, message->delay);
+
+    self->outbox.Add(message);
+}
+
+
+void FDriftMessageQueue::HandleMessages(FDriftMessageQueueBatch& queues)
+{
+    struct FQueueCursor
+    {
+        const TArray<FMessageQueueEntry>* messages;
+        int32 next;
+        TSharedPtr<FDriftMessageQueueDelegate> handler;
+    };
+    const auto earlier = [](const FQueueCursor& lhs, const FQueueCursor& rhs)
+    {
+        return (*lhs.messages)[lhs.next].message_number < (*rhs.messages)[rhs.next].message_number;
+    };
+
+    TArray<FQueueCursor, TInlineAllocator<8>> heap;
+    for (const auto& messages : queues)
+    {
+        // Look the handler up once per queue, rather than once per message
+        const auto handler = messageHandlers.Find(messages[0].queue);
+        heap.Add(FQueueCursor{ &messages, 0, handler ? TSharedPtr<FDriftMessageQueueDelegate>{ *handler } : nullptr });
+    }
+    heap.Heapify(earlier);
+
+    // Each queue is already in order, so merge them rather than flattening and sorting everything
+    const auto oldLastMessageNumber = lastMessageNumber;
+    while (heap.Num() > 0)
+    {
+        FQueueCursor cursor;
+        heap.HeapPop(cursor, earlier);
+
+        const auto& message = (*cursor.messages)[cursor.next];
+        if (RememberMessage(message.message_id))
+        {
+            ProcessMessage(cursor.handler.Get(), message);
+        }
+        else
+        {
+            UE_LOG(LogDriftMessages, Verbose, TEXT("Dropping duplicate message %s on queue '%s'"), *message.message_id, *message.queue);
+        }
+        lastMessageNumber = FMath::Max(lastMessageNumber, message.message_number);
+
+        if (++cursor.next < cursor.messages->Num())
+        {
+            heap.HeapPush(MoveTemp(cursor), earlier);
+        }
+    }
 
-            currentPoll.Reset();
-        });
-        request->OnError.BindLambda([this](ResponseContext& context)
+    if (lastMessageNumber != oldLastMessageNumber)
+    {
+        if (transport.IsValid())
+        {
+            transport->SetCursor(lastMessageNumber);
+        }
+        if (!cursorDirty)
         {
-            currentPoll.Reset();
-            fetchDelay = DEFAULT_FETCH_THROTTLE_DELAY_SECONDS;
-            context.errorHandled = true;
-            return;
-        });
-        request->Dispatch();
+            cursorDirty = true;
+            cursorSaveDelay = CURSOR_SAVE_DELAY_SECONDS;
+        }
     }
 }
 
 
-void FDriftMessageQueue::ProcessMessage(const FString& queue, const FMessageQueueEntry& message)
+void FDriftMessageQueue::ProcessMessage(const FDriftMessageQueueDelegate* delegate, const FMessageQueueEntry& message)
 {
-    UE_LOG(LogDriftMessages, Log, TEXT("Got message: %s\n%s"), *message.message_id, *JsonArchive::ToString(message.payload));
+    UE_LOG(LogDriftMessages, Verbose, TEXT("Got message %s on queue '%s'"), *message.message_id, *message.queue);
+    UE_LOG(LogDriftMessages, VeryVerbose, TEXT("Message %s payload: %s"), *message.message_id, *JsonArchive::ToString(message.payload));
 
-    const auto delegate = messageHandlers.Find(queue);
     if (delegate)
     {
         delegate->Broadcast(message);
@@ -235,9 +466,84 @@ void FDriftMessageQueue::ProcessMessage(const FString& queue, const FMessageQueu
 }
 
 
-FDriftMessageQueueDelegate& FDriftMessageQueue::OnMessageQueueMessage(const FString& queue)
+bool FDriftMessageQueue::RememberMessage(const FString& messageId)
+{
+    if (messageId.IsEmpty())
+    {
+        return true;
+    }
+
+    bool alreadyKnown = false;
+    recentMessageIdSet.Add(messageId, &alreadyKnown);
+    if (alreadyKnown)
+    {
+        return false;
+    }
+
+    recentMessageIds.Add(messageId);
+    if (recentMessageIds.Num() > MESSAGE_DEDUP_WINDOW)
+    {
+        recentMessageIdSet.Remove(recentMessageIds[0]);
+        recentMessageIds.RemoveAt(0);
+    }
+    return true;
+}
+
+
+void FDriftMessageQueue::LoadCursor()
+{
+    lastMessageNumber = 0;
+    recentMessageIds.Empty();
+    recentMessageIdSet.Empty();
+
+    FString content;
+    if (!FFileHelper::LoadFileToString(content, *cursorFilePath))
+    {
+        return;
+    }
+
+    FMessageQueueCursor cursor;
+    if (!JsonArchive::LoadObject(*content, cursor))
+    {
+        UE_LOG(LogDriftMessages, Warning, TEXT("Failed to parse message queue cursor '%s', starting from the beginning"), *cursorFilePath);
+        return;
+    }
+
+    lastMessageNumber = cursor.last_message_number;
+    for (const auto& messageId : cursor.recent_message_ids)
+    {
+        RememberMessage(messageId);
+    }
+
+    UE_LOG(LogDriftMessages, Verbose, TEXT("Resuming message queue after message %d"), lastMessageNumber);
+}
+
+
+void FDriftMessageQueue::SaveCursor()
 {
-    return messageHandlers.FindOrAdd(queue);
+    cursorDirty = false;
+    if (cursorFilePath.IsEmpty())
+    {
+        return;
+    }
+
+    FMessageQueueCursor cursor;
+    cursor.last_message_number = lastMessageNumber;
+    cursor.recent_message_ids = recentMessageIds;
+
+    FString content;
+    if (!JsonArchive::SaveObject(cursor, content) || !FFileHelper::SaveStringToFile(content, *cursorFilePath))
+    {
+        UE_LOG(LogDriftMessages, Warning, TEXT("Failed to save message queue cursor to '%s'"), *cursorFilePath);
+    }
 }
 
 
+FDriftMessageQueueDelegate& FDriftMessageQueue::OnMessageQueueMessage(const FString& queue)
+{
+    if (const auto handler = messageHandlers.Find(queue))
+    {
+        return handler->Get();
+    }
+    return messageHandlers.Add(queue, MakeShared<FDriftMessageQueueDelegate>()).Get();
+}
@@ -14,7 +14,15 @@
 DECLARE_LOG_CATEGORY_EXTERN(LogDriftMessages, Log, All);
 
 
-class FDriftMessageQueue : public FTickableGameObject, public IDriftMessageQueue
+class IDriftMessageTransport;
+
+
+/** Posts a message payload to the URL, and calls back with the status and error if it failed */
+using FDriftMessageQueueSender = TFunction<void(const TSharedPtr<JsonRequestManager>& requestManager, const FString& url, const JsonValue& payload,
+    TFunction<void(int32 responseCode, const FString& error)> onFailed)>;
+
+
+class FDriftMessageQueue : public FTickableGameObject, public IDriftMessageQueue, public TSharedFromThis<FDriftMessageQueue>
 {
 public:
     FDriftMessageQueue();
@@ -34,26 +42,92 @@ public:
     void SetRequestManager(TSharedPtr<JsonRequestManager> newRequestManager);
     void SetMessageQueueUrl(const FString& newMessageQueueUrl);
 
+    /** Pick up where the last session for this player left off, and remember progress for the next one */
+    void ConfigureSession(int32 playerId);
+
+    /**
+     * Choose how messages are fetched, "websocket" to stream them, or "longpoll".
+     * Streaming falls back to long polling if it can't be used.
+     */
+    void SetPreferredTransport(const FString& name);
+
+    /**
+     * Send messages headed for the same player in one request, if the backend accepts
+     * { "messages": [ { "queue", "message", "expire" }, ... ] } posted to the player's exchange URL.
+     * Only URL templates ending in '/{queue}' have an exchange URL, messages to others are always sent on their own.
+     */
+    void SetBatchSend(bool enabled) { batchSend = enabled; }
+
+    /** Replace how messages are posted, mainly for testing without a backend */
+    void SetSender(FDriftMessageQueueSender newSender);
+
+    /** Use a specific transport, e.g. one pointed at a local test server */
+    void SetTransport(TUniquePtr<IDriftMessageTransport> newTransport);
+
+    /**
+     * Send everything waiting in the outbox right away, including messages waiting to be retried.
+     * Failures are not retried, this is meant for when the queue is about to go away.
+     */
+    void Flush();
+
     void SendMessage(const FString& urlTemplate, const FString& queue, JsonValue&& message) override;
     void SendMessage(const FString& urlTemplate, const FString& queue, JsonValue&& message, int timeoutSeconds) override;
 
     virtual FDriftMessageQueueDelegate& OnMessageQueueMessage(const FString& queue) override;
 
 private:
-    void GetMessages();
-    void ProcessMessage(const FString& queue, const FMessageQueueEntry& message);
+    void RestartTransport();
+    void HandleMessages(TArray<TArray<FMessageQueueEntry>>& queues);
+    void HandleTransportFailed(const FString& error);
+    void ProcessMessage(const FDriftMessageQueueDelegate* delegate, const FMessageQueueEntry& message);
+    bool RememberMessage(const FString& messageId);
+
+    struct FOutboundMessage
+    {
+        FString url;
+        /** Where batches are sent, empty unless the queue is the last part of the URL */
+        FString exchangeUrl;
+        FString queue;
+        JsonValue message;
+        int32 timeoutSeconds = 0;
+        int32 attempts = 0;
+        float delay = 0.0f;
+    };
+
+    void FlushOutbox(float deltaTime);
+    void SendReady(TMap<FString, TArray<TSharedRef<FOutboundMessage>>>& ready, bool retry);
+    void SendSingle(TSharedRef<FOutboundMessage> message, bool retry);
+    void SendBatch(const FString& exchangeUrl, TArray<TSharedRef<FOutboundMessage>> messages, bool retry);
+    /** Queue the message for another attempt, unless the queue is gone or it's not worth trying again */
+    static void HandleSendFailure(const TSharedPtr<FDriftMessageQueue>& self, TSharedRef<FOutboundMessage> message, int32 responseCode, const FString& error);
+    static void PostPayload(const TSharedPtr<JsonRequestManager>& requestManager, const FString& url, const JsonValue& payload,
+        TFunction<void(int32 responseCode, const FString& error)> onFailed);
+    void LoadCursor();
+    void SaveCursor();
 
 private:
     TWeakPtr<JsonRequestManager> requestManager;
     FString messageQueueUrl;
 
-    TMap<FString, FDriftMessageQueueDelegate> messageHandlers;
+    /** Shared so that a handler registering for another queue during dispatch can't move the one being broadcast */
+    TMap<FString, TSharedRef<FDriftMessageQueueDelegate>> messageHandlers;
 
-    TWeakPtr<HttpRequest> currentPoll;
+    TUniquePtr<IDriftMessageTransport> transport;
+    FString preferredTransport;
+    bool fallBackToLongPoll = false;
 
     int32 lastMessageNumber = 0;
 
-    float fetchDelay = 0.0f;
-};
+    /** IDs of the most recently processed messages, oldest first, to drop messages delivered twice */
+    TArray<FString> recentMessageIds;
+    TSet<FString> recentMessageIdSet;
 
+    /** Messages waiting to be sent, coalesced and sent on the next tick */
+    TArray<TSharedRef<FOutboundMessage>> outbox;
+    bool batchSend = false;
+    FDriftMessageQueueSender sender;
 
+    FString cursorFilePath;
+    bool cursorDirty = false;
+    float cursorSaveDelay = 0.0f;
+};
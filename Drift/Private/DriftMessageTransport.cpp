@@ -0,0 +1,62 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftMessageTransport.h"
+
+#include "DriftAPI.h"
+#include "JsonArchive.h"
+
+#include "Algo/IsSorted.h"
+
+
+struct FMessageQueue
+{
+    TMap<FString, TArray<FMessageQueueEntry>> queues;
+
+    bool Serialize(SerializationContext& context)
+    {
+        if (context.IsLoading())
+        {
+            queues.Empty();
+            auto& jValue = context.GetValue();
+            if (!jValue.IsObject())
+            {
+                return false;
+            }
+            for (auto& member : jValue.GetObject())
+            {
+                const auto& queue = member.Key;
+                auto& entry = queues.Emplace(queue);
+                context.SerializeProperty(*queue, entry);
+            }
+            return true;
+        }
+        return false;
+    }
+};
+
+
+bool IDriftMessageTransport::ParseMessages(const JsonValue& document, FDriftMessageQueueBatch& queues)
+{
+    FMessageQueue parsed;
+    if (!JsonArchive::LoadObject(document, parsed))
+    {
+        return false;
+    }
+
+    queues.Reserve(queues.Num() + parsed.queues.Num());
+    for (auto& queue : parsed.queues)
+    {
+        if (queue.Value.Num() == 0)
+        {
+            continue;
+        }
+
+        // The backend returns each queue in order, this is only a cheap safety net
+        auto& messages = queues.Add_GetRef(MoveTemp(queue.Value));
+        if (!Algo::IsSorted(messages, [](const FMessageQueueEntry& lhs, const FMessageQueueEntry& rhs) { return lhs.message_number < rhs.message_number; }))
+        {
+            messages.Sort([](const FMessageQueueEntry& lhs, const FMessageQueueEntry& rhs) { return lhs.message_number < rhs.message_number; });
+        }
+    }
+    return true;
+}
@@ -0,0 +1,49 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+class JsonValue;
+struct FMessageQueueEntry;
+
+
+/** Messages grouped by queue, each group ordered by message number */
+using FDriftMessageQueueBatch = TArray<TArray<FMessageQueueEntry>>;
+
+
+DECLARE_DELEGATE_OneParam(FDriftMessageTransportMessagesDelegate, FDriftMessageQueueBatch& /* Queues */);
+DECLARE_DELEGATE_OneParam(FDriftMessageTransportFailedDelegate, const FString& /* Error */);
+
+
+/**
+ * Fetches messages for the player's message queue from the backend.
+ *
+ * Transports report batches of messages through OnMessages, grouped by queue.
+ * The handler is free to move the messages out of the batch.
+ * A transport that can't be used at all reports it through OnFailed, after which the
+ * message queue falls back to long polling.
+ */
+class IDriftMessageTransport
+{
+public:
+    virtual ~IDriftMessageTransport() = default;
+
+    virtual FString GetName() const = 0;
+
+    /** Start fetching messages with numbers higher than lastMessageNumber */
+    virtual void Start(const FString& messageQueueUrl, int32 lastMessageNumber) = 0;
+    virtual void Stop() = 0;
+
+    /** Let the transport know which messages have been processed, used when reconnecting */
+    virtual void SetCursor(int32 lastMessageNumber) = 0;
+
+    virtual void Tick(float deltaTime) {}
+
+    /** Parse a message queue document, in the { "<queue>": [ <message>, ... ], ... } format. Empty queues are left out. */
+    static bool ParseMessages(const JsonValue& document, FDriftMessageQueueBatch& queues);
+
+    FDriftMessageTransportMessagesDelegate OnMessages;
+    FDriftMessageTransportFailedDelegate OnFailed;
+};
@@ -12,74 +12,6 @@
 DEFINE_LOG_CATEGORY(LogDriftParties);
 
 
-struct FDriftPartyInviteMessage : FJsonSerializable
-{
-	BEGIN_JSON_SERIALIZER;
-		JSON_SERIALIZE("invite_id", InviteId);
-		JSON_SERIALIZE("invite_url", InviteUrl);
-		JSON_SERIALIZE("inviting_player_id", InvitingPlayerId);
-		JSON_SERIALIZE("inviting_player_name", InvitingPlayerName);
-		JSON_SERIALIZE("inviting_player_url", InvitingPlayerUrl);
-		END_JSON_SERIALIZER;
-
-	int32 InviteId;
-	FString InviteUrl;
-	int32 InvitingPlayerId;
-	FString InvitingPlayerName;
-	FString InvitingPlayerUrl;
-};
-
-
-struct FDriftPlayerJoinedPartyMessage : FJsonSerializable
-{
-	BEGIN_JSON_SERIALIZER;
-		JSON_SERIALIZE("party_id", PartyId);
-		JSON_SERIALIZE("party_url", PartyUrl);
-		JSON_SERIALIZE("player_id", PlayerId);
-		JSON_SERIALIZE("member_url", MemberUrl);
-		JSON_SERIALIZE("player_url", PlayerUrl);
-		JSON_SERIALIZE("inviting_player_id", InvitingPlayerId);
-		JSON_SERIALIZE("inviting_player_url", InvitingPlayerUrl);
-		END_JSON_SERIALIZER;
-
-	int32 PartyId;
-	FString PartyUrl;
-	int32 PlayerId;
-	FString MemberUrl;
-	FString PlayerUrl;
-	int32 InvitingPlayerId;
-	FString InvitingPlayerUrl;
-};
-
-
-struct FDriftPlayerLeftPartyMessage : FJsonSerializable
-{
-	BEGIN_JSON_SERIALIZER;
-		JSON_SERIALIZE("party_id", PartyId);
-		JSON_SERIALIZE("party_url", PartyUrl);
-		JSON_SERIALIZE("player_id", PlayerId);
-		JSON_SERIALIZE("player_url", PlayerUrl);
-		END_JSON_SERIALIZER;
-
-	int32 PartyId;
-	FString PartyUrl;
-	int32 PlayerId;
-	FString PlayerUrl;
-};
-
-
-struct FDriftPartyDisbandedMessage : FJsonSerializable
-{
-	BEGIN_JSON_SERIALIZER;
-		JSON_SERIALIZE("party_id", PartyId);
-		JSON_SERIALIZE("party_url", PartyUrl);
-		END_JSON_SERIALIZER;
-
-	int32 PartyId;
-	FString PartyUrl;
-};
-
-
 struct FDriftPartyCreatedMessage : FJsonSerializable
 {
 	BEGIN_JSON_SERIALIZER;
@@ -92,44 +24,6 @@ struct FDriftPartyCreatedMessage : FJsonSerializable
 };
 
 
-struct FDriftPartyInviteAcceptedMessage : FJsonSerializable
-{
-	BEGIN_JSON_SERIALIZER;
-	JSON_SERIALIZE("player_id", PlayerId);
-	JSON_SERIALIZE("player_url", PlayerUrl);
-	END_JSON_SERIALIZER;
-
-	int32 PlayerId;
-	FString PlayerUrl;
-};
-
-
-struct FDriftPartyInviteDeclinedMessage : FJsonSerializable
-{
-	BEGIN_JSON_SERIALIZER;
-	JSON_SERIALIZE("player_id", PlayerId);
-	JSON_SERIALIZE("player_url", PlayerUrl);
-	END_JSON_SERIALIZER;
-
-	int32 PlayerId;
-	FString PlayerUrl;
-};
-
-
-struct FDriftPartyInviteCanceledMessage : FJsonSerializable
-{
-	BEGIN_JSON_SERIALIZER;
-	JSON_SERIALIZE("invite_id", InviteId);
-	JSON_SERIALIZE("inviting_player_id", InvitingPlayerId);
-	JSON_SERIALIZE("inviting_player_url", InvitingPlayerUrl);
-	END_JSON_SERIALIZER;
-
-	int32 InviteId;
-	int32 InvitingPlayerId;
-	FString InvitingPlayerUrl;
-};
-
-
 struct FDriftSendPartyInviteResponse : FJsonSerializable
 {
 	BEGIN_JSON_SERIALIZER;
@@ -158,22 +52,6 @@ struct FDriftAcceptPartyInviteResponse : FJsonSerializable
 };
 
 
-struct FDriftPartyResponseMember : FJsonSerializable
-{
-	BEGIN_JSON_SERIALIZER;
-		JSON_SERIALIZE("id", Id);
-		JSON_SERIALIZE("url", Url);
-		JSON_SERIALIZE("player_url", PlayerUrl);
-		JSON_SERIALIZE("player_name", PlayerName);
-		END_JSON_SERIALIZER;
-
-	int32 Id;
-	FString Url;
-	FString PlayerUrl;
-	FString PlayerName;
-};
-
-
 struct FDriftGetPartyResponse : FJsonSerializable
 {
 	BEGIN_JSON_SERIALIZER;
@@ -192,17 +70,34 @@ struct FDriftGetPartyResponse : FJsonSerializable
 };
 
 
-FDriftPartyManager::FDriftPartyManager(TSharedPtr<IDriftMessageQueue> MessageQueue)
-	: MessageQueue_{MoveTemp(MessageQueue)}
+FDriftPartyManager::FDriftPartyManager(TSharedPtr<FDriftSocialSession> SocialSession)
+	: SocialSession_{SocialSession}
 {
-	MessageQueue_->OnMessageQueueMessage(TEXT("party_notification")).AddRaw(
-		this, &FDriftPartyManager::HandlePartyNotification);
+	SocialSession->RegisterHandler(EDriftSocialEvent::PartyInvite, FDriftSocialEventDelegate::CreateRaw(
+		this, &FDriftPartyManager::HandlePartyInviteNotification));
+	SocialSession->RegisterHandler(EDriftSocialEvent::PartyInviteAccepted, FDriftSocialEventDelegate::CreateRaw(
+		this, &FDriftPartyManager::HandlePartyInviteAcceptedNotification));
+	SocialSession->RegisterHandler(EDriftSocialEvent::PartyInviteDeclined, FDriftSocialEventDelegate::CreateRaw(
+		this, &FDriftPartyManager::HandlePartyInviteDeclinedNotification));
+	SocialSession->RegisterHandler(EDriftSocialEvent::PartyInviteCanceled, FDriftSocialEventDelegate::CreateRaw(
+		this, &FDriftPartyManager::HandlePartyInviteCanceledNotification));
+	SocialSession->RegisterHandler(EDriftSocialEvent::PartyPlayerJoined, FDriftSocialEventDelegate::CreateRaw(
+		this, &FDriftPartyManager::HandlePartyPlayerJoinedNotification));
+	SocialSession->RegisterHandler(EDriftSocialEvent::PartyPlayerLeft, FDriftSocialEventDelegate::CreateRaw(
+		this, &FDriftPartyManager::HandlePartyPlayerLeftNotification));
+	SocialSession->RegisterHandler(EDriftSocialEvent::PartyDisbanded, FDriftSocialEventDelegate::CreateRaw(
+		this, &FDriftPartyManager::HandlePartyDisbandedNotification));
+	SocialSession->RegisterParticipant(this);
 }
 
 
 FDriftPartyManager::~FDriftPartyManager()
 {
-	MessageQueue_->OnMessageQueueMessage(TEXT("party_notification")).RemoveAll(this);
+	if (const auto SocialSession = SocialSession_.Pin())
+	{
+		SocialSession->UnregisterHandlers(this);
+		SocialSession->UnregisterParticipant(this);
+	}
 }
 
 
@@ -214,7 +109,7 @@ TSharedPtr<IDriftParty> FDriftPartyManager::GetCachedParty() const
 
 		return {};
 	}
-	return CurrentParty_;
+	return PartyState_.GetParty();
 }
 
 
@@ -249,64 +144,26 @@ bool FDriftPartyManager::QueryParty(FQueryPartyCompletedDelegate Callback)
         {
             UE_LOG(LogDriftParties, Display, TEXT("Found existing party: %s"), *CurrentPartyUrl_);
 
-            // Update party if metadata changed
-            bool bUpdateParty = CurrentMembershipUrl_ != Membership->Url || CurrentPartyId_ != PartyResponse.Id || CurrentPartyUrl_ != PartyResponse.Url;
+            const bool bMetadataChanged = CurrentMembershipUrl_ != Membership->Url || CurrentPartyId_ != PartyResponse.Id || CurrentPartyUrl_ != PartyResponse.Url;
 
-        	TArray<TSharedPtr<IDriftPartyMember>> Members;
-        	for (const auto& Member : PartyResponse.Members)
-        	{
-        		Members.Add(MakeShared<FDriftPartyMember>(Member.PlayerName, Member.Id));
-        	}
+            CurrentMembershipUrl_ = Membership->Url;
+            CurrentPartyId_ = PartyResponse.Id;
+            CurrentPartyUrl_ = PartyResponse.Url;
 
-            // Check if the members have changed if metadata hasn't changed
-            if (!bUpdateParty)
-            {
-                UE_LOG(LogDriftParties, Verbose, TEXT("Checking if party members have changed"));
-
-                for (const auto& Member : Members)
-                {
-                    UE_LOG(LogDriftParties, Verbose, TEXT("Checking for member: %d / %s"), Member->GetPlayerID(), *Member->GetPlayerName());
-
-                    bool bMemberFound = false;
-                    if (CurrentParty_)
-                    {
-                        for (const auto& PartyMember : CurrentParty_->Members)
-                        {
-                            UE_LOG(LogDriftParties, Verbose, TEXT("Comparing cached member: %d / %s"), PartyMember->GetPlayerID(), *PartyMember->GetPlayerName());
-
-                            if (PartyMember.IsValid() && Member->GetPlayerID() == PartyMember->GetPlayerID() && Member->GetPlayerName() == PartyMember->GetPlayerName())
-                            {
-                                bMemberFound = true;
-                                break;
-                            }
-                        }
-                    }
-
-                    if (!bMemberFound)
-                    {
-                        UE_LOG(LogDriftParties, Verbose, TEXT("Member not in cached found: %d / %s"), Member->GetPlayerID(), *Member->GetPlayerName());
-
-                        bUpdateParty = true;
-                        break;
-                    }
-                }
-            }
-            else
+            // Patches the cached party in place, keeping the objects of members that are still in it
+            const bool bMembersChanged = PartyState_.ApplySnapshot(PartyResponse.Id, PartyResponse.Members, PendingMemberChanges_);
+
+            if (const auto SocialSession = SocialSession_.Pin())
             {
-                UE_LOG(LogDriftParties, Verbose, TEXT("Party metadata changed, updating party"));
+                SocialSession->PartySnapshot(true);
             }
 
-            // Update party if needed
-            if (bUpdateParty)
+            if (bMetadataChanged || bMembersChanged)
             {
-                UE_LOG(LogDriftParties, Display, TEXT("Party changed, updating"));
-
-                CurrentMembershipUrl_ = Membership->Url;
-                CurrentPartyId_ = PartyResponse.Id;
-                CurrentPartyUrl_ = PartyResponse.Url;
-                CurrentParty_ = MakeShared<FDriftParty>(PartyResponse.Id, MoveTemp(Members));
+                UE_LOG(LogDriftParties, Display, TEXT("Party changed, %d member changes"), PendingMemberChanges_.Num());
 
                 RaisePartyUpdated(CurrentPartyId_);
+                RaisePartyMemberChanges(CurrentPartyId_);
             }
             else
             {
@@ -316,6 +173,11 @@ bool FDriftPartyManager::QueryParty(FQueryPartyCompletedDelegate Callback)
         else
         {
             UE_LOG(LogDriftParties, Error, TEXT("Found existing party but player is not a member"));
+
+            if (const auto SocialSession = SocialSession_.Pin())
+            {
+                SocialSession->PartySnapshot(false);
+            }
         }
     });
 	Request->OnError.BindLambda([](ResponseContext& Context)
@@ -335,7 +197,7 @@ bool FDriftPartyManager::LeaveParty(int PartyId, FLeavePartyCompletedDelegate Ca
 
 		return false;
 	}
-	if (!CurrentParty_.IsValid())
+	if (!PartyState_.GetParty().IsValid())
 	{
 		UE_LOG(LogDriftParties, Error, TEXT("Trying to leave a party without being in one"));
 
@@ -346,11 +208,16 @@ bool FDriftPartyManager::LeaveParty(int PartyId, FLeavePartyCompletedDelegate Ca
 	{
 		CurrentPartyUrl_.Empty();
 		CurrentPartyId_ = INDEX_NONE;
-		CurrentParty_.Reset();
+		PartyState_.Reset();
 		CurrentMembershipUrl_.Empty();
 
 		UE_LOG(LogDriftParties, Verbose, TEXT("Player left party"));
 
+		if (const auto SocialSession = SocialSession_.Pin())
+		{
+			SocialSession->PartySnapshot(false);
+		}
+
 		RaisePartyUpdated(PartyId);
 
 		(void)Callback.ExecuteIfBound(true, PartyId);
@@ -561,12 +428,24 @@ FPartyUpdatedDelegate& FDriftPartyManager::OnPartyUpdated()
 }
 
 
+FPartyMemberChangedDelegate& FDriftPartyManager::OnPartyMemberChanged()
+{
+	return OnPartyMemberChangedDelegate_;
+}
+
+
 void FDriftPartyManager::SetRequestManager(TSharedPtr<JsonRequestManager> RequestManager)
 {
 	RequestManager_ = RequestManager;
 }
 
 
+void FDriftPartyManager::ConfigureSession(const FDriftEndpointsResponse& DriftEndpoints, int32 PlayerId)
+{
+	ConfigureSession(PlayerId, DriftEndpoints.party_invites, DriftEndpoints.parties);
+}
+
+
 void FDriftPartyManager::ConfigureSession(int32 PlayerId, const FString& PartyInvitesUrl, const FString& PartiesUrl)
 {
 	PlayerId_ = PlayerId;
@@ -624,6 +503,19 @@ void FDriftPartyManager::RaisePartyUpdated(int32 PartyId)
 }
 
 
+void FDriftPartyManager::RaisePartyMemberChanges(int32 PartyId)
+{
+	// Listeners may cause more changes, which go out in their own round
+	auto Changes = MoveTemp(PendingMemberChanges_);
+	PendingMemberChanges_.Reset();
+
+	for (const auto& Change : Changes)
+	{
+		OnPartyMemberChangedDelegate_.Broadcast(PartyId, Change.PlayerId, Change.Change);
+	}
+}
+
+
 bool FDriftPartyManager::HasSession() const
 {
 	return !PartyInvitesUrl_.IsEmpty() && RequestManager_.IsValid();
@@ -648,186 +540,99 @@ void FDriftPartyManager::RemoveInviteToPlayer(int32 InvitedPlayerId)
 }
 
 
-void FDriftPartyManager::HandlePartyNotification(const FMessageQueueEntry& Message)
-{
-	const auto EventField = Message.payload.FindField(TEXT("event"));
-	if (!EventField.IsString())
-	{
-		UE_LOG(LogDriftParties, Error, TEXT("Party notification message contains no event"));
-
-		return;
-	}
-
-	const auto EventName = EventField.GetString();
-
-	UE_LOG(LogDriftParties, Verbose, TEXT("Received party notification (%d): %s"), *Message.message_id, *EventName);
-
-	if (EventName == TEXT("invite"))
-	{
-		HandlePartyInviteNotification(Message);
-	}
-	else if (EventName == TEXT("invite_accepted"))
-	{
-		HandlePartyInviteAcceptedNotification(Message);
-	}
-	else if (EventName == TEXT("invite_declined"))
-	{
-		HandlePartyInviteDeclinedNotification(Message);
-	}
-	else if (EventName == TEXT("invite_canceled"))
-	{
-		HandlePartyInviteCanceledNotification(Message);
-	}
-	else if (EventName == TEXT("player_joined"))
-	{
-		HandlePartyPlayerJoinedNotification(Message);
-	}
-	else if (EventName == TEXT("player_left"))
-	{
-		HandlePartyPlayerLeftNotification(Message);
-	}
-	else if (EventName == TEXT("disbanded"))
-	{
-		HandlePartyDisbandedNotification(Message);
-	}
-}
-
-
-void FDriftPartyManager::HandlePartyInviteNotification(const FMessageQueueEntry& Message)
+void FDriftPartyManager::HandlePartyInviteNotification(const FDriftSocialEvent& Event)
 {
-	FDriftPartyInviteMessage Payload{};
-	if (!Payload.FromJson(Message.payload.GetInternalValue()->AsObject()))
-	{
-		UE_LOG(LogDriftParties, Error, TEXT("Failed to serialize party invite message"));
-		return;
-	}
+	const auto& Payload = Event.Party;
 
-	RemoveExistingInvitesFromPlayer(Payload.InvitingPlayerId);
+	RemoveExistingInvitesFromPlayer(Payload.inviting_player_id);
 
 	IncomingInvites_.Add(
-		MakeShared<FDriftPartyInvite>(Payload.InviteUrl, Payload.InviteId, Payload.InvitingPlayerId, Payload.InvitingPlayerName, 0));
+		MakeShared<FDriftPartyInvite>(Payload.invite_url, Payload.invite_id, Payload.inviting_player_id, Payload.inviting_player_name, 0));
 
-	UE_LOG(LogDriftParties, Log, TEXT("Got a party invite from player %d"), Payload.InvitingPlayerId);
+	UE_LOG(LogDriftParties, Log, TEXT("Got a party invite from player %d"), Payload.inviting_player_id);
 
-	RaisePartyInviteReceived(Payload.InviteId, Payload.InvitingPlayerId, Payload.InvitingPlayerName);
+	RaisePartyInviteReceived(Payload.invite_id, Payload.inviting_player_id, Payload.inviting_player_name);
 }
 
 
-void FDriftPartyManager::HandlePartyInviteAcceptedNotification(const FMessageQueueEntry& Message)
+void FDriftPartyManager::HandlePartyInviteAcceptedNotification(const FDriftSocialEvent& Event)
 {
-	FDriftPartyInviteAcceptedMessage Payload{};
-	if (!Payload.FromJson(Message.payload.GetInternalValue()->AsObject()))
-	{
-		UE_LOG(LogDriftParties, Error, TEXT("Failed to serialize party invite accepted message"));
-		return;
-	}
-
 	// TODO: Refresh party
 }
 
 
-void FDriftPartyManager::HandlePartyInviteDeclinedNotification(const FMessageQueueEntry& Message)
+void FDriftPartyManager::HandlePartyInviteDeclinedNotification(const FDriftSocialEvent& Event)
 {
-	FDriftPartyInviteDeclinedMessage Payload{};
-	if (!Payload.FromJson(Message.payload.GetInternalValue()->AsObject()))
-	{
-		UE_LOG(LogDriftParties, Error, TEXT("Failed to serialize party invite declined message"));
-		return;
-	}
+	const auto& Payload = Event.Party;
 
-	RemoveInviteToPlayer(Payload.PlayerId);
+	RemoveInviteToPlayer(Payload.player_id);
 }
 
 
-void FDriftPartyManager::HandlePartyInviteCanceledNotification(const FMessageQueueEntry& Message)
+void FDriftPartyManager::HandlePartyInviteCanceledNotification(const FDriftSocialEvent& Event)
 {
-	FDriftPartyInviteCanceledMessage Payload{};
-	if (!Payload.FromJson(Message.payload.GetInternalValue()->AsObject()))
-	{
-		UE_LOG(LogDriftParties, Error, TEXT("Failed to serialize party invite canceled message"));
-		return;
-	}
+	const auto& Payload = Event.Party;
 
-	RemoveExistingInvitesFromPlayer(Payload.InvitingPlayerId);
+	RemoveExistingInvitesFromPlayer(Payload.inviting_player_id);
 
-	UE_LOG(LogDriftParties, Log, TEXT("A party invite from player %d was canceled"), Payload.InvitingPlayerId);
+	UE_LOG(LogDriftParties, Log, TEXT("A party invite from player %d was canceled"), Payload.inviting_player_id);
 
-	RaisePartyInviteCanceled(Payload.InviteId, Payload.InvitingPlayerId);
+	RaisePartyInviteCanceled(Payload.invite_id, Payload.inviting_player_id);
 }
 
 
-void FDriftPartyManager::HandlePartyPlayerJoinedNotification(const FMessageQueueEntry& Message)
+void FDriftPartyManager::HandlePartyPlayerJoinedNotification(const FDriftSocialEvent& Event)
 {
-	FDriftPlayerJoinedPartyMessage Payload{};
-	if (!Payload.FromJson(Message.payload.GetInternalValue()->AsObject()))
-	{
-		UE_LOG(LogDriftParties, Error, TEXT("Failed to serialize player joined party message"));
-		return;
-	}
+	const auto& Payload = Event.Party;
 
 	if (CurrentPartyUrl_.IsEmpty())
 	{
 		PartyPlayers_.Empty();
-		CurrentPartyUrl_ = Payload.PartyUrl;
+		CurrentPartyUrl_ = Payload.party_url;
 	}
-	else if (CurrentPartyUrl_ != Payload.PartyUrl)
+	else if (CurrentPartyUrl_ != Payload.party_url)
 	{
 		UE_LOG(LogDriftParties, Error
 			   , TEXT("Got notification about player joining a different party than the one you're in"));
 	}
-	PartyPlayers_.Add(Payload.PlayerId);
+	PartyPlayers_.Add(Payload.player_id);
 
-	UE_LOG(LogDriftParties, Log, TEXT("Player %d joined party %s"), Payload.PlayerId, *Payload.PartyUrl);
+	UE_LOG(LogDriftParties, Log, TEXT("Player %d joined party %s"), Payload.player_id, *Payload.party_url);
 
-	RaisePartyMemberJoined(Payload.PartyId, Payload.PlayerId);
+	RaisePartyMemberJoined(Payload.party_id, Payload.player_id);
 
 	// Query party again to update party members array. Maybe add the player name to the notification?
 	QueryParty({});
 }
 
 
-void FDriftPartyManager::HandlePartyPlayerLeftNotification(const FMessageQueueEntry& Message)
+void FDriftPartyManager::HandlePartyPlayerLeftNotification(const FDriftSocialEvent& Event)
 {
-	FDriftPlayerLeftPartyMessage Payload{};
-	if (!Payload.FromJson(Message.payload.GetInternalValue()->AsObject()))
-	{
-		UE_LOG(LogDriftParties, Error, TEXT("Failed to serialize player left party message"));
-		return;
-	}
+	const auto& Payload = Event.Party;
 
-	PartyPlayers_.Remove(Payload.PlayerId);
+	PartyPlayers_.Remove(Payload.player_id);
 
 	// Remove from cached party (Can also be done via QueryParty, unsure which is more desirable)
-	if (CurrentParty_.IsValid())
-	{
-		CurrentParty_->Members.RemoveAll([Payload](const TSharedPtr<IDriftPartyMember>& Member)
-		{
-			return Member->GetPlayerID() == Payload.PlayerId;
-		});
-	}
+	PartyState_.RemoveMember(Payload.player_id, PendingMemberChanges_);
 
-	UE_LOG(LogDriftParties, Log, TEXT("Player %d left party %s"), Payload.PlayerId, *Payload.PartyUrl);
+	UE_LOG(LogDriftParties, Log, TEXT("Player %d left party %s"), Payload.player_id, *Payload.party_url);
 
-	RaisePartyMemberLeft(Payload.PartyId, Payload.PlayerId);
+	RaisePartyMemberLeft(Payload.party_id, Payload.player_id);
+	RaisePartyMemberChanges(Payload.party_id);
 }
 
 
-void FDriftPartyManager::HandlePartyDisbandedNotification(const FMessageQueueEntry& Message)
+void FDriftPartyManager::HandlePartyDisbandedNotification(const FDriftSocialEvent& Event)
 {
-	FDriftPartyDisbandedMessage Payload{};
-	if (!Payload.FromJson(Message.payload.GetInternalValue()->AsObject()))
-	{
-		UE_LOG(LogDriftParties, Error, TEXT("Failed to serialize party disbanded message"));
-		return;
-	}
+	const auto& Payload = Event.Party;
 
 	CurrentPartyUrl_.Empty();
 	PartyPlayers_.Empty();
-	CurrentParty_.Reset();
+	PartyState_.Reset();
 
-	UE_LOG(LogDriftParties, Log, TEXT("Party %s was disbanded"), *Payload.PartyUrl);
+	UE_LOG(LogDriftParties, Log, TEXT("Party %s was disbanded"), *Payload.party_url);
 
-	RaisePartyDisbanded(Payload.PartyId);
+	RaisePartyDisbanded(Payload.party_id);
 }
 
 
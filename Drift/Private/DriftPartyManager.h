@@ -2,7 +2,8 @@
 
 #pragma once
 
-#include "DriftMessageQueue.h"
+#include "DriftPartyState.h"
+#include "DriftSocialSession.h"
 #include "IDriftPartyManager.h"
 #include "JsonRequestManager.h"
 #include "OnlineSubsystemTypes.h"
@@ -49,54 +50,10 @@ struct FDriftPartyInvite : IDriftPartyInvite
 };
 
 
-struct FDriftPartyMember : IDriftPartyMember
-{
-	FDriftPartyMember(FString PlayerName, int PlayerId)
-		: PlayerName{ PlayerName }
-		, PlayerId{ PlayerId }
-	{}
-
-	FString GetPlayerName() const override
-	{
-		return PlayerName;
-	}
-
-	int GetPlayerID() const override
-	{
-		return PlayerId;
-	}
-
-	FString PlayerName;
-	int PlayerId;
-};
-
-
-struct FDriftParty : IDriftParty
-{
-	FDriftParty(int32 PartyId, TArray<TSharedPtr<IDriftPartyMember>> Members)
-		: PartyId{ PartyId }
-		, Members{ MoveTemp(Members) }
-	{}
-
-	int GetPartyId() const override
-	{
-		return PartyId;
-	}
-
-	TArray<TSharedPtr<IDriftPartyMember>> GetMembers() const override
-	{
-		return Members;
-	}
-
-	int32 PartyId;
-	TArray<TSharedPtr<IDriftPartyMember>> Members;
-};
-
-
-class FDriftPartyManager : public IDriftPartyManager, public FSelfRegisteringExec
+class FDriftPartyManager : public IDriftPartyManager, public IDriftSocialSessionParticipant, public FSelfRegisteringExec
 {
 public:
-	FDriftPartyManager(TSharedPtr<IDriftMessageQueue> MessageQueue);
+	FDriftPartyManager(TSharedPtr<FDriftSocialSession> SocialSession);
 	~FDriftPartyManager();
 
 	// IDriftPartyManager implementation
@@ -122,14 +79,19 @@ public:
 	FPartyMemberLeftDelegate& OnPartyMemberLeft() override;
 	FPartyDisbandedDelegate& OnPartyDisbanded() override;
 	FPartyUpdatedDelegate& OnPartyUpdated() override;
+	FPartyMemberChangedDelegate& OnPartyMemberChanged() override;
 
 	// FSelfRegisteringExec overrides
 
 	virtual bool Exec(class UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar) override;
 
+	// IDriftSocialSessionParticipant overrides
+
+	void SetRequestManager(TSharedPtr<JsonRequestManager> RequestManager) override;
+	void ConfigureSession(const FDriftEndpointsResponse& DriftEndpoints, int32 PlayerId) override;
+
 	// Public API
 
-	void SetRequestManager(TSharedPtr<JsonRequestManager> RequestManager);
 	void ConfigureSession(int32 PlayerId, const FString& PartyInvitesUrl, const FString& PartiesUrl);
 
 protected:
@@ -141,23 +103,23 @@ protected:
 	void RaisePartyMemberLeft(int32 PartyId, int32 PlayerId);
 	void RaisePartyDisbanded(int32 PartyId);
 	void RaisePartyUpdated(int32 PartyId);
+	void RaisePartyMemberChanges(int32 PartyId);
 
 private:
 	bool HasSession() const;
 	void RemoveExistingInvitesFromPlayer(int32 InvitingPlayerId);
 	void RemoveInviteToPlayer(int32 InvitedPlayerId);
-	void HandlePartyNotification(const FMessageQueueEntry& Message);
-	void HandlePartyInviteNotification(const FMessageQueueEntry& Message);
-	void HandlePartyInviteAcceptedNotification(const FMessageQueueEntry& Message);
-	void HandlePartyInviteDeclinedNotification(const FMessageQueueEntry& Message);
-	void HandlePartyInviteCanceledNotification(const FMessageQueueEntry& Message);
-	void HandlePartyPlayerJoinedNotification(const FMessageQueueEntry& Message);
-	void HandlePartyPlayerLeftNotification(const FMessageQueueEntry& Message);
-	void HandlePartyDisbandedNotification(const FMessageQueueEntry& Message);
+	void HandlePartyInviteNotification(const FDriftSocialEvent& Event);
+	void HandlePartyInviteAcceptedNotification(const FDriftSocialEvent& Event);
+	void HandlePartyInviteDeclinedNotification(const FDriftSocialEvent& Event);
+	void HandlePartyInviteCanceledNotification(const FDriftSocialEvent& Event);
+	void HandlePartyPlayerJoinedNotification(const FDriftSocialEvent& Event);
+	void HandlePartyPlayerLeftNotification(const FDriftSocialEvent& Event);
+	void HandlePartyDisbandedNotification(const FDriftSocialEvent& Event);
 
 	void TryGetCurrentParty();
 
-	TSharedPtr<IDriftMessageQueue> MessageQueue_;
+	TWeakPtr<FDriftSocialSession> SocialSession_;
 
 	TSharedPtr<JsonRequestManager> RequestManager_;
 	FString PartyInvitesUrl_;
@@ -165,7 +127,8 @@ private:
 	int32 PlayerId_;
 	TArray<TSharedPtr<FDriftPartyInvite>> OutgoingInvites_;
 	TArray<TSharedPtr<FDriftPartyInvite>> IncomingInvites_;
-	TSharedPtr<FDriftParty> CurrentParty_;
+	FDriftPartyState PartyState_;
+	TArray<FDriftPartyMemberChange> PendingMemberChanges_;
 	int32 CurrentPartyId_;
 	FString CurrentPartyUrl_;
 	FString CurrentMembershipUrl_;
@@ -179,4 +142,5 @@ private:
 	FPartyMemberLeftDelegate OnPartyMemberLeftDelegate_;
 	FPartyDisbandedDelegate OnPartyDisbandedDelegate_;
 	FPartyUpdatedDelegate OnPartyUpdatedDelegate_;
+	FPartyMemberChangedDelegate OnPartyMemberChangedDelegate_;
 };
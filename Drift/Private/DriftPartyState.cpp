@@ -0,0 +1,81 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftPartyState.h"
+
+
+bool FDriftPartyState::ApplySnapshot(int32 PartyId, TArrayView<const FDriftPartyResponseMember> Members, TArray<FDriftPartyMemberChange>& OutChanges)
+{
+	const auto NumChanges = OutChanges.Num();
+	const auto bNewParty = !Party.IsValid() || Party->PartyId != PartyId;
+
+	if (bNewParty)
+	{
+		Reset();
+		Party = MakeShared<FDriftParty>(PartyId, TArray<TSharedPtr<IDriftPartyMember>>{});
+	}
+	else
+	{
+		TSet<int32, DefaultKeyFuncs<int32>, TInlineSetAllocator<16>> PresentPlayerIds;
+		for (const auto& Member : Members)
+		{
+			PresentPlayerIds.Add(Member.Id);
+		}
+
+		Party->Members.RemoveAll([this, &PresentPlayerIds, &OutChanges](const TSharedPtr<IDriftPartyMember>& Member)
+		{
+			const auto PlayerId = Member->GetPlayerID();
+			if (PresentPlayerIds.Contains(PlayerId))
+			{
+				return false;
+			}
+
+			MembersById.Remove(PlayerId);
+			OutChanges.Add({ PlayerId, EDriftPartyMemberChange::Left });
+			return true;
+		});
+	}
+
+	for (const auto& ResponseMember : Members)
+	{
+		if (const auto Existing = MembersById.Find(ResponseMember.Id))
+		{
+			if ((*Existing)->PlayerName != ResponseMember.PlayerName)
+			{
+				(*Existing)->PlayerName = ResponseMember.PlayerName;
+				OutChanges.Add({ ResponseMember.Id, EDriftPartyMemberChange::Renamed });
+			}
+		}
+		else
+		{
+			const auto Member = MakeShared<FDriftPartyMember>(ResponseMember.PlayerName, ResponseMember.Id);
+			Party->Members.Add(Member);
+			MembersById.Add(ResponseMember.Id, Member);
+			OutChanges.Add({ ResponseMember.Id, EDriftPartyMemberChange::Joined });
+		}
+	}
+
+	return bNewParty || OutChanges.Num() != NumChanges;
+}
+
+
+bool FDriftPartyState::RemoveMember(int32 PlayerId, TArray<FDriftPartyMemberChange>& OutChanges)
+{
+	if (!Party.IsValid() || MembersById.Remove(PlayerId) == 0)
+	{
+		return false;
+	}
+
+	Party->Members.RemoveAll([PlayerId](const TSharedPtr<IDriftPartyMember>& Member)
+	{
+		return Member->GetPlayerID() == PlayerId;
+	});
+	OutChanges.Add({ PlayerId, EDriftPartyMemberChange::Left });
+	return true;
+}
+
+
+void FDriftPartyState::Reset()
+{
+	Party.Reset();
+	MembersById.Reset();
+}
@@ -0,0 +1,102 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#pragma once
+
+#include "IDriftPartyManager.h"
+
+#include "Serialization/JsonSerializerMacros.h"
+
+
+struct FDriftPartyMember : IDriftPartyMember
+{
+	FDriftPartyMember(FString PlayerName, int PlayerId)
+		: PlayerName{ PlayerName }
+		, PlayerId{ PlayerId }
+	{}
+
+	FString GetPlayerName() const override
+	{
+		return PlayerName;
+	}
+
+	int GetPlayerID() const override
+	{
+		return PlayerId;
+	}
+
+	FString PlayerName;
+	int PlayerId;
+};
+
+
+struct FDriftParty : IDriftParty
+{
+	FDriftParty(int32 PartyId, TArray<TSharedPtr<IDriftPartyMember>> Members)
+		: PartyId{ PartyId }
+		, Members{ MoveTemp(Members) }
+	{}
+
+	int GetPartyId() const override
+	{
+		return PartyId;
+	}
+
+	TArray<TSharedPtr<IDriftPartyMember>> GetMembers() const override
+	{
+		return Members;
+	}
+
+	int32 PartyId;
+	TArray<TSharedPtr<IDriftPartyMember>> Members;
+};
+
+
+
+
+struct FDriftPartyResponseMember : FJsonSerializable
+{
+	BEGIN_JSON_SERIALIZER;
+		JSON_SERIALIZE("id", Id);
+		JSON_SERIALIZE("url", Url);
+		JSON_SERIALIZE("player_url", PlayerUrl);
+		JSON_SERIALIZE("player_name", PlayerName);
+		END_JSON_SERIALIZER;
+
+	int32 Id;
+	FString Url;
+	FString PlayerUrl;
+	FString PlayerName;
+};
+
+
+struct FDriftPartyMemberChange
+{
+	int32 PlayerId = INDEX_NONE;
+	EDriftPartyMemberChange Change = EDriftPartyMemberChange::Joined;
+};
+
+
+/**
+ * The locally cached party, patched in place from each party query.
+ *
+ * Members are looked up by player id, so comparing a query with the cache is linear in the
+ * size of the party, and member objects stay the same for as long as the player is in the
+ * party. Each patch reports which members joined, left or were renamed.
+ */
+class FDriftPartyState
+{
+public:
+	const TSharedPtr<FDriftParty>& GetParty() const { return Party; }
+
+	/* Take the party from a query. Returns whether anything changed, a different party always counts as a change */
+	bool ApplySnapshot(int32 PartyId, TArrayView<const FDriftPartyResponseMember> Members, TArray<FDriftPartyMemberChange>& OutChanges);
+
+	/* Remove a member ahead of the next query */
+	bool RemoveMember(int32 PlayerId, TArray<FDriftPartyMemberChange>& OutChanges);
+
+	void Reset();
+
+private:
+	TSharedPtr<FDriftParty> Party;
+	TMap<int32, TSharedPtr<FDriftPartyMember>> MembersById;
+};
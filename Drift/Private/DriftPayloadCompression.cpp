@@ -0,0 +1,54 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftPayloadCompression.h"
+
+#include "HttpRequest.h"
+
+#include "Misc/Compression.h"
+
+
+static constexpr int32 MIN_SIZE_PAYLOAD_TO_COMPRESS = 200;
+
+
+bool DriftPayloadCompression::Compress(const FString& Payload, TArray<uint8>& Compressed)
+{
+    Compressed.Empty();
+
+    const FTCHARToUTF8 Converter(*Payload);
+    const auto UncompressedSize{ Converter.Length() };
+    if (UncompressedSize < MIN_SIZE_PAYLOAD_TO_COMPRESS)
+    {
+        return false;
+    }
+
+    auto CompressedSize = FCompression::CompressMemoryBound(NAME_Gzip, UncompressedSize);
+    Compressed.SetNumUninitialized(CompressedSize);
+
+    const auto Uncompressed = reinterpret_cast<const uint8*>(Converter.Get());
+
+    const auto CompressionResult = FCompression::CompressMemory(NAME_Gzip, Compressed.GetData(), CompressedSize, Uncompressed, UncompressedSize);
+    if (!CompressionResult || CompressedSize >= UncompressedSize)
+    {
+        Compressed.Empty();
+        return false;
+    }
+
+    Compressed.SetNum(CompressedSize);
+    return true;
+}
+
+
+void DriftPayloadCompression::SetContent(HttpRequest& Request, const FString& Payload, const TArray<uint8>& Compressed, bool bUseCompressed)
+{
+    if (bUseCompressed)
+    {
+        Request.SetContent(Compressed);
+        Request.SetHeader(TEXT("Content-Encoding"), TEXT("gzip"));
+    }
+    else
+    {
+        Request.SetPayload(Payload);
+    }
+
+    Request.SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+}
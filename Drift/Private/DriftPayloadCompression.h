@@ -0,0 +1,25 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+class HttpRequest;
+
+
+/**
+ * Gzipping of JSON request bodies, shared by everything that uploads in bulk.
+ * Compression is the expensive part, so it's meant to run on a worker thread.
+ */
+namespace DriftPayloadCompression
+{
+    /**
+     * Gzip the UTF-8 encoding of Payload into Compressed.
+     * Returns false, leaving Compressed empty, if the payload is too small to bother or doesn't get any smaller.
+     */
+    bool Compress(const FString& Payload, TArray<uint8>& Compressed);
+
+    /** Set the JSON body of the request, using the compressed form if there is one */
+    void SetContent(HttpRequest& Request, const FString& Payload, const TArray<uint8>& Compressed, bool bUseCompressed);
+}
@@ -22,6 +22,9 @@ const FName DefaultInstanceName = TEXT("DefaultInstance");
 
 FDriftProvider::FDriftProvider()
 : cache{ FileHttpCacheFactory().Create() }
+, heartbeatMultiplexer{ MakeShared<FDriftHeartbeatMultiplexer>() }
+, staticDataStore{ MakeShared<FDriftStaticDataStore>() }
+, cdnScoreboard{ MakeShared<FDriftCdnScoreboard>() }
 {
 }
 
@@ -40,7 +43,11 @@ IDriftAPI* FDriftProvider::GetInstance(const FName& identifier, const FString& c
     auto instance = instances.Find(keyName);
     if (instance == nullptr)
     {
-        const DriftBasePtr newInstance = MakeShareable(new FDriftBase(cache, keyName, instances.Num(), config), [](IDriftAPI* drift)
+        const auto driftBase = new FDriftBase(cache, keyName, instances.Num(), config);
+        driftBase->SetHeartbeatMultiplexer(heartbeatMultiplexer);
+        driftBase->SetStaticDataStore(staticDataStore);
+        driftBase->SetCdnScoreboard(cdnScoreboard);
+        const DriftBasePtr newInstance = MakeShareable(driftBase, [](IDriftAPI* drift)
         {
 			drift->Shutdown();
             delete drift;
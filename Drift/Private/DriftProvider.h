@@ -15,6 +15,9 @@
 #include "IDriftProvider.h"
 #include "DriftAPI.h"
 #include "DriftHttpCache.h"
+#include "DriftHeartbeatMultiplexer.h"
+#include "DriftStaticDataStore.h"
+#include "DriftCdnScoreboard.h"
 
 #include "Features/IModularFeature.h"
 
@@ -38,4 +41,7 @@ private:
     FCriticalSection mutex;
     
     TSharedPtr<IHttpCache> cache;
+    TSharedPtr<FDriftHeartbeatMultiplexer> heartbeatMultiplexer;
+    TSharedPtr<FDriftStaticDataStore> staticDataStore;
+    TSharedPtr<FDriftCdnScoreboard> cdnScoreboard;
 };
@@ -0,0 +1,70 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftRegionScoring.h"
+
+#include "DriftLatencyProber.h"
+
+
+TOptional<FDriftRegionMeasurement> FDriftRegionScoring::Measure(const FString& Region, const FDriftLatencyEstimate* Estimate, const int32* ServerAverageMs)
+{
+	FDriftRegionMeasurement Measurement;
+	Measurement.Region = Region;
+
+	if (Estimate && Estimate->HasSamples())
+	{
+		Measurement.LatencyMs = Estimate->GetMedian();
+		Measurement.JitterMs = Estimate->GetJitter();
+		Measurement.PacketLoss = Estimate->GetPacketLoss();
+		return Measurement;
+	}
+
+	if (!ServerAverageMs)
+	{
+		return {};
+	}
+
+	// Our probes to it went unanswered, so the server's average says nothing about how it'll play
+	Measurement.LatencyMs = *ServerAverageMs;
+	Measurement.PacketLoss = Estimate ? Estimate->GetPacketLoss() : 0.0f;
+	return Measurement;
+}
+
+TOptional<float> FDriftRegionScoring::Score(const FDriftRegionMeasurement& Measurement, const FDriftRegionScoringSettings& Settings)
+{
+	if (Settings.LatencyCeilingMs > 0.0f && Measurement.LatencyMs > Settings.LatencyCeilingMs)
+	{
+		return {};
+	}
+
+	// Nothing got through at all, whatever the limit
+	if (Measurement.PacketLoss >= 1.0f || Measurement.PacketLoss > Settings.MaxPacketLoss)
+	{
+		return {};
+	}
+
+	const auto RegionWeight = Settings.RegionWeights.Find(Measurement.Region);
+	const auto Weight = RegionWeight ? *RegionWeight : 1.0f;
+	const auto Penalties = Measurement.JitterMs * Settings.JitterWeight + Measurement.PacketLoss * 100.0f * Settings.PacketLossPenaltyMs;
+	return (Measurement.LatencyMs + Penalties) * Weight;
+}
+
+TArray<FDriftRegionScore> FDriftRegionScoring::Rank(const TArray<FDriftRegionMeasurement>& Measurements, const FDriftRegionScoringSettings& Settings)
+{
+	TArray<FDriftRegionScore> Ranked;
+	Ranked.Reserve(Measurements.Num());
+	for (const auto& Measurement : Measurements)
+	{
+		if (const auto RegionScore = Score(Measurement, Settings))
+		{
+			Ranked.Add(FDriftRegionScore{ Measurement.Region, RegionScore.GetValue() });
+		}
+	}
+
+	// Ties keep the order they came in
+	Ranked.StableSort([](const FDriftRegionScore& A, const FDriftRegionScore& B)
+	{
+		return A.Score < B.Score;
+	});
+
+	return Ranked;
+}
@@ -0,0 +1,65 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+class FDriftLatencyEstimate;
+
+/* What is known about the connection to a region */
+struct FDriftRegionMeasurement
+{
+	FString Region;
+	float LatencyMs = 0.0f;
+	float JitterMs = 0.0f;
+	/* Fraction of probes lost, from 0 to 1. A region that never replied has lost them all */
+	float PacketLoss = 0.0f;
+};
+
+
+struct FDriftRegionScoringSettings
+{
+	/* Regions slower than this aren't considered at all. Zero or less for no ceiling */
+	float LatencyCeilingMs = 250.0f;
+	/* Milliseconds added to the score per millisecond of jitter */
+	float JitterWeight = 2.0f;
+	/* Milliseconds added to the score per percent of packet loss */
+	float PacketLossPenaltyMs = 10.0f;
+	/* Regions losing more than this fraction of probes aren't considered at all */
+	float MaxPacketLoss = 0.5f;
+	/* Multiplies the score of a region, so that weights below 1 make it more attractive. Regions not listed weigh 1 */
+	TMap<FString, float> RegionWeights;
+};
+
+
+struct FDriftRegionScore
+{
+	FString Region;
+	/* Effective latency in milliseconds, lower is better */
+	float Score = 0.0f;
+};
+
+
+/**
+ * Ranks regions for matchmaking.
+ *
+ * A region's score is its latency plus penalties for jitter and packet loss, times its
+ * weight, so it reads as an effective latency. Regions over the latency ceiling, or losing
+ * too many probes, are left out.
+ */
+class FDriftRegionScoring
+{
+public:
+	/*
+	 * What is known about a region, from our own estimate if it has any replies, or the
+	 * server's average otherwise. Unset if there's neither.
+	 */
+	static TOptional<FDriftRegionMeasurement> Measure(const FString& Region, const FDriftLatencyEstimate* Estimate, const int32* ServerAverageMs);
+
+	/* Score of a single region, or unset if it isn't eligible */
+	static TOptional<float> Score(const FDriftRegionMeasurement& Measurement, const FDriftRegionScoringSettings& Settings);
+
+	/* Eligible regions from best to worst. Empty if none are */
+	static TArray<FDriftRegionScore> Rank(const TArray<FDriftRegionMeasurement>& Measurements, const FDriftRegionScoringSettings& Settings);
+};
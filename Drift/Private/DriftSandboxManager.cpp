@@ -3,17 +3,22 @@
 #include "DriftSandboxManager.h"
 
 DEFINE_LOG_CATEGORY(LogDriftSandbox);
-static const FString SandboxMessageQueue(TEXT("sandbox"));
 
-FDriftSandboxManager::FDriftSandboxManager(TSharedPtr<IDriftMessageQueue> InMessageQueue)
-    : MessageQueue{MoveTemp(InMessageQueue)}
+FDriftSandboxManager::FDriftSandboxManager(TSharedPtr<FDriftSocialSession> InSocialSession)
+    : SocialSession{InSocialSession}
 {
-    MessageQueue->OnMessageQueueMessage(SandboxMessageQueue).AddRaw(this, &FDriftSandboxManager::HandleSandboxEvent);
+    InSocialSession->RegisterHandler(EDriftSocialEvent::SandboxSessionReserved, FDriftSocialEventDelegate::CreateRaw(this, &FDriftSandboxManager::HandleSessionReserved));
+    InSocialSession->RegisterHandler(EDriftSocialEvent::SandboxSessionCreationFailed, FDriftSocialEventDelegate::CreateRaw(this, &FDriftSandboxManager::HandleSessionCreationFailed));
+    InSocialSession->RegisterParticipant(this);
 }
 
 FDriftSandboxManager::~FDriftSandboxManager()
 {
-    MessageQueue->OnMessageQueueMessage(SandboxMessageQueue).RemoveAll(this);
+    if (const auto Session = SocialSession.Pin())
+    {
+        Session->UnregisterHandlers(this);
+        Session->UnregisterParticipant(this);
+    }
 }
 
 void FDriftSandboxManager::SetRequestManager(TSharedPtr<JsonRequestManager> RootRequestManager)
@@ -61,41 +66,19 @@ bool FDriftSandboxManager::JoinSandbox(const int32 SandboxId, FString Queue, FJo
 	return Request->Dispatch();
 }
 
-void FDriftSandboxManager::HandleSandboxEvent(const FMessageQueueEntry& Message)
+void FDriftSandboxManager::HandleSessionReserved(const FDriftSocialEvent& Event)
 {
-    if (Message.sender_id != FDriftMessageQueue::SenderSystemID && Message.sender_id != PlayerId)
-    {
-        UE_LOG(LogDriftSandbox, Error, TEXT("HandleSandboxEvent - Ignoring message from sender '%d'"), Message.sender_id);
-        return;
-    }
-
-    if (!Message.payload.HasField("event") || !Message.payload.HasField("data"))
+    // The social session has already checked the sender and decoded the data
+    if (Event.Sandbox.connection_info.IsEmpty())
     {
-        UE_LOG(LogDriftSandbox, Error, TEXT("HandleSandboxEvent - No event or data field in message. Discarding the event."));
+        UE_LOG(LogDriftSandbox, Error, TEXT("HandleSessionReserved - Event data doesn't contain 'connection_info'. Discarding the event."));
         return;
     }
 
-    const auto Event = Message.payload.FindField("event").GetString();
-    const auto EventData = Message.payload.FindField("data");
-
-    UE_LOG(LogDriftSandbox, Verbose, TEXT("HandleSandboxEvent - Incoming event '%s'"), *Event);
-
-    if (Event.Equals("PlayerSessionReserved"))
-    {
-        if (!EventData.HasField("connection_info"))
-        {
-            UE_LOG(LogDriftSandbox, Error, TEXT("HandleSandboxEvent - Event data doesn't contain 'connection_string'. Discarding the event."));
-            return;
-        }
-        const auto MatchConnectionString = EventData.FindField("connection_info").GetString();
-        OnSandboxJoinStatusChangedDelegate.Broadcast(MatchConnectionString, true);
-        return;
-    }
+    OnSandboxJoinStatusChangedDelegate.Broadcast(Event.Sandbox.connection_info, true);
+}
 
-    if (Event.Equals("SessionCreationFailed"))
-    {
-        const auto JoinError = EventData.FindField("error").GetString();
-        OnSandboxJoinStatusChangedDelegate.Broadcast(JoinError, false);
-        return;
-    }
+void FDriftSandboxManager::HandleSessionCreationFailed(const FDriftSocialEvent& Event)
+{
+    OnSandboxJoinStatusChangedDelegate.Broadcast(Event.Sandbox.error, false);
 }
@@ -3,27 +3,28 @@
 #pragma once
 
 #include "IDriftSandboxManager.h"
-#include "DriftMessageQueue.h"
+#include "DriftSocialSession.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogDriftSandbox, Log, All);
 
-class FDriftSandboxManager : public IDriftSandboxManager
+class FDriftSandboxManager : public IDriftSandboxManager, public IDriftSocialSessionParticipant
 {
 public:
-	FDriftSandboxManager(TSharedPtr<IDriftMessageQueue> InMessageQueue);
+	FDriftSandboxManager(TSharedPtr<FDriftSocialSession> InSocialSession);
 	~FDriftSandboxManager() override;
 
-    void SetRequestManager(TSharedPtr<JsonRequestManager> RootRequestManager);
-    void ConfigureSession(const FDriftEndpointsResponse& DriftEndpoints, int32 InPlayerId);
+    void SetRequestManager(TSharedPtr<JsonRequestManager> RootRequestManager) override;
+    void ConfigureSession(const FDriftEndpointsResponse& DriftEndpoints, int32 InPlayerId) override;
 
     bool JoinSandbox(const int32 SandboxId, FString Queue, FJoinSandboxFinishedDelegate Delegate) override;
     FOnSandboxJoinStatusChangedDelegate& OnSandboxJoinStatusChanged() override { return OnSandboxJoinStatusChangedDelegate; }
 
 private:
-    void HandleSandboxEvent(const FMessageQueueEntry& Message);
+    void HandleSessionReserved(const FDriftSocialEvent& Event);
+    void HandleSessionCreationFailed(const FDriftSocialEvent& Event);
 
     TSharedPtr<JsonRequestManager> RequestManager;
-    TSharedPtr<IDriftMessageQueue> MessageQueue;
+    TWeakPtr<FDriftSocialSession> SocialSession;
     int32 PlayerId = INDEX_NONE;
     FString SandboxURL;
 
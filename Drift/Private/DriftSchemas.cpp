@@ -43,6 +43,7 @@ bool FDriftEndpointsResponse::Serialize(SerializationContext& context)
 		&& SERIALIZE_PROPERTY(context, match_placements)
         && SERIALIZE_PROPERTY(context, public_match_placements)
         && SERIALIZE_PROPERTY(context, sandbox)
+		&& SERIALIZE_OPTIONAL_PROPERTY(context, heartbeats)
 		&& SERIALIZE_PROPERTY(context, template_lobby_member)
 		&& SERIALIZE_PROPERTY(context, template_lobby_members)
 		&& SERIALIZE_PROPERTY(context, template_player_gamestate)
@@ -97,6 +98,7 @@ bool FClientRegistrationResponse::Serialize(SerializationContext& context)
 		&& SERIALIZE_PROPERTY(context, player_id)
 		&& SERIALIZE_PROPERTY(context, user_id)
 		&& SERIALIZE_PROPERTY(context, next_heartbeat_seconds)
+		&& SERIALIZE_OPTIONAL_PROPERTY(context, heartbeat_timeout_seconds)
 		&& SERIALIZE_PROPERTY(context, url)
 		&& SERIALIZE_PROPERTY(context, jwt)
 		&& SERIALIZE_PROPERTY(context, jti);
@@ -364,7 +366,7 @@ bool FDriftLogMessage::Serialize(SerializationContext& context)
     {
         FString adjusted_message = message;
         adjusted_message += FString::Printf(TEXT(" (This log message has been repeated %d times until %s)"), count, *last_entry_timestamp.ToString());
-        context.SerializeProperty(TEXT("message"), message);
+        context.SerializeProperty(TEXT("message"), adjusted_message);
     }
     else
     {
@@ -55,6 +55,8 @@ struct FDriftEndpointsResponse
 	FString match_placements;
     FString public_match_placements;
     FString sandbox;
+	/** Only on backends which accept heartbeats in batches */
+	FString heartbeats;
 
 	// Templates
 	FString template_lobby_member;
@@ -146,6 +148,8 @@ struct FClientRegistrationResponse
 	int32 player_id = 0;
 	int32 user_id = 0;
 	int32 next_heartbeat_seconds = 0;
+	/* Zero if the backend doesn't say */
+	int32 heartbeat_timeout_seconds = 0;
 	FString url;
 	FString jwt;
 	FString jti;
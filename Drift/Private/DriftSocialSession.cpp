@@ -0,0 +1,393 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftSocialSession.h"
+
+#include "JsonArchive.h"
+
+#include "Algo/Find.h"
+
+
+DEFINE_LOG_CATEGORY(LogDriftSocial);
+
+
+static const FString PartyMessageQueue(TEXT("party_notification"));
+static const FString LobbyMessageQueue(TEXT("lobby"));
+static const FString SandboxMessageQueue(TEXT("sandbox"));
+
+
+static constexpr uint8 StateBit(EDriftSocialState State)
+{
+	return static_cast<uint8>(1 << static_cast<uint8>(State));
+}
+
+static constexpr uint8 LobbyStates = StateBit(EDriftSocialState::InLobby) | StateBit(EDriftSocialState::MatchStarting) | StateBit(EDriftSocialState::InMatch);
+static constexpr uint8 OutsideLobbyStates = StateBit(EDriftSocialState::Idle) | StateBit(EDriftSocialState::InParty) | StateBit(EDriftSocialState::InSandbox);
+
+
+struct FDriftSocialTransition
+{
+	EDriftSocialEvent Event;
+	/* States the event moves on from */
+	uint8 From;
+	/* States the event is expected in, but doesn't change */
+	uint8 Unaffected;
+	/* Idle means leaving the lobby, which is back to the party if there is one */
+	EDriftSocialState To;
+};
+
+/* Events not listed don't take part in the lifecycle */
+static const FDriftSocialTransition SocialTransitions[] =
+{
+	{ EDriftSocialEvent::PartyPlayerJoined, StateBit(EDriftSocialState::Idle), StateBit(EDriftSocialState::InParty) | LobbyStates | StateBit(EDriftSocialState::InSandbox), EDriftSocialState::InParty },
+	{ EDriftSocialEvent::PartyPlayerLeft, StateBit(EDriftSocialState::InParty), StateBit(EDriftSocialState::Idle) | LobbyStates | StateBit(EDriftSocialState::InSandbox), EDriftSocialState::Idle },
+	{ EDriftSocialEvent::PartyDisbanded, StateBit(EDriftSocialState::InParty), StateBit(EDriftSocialState::Idle) | LobbyStates | StateBit(EDriftSocialState::InSandbox), EDriftSocialState::Idle },
+
+	{ EDriftSocialEvent::LobbyUpdated, OutsideLobbyStates, LobbyStates, EDriftSocialState::InLobby },
+	{ EDriftSocialEvent::LobbyMemberJoined, OutsideLobbyStates, LobbyStates, EDriftSocialState::InLobby },
+	{ EDriftSocialEvent::LobbyMemberUpdated, OutsideLobbyStates, LobbyStates, EDriftSocialState::InLobby },
+	{ EDriftSocialEvent::LobbyMemberLeft, 0, LobbyStates, EDriftSocialState::InLobby },
+	{ EDriftSocialEvent::LobbyMemberKicked, 0, LobbyStates, EDriftSocialState::InLobby },
+	{ EDriftSocialEvent::LobbyDeleted, LobbyStates, 0, EDriftSocialState::Idle },
+	{ EDriftSocialEvent::LobbyMatchStarting, StateBit(EDriftSocialState::InLobby), StateBit(EDriftSocialState::MatchStarting), EDriftSocialState::MatchStarting },
+	{ EDriftSocialEvent::LobbyMatchStarted, StateBit(EDriftSocialState::InLobby) | StateBit(EDriftSocialState::MatchStarting), StateBit(EDriftSocialState::InMatch), EDriftSocialState::InMatch },
+	{ EDriftSocialEvent::LobbyMatchCancelled, StateBit(EDriftSocialState::MatchStarting), StateBit(EDriftSocialState::InLobby), EDriftSocialState::InLobby },
+	{ EDriftSocialEvent::LobbyMatchTimedOut, StateBit(EDriftSocialState::MatchStarting), StateBit(EDriftSocialState::InLobby), EDriftSocialState::InLobby },
+	{ EDriftSocialEvent::LobbyMatchFailed, StateBit(EDriftSocialState::MatchStarting), StateBit(EDriftSocialState::InLobby), EDriftSocialState::InLobby },
+
+	{ EDriftSocialEvent::SandboxSessionReserved, StateBit(EDriftSocialState::Idle) | StateBit(EDriftSocialState::InParty), StateBit(EDriftSocialState::InSandbox), EDriftSocialState::InSandbox },
+	{ EDriftSocialEvent::SandboxSessionCreationFailed, StateBit(EDriftSocialState::InSandbox), StateBit(EDriftSocialState::Idle) | StateBit(EDriftSocialState::InParty), EDriftSocialState::Idle },
+};
+
+
+bool FDriftPartyEventData::Serialize(SerializationContext& Context)
+{
+	return SERIALIZE_OPTIONAL_PROPERTY(Context, party_id)
+		&& SERIALIZE_OPTIONAL_PROPERTY(Context, party_url)
+		&& SERIALIZE_OPTIONAL_PROPERTY(Context, player_id)
+		&& SERIALIZE_OPTIONAL_PROPERTY(Context, player_url)
+		&& SERIALIZE_OPTIONAL_PROPERTY(Context, member_url)
+		&& SERIALIZE_OPTIONAL_PROPERTY(Context, invite_id)
+		&& SERIALIZE_OPTIONAL_PROPERTY(Context, invite_url)
+		&& SERIALIZE_OPTIONAL_PROPERTY(Context, inviting_player_id)
+		&& SERIALIZE_OPTIONAL_PROPERTY(Context, inviting_player_name)
+		&& SERIALIZE_OPTIONAL_PROPERTY(Context, inviting_player_url);
+}
+
+
+bool FDriftLobbyEventData::Serialize(SerializationContext& Context)
+{
+	return SERIALIZE_OPTIONAL_PROPERTY(Context, lobby_id)
+		&& SERIALIZE_OPTIONAL_PROPERTY(Context, revision)
+		&& SERIALIZE_OPTIONAL_PROPERTY(Context, status)
+		&& SERIALIZE_OPTIONAL_PROPERTY(Context, connection_string)
+		&& SERIALIZE_OPTIONAL_PROPERTY(Context, connection_options)
+		&& SERIALIZE_OPTIONAL_PROPERTY(Context, members);
+}
+
+
+bool FDriftSandboxEventData::Serialize(SerializationContext& Context)
+{
+	return SERIALIZE_OPTIONAL_PROPERTY(Context, connection_info)
+		&& SERIALIZE_OPTIONAL_PROPERTY(Context, error);
+}
+
+
+FDriftSocialSession::FDriftSocialSession(TSharedPtr<IDriftMessageQueue> InMessageQueue)
+	: MessageQueue{InMessageQueue}
+{
+	Routes.Add(PartyMessageQueue, FQueueRoute{ EDriftSocialEventSource::Party, false, false, {
+		{ TEXT("invite"), EDriftSocialEvent::PartyInvite },
+		{ TEXT("invite_accepted"), EDriftSocialEvent::PartyInviteAccepted },
+		{ TEXT("invite_declined"), EDriftSocialEvent::PartyInviteDeclined },
+		{ TEXT("invite_canceled"), EDriftSocialEvent::PartyInviteCanceled },
+		{ TEXT("player_joined"), EDriftSocialEvent::PartyPlayerJoined },
+		{ TEXT("player_left"), EDriftSocialEvent::PartyPlayerLeft },
+		{ TEXT("disbanded"), EDriftSocialEvent::PartyDisbanded },
+	} });
+
+	Routes.Add(LobbyMessageQueue, FQueueRoute{ EDriftSocialEventSource::Lobby, true, true, {
+		{ TEXT("LobbyUpdated"), EDriftSocialEvent::LobbyUpdated },
+		{ TEXT("LobbyDeleted"), EDriftSocialEvent::LobbyDeleted },
+		{ TEXT("LobbyMemberJoined"), EDriftSocialEvent::LobbyMemberJoined },
+		{ TEXT("LobbyMemberUpdated"), EDriftSocialEvent::LobbyMemberUpdated },
+		{ TEXT("LobbyMemberLeft"), EDriftSocialEvent::LobbyMemberLeft },
+		{ TEXT("LobbyMemberKicked"), EDriftSocialEvent::LobbyMemberKicked },
+		{ TEXT("LobbyMatchStarting"), EDriftSocialEvent::LobbyMatchStarting },
+		{ TEXT("LobbyMatchStarted"), EDriftSocialEvent::LobbyMatchStarted },
+		{ TEXT("LobbyMatchCancelled"), EDriftSocialEvent::LobbyMatchCancelled },
+		{ TEXT("LobbyMatchTimedOut"), EDriftSocialEvent::LobbyMatchTimedOut },
+		{ TEXT("LobbyMatchFailed"), EDriftSocialEvent::LobbyMatchFailed },
+	} });
+
+	Routes.Add(SandboxMessageQueue, FQueueRoute{ EDriftSocialEventSource::Sandbox, true, true, {
+		{ TEXT("PlayerSessionReserved"), EDriftSocialEvent::SandboxSessionReserved },
+		{ TEXT("SessionCreationFailed"), EDriftSocialEvent::SandboxSessionCreationFailed },
+	} });
+
+	for (const auto& Route : Routes)
+	{
+		InMessageQueue->OnMessageQueueMessage(Route.Key).AddRaw(this, &FDriftSocialSession::HandleMessage);
+	}
+}
+
+FDriftSocialSession::~FDriftSocialSession()
+{
+	if (const auto Queue = MessageQueue.Pin())
+	{
+		for (const auto& Route : Routes)
+		{
+			Queue->OnMessageQueueMessage(Route.Key).RemoveAll(this);
+		}
+	}
+}
+
+void FDriftSocialSession::RegisterHandler(EDriftSocialEvent Type, FDriftSocialEventDelegate Handler)
+{
+	EventHandlers.Add(Type, MoveTemp(Handler));
+}
+
+void FDriftSocialSession::RegisterSourceHandler(EDriftSocialEventSource Source, FDriftSocialEventDelegate Handler)
+{
+	SourceHandlers.Add(Source, MoveTemp(Handler));
+}
+
+void FDriftSocialSession::RegisterParticipant(IDriftSocialSessionParticipant* Participant)
+{
+	Participants.AddUnique(Participant);
+}
+
+void FDriftSocialSession::UnregisterHandlers(const void* Owner)
+{
+	for (auto It = EventHandlers.CreateIterator(); It; ++It)
+	{
+		if (It->Value.IsBoundToObject(Owner))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	for (auto It = SourceHandlers.CreateIterator(); It; ++It)
+	{
+		if (It->Value.IsBoundToObject(Owner))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FDriftSocialSession::UnregisterParticipant(IDriftSocialSessionParticipant* Participant)
+{
+	Participants.Remove(Participant);
+}
+
+void FDriftSocialSession::SetRequestManager(TSharedPtr<JsonRequestManager> RootRequestManager)
+{
+	for (const auto Participant : Participants)
+	{
+		Participant->SetRequestManager(RootRequestManager);
+	}
+}
+
+void FDriftSocialSession::ConfigureSession(const FDriftEndpointsResponse& DriftEndpoints, int32 InPlayerId)
+{
+	PlayerId = InPlayerId;
+
+	for (const auto Participant : Participants)
+	{
+		Participant->ConfigureSession(DriftEndpoints, PlayerId);
+	}
+}
+
+void FDriftSocialSession::PartySnapshot(bool bInPartyNow)
+{
+	bInParty = bInPartyNow;
+
+	if (State == EDriftSocialState::Idle || State == EDriftSocialState::InParty)
+	{
+		SetState(GetStateOutsideLobby());
+	}
+}
+
+void FDriftSocialSession::LobbySnapshot(bool bInLobby, EDriftLobbyStatus Status)
+{
+	if (!bInLobby)
+	{
+		if (LobbyStates & StateBit(State))
+		{
+			SetState(GetStateOutsideLobby());
+		}
+		return;
+	}
+
+	switch (Status)
+	{
+		case EDriftLobbyStatus::Starting:
+			SetState(EDriftSocialState::MatchStarting);
+			break;
+
+		case EDriftLobbyStatus::Started:
+			SetState(EDriftSocialState::InMatch);
+			break;
+
+		default:
+			SetState(EDriftSocialState::InLobby);
+	}
+}
+
+const TCHAR* FDriftSocialSession::StateToString(EDriftSocialState InState)
+{
+	switch (InState)
+	{
+		case EDriftSocialState::Idle: return TEXT("Idle");
+		case EDriftSocialState::InParty: return TEXT("InParty");
+		case EDriftSocialState::InLobby: return TEXT("InLobby");
+		case EDriftSocialState::MatchStarting: return TEXT("MatchStarting");
+		case EDriftSocialState::InMatch: return TEXT("InMatch");
+		case EDriftSocialState::InSandbox: return TEXT("InSandbox");
+	}
+
+	return TEXT("Unknown");
+}
+
+void FDriftSocialSession::HandleMessage(const FMessageQueueEntry& Message)
+{
+	const auto Route = Routes.Find(Message.queue);
+	if (!Route)
+	{
+		return;
+	}
+
+	if (Route->bSystemOrSelfOnly && Message.sender_id != IDriftMessageQueue::SenderSystemID && Message.sender_id != PlayerId)
+	{
+		UE_LOG(LogDriftSocial, Error, TEXT("Ignoring message %s on queue '%s' from sender '%d'"), *Message.message_id, *Message.queue, Message.sender_id);
+		return;
+	}
+
+	const auto EventField = Message.payload.FindField(TEXT("event"));
+	if (!EventField.IsString())
+	{
+		UE_LOG(LogDriftSocial, Error, TEXT("Message %s on queue '%s' contains no event"), *Message.message_id, *Message.queue);
+		return;
+	}
+
+	FDriftSocialEvent Event;
+	Event.Source = Route->Source;
+	Event.Name = EventField.GetString();
+	const auto Type = Route->EventTypes.Find(Event.Name);
+	Event.Type = Type ? *Type : EDriftSocialEvent::Unknown;
+	if (!DecodeEvent(Message, Route->bDataField, Event))
+	{
+		UE_LOG(LogDriftSocial, Error, TEXT("Failed to decode event '%s' (%s) on queue '%s'"), *Event.Name, *Message.message_id, *Message.queue);
+		return;
+	}
+
+	UE_LOG(LogDriftSocial, Verbose, TEXT("Received event '%s' (%s) on queue '%s'"), *Event.Name, *Message.message_id, *Message.queue);
+
+	ApplyTransition(Event);
+
+	if (const auto Handler = EventHandlers.Find(Event.Type))
+	{
+		// Copy, the handler may register or unregister handlers
+		const auto Delegate = *Handler;
+		Delegate.ExecuteIfBound(Event);
+	}
+	else if (const auto SourceHandler = SourceHandlers.Find(Event.Source))
+	{
+		const auto Delegate = *SourceHandler;
+		Delegate.ExecuteIfBound(Event);
+	}
+	else
+	{
+		UE_LOG(LogDriftSocial, Verbose, TEXT("No handler for event '%s' on queue '%s'"), *Event.Name, *Message.queue);
+	}
+}
+
+bool FDriftSocialSession::DecodeEvent(const FMessageQueueEntry& Message, bool bDataField, FDriftSocialEvent& Event)
+{
+	const auto Data = bDataField ? Message.payload.FindField(TEXT("data")) : Message.payload;
+
+	switch (Event.Source)
+	{
+		case EDriftSocialEventSource::Party:
+			return JsonArchive::LoadObject(Data, Event.Party);
+
+		case EDriftSocialEventSource::Lobby:
+			if (!JsonArchive::LoadObject(Data, Event.Lobby))
+			{
+				return false;
+			}
+			return Event.Type != EDriftSocialEvent::LobbyUpdated || Event.Lobby.Lobby.FromJson(Data.GetInternalValue()->AsObject());
+
+		case EDriftSocialEventSource::Sandbox:
+			return JsonArchive::LoadObject(Data, Event.Sandbox);
+	}
+
+	return false;
+}
+
+void FDriftSocialSession::ApplyTransition(const FDriftSocialEvent& Event)
+{
+	// Only our own leaving takes us out of the party
+	if (Event.Type == EDriftSocialEvent::PartyPlayerLeft && Event.Party.player_id != PlayerId)
+	{
+		return;
+	}
+
+	const auto Transition = Algo::FindByPredicate(SocialTransitions, [&Event](const FDriftSocialTransition& Candidate)
+	{
+		return Candidate.Event == Event.Type;
+	});
+	if (!Transition)
+	{
+		return;
+	}
+
+	switch (Event.Type)
+	{
+		case EDriftSocialEvent::PartyPlayerJoined:
+			bInParty = true;
+			break;
+
+		case EDriftSocialEvent::PartyPlayerLeft:
+		case EDriftSocialEvent::PartyDisbanded:
+			bInParty = false;
+			break;
+
+		default:
+			break;
+	}
+
+	const auto CurrentBit = StateBit(State);
+	if (Transition->Unaffected & CurrentBit)
+	{
+		return;
+	}
+
+	if (!(Transition->From & CurrentBit))
+	{
+		UE_LOG(LogDriftSocial, Warning, TEXT("Event '%s' is not expected while '%s', state left as it is"), *Event.Name, StateToString(State));
+		OnInvalidTransitionDelegate.Broadcast(State, Event.Type);
+		return;
+	}
+
+	SetState(Transition->To == EDriftSocialState::Idle ? GetStateOutsideLobby() : Transition->To);
+}
+
+void FDriftSocialSession::SetState(EDriftSocialState NewState)
+{
+	if (NewState == State)
+	{
+		return;
+	}
+
+	const auto OldState = State;
+	State = NewState;
+
+	UE_LOG(LogDriftSocial, Log, TEXT("Social state changed from '%s' to '%s'"), StateToString(OldState), StateToString(NewState));
+	OnStateChangedDelegate.Broadcast(OldState, NewState);
+}
+
+EDriftSocialState FDriftSocialSession::GetStateOutsideLobby() const
+{
+	return bInParty ? EDriftSocialState::InParty : EDriftSocialState::Idle;
+}
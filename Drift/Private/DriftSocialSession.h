@@ -0,0 +1,224 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#pragma once
+
+#include "DriftAPI.h"
+#include "DriftLobbyState.h"
+#include "DriftSchemas.h"
+#include "IDriftLobbyManager.h"
+#include "IDriftMessageQueue.h"
+#include "JsonRequestManager.h"
+
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDriftSocial, Log, All);
+
+
+enum class EDriftSocialEventSource : uint8
+{
+	Party,
+	Lobby,
+	Sandbox,
+};
+
+
+enum class EDriftSocialEvent : uint8
+{
+	Unknown,
+
+	PartyInvite,
+	PartyInviteAccepted,
+	PartyInviteDeclined,
+	PartyInviteCanceled,
+	PartyPlayerJoined,
+	PartyPlayerLeft,
+	PartyDisbanded,
+
+	LobbyUpdated,
+	LobbyDeleted,
+	LobbyMemberJoined,
+	LobbyMemberUpdated,
+	LobbyMemberLeft,
+	LobbyMemberKicked,
+	LobbyMatchStarting,
+	LobbyMatchStarted,
+	LobbyMatchCancelled,
+	LobbyMatchTimedOut,
+	LobbyMatchFailed,
+
+	SandboxSessionReserved,
+	SandboxSessionCreationFailed,
+};
+
+
+/**
+ * Where the player is in the party -> lobby -> match -> sandbox lifecycle
+ */
+enum class EDriftSocialState : uint8
+{
+	Idle,
+	InParty,
+	InLobby,
+	MatchStarting,
+	InMatch,
+	InSandbox,
+};
+
+
+/**
+ * Fields of party events, which carry them alongside 'event'. Each event has only some of them
+ */
+struct FDriftPartyEventData
+{
+	int32 party_id = 0;
+	FString party_url;
+	int32 player_id = 0;
+	FString player_url;
+	FString member_url;
+	int32 invite_id = 0;
+	FString invite_url;
+	int32 inviting_player_id = 0;
+	FString inviting_player_name;
+	FString inviting_player_url;
+
+	bool Serialize(SerializationContext& Context);
+};
+
+
+/**
+ * Fields of lobby events, found under 'data'. Each event has only some of them
+ */
+struct FDriftLobbyEventData
+{
+	FString lobby_id;
+	/* The lobby revision the event produces, INDEX_NONE if the backend doesn't track them */
+	int64 revision = INDEX_NONE;
+	FString status;
+	FString connection_string;
+	FString connection_options;
+	/* Every member after the event, null if the event doesn't list them */
+	JsonValue members;
+
+	/* The whole lobby, only decoded for LobbyUpdated */
+	FDriftLobbyResponse Lobby;
+
+	bool Serialize(SerializationContext& Context);
+};
+
+
+/**
+ * Fields of sandbox events, found under 'data'
+ */
+struct FDriftSandboxEventData
+{
+	FString connection_info;
+	FString error;
+
+	bool Serialize(SerializationContext& Context);
+};
+
+
+/**
+ * A message queue message, decoded once for whoever handles it
+ */
+struct FDriftSocialEvent
+{
+	EDriftSocialEventSource Source;
+	EDriftSocialEvent Type;
+	FString Name;
+	/* Only the fields for the event's source are filled in */
+	FDriftPartyEventData Party;
+	FDriftLobbyEventData Lobby;
+	FDriftSandboxEventData Sandbox;
+};
+
+
+DECLARE_DELEGATE_OneParam(FDriftSocialEventDelegate, const FDriftSocialEvent& /* Event */);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FDriftSocialStateChangedDelegate, EDriftSocialState /* OldState */, EDriftSocialState /* NewState */);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FDriftSocialInvalidTransitionDelegate, EDriftSocialState /* State */, EDriftSocialEvent /* Event */);
+
+
+/**
+ * Anything configured together with the social session
+ */
+class IDriftSocialSessionParticipant
+{
+public:
+	virtual void SetRequestManager(TSharedPtr<JsonRequestManager> RootRequestManager) = 0;
+	virtual void ConfigureSession(const FDriftEndpointsResponse& DriftEndpoints, int32 PlayerId) = 0;
+
+	virtual ~IDriftSocialSessionParticipant() = default;
+};
+
+
+/**
+ * Single entry point for party, lobby and sandbox events.
+ *
+ * Each message from the social queues is checked and decoded once, then routed through a
+ * table of handlers the managers register per event type, or per source for managers that
+ * want all of their events. The session also keeps track of the lifecycle across managers:
+ * events move it on through an explicit transition table, and an event that doesn't fit the
+ * current state is reported rather than applied. Such events are still routed, as the managers
+ * remain in charge of their own caches. Managers also report what they learn from queries,
+ * which is taken as is.
+ */
+class FDriftSocialSession
+{
+public:
+	FDriftSocialSession(TSharedPtr<IDriftMessageQueue> InMessageQueue);
+	~FDriftSocialSession();
+
+	void RegisterHandler(EDriftSocialEvent Type, FDriftSocialEventDelegate Handler);
+	void RegisterSourceHandler(EDriftSocialEventSource Source, FDriftSocialEventDelegate Handler);
+	void RegisterParticipant(IDriftSocialSessionParticipant* Participant);
+
+	/* Remove every handler bound to the object */
+	void UnregisterHandlers(const void* Owner);
+	void UnregisterParticipant(IDriftSocialSessionParticipant* Participant);
+
+	void SetRequestManager(TSharedPtr<JsonRequestManager> RootRequestManager);
+	void ConfigureSession(const FDriftEndpointsResponse& DriftEndpoints, int32 InPlayerId);
+
+	/* What the party manager found when it queried the party */
+	void PartySnapshot(bool bInParty);
+
+	/* What the lobby manager found when it queried or left the lobby */
+	void LobbySnapshot(bool bInLobby, EDriftLobbyStatus Status);
+
+	EDriftSocialState GetState() const { return State; }
+
+	FDriftSocialStateChangedDelegate& OnStateChanged() { return OnStateChangedDelegate; }
+	FDriftSocialInvalidTransitionDelegate& OnInvalidTransition() { return OnInvalidTransitionDelegate; }
+
+	static const TCHAR* StateToString(EDriftSocialState InState);
+
+private:
+	void HandleMessage(const FMessageQueueEntry& Message);
+	static bool DecodeEvent(const FMessageQueueEntry& Message, bool bDataField, FDriftSocialEvent& Event);
+	void ApplyTransition(const FDriftSocialEvent& Event);
+	void SetState(EDriftSocialState NewState);
+	EDriftSocialState GetStateOutsideLobby() const;
+
+	struct FQueueRoute
+	{
+		EDriftSocialEventSource Source;
+		/* Only accept messages from the system or the player itself */
+		bool bSystemOrSelfOnly;
+		/* Event fields are under 'data' rather than alongside 'event' */
+		bool bDataField;
+		TMap<FString, EDriftSocialEvent> EventTypes;
+	};
+
+	TWeakPtr<IDriftMessageQueue> MessageQueue;
+	TMap<FString, FQueueRoute> Routes;
+
+	TMap<EDriftSocialEvent, FDriftSocialEventDelegate> EventHandlers;
+	TMap<EDriftSocialEventSource, FDriftSocialEventDelegate> SourceHandlers;
+	TArray<IDriftSocialSessionParticipant*> Participants;
+
+	int32 PlayerId = INDEX_NONE;
+	EDriftSocialState State = EDriftSocialState::Idle;
+	bool bInParty = false;
+
+	FDriftSocialStateChangedDelegate OnStateChangedDelegate;
+	FDriftSocialInvalidTransitionDelegate OnInvalidTransitionDelegate;
+};
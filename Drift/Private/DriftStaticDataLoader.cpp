@@ -0,0 +1,385 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftStaticDataLoader.h"
+
+#include "DriftCdnScoreboard.h"
+#include "DriftStaticData.h"
+#include "DriftStaticDataStore.h"
+#include "JsonRequestManager.h"
+
+
+static constexpr int64 STATIC_DATA_CHUNK_SIZE = 4 * 1024 * 1024;
+
+
+FDriftStaticDataLoader::FDriftStaticDataLoader(TSharedPtr<JsonRequestManager> InRequestManager, TSharedPtr<FDriftStaticDataStore> InStore,
+    TSharedPtr<FDriftCdnScoreboard> InScoreboard, const FString& InName, const FString& InCommit, TArray<FDriftStaticDataSource> InSources)
+    : RequestManager{ InRequestManager }
+    , Store{ InStore }
+    , Scoreboard{ InScoreboard }
+    , Name{ InName }
+    , Commit{ InCommit }
+    , Sources{ Scoreboard.IsValid() ? Scoreboard->Rank(InSources) : MoveTemp(InSources) }
+{
+}
+
+
+FDriftStaticDataLoader::~FDriftStaticDataLoader()
+{
+    if (bClaimed)
+    {
+        Store->ReleaseDownload(Commit, Name);
+    }
+}
+
+
+void FDriftStaticDataLoader::Start()
+{
+    StartTime = FDateTime::UtcNow();
+
+    StartDownload();
+}
+
+
+void FDriftStaticDataLoader::StartDownload()
+{
+    if (Store->Contains(Commit, Name))
+    {
+        UE_LOG(LogDriftStaticData, Log, TEXT("Static data file '%s' for commit '%s' found locally"), *Name, *Commit);
+
+        Result.bFromStore = true;
+        Finish(true);
+        return;
+    }
+
+    if (Sources.Num() == 0)
+    {
+        Finish(false, TEXT("No static data sources available"));
+        return;
+    }
+
+    bClaimed = Store->ClaimDownload(Commit, Name);
+    bWaitingForOtherDownload = !bClaimed;
+    if (bWaitingForOtherDownload)
+    {
+        // Ticks until the other download is done, successful or not
+        UE_LOG(LogDriftStaticData, Log, TEXT("Static data file '%s' for commit '%s' is already being downloaded, waiting for it"), *Name, *Commit);
+        return;
+    }
+
+    Offset = Store->GetPartialSize(Commit, Name);
+    Result.ResumedBytes = Offset;
+    if (Offset > 0)
+    {
+        UE_LOG(LogDriftStaticData, Log, TEXT("Resuming download of static data file '%s' at %lld bytes"), *Name, Offset);
+    }
+
+    StartNextSource();
+}
+
+
+void FDriftStaticDataLoader::Tick(float DeltaTime)
+{
+    if (bWaitingForOtherDownload)
+    {
+        if (!Store->IsDownloading(Commit, Name))
+        {
+            StartDownload();
+        }
+        return;
+    }
+
+    HedgeDueInSeconds -= DeltaTime;
+    if (HedgeDueInSeconds > 0.0f)
+    {
+        return;
+    }
+
+    UE_LOG(LogDriftStaticData, Log, TEXT("No data for '%s' yet, also trying the next CDN"), *Name);
+
+    StartNextSource();
+}
+
+
+TStatId FDriftStaticDataLoader::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(FDriftStaticDataLoader, STATGROUP_Tickables);
+}
+
+
+bool FDriftStaticDataLoader::StartNextSource()
+{
+    while (NextSource < Sources.Num() && FailedSources.Contains(NextSource))
+    {
+        ++NextSource;
+    }
+    if (NextSource >= Sources.Num())
+    {
+        HedgeDueInSeconds = FLT_MAX;
+        return false;
+    }
+
+    const auto SourceIndex = NextSource++;
+    RequestChunk(SourceIndex);
+
+    HedgeDueInSeconds = NextSource < Sources.Num() && Scoreboard.IsValid() ? Scoreboard->GetHedgeDelay(Sources[SourceIndex].Cdn) : FLT_MAX;
+    return true;
+}
+
+
+void FDriftStaticDataLoader::RequestChunk(int32 SourceIndex)
+{
+    const auto Url = Sources[SourceIndex].RootUrl + Name;
+    const auto Range = FString::Printf(TEXT("bytes=%lld-%lld"), Offset, Offset + STATIC_DATA_CHUNK_SIZE - 1);
+
+    UE_LOG(LogDriftStaticData, Verbose, TEXT("Requesting '%s' %s from '%s'"), *Name, *Range, *Sources[SourceIndex].Cdn);
+
+    auto Request = RequestManager->Get(Url, HttpStatusCodes::Undefined);
+    Request->SetExpectJsonResponse(false);
+    Request->SetHeader(TEXT("Range"), Range);
+    Request->OnRequestProgress().BindLambda([Self = SharedThis(this), SourceIndex](FHttpRequestPtr Req, int32 BytesWritten, int32 BytesRead)
+    {
+        Self->HandleProgress(SourceIndex, BytesRead);
+    });
+    Request->OnResponse.BindLambda([Self = SharedThis(this), SourceIndex](ResponseContext& Context, JsonDocument& Doc)
+    {
+        Self->HandleChunk(SourceIndex, Context);
+    });
+    Request->OnError.BindLambda([Self = SharedThis(this), SourceIndex](ResponseContext& Context)
+    {
+        Self->HandleChunkError(SourceIndex, Context);
+    });
+    ActiveRequests.Add(SourceIndex, Request);
+    RequestStartTimes.Add(SourceIndex, FDateTime::UtcNow());
+    Request->Dispatch();
+}
+
+
+void FDriftStaticDataLoader::HandleProgress(int32 SourceIndex, int32 BytesRead)
+{
+    if (bFinished || BytesRead <= 0)
+    {
+        return;
+    }
+
+    if (SelectedSource == INDEX_NONE)
+    {
+        UE_LOG(LogDriftStaticData, Verbose, TEXT("CDN '%s' responded first, cancelling the others"), *Sources[SourceIndex].Cdn);
+
+        RecordFirstByte(SourceIndex);
+        SelectSource(SourceIndex);
+    }
+
+    if (SelectedSource == SourceIndex)
+    {
+        OnProgress.ExecuteIfBound(Name, static_cast<int32>(FMath::Min<int64>(Offset + BytesRead, MAX_int32)));
+    }
+}
+
+
+void FDriftStaticDataLoader::SelectSource(int32 SourceIndex)
+{
+    SelectedSource = SourceIndex;
+    Result.Cdn = Sources[SourceIndex].Cdn;
+
+    for (auto It = ActiveRequests.CreateIterator(); It; ++It)
+    {
+        if (It.Key() != SourceIndex)
+        {
+            It.Value()->Destroy();
+            It.RemoveCurrent();
+        }
+    }
+}
+
+
+void FDriftStaticDataLoader::RecordFirstByte(int32 SourceIndex)
+{
+    TransferStartTime = FDateTime::UtcNow();
+    if (Scoreboard.IsValid())
+    {
+        const auto Latency = TransferStartTime - RequestStartTimes.FindRef(SourceIndex);
+        Scoreboard->RecordFirstByte(Sources[SourceIndex].Cdn, Latency.GetTotalSeconds());
+    }
+}
+
+
+void FDriftStaticDataLoader::HandleChunk(int32 SourceIndex, ResponseContext& Context)
+{
+    if (bFinished || (SelectedSource != INDEX_NONE && SelectedSource != SourceIndex))
+    {
+        return;
+    }
+
+    ActiveRequests.Remove(SourceIndex);
+    if (SelectedSource == INDEX_NONE)
+    {
+        RecordFirstByte(SourceIndex);
+        SelectSource(SourceIndex);
+    }
+
+    const auto& Content = Context.response->GetContent();
+    if (Context.responseCode == static_cast<int32>(HttpStatusCodes::PartialContent))
+    {
+        // Content-Range: bytes <first>-<last>/<total>
+        const auto ContentRange = Context.response->GetHeader(TEXT("Content-Range"));
+        FString Span, Total;
+        FString First, Last;
+        if (!ContentRange.Split(TEXT("/"), &Span, &Total)
+            || !Span.Replace(TEXT("bytes"), TEXT("")).TrimStartAndEnd().Split(TEXT("-"), &First, &Last)
+            || FCString::Atoi64(*First) != Offset)
+        {
+            UE_LOG(LogDriftStaticData, Warning, TEXT("Unexpected Content-Range '%s' for '%s', restarting download"), *ContentRange, *Name);
+
+            if (bRestarted)
+            {
+                Finish(false, FString::Printf(TEXT("Unexpected Content-Range '%s'"), *ContentRange));
+                return;
+            }
+            bRestarted = true;
+            Store->DiscardPartial(Commit, Name);
+            Offset = 0;
+            RequestChunk(SelectedSource);
+            return;
+        }
+
+        if (!Store->AppendPartial(Commit, Name, Content))
+        {
+            Finish(false, TEXT("Failed to write static data to disk"));
+            return;
+        }
+
+        Offset += Content.Num();
+        TotalSize = Total == TEXT("*") ? INDEX_NONE : FCString::Atoi64(*Total);
+
+        const auto bComplete = TotalSize == INDEX_NONE ? Content.Num() < STATIC_DATA_CHUNK_SIZE : Offset >= TotalSize;
+        if (!bComplete)
+        {
+            RequestChunk(SelectedSource);
+            return;
+        }
+    }
+    else
+    {
+        // The server ignored the range and returned the whole file
+        Store->DiscardPartial(Commit, Name);
+        Result.ResumedBytes = 0;
+        if (!Store->AppendPartial(Commit, Name, Content))
+        {
+            Finish(false, TEXT("Failed to write static data to disk"));
+            return;
+        }
+        Offset = Content.Num();
+    }
+
+    if (!Store->CompletePartial(Commit, Name))
+    {
+        Finish(false, TEXT("Failed to store static data"));
+        return;
+    }
+    Store->Prune(Name, Commit);
+    Finish(true);
+}
+
+
+void FDriftStaticDataLoader::HandleChunkError(int32 SourceIndex, ResponseContext& Context)
+{
+    Context.errorHandled = true;
+
+    if (bFinished || !ActiveRequests.Contains(SourceIndex))
+    {
+        return;
+    }
+    ActiveRequests.Remove(SourceIndex);
+
+    if (Context.responseCode == static_cast<int32>(HttpStatusCodes::RangeNotSatisfiable) && !bRestarted)
+    {
+        // Whatever is on disk doesn't belong to this file, start over
+        UE_LOG(LogDriftStaticData, Warning, TEXT("Partial download of '%s' is invalid, restarting download"), *Name);
+
+        bRestarted = true;
+        Store->DiscardPartial(Commit, Name);
+        Offset = 0;
+        RequestChunk(SourceIndex);
+        return;
+    }
+
+    const auto Error = Context.error.IsEmpty() ? FString::Printf(TEXT("HTTP status %d"), Context.responseCode) : Context.error;
+    UE_LOG(LogDriftStaticData, Warning, TEXT("Failed to download '%s' from CDN '%s': %s"), *Name, *Sources[SourceIndex].Cdn, *Error);
+
+    FailedSources.Add(SourceIndex);
+    OnSourceFailed.ExecuteIfBound(Sources[SourceIndex], Error);
+    if (Scoreboard.IsValid())
+    {
+        Scoreboard->RecordFailure(Sources[SourceIndex].Cdn);
+    }
+
+    if (SelectedSource == INDEX_NONE)
+    {
+        // Still waiting for the first byte, move on to the next source right away unless one is already running
+        if (ActiveRequests.Num() == 0 && !StartNextSource())
+        {
+            Finish(false, Error);
+        }
+        return;
+    }
+
+    for (int32 Next = 0; Next < Sources.Num(); ++Next)
+    {
+        if (!FailedSources.Contains(Next))
+        {
+            UE_LOG(LogDriftStaticData, Log, TEXT("Continuing download of '%s' from CDN '%s'"), *Name, *Sources[Next].Cdn);
+
+            SelectSource(Next);
+            RequestChunk(Next);
+            return;
+        }
+    }
+
+    Finish(false, Error);
+}
+
+
+void FDriftStaticDataLoader::Finish(bool bSuccess, const FString& Error)
+{
+    bFinished = true;
+
+    for (const auto& Request : ActiveRequests)
+    {
+        Request.Value->Destroy();
+    }
+    ActiveRequests.Empty();
+
+    if (bClaimed)
+    {
+        Store->ReleaseDownload(Commit, Name);
+        bClaimed = false;
+    }
+
+    if (bSuccess && !Result.bFromStore && SelectedSource != INDEX_NONE && Scoreboard.IsValid())
+    {
+        const auto TransferTime = FDateTime::UtcNow() - TransferStartTime;
+        Scoreboard->RecordTransfer(Sources[SelectedSource].Cdn, Offset - Result.ResumedBytes, TransferTime.GetTotalSeconds());
+    }
+
+    Result.bSuccess = bSuccess;
+    Result.Bytes = Offset;
+    Result.DownloadSeconds = (FDateTime::UtcNow() - StartTime).GetTotalSeconds();
+    Result.Error = Error;
+
+    TSharedPtr<FDriftStaticDataView> View;
+    if (bSuccess)
+    {
+        View = Store->Open(Commit, Name);
+        if (!View.IsValid())
+        {
+            Result.bSuccess = false;
+            Result.Error = TEXT("Failed to open stored static data");
+        }
+        else
+        {
+            Result.Bytes = View->GetSize();
+        }
+    }
+
+    OnCompleted.ExecuteIfBound(Result, View);
+}
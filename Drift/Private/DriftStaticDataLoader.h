@@ -0,0 +1,108 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+
+
+class FDriftCdnScoreboard;
+class FDriftStaticDataStore;
+class FDriftStaticDataView;
+class HttpRequest;
+class JsonRequestManager;
+class ResponseContext;
+
+
+/** A CDN the static data file can be downloaded from */
+struct FDriftStaticDataSource
+{
+    FString Cdn;
+    FString RootUrl;
+};
+
+
+struct FDriftStaticDataLoadResult
+{
+    bool bSuccess = false;
+    /** True if the file was already in the local store and nothing was downloaded */
+    bool bFromStore = false;
+    FString Cdn;
+    int64 Bytes = 0;
+    /** Bytes that were already on disk from an earlier, interrupted download */
+    int64 ResumedBytes = 0;
+    double DownloadSeconds = 0.0;
+    FString Error;
+};
+
+
+DECLARE_DELEGATE_TwoParams(FDriftStaticDataLoaderProgressDelegate, const FString& /* Name */, int32 /* BytesRead */);
+DECLARE_DELEGATE_TwoParams(FDriftStaticDataLoaderCompletedDelegate, const FDriftStaticDataLoadResult& /* Result */, const TSharedPtr<FDriftStaticDataView>& /* View */);
+DECLARE_DELEGATE_TwoParams(FDriftStaticDataLoaderSourceFailedDelegate, const FDriftStaticDataSource& /* Source */, const FString& /* Error */);
+
+
+/**
+ * Downloads one static data file for a specific commit into the local store.
+ *
+ * The first chunk is requested from the source the scoreboard ranks highest. If it hasn't
+ * started returning data within its usual latency, the runner-up is tried as well, and so on.
+ * The first source to return data wins and any others are cancelled. The rest of the file
+ * is fetched in chunks from the winner, falling back to the remaining sources if it fails.
+ * If another loader in the process is already downloading the same file, this one waits
+ * for it to finish and then picks the file up from the store.
+ */
+class FDriftStaticDataLoader : public FTickableGameObject, public TSharedFromThis<FDriftStaticDataLoader>
+{
+public:
+    FDriftStaticDataLoader(TSharedPtr<JsonRequestManager> InRequestManager, TSharedPtr<FDriftStaticDataStore> InStore,
+        TSharedPtr<FDriftCdnScoreboard> InScoreboard, const FString& InName, const FString& InCommit, TArray<FDriftStaticDataSource> InSources);
+    ~FDriftStaticDataLoader();
+
+    void Start();
+
+    // FTickableGameObject API
+    void Tick(float DeltaTime) override;
+    bool IsTickable() const override { return !bFinished && SelectedSource == INDEX_NONE; }
+    TStatId GetStatId() const override;
+
+    FDriftStaticDataLoaderProgressDelegate OnProgress;
+    FDriftStaticDataLoaderCompletedDelegate OnCompleted;
+    FDriftStaticDataLoaderSourceFailedDelegate OnSourceFailed;
+
+private:
+    void StartDownload();
+    bool StartNextSource();
+    void RequestChunk(int32 SourceIndex);
+    void HandleChunk(int32 SourceIndex, ResponseContext& Context);
+    void HandleChunkError(int32 SourceIndex, ResponseContext& Context);
+    void HandleProgress(int32 SourceIndex, int32 BytesRead);
+    void SelectSource(int32 SourceIndex);
+    void RecordFirstByte(int32 SourceIndex);
+    void Finish(bool bSuccess, const FString& Error = {});
+
+    TSharedPtr<JsonRequestManager> RequestManager;
+    TSharedPtr<FDriftStaticDataStore> Store;
+    TSharedPtr<FDriftCdnScoreboard> Scoreboard;
+    FString Name;
+    FString Commit;
+    TArray<FDriftStaticDataSource> Sources;
+
+    /** Outstanding chunk request per source, only the selected source has one once the race is decided */
+    TMap<int32, TSharedPtr<HttpRequest>> ActiveRequests;
+    TMap<int32, FDateTime> RequestStartTimes;
+    TSet<int32> FailedSources;
+    int32 SelectedSource = INDEX_NONE;
+    int32 NextSource = 0;
+    float HedgeDueInSeconds = FLT_MAX;
+
+    int64 Offset = 0;
+    int64 TotalSize = INDEX_NONE;
+    bool bRestarted = false;
+    bool bFinished = false;
+    bool bClaimed = false;
+    bool bWaitingForOtherDownload = false;
+
+    FDriftStaticDataLoadResult Result;
+    FDateTime StartTime;
+    FDateTime TransferStartTime;
+};
@@ -0,0 +1,205 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftStaticDataStore.h"
+
+#include "DriftStaticData.h"
+
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+
+DEFINE_LOG_CATEGORY(LogDriftStaticData);
+
+
+static const TCHAR* PARTIAL_FILE_EXTENSION = TEXT(".part");
+
+
+FDriftStaticDataStore::FDriftStaticDataStore()
+    : FDriftStaticDataStore(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("DriftStaticData")))
+{
+}
+
+
+FDriftStaticDataStore::FDriftStaticDataStore(const FString& InRootDir)
+    : RootDir{ InRootDir }
+{
+}
+
+
+bool FDriftStaticDataStore::Contains(const FString& Commit, const FString& Name) const
+{
+    return IFileManager::Get().FileExists(*GetFilePath(Commit, Name));
+}
+
+
+bool FDriftStaticDataStore::ClaimDownload(const FString& Commit, const FString& Name)
+{
+    bool bAlreadyClaimed = false;
+    Downloads.Add(GetPartialPath(Commit, Name), &bAlreadyClaimed);
+    return !bAlreadyClaimed;
+}
+
+
+void FDriftStaticDataStore::ReleaseDownload(const FString& Commit, const FString& Name)
+{
+    Downloads.Remove(GetPartialPath(Commit, Name));
+}
+
+
+bool FDriftStaticDataStore::IsDownloading(const FString& Commit, const FString& Name) const
+{
+    return Downloads.Contains(GetPartialPath(Commit, Name));
+}
+
+
+int64 FDriftStaticDataStore::GetPartialSize(const FString& Commit, const FString& Name) const
+{
+    return FMath::Max<int64>(IFileManager::Get().FileSize(*GetPartialPath(Commit, Name)), 0);
+}
+
+
+bool FDriftStaticDataStore::AppendPartial(const FString& Commit, const FString& Name, const TArray<uint8>& Data)
+{
+    const auto Path = GetPartialPath(Commit, Name);
+    TUniquePtr<FArchive> Writer{ IFileManager::Get().CreateFileWriter(*Path, FILEWRITE_Append) };
+    if (!Writer)
+    {
+        UE_LOG(LogDriftStaticData, Error, TEXT("Failed to open '%s' for writing"), *Path);
+        return false;
+    }
+
+    Writer->Serialize(const_cast<uint8*>(Data.GetData()), Data.Num());
+    return Writer->Close();
+}
+
+
+void FDriftStaticDataStore::DiscardPartial(const FString& Commit, const FString& Name)
+{
+    IFileManager::Get().Delete(*GetPartialPath(Commit, Name), false, false, true);
+}
+
+
+bool FDriftStaticDataStore::CompletePartial(const FString& Commit, const FString& Name)
+{
+    const auto Path = GetFilePath(Commit, Name);
+    if (!IFileManager::Get().Move(*Path, *GetPartialPath(Commit, Name), true))
+    {
+        UE_LOG(LogDriftStaticData, Error, TEXT("Failed to move downloaded static data into '%s'"), *Path);
+        return false;
+    }
+    return true;
+}
+
+
+void FDriftStaticDataStore::Prune(const FString& Name, const FString& KeepCommit)
+{
+    TArray<FString> CommitDirs;
+    IFileManager::Get().FindFiles(CommitDirs, *FPaths::Combine(RootDir, TEXT("*")), false, true);
+
+    const auto KeepDir = FPaths::GetCleanFilename(GetCommitDir(KeepCommit));
+    for (const auto& CommitDir : CommitDirs)
+    {
+        if (CommitDir == KeepDir)
+        {
+            continue;
+        }
+
+        const auto Dir = FPaths::Combine(RootDir, CommitDir);
+        const auto FileName = FPaths::MakeValidFileName(Name);
+        IFileManager::Get().Delete(*FPaths::Combine(Dir, FileName), false, false, true);
+        IFileManager::Get().Delete(*(FPaths::Combine(Dir, FileName) + PARTIAL_FILE_EXTENSION), false, false, true);
+
+        TArray<FString> Remaining;
+        IFileManager::Get().FindFiles(Remaining, *FPaths::Combine(Dir, TEXT("*")), true, false);
+        if (Remaining.Num() == 0)
+        {
+            IFileManager::Get().DeleteDirectory(*Dir, false, true);
+        }
+    }
+}
+
+
+TSharedPtr<FDriftStaticDataView> FDriftStaticDataStore::Open(const FString& Commit, const FString& Name) const
+{
+    auto View = MakeShared<FDriftStaticDataView>(Name, Commit, GetFilePath(Commit, Name));
+    if (!View->Open())
+    {
+        return {};
+    }
+    return View;
+}
+
+
+FString FDriftStaticDataStore::GetCommitDir(const FString& Commit) const
+{
+    return FPaths::Combine(RootDir, FPaths::MakeValidFileName(Commit.IsEmpty() ? TEXT("default") : Commit));
+}
+
+
+FString FDriftStaticDataStore::GetFilePath(const FString& Commit, const FString& Name) const
+{
+    return FPaths::Combine(GetCommitDir(Commit), FPaths::MakeValidFileName(Name));
+}
+
+
+FString FDriftStaticDataStore::GetPartialPath(const FString& Commit, const FString& Name) const
+{
+    return GetFilePath(Commit, Name) + PARTIAL_FILE_EXTENSION;
+}
+
+
+FDriftStaticDataView::FDriftStaticDataView(const FString& InName, const FString& InCommit, const FString& InFilePath)
+    : Name{ InName }
+    , Commit{ InCommit }
+    , FilePath{ InFilePath }
+{
+}
+
+
+FDriftStaticDataView::~FDriftStaticDataView()
+{
+    // The region must be released before the handle it was mapped from
+    MappedRegion.Reset();
+    MappedHandle.Reset();
+}
+
+
+bool FDriftStaticDataView::Open()
+{
+    MappedHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+    if (MappedHandle)
+    {
+        MappedRegion.Reset(MappedHandle->MapRegion());
+        if (MappedRegion)
+        {
+            return true;
+        }
+        MappedHandle.Reset();
+    }
+
+    UE_LOG(LogDriftStaticData, Verbose, TEXT("Memory mapping '%s' failed, loading it instead"), *FilePath);
+
+    return FFileHelper::LoadFileToArray(Fallback, *FilePath);
+}
+
+
+const uint8* FDriftStaticDataView::GetData() const
+{
+    return MappedRegion ? MappedRegion->GetMappedPtr() : Fallback.GetData();
+}
+
+
+int64 FDriftStaticDataView::GetSize() const
+{
+    return MappedRegion ? MappedRegion->GetMappedSize() : Fallback.Num();
+}
+
+
+FString FDriftStaticDataView::ToString() const
+{
+    const FUTF8ToTCHAR Converted{ reinterpret_cast<const ANSICHAR*>(GetData()), static_cast<int32>(GetSize()) };
+    return FString(Converted.Length(), Converted.Get());
+}
@@ -0,0 +1,57 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+class FDriftStaticDataView;
+
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDriftStaticData, Log, All);
+
+
+/**
+ * Local store of static data files, addressed by the commit they were published from.
+ * A commit's content never changes, so a file that's been fully downloaded once never
+ * needs to be fetched again. Downloads are appended to a partial file and only moved
+ * into place when complete, which lets an interrupted download resume where it stopped.
+ *
+ * The files are shared by everything in the process, so there should only be one store,
+ * and a file may only be downloaded by whoever claimed it.
+ */
+class FDriftStaticDataStore
+{
+public:
+    FDriftStaticDataStore();
+    explicit FDriftStaticDataStore(const FString& InRootDir);
+
+    bool Contains(const FString& Commit, const FString& Name) const;
+
+    /** Take over downloading a file, false if someone else is already downloading it */
+    bool ClaimDownload(const FString& Commit, const FString& Name);
+    void ReleaseDownload(const FString& Commit, const FString& Name);
+    bool IsDownloading(const FString& Commit, const FString& Name) const;
+
+    /** Return the number of bytes already downloaded for an unfinished file */
+    int64 GetPartialSize(const FString& Commit, const FString& Name) const;
+    bool AppendPartial(const FString& Commit, const FString& Name, const TArray<uint8>& Data);
+    void DiscardPartial(const FString& Commit, const FString& Name);
+
+    /** Move a fully downloaded partial file into place */
+    bool CompletePartial(const FString& Commit, const FString& Name);
+
+    /** Remove copies of the file belonging to any other commit */
+    void Prune(const FString& Name, const FString& KeepCommit);
+
+    TSharedPtr<FDriftStaticDataView> Open(const FString& Commit, const FString& Name) const;
+
+private:
+    FString GetCommitDir(const FString& Commit) const;
+    FString GetFilePath(const FString& Commit, const FString& Name) const;
+    FString GetPartialPath(const FString& Commit, const FString& Name) const;
+
+    FString RootDir;
+    /** Partial files with a download writing to them */
+    TSet<FString> Downloads;
+};
@@ -0,0 +1,198 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftWebSocketMessageTransport.h"
+
+#include "DriftAPI.h"
+#include "DriftMessageQueue.h"
+#include "Details/UrlHelper.h"
+#include "JsonArchive.h"
+#include "JsonRequestManager.h"
+
+#include "IWebSocket.h"
+#include "WebSocketsModule.h"
+
+
+/** Give up on streaming if it never worked after this many attempts */
+const int32 MAX_INITIAL_CONNECT_ATTEMPTS = 2;
+
+/** Give up on streaming if it stops working for this many attempts in a row */
+const int32 MAX_RECONNECT_ATTEMPTS = 5;
+
+const float MAX_RECONNECT_DELAY_SECONDS = 30.0f;
+
+
+FDriftWebSocketMessageTransport::FDriftWebSocketMessageTransport(TWeakPtr<JsonRequestManager> requestManager)
+    : requestManager{ requestManager }
+{
+}
+
+
+FDriftWebSocketMessageTransport::~FDriftWebSocketMessageTransport()
+{
+    Stop();
+}
+
+
+void FDriftWebSocketMessageTransport::Start(const FString& newMessageQueueUrl, int32 newLastMessageNumber)
+{
+    messageQueueUrl = newMessageQueueUrl;
+    lastMessageNumber = newLastMessageNumber;
+    failedAttempts = 0;
+    failed = false;
+    Connect();
+}
+
+
+void FDriftWebSocketMessageTransport::Stop()
+{
+    ReleaseSocket();
+    messageQueueUrl.Empty();
+    reconnectDelay = -1.0f;
+}
+
+
+void FDriftWebSocketMessageTransport::SetCursor(int32 newLastMessageNumber)
+{
+    lastMessageNumber = newLastMessageNumber;
+}
+
+
+void FDriftWebSocketMessageTransport::Tick(float deltaTime)
+{
+    if (reconnectDelay < 0.0f || failed)
+    {
+        return;
+    }
+
+    reconnectDelay -= deltaTime;
+    if (reconnectDelay <= 0.0f)
+    {
+        reconnectDelay = -1.0f;
+        Connect();
+    }
+}
+
+
+FString FDriftWebSocketMessageTransport::MakeStreamUrl(const FString& messageQueueUrl, int32 lastMessageNumber)
+{
+    auto url = messageQueueUrl;
+    if (url.StartsWith(TEXT("https://")))
+    {
+        url = TEXT("wss://") + url.RightChop(8);
+    }
+    else if (url.StartsWith(TEXT("http://")))
+    {
+        url = TEXT("ws://") + url.RightChop(7);
+    }
+    internal::UrlHelper::AddUrlOption(url, TEXT("messages_after"), lastMessageNumber);
+    return url;
+}
+
+
+void FDriftWebSocketMessageTransport::Connect()
+{
+    ReleaseSocket();
+
+    auto rm = requestManager.Pin();
+    if (!rm.IsValid() || messageQueueUrl.IsEmpty())
+    {
+        return;
+    }
+
+    // The same headers as a normal request, such as Authorization
+    const auto headers = rm->GetDefaultHeaders();
+    const auto url = MakeStreamUrl(messageQueueUrl, lastMessageNumber);
+
+    UE_LOG(LogDriftMessages, Verbose, TEXT("Connecting to message stream at %s"), *url);
+
+    OpenSocket(url, headers);
+}
+
+
+void FDriftWebSocketMessageTransport::OpenSocket(const FString& url, const TMap<FString, FString>& headers)
+{
+    socket = FWebSocketsModule::Get().CreateWebSocket(url, TEXT(""), headers);
+    socket->OnConnected().AddRaw(this, &FDriftWebSocketMessageTransport::HandleConnected);
+    socket->OnConnectionError().AddRaw(this, &FDriftWebSocketMessageTransport::HandleConnectionError);
+    socket->OnClosed().AddRaw(this, &FDriftWebSocketMessageTransport::HandleClosed);
+    socket->OnMessage().AddRaw(this, &FDriftWebSocketMessageTransport::HandleMessage);
+    socket->Connect();
+}
+
+
+void FDriftWebSocketMessageTransport::ReleaseSocket()
+{
+    if (socket.IsValid())
+    {
+        socket->OnConnected().RemoveAll(this);
+        socket->OnConnectionError().RemoveAll(this);
+        socket->OnClosed().RemoveAll(this);
+        socket->OnMessage().RemoveAll(this);
+        if (socket->IsConnected())
+        {
+            socket->Close();
+        }
+        socket.Reset();
+    }
+    connected = false;
+}
+
+
+void FDriftWebSocketMessageTransport::ScheduleReconnect(const FString& error)
+{
+    connected = false;
+    ++failedAttempts;
+
+    const auto maxAttempts = everConnected ? MAX_RECONNECT_ATTEMPTS : MAX_INITIAL_CONNECT_ATTEMPTS;
+    if (failedAttempts >= maxAttempts)
+    {
+        UE_LOG(LogDriftMessages, Warning, TEXT("Giving up on the message stream after %d attempts: %s"), failedAttempts, *error);
+
+        failed = true;
+        OnFailed.ExecuteIfBound(error);
+        return;
+    }
+
+    // The socket is released on the next connection attempt, not from inside its own callback
+    reconnectDelay = FMath::Min(FMath::Pow(2.0f, failedAttempts - 1), MAX_RECONNECT_DELAY_SECONDS);
+
+    UE_LOG(LogDriftMessages, Log, TEXT("Message stream unavailable (%s), reconnecting in %.0f seconds"), *error, reconnectDelay);
+}
+
+
+void FDriftWebSocketMessageTransport::HandleConnected()
+{
+    UE_LOG(LogDriftMessages, Log, TEXT("Message stream connected"));
+
+    connected = true;
+    everConnected = true;
+    failedAttempts = 0;
+}
+
+
+void FDriftWebSocketMessageTransport::HandleConnectionError(const FString& error)
+{
+    ScheduleReconnect(error);
+}
+
+
+void FDriftWebSocketMessageTransport::HandleClosed(int32 statusCode, const FString& reason, bool wasClean)
+{
+    ScheduleReconnect(FString::Printf(TEXT("closed with status %d '%s'"), statusCode, *reason));
+}
+
+
+void FDriftWebSocketMessageTransport::HandleMessage(const FString& message)
+{
+    UE_LOG(LogDriftMessages, VeryVerbose, TEXT("Message stream frame: %s"), *message);
+
+    JsonDocument doc;
+    FDriftMessageQueueBatch messages;
+    if (!JsonArchive::LoadDocument(*message, doc) || !ParseMessages(doc, messages))
+    {
+        UE_LOG(LogDriftMessages, Warning, TEXT("Failed to parse message stream frame"));
+        return;
+    }
+
+    OnMessages.ExecuteIfBound(messages);
+}
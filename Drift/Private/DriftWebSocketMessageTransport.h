@@ -0,0 +1,60 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#pragma once
+
+#include "DriftMessageTransport.h"
+
+
+class IWebSocket;
+class JsonRequestManager;
+
+
+/**
+ * Keeps a WebSocket open to the message queue, and receives each batch of messages as
+ * a text frame as soon as the backend has it. The URL is the message queue URL with a
+ * ws:// or wss:// scheme, and the upgrade request carries the same headers as any other
+ * request made through the request manager.
+ *
+ * Reconnects with back-off when the connection drops, picking up after the last processed message.
+ */
+class FDriftWebSocketMessageTransport : public IDriftMessageTransport
+{
+public:
+    explicit FDriftWebSocketMessageTransport(TWeakPtr<JsonRequestManager> requestManager);
+    ~FDriftWebSocketMessageTransport();
+
+    FString GetName() const override { return TEXT("websocket"); }
+    void Start(const FString& messageQueueUrl, int32 lastMessageNumber) override;
+    void Stop() override;
+    void SetCursor(int32 lastMessageNumber) override;
+    void Tick(float deltaTime) override;
+
+    /** Turn an http(s):// message queue URL into the ws(s):// URL of its stream */
+    static FString MakeStreamUrl(const FString& messageQueueUrl, int32 lastMessageNumber);
+
+protected:
+    /** Create the socket and start connecting, its events go to the handlers below */
+    virtual void OpenSocket(const FString& url, const TMap<FString, FString>& headers);
+
+    void HandleConnected();
+    void HandleConnectionError(const FString& error);
+    void HandleClosed(int32 statusCode, const FString& reason, bool wasClean);
+    void HandleMessage(const FString& message);
+
+private:
+    void Connect();
+    void ReleaseSocket();
+    void ScheduleReconnect(const FString& error);
+
+    TWeakPtr<JsonRequestManager> requestManager;
+    FString messageQueueUrl;
+
+    TSharedPtr<IWebSocket> socket;
+
+    int32 lastMessageNumber = 0;
+    int32 failedAttempts = 0;
+    float reconnectDelay = -1.0f;
+    bool connected = false;
+    bool everConnected = false;
+    bool failed = false;
+};
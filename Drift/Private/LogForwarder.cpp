@@ -3,14 +3,200 @@
 
 #include "LogForwarder.h"
 
+#include "DriftPayloadCompression.h"
+#include "JsonArchive.h"
+#include "LogRingBuffer.h"
+
+#include "Async/Async.h"
+
 
 DEFINE_LOG_CATEGORY(LogDriftLogs);
 
 
 static const float FLUSH_LOGS_INTERVAL = 5.0f;
 
+/** How often the capture buffer is emptied between flushes */
+static const float DRAIN_LOGS_INTERVAL = 0.5f;
+
+static const uint32 LOG_RING_BUFFER_CAPACITY = 512;
+
+/** Rough upper limit on the size of one flush, messages past it are dropped until the next one */
+static const int32 LOG_FLUSH_BYTE_BUDGET = 64 * 1024;
+
+/** Estimated JSON overhead of one message on top of its text */
+static const int32 LOG_MESSAGE_OVERHEAD_BYTES = 96;
+
+/** Each category can add this many distinct messages in a burst, refilled at the given rate */
+static const float LOG_CATEGORY_BURST = 20.0f;
+static const float LOG_CATEGORY_MESSAGES_PER_SECOND = 1.0f;
+
+
+static const FString& GetLogLevelName(ELogVerbosity::Type level);
+
+
+/**
+ * Replace numbers, hex strings and GUIDs with a placeholder, so that messages
+ * which only differ by IDs, counts or addresses are merged into one
+ */
+static FString MakeLogTemplate(const TCHAR* text)
+{
+    FString result;
+    result.Reserve(FCString::Strlen(text));
+
+    const auto isTokenChar = [](TCHAR c)
+    {
+        return FChar::IsAlnum(c) || c == TEXT('-') || c == TEXT('.') || c == TEXT('_');
+    };
+
+    for (auto current = text; *current;)
+    {
+        if (!isTokenChar(*current))
+        {
+            result.AppendChar(*current++);
+            continue;
+        }
+
+        const auto start = current;
+        auto hasDigit = false;
+        auto isNumber = true;
+        auto isHex = true;
+        for (; *current && isTokenChar(*current); ++current)
+        {
+            hasDigit = hasDigit || FChar::IsDigit(*current);
+            isNumber = isNumber && (FChar::IsDigit(*current) || *current == TEXT('.') || *current == TEXT('-'));
+            isHex = isHex && (FChar::IsHexDigit(*current) || *current == TEXT('-'));
+        }
+
+        const auto length = static_cast<int32>(current - start);
+        if (hasDigit && (isNumber || (isHex && length >= 8)))
+        {
+            result.AppendChar(TEXT('#'));
+        }
+        else
+        {
+            result.AppendChars(start, length);
+        }
+    }
+    return result;
+}
+
+
+/**
+ * Log messages captured on any thread, and the merged messages waiting to be flushed.
+ * Only one background task at a time touches anything but the ring buffer.
+ */
+struct FLogCapture
+{
+    FLogRingBuffer buffer{ LOG_RING_BUFFER_CAPACITY };
+
+    TArray<FDriftLogMessage> pendingLogs;
+    TMap<uint32, int32> pendingLogsHashTable;
+    int32 pendingBytes = 0;
+
+    struct FTokenBucket
+    {
+        float tokens = LOG_CATEGORY_BURST;
+        FDateTime lastRefill;
+    };
+    TMap<FName, FTokenBucket> categoryBuckets;
+
+    /** Messages left out of the current flush window */
+    int32 droppedOverBudget = 0;
+    uint32 droppedBufferFull = 0;
+    TMap<FName, int32> rateLimited;
+
+    std::atomic<bool> draining{ false };
+
+    void Drain()
+    {
+        buffer.Drain([this](const FLogRecord& record)
+        {
+            Add(record);
+        });
+        droppedBufferFull += buffer.TakeDroppedCount();
+    }
+
+    void Add(const FLogRecord& record)
+    {
+        const auto A = FCrc::Strihash_DEPRECATED(*MakeLogTemplate(record.text));
+        const auto B = GetTypeHash(record.level);
+        const auto C = GetTypeHash(record.category);
+        const auto message_hash = HashCombine(HashCombine(A, B), C);
+        if (auto ptrIndex = pendingLogsHashTable.Find(message_hash))
+        {
+            auto& pendLog = pendingLogs[*ptrIndex];
+            pendLog.last_entry_timestamp = record.timestamp;
+            pendLog.count += 1;
+            return;
+        }
+
+        // Repeats are nearly free, only new messages count against the limits
+        if (!TakeToken(record.category, record.timestamp))
+        {
+            rateLimited.FindOrAdd(record.category) += 1;
+            return;
+        }
+
+        const auto bytes = record.length + LOG_MESSAGE_OVERHEAD_BYTES;
+        if (pendingBytes + bytes > LOG_FLUSH_BYTE_BUDGET)
+        {
+            ++droppedOverBudget;
+            return;
+        }
+        pendingBytes += bytes;
+
+        const auto index = pendingLogs.Emplace(record.text, *GetLogLevelName(record.level), record.category, record.timestamp);
+        pendingLogsHashTable.Add(message_hash, index);
+    }
+
+    bool TakeToken(const FName& category, const FDateTime& now)
+    {
+        auto& bucket = categoryBuckets.FindOrAdd(category);
+        if (bucket.lastRefill != FDateTime{})
+        {
+            const auto elapsed = FMath::Max((now - bucket.lastRefill).GetTotalSeconds(), 0.0);
+            bucket.tokens = FMath::Min(bucket.tokens + static_cast<float>(elapsed) * LOG_CATEGORY_MESSAGES_PER_SECOND, LOG_CATEGORY_BURST);
+        }
+        bucket.lastRefill = now;
+
+        if (bucket.tokens < 1.0f)
+        {
+            return false;
+        }
+        bucket.tokens -= 1.0f;
+        return true;
+    }
+
+    /** Hand over everything for this flush window, with a summary of what was left out */
+    TArray<FDriftLogMessage> TakeLogs()
+    {
+        if (droppedBufferFull > 0 || droppedOverBudget > 0 || rateLimited.Num() > 0)
+        {
+            FString limitedCategories;
+            for (const auto& entry : rateLimited)
+            {
+                limitedCategories += FString::Printf(TEXT("%s%s: %d"), limitedCategories.IsEmpty() ? TEXT("") : TEXT(", "), *entry.Key.ToString(), entry.Value);
+            }
+
+            pendingLogs.Emplace(FString::Printf(TEXT("Log forwarding was limited, dropped %u messages when the capture buffer was full, %d over the size budget, and rate limited [%s]"),
+                droppedBufferFull, droppedOverBudget, *limitedCategories),
+                *GetLogLevelName(ELogVerbosity::Warning), LogDriftLogs.GetCategoryName(), FDateTime::UtcNow());
+        }
+
+        auto logs = MoveTemp(pendingLogs);
+        pendingLogs.Reset();
+        pendingLogsHashTable.Reset();
+        pendingBytes = 0;
+        droppedBufferFull = 0;
+        droppedOverBudget = 0;
+        rateLimited.Reset();
+        return logs;
+    }
+};
+
 
 FLogForwarder::FLogForwarder()
+    : capture{ MakeShared<FLogCapture>() }
 {
     GLog->AddOutputDevice(this);
 }
@@ -38,13 +224,16 @@ void FLogForwarder::Tick(float DeltaTime)
         return;
     }
 
+    drainLogsInSeconds -= DeltaTime;
     flushLogsInSeconds -= DeltaTime;
-    if (flushLogsInSeconds > 0.0f)
+    if (flushLogsInSeconds <= 0.0f)
     {
-        return;
+        FlushLogs();
+    }
+    else if (flushRequested || drainLogsInSeconds <= 0.0f)
+    {
+        DrainLogs(flushRequested);
     }
-    
-    FlushLogs();
 }
 
 
@@ -93,21 +282,67 @@ bool FLogForwarder::Exec(class UWorld* InWorld, const TCHAR* Cmd, FOutputDevice&
 
 void FLogForwarder::FlushLogs()
 {
-	if (!logsUrl.IsEmpty() && requestManager.IsValid() && pendingLogs.Num() > 0)
+	if (!logsUrl.IsEmpty() && requestManager.IsValid())
 	{
-        UE_LOG(LogDriftLogs, Verbose, TEXT("Flushing %d log entries"), pendingLogs.Num());
-
-        auto rm = requestManager.Pin();
-		auto request = rm->Post(logsUrl, pendingLogs);
-		request->Dispatch();
-		pendingLogs.Empty();
-        pendingLogsHashTable.Empty();
+        DrainLogs(true);
 	}
 
 	flushLogsInSeconds += FLUSH_LOGS_INTERVAL;
 }
 
 
+void FLogForwarder::DrainLogs(bool flush)
+{
+    drainLogsInSeconds = DRAIN_LOGS_INTERVAL;
+
+    if (capture->draining.exchange(true))
+    {
+        // The previous task is still going, try again next tick
+        flushRequested = flushRequested || flush;
+        return;
+    }
+    flushRequested = false;
+
+    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [capture = capture, flush, weakRequestManager = requestManager, url = logsUrl]()
+    {
+        capture->Drain();
+
+        TArray<FDriftLogMessage> logs;
+        if (flush)
+        {
+            logs = capture->TakeLogs();
+        }
+        capture->draining = false;
+
+        if (logs.Num() == 0)
+        {
+            return;
+        }
+
+        FString payload;
+        TArray<uint8> compressed;
+        JsonArchive::SaveObject(logs, payload);
+        const auto useCompressed = DriftPayloadCompression::Compress(payload, compressed);
+
+        AsyncTask(ENamedThreads::GameThread, [weakRequestManager, url, count = logs.Num(), payload = MoveTemp(payload), compressed = MoveTemp(compressed), useCompressed]()
+        {
+            const auto rm = weakRequestManager.Pin();
+            if (!rm.IsValid())
+            {
+                return;
+            }
+
+            UE_LOG(LogDriftLogs, Verbose, TEXT("Flushing %d log entries, %d bytes%s"), count,
+                useCompressed ? compressed.Num() : payload.Len(), useCompressed ? TEXT(" compressed") : TEXT(""));
+
+            auto request = rm->CreateRequest(HttpMethods::XPOST, url, HttpStatusCodes::Created);
+            DriftPayloadCompression::SetContent(*request, payload, compressed, useCompressed);
+            request->Dispatch();
+        });
+    });
+}
+
+
 void FLogForwarder::SetRequestManager(TSharedPtr<JsonRequestManager> newRequestManager)
 {
     requestManager = newRequestManager;
@@ -128,31 +363,16 @@ void FLogForwarder::Log(const TCHAR* text, ELogVerbosity::Type level, const FNam
         return;
     }
 
-    if ((int32)level > (int32)minLogLevel)
+    if ((int32)level > (int32)minLogLevel.load(std::memory_order_relaxed))
     {
         return;
     }
 
-    const auto timestamp = FDateTime::UtcNow();
-
-    const auto A = FCrc::Strihash_DEPRECATED(text);
-    const auto B = GetTypeHash(level);
-    const auto C = GetTypeHash(category);
-    const auto message_hash = HashCombine(HashCombine(A, B), C);
-    if (auto ptrIndex = pendingLogsHashTable.Find(message_hash))
-    {
-        auto& pendLog = pendingLogs[*ptrIndex];
-        pendLog.last_entry_timestamp = timestamp;
-        pendLog.count += 1;
-        return;
-    }
-    
-    const auto index = pendingLogs.Emplace(text, *GetLogLevelName(level), category, timestamp);
-    pendingLogsHashTable.Add(message_hash, index);
+    capture->buffer.Push(text, level, category, FDateTime::UtcNow());
 }
 
 
-const FString& FLogForwarder::GetLogLevelName(ELogVerbosity::Type level) const
+static const FString& GetLogLevelName(ELogVerbosity::Type level)
 {
     static const TMap<ELogVerbosity::Type, FString> LogLevelNames =
     {
@@ -7,10 +7,25 @@
 
 #include "Tickable.h"
 
+#include <atomic>
+
 
 DECLARE_LOG_CATEGORY_EXTERN(LogDriftLogs, Log, All);
 
 
+struct FLogCapture;
+
+
+/**
+ * Forwards log messages at or above the configured level to the backend.
+ *
+ * Messages are captured from any thread into a lock-free ring buffer. A background task
+ * drains it regularly, merging repeated messages, and serializes and gzips them at each flush,
+ * so the game thread only posts the result.
+ *
+ * Messages that differ only by numbers or IDs count as repeats. New messages are rate limited
+ * per category and each flush has a size budget, anything left out is summarized in the flush.
+ */
 class FLogForwarder : public FOutputDevice, public FTickableGameObject, public FSelfRegisteringExec
 {
 public:
@@ -21,6 +36,8 @@ public:
 	 * FOutputDevice overrides
 	 */
 	virtual void Serialize(const TCHAR* text, ELogVerbosity::Type level, const FName& category) override;
+	bool CanBeUsedOnAnyThread() const override { return true; }
+	bool CanBeUsedOnMultipleThreads() const override { return true; }
 
 	/**
 	 * FTickableGameObject overrides
@@ -46,14 +63,16 @@ public:
     
 private:
 	void Log(const TCHAR* text, ELogVerbosity::Type level, const FName& category);
-    const FString& GetLogLevelName(ELogVerbosity::Type level) const;
+    void DrainLogs(bool flush);
 
     TWeakPtr<JsonRequestManager> requestManager;
     FString logsUrl;
 
-    TArray<FDriftLogMessage> pendingLogs;
-    TMap<uint32, int32> pendingLogsHashTable;
+    /** Shared with the background task draining it, so it outlives the forwarder if it has to */
+    TSharedRef<FLogCapture> capture;
     float flushLogsInSeconds = FLT_MAX;
+    float drainLogsInSeconds = 0.0f;
+    bool flushRequested = false;
 
-    ELogVerbosity::Type minLogLevel = ELogVerbosity::Error;
+    std::atomic<ELogVerbosity::Type> minLogLevel{ ELogVerbosity::Error };
 };
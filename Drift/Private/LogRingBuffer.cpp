@@ -0,0 +1,99 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "LogRingBuffer.h"
+
+
+FLogRingBuffer::FLogRingBuffer(uint32 capacity)
+{
+    const auto size = FMath::RoundUpToPowerOfTwo(FMath::Max(capacity, 2u));
+    slots = MakeUnique<FSlot[]>(size);
+    mask = size - 1;
+
+    for (uint32 index = 0; index < size; ++index)
+    {
+        slots[index].sequence.store(index, std::memory_order_relaxed);
+    }
+}
+
+
+FLogRingBuffer::~FLogRingBuffer()
+{
+    // Records published but never drained
+    for (uint64 index = 0; index <= mask; ++index)
+    {
+        FMemory::Free(slots[index].record.text);
+    }
+}
+
+
+bool FLogRingBuffer::Push(const TCHAR* text, ELogVerbosity::Type level, const FName& category, const FDateTime& timestamp)
+{
+    auto position = enqueuePosition.load(std::memory_order_relaxed);
+    FSlot* slot;
+    for (;;)
+    {
+        slot = &slots[position & mask];
+        const auto sequence = slot->sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<int64>(sequence) - static_cast<int64>(position);
+        if (difference == 0)
+        {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            // The consumer hasn't caught up with this slot yet
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else
+        {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    auto& record = slot->record;
+    record.length = FMath::Min(FCString::Strlen(text), LOG_RECORD_MAX_TEXT_LENGTH - 1);
+    record.text = static_cast<TCHAR*>(FMemory::Malloc((record.length + 1) * sizeof(TCHAR)));
+    FMemory::Memcpy(record.text, text, record.length * sizeof(TCHAR));
+    record.text[record.length] = TEXT('\0');
+    record.level = level;
+    record.category = category;
+    record.timestamp = timestamp;
+
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+
+int32 FLogRingBuffer::Drain(TFunctionRef<void(const FLogRecord&)> consumer)
+{
+    auto consumed = 0;
+    for (;;)
+    {
+        auto& slot = slots[dequeuePosition & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeuePosition + 1)
+        {
+            // Empty, or the producer that claimed the slot is still writing it
+            return consumed;
+        }
+
+        consumer(slot.record);
+        ++consumed;
+
+        FMemory::Free(slot.record.text);
+        slot.record.text = nullptr;
+
+        // Hand the slot back to the producers for the next lap around the buffer
+        slot.sequence.store(dequeuePosition + mask + 1, std::memory_order_release);
+        ++dequeuePosition;
+    }
+}
+
+
+uint32 FLogRingBuffer::TakeDroppedCount()
+{
+    return dropped.exchange(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,62 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+
+/** Longer log lines are truncated when captured, anything near this size wouldn't fit in a flush anyway */
+static constexpr int32 LOG_RECORD_MAX_TEXT_LENGTH = 16 * 1024;
+
+
+struct FLogRecord
+{
+    /** Allocated to fit the line when it's captured, and owned by the buffer */
+    TCHAR* text = nullptr;
+    int32 length = 0;
+    ELogVerbosity::Type level;
+    FName category;
+    FDateTime timestamp;
+};
+
+
+/**
+ * Bounded, lock-free queue of log records with any number of producers and a single consumer.
+ *
+ * Producers claim a slot with a compare-and-swap and publish it through the slot's sequence
+ * number, so logging never blocks. Slots only hold a pointer to the text, which is allocated
+ * at its actual length, so an idle buffer costs little however long the lines it has seen.
+ * When the buffer is full the record is dropped and counted instead.
+ */
+class FLogRingBuffer
+{
+public:
+    /** Capacity is rounded up to a power of two */
+    explicit FLogRingBuffer(uint32 capacity);
+    ~FLogRingBuffer();
+
+    /** Safe to call from any thread, returns false if the record was dropped */
+    bool Push(const TCHAR* text, ELogVerbosity::Type level, const FName& category, const FDateTime& timestamp);
+
+    /** Consume every published record in order, must only be called from one thread at a time */
+    int32 Drain(TFunctionRef<void(const FLogRecord&)> consumer);
+
+    /** Number of records dropped since the last call */
+    uint32 TakeDroppedCount();
+
+private:
+    struct FSlot
+    {
+        std::atomic<uint64> sequence;
+        FLogRecord record;
+    };
+
+    TUniquePtr<FSlot[]> slots;
+    uint64 mask;
+
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> enqueuePosition{ 0 };
+    alignas(PLATFORM_CACHE_LINE_SIZE) uint64 dequeuePosition = 0;
+    std::atomic<uint32> dropped{ 0 };
+};
@@ -0,0 +1,161 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftCounterManager.h"
+
+#include "DriftCounterAggregator.h"
+
+#include "Misc/AutomationTest.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * A match worth of server counter managers, flushing into an aggregator that has nowhere to send
+ * what it's given, so nothing leaves the process
+ */
+struct FCounterManagerHarness
+{
+    TArray<TUniquePtr<FDriftCounterManager>> managers;
+    TSharedPtr<FDriftCounterAggregator> aggregator;
+    TArray<FString> counterNames;
+
+    FCounterManagerHarness(int32 numPlayers, int32 numCounters)
+    {
+        for (int32 index = 0; index < numPlayers; ++index)
+        {
+            auto& manager = managers.Add_GetRef(MakeUnique<FDriftCounterManager>());
+            manager->SetCounterUrl(FString::Printf(TEXT("https://stub/players/%d/counters"), index + 1));
+        }
+        for (int32 index = 0; index < numCounters; ++index)
+        {
+            counterNames.Add(FString::Printf(TEXT("counter_%d"), index));
+        }
+        ResetAggregator();
+    }
+
+    /** The aggregator never sends, so it's replaced to let go of what it has collected */
+    void ResetAggregator()
+    {
+        aggregator = MakeShared<FDriftCounterAggregator>();
+        for (int32 index = 0; index < managers.Num(); ++index)
+        {
+            managers[index]->SetAggregator(aggregator, index + 1);
+        }
+    }
+
+    /** One relative update of every counter, and an absolute one of every fourth */
+    void AddCounts()
+    {
+        for (const auto& manager : managers)
+        {
+            for (int32 index = 0; index < counterNames.Num(); ++index)
+            {
+                manager->AddCount(counterNames[index], 1.0f, false);
+                if (index % 4 == 0)
+                {
+                    manager->AddCount(counterNames[index], 100.0f, true);
+                }
+            }
+        }
+    }
+
+    void Flush()
+    {
+        for (const auto& manager : managers)
+        {
+            manager->FlushCounters();
+        }
+    }
+
+    int32 NumAddCountsPerRound() const
+    {
+        return managers.Num() * (counterNames.Num() + (counterNames.Num() + 3) / 4);
+    }
+};
+
+
+BEGIN_DEFINE_SPEC(DriftCounterManagerSpec, "Game.Drift.CounterManager", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(DriftCounterManagerSpec)
+
+void DriftCounterManagerSpec::Define()
+{
+    Describe("AddCount", [this]
+    {
+        It("should keep the totals of every counter across flushes", [this]
+        {
+            FCounterManagerHarness harness{ 2, 8 };
+
+            for (int32 round = 0; round < 3; ++round)
+            {
+                harness.AddCounts();
+                harness.Flush();
+            }
+            harness.managers[0]->AddCount(TEXT("counter_1"), 2.0f, false);
+
+            float value = 0.0f;
+            TestTrue("Relative counter", harness.managers[0]->GetCount(TEXT("counter_1"), value));
+            TestEqual("Relative total", value, 5.0f);
+            TestTrue("Absolute counter", harness.managers[1]->GetCount(TEXT("counter_4"), value));
+            TestEqual("Absolute total", value, 100.0f);
+            TestFalse("Unknown counter", harness.managers[1]->GetCount(TEXT("counter_8"), value));
+        });
+    });
+
+    Describe("Scaling", [this]
+    {
+        It("should take the same time per update and flush however many counters there are", [this]
+        {
+            constexpr int32 numPlayers = 64;
+            constexpr int32 rounds = 2;
+            constexpr int32 runs = 3;
+
+            TMap<int32, double> secondsPerAddCount;
+            TMap<int32, double> secondsPerFlushedCounter;
+            for (const auto numCounters : { 100, 1000 })
+            {
+                FCounterManagerHarness harness{ numPlayers, numCounters };
+
+                auto bestAddSeconds = DBL_MAX;
+                auto bestFlushSeconds = DBL_MAX;
+                for (int32 run = 0; run < runs; ++run)
+                {
+                    auto addSeconds = 0.0;
+                    auto flushSeconds = 0.0;
+                    for (int32 round = 0; round < rounds; ++round)
+                    {
+                        auto start = FPlatformTime::Seconds();
+                        harness.AddCounts();
+                        addSeconds += FPlatformTime::Seconds() - start;
+
+                        start = FPlatformTime::Seconds();
+                        harness.Flush();
+                        flushSeconds += FPlatformTime::Seconds() - start;
+                    }
+                    harness.ResetAggregator();
+
+                    bestAddSeconds = FMath::Min(bestAddSeconds, addSeconds);
+                    bestFlushSeconds = FMath::Min(bestFlushSeconds, flushSeconds);
+                }
+
+                const auto numAddCounts = harness.NumAddCountsPerRound() * rounds;
+                // Absolute updates replace the relative ones made before them, so each counter is flushed once per round
+                const auto numFlushedCounters = numPlayers * numCounters * rounds;
+                secondsPerAddCount.Add(numCounters, bestAddSeconds / numAddCounts);
+                secondsPerFlushedCounter.Add(numCounters, bestFlushSeconds / numFlushedCounters);
+
+                AddInfo(FString::Printf(TEXT("%d counters x %d players: %.3f us per AddCount, %.3f us per flushed counter, %.2f ms per flush of all players"),
+                    numCounters, numPlayers, bestAddSeconds / numAddCounts * 1e6, bestFlushSeconds / numFlushedCounters * 1e6, bestFlushSeconds / rounds * 1000.0));
+
+                float value = 0.0f;
+                TestTrue(FString::Printf(TEXT("Counted with %d counters"), numCounters), harness.managers.Last()->GetCount(harness.counterNames.Last(), value));
+                TestEqual(FString::Printf(TEXT("Total with %d counters"), numCounters), value, static_cast<float>(rounds * runs));
+            }
+
+            // Scanning for the counter would make each call ten times slower with ten times the counters
+            TestTrue("AddCount stays flat from 100 to 1000 counters", secondsPerAddCount[1000] < secondsPerAddCount[100] * 4.0);
+            TestTrue("Flush stays flat from 100 to 1000 counters", secondsPerFlushedCounter[1000] < secondsPerFlushedCounter[100] * 4.0);
+        });
+    });
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,252 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftHeartbeatMultiplexer.h"
+#include "DriftHeartbeatScheduler.h"
+#include "JWTRequestManager.h"
+
+#include "Misc/AutomationTest.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * A process full of Drift instances, heartbeating through one multiplexer against a stub
+ * backend that answers every batch straight away, on a clock the test controls.
+ */
+struct FHeartbeatMultiplexerHarness
+{
+    static constexpr int32 NextHeartbeatSeconds = 10;
+    static constexpr int32 TimeoutSeconds = 60;
+
+    TSharedRef<FDriftHeartbeatMultiplexer> Multiplexer = MakeShared<FDriftHeartbeatMultiplexer>();
+    TArray<TUniquePtr<FDriftHeartbeatScheduler>> Schedulers;
+    TArray<int32> Handles;
+    TArray<int32> ResultCounts;
+    double Now = 0.0;
+    int32 Requests = 0;
+    int32 Heartbeats = 0;
+    EDriftHeartbeatStatus StubStatus = EDriftHeartbeatStatus::Succeeded;
+    /** Per entry of the batch, overriding StubStatus */
+    TArray<EDriftHeartbeatStatus> StubStatuses;
+    TArray<EDriftHeartbeatStatus> LastStatuses;
+    /** When set, the whole batch request fails with this status code */
+    int32 StubResponseCode = 0;
+
+    /** Shared by every instance, like the root request manager of a Drift instance */
+    TSharedRef<JsonRequestManager> BatchRequestManager = MakeShared<JsonRequestManager>();
+    TArray<TSharedRef<JsonRequestManager>> SessionRequestManagers;
+    TSharedPtr<JsonRequestManager> LastRequestManager;
+    TArray<FString> LastAuthorizations;
+
+    FHeartbeatMultiplexerHarness()
+    {
+        Multiplexer->SetBatchSender([this](const FString& BatchUrl, const TSharedPtr<JsonRequestManager>& RequestManager,
+            const FDriftHeartbeatBatchPayload& Payload, TFunction<void(TArray<FDriftHeartbeatResult>&&)> OnComplete)
+        {
+            ++Requests;
+            Heartbeats += Payload.heartbeats.Num();
+            LastRequestManager = RequestManager;
+            LastAuthorizations.Reset();
+            for (const auto& Entry : Payload.heartbeats)
+            {
+                LastAuthorizations.Add(Entry.authorization);
+            }
+
+            if (StubResponseCode != 0)
+            {
+                TArray<FDriftHeartbeatResult> Results;
+                Results.Init(FDriftHeartbeatResult{ FDriftHeartbeatMultiplexer::GetBatchFailureStatus(true, StubResponseCode) }, Payload.heartbeats.Num());
+                OnComplete(MoveTemp(Results));
+                return;
+            }
+
+            TArray<FDriftHeartbeatResult> Results;
+            Results.Init(FDriftHeartbeatResult{ StubStatus, 0.1f, NextHeartbeatSeconds, TimeoutSeconds, {} }, Payload.heartbeats.Num());
+            for (auto Index = 0; Index < Results.Num() && Index < StubStatuses.Num(); ++Index)
+            {
+                Results[Index].status = StubStatuses[Index];
+            }
+            OnComplete(MoveTemp(Results));
+        });
+    }
+
+    void AddInstance(double StartAt, const FString& BatchUrl = TEXT("https://stub/heartbeats"))
+    {
+        const auto Index = Schedulers.Num();
+        auto* Scheduler = Schedulers.Add_GetRef(MakeUnique<FDriftHeartbeatScheduler>()).Get();
+        Scheduler->Start(StartAt, NextHeartbeatSeconds);
+        ResultCounts.Add(0);
+        LastStatuses.Add(EDriftHeartbeatStatus::Failed);
+
+        const auto& SessionRequestManager = SessionRequestManagers.Add_GetRef(MakeShared<JWTRequestManager>(FString::Printf(TEXT("token%d"), Index)));
+
+        FDriftHeartbeatParticipant Participant;
+        Participant.scheduler = Scheduler;
+        Participant.heartbeatUrl = FString::Printf(TEXT("https://stub/clients/%d"), Index);
+        Participant.batchUrl = BatchUrl;
+        Participant.requestManager = SessionRequestManager;
+        Participant.batchRequestManager = BatchRequestManager;
+        Participant.onResult.BindLambda([this, Scheduler, Index](const FDriftHeartbeatResult& Result)
+        {
+            ++ResultCounts[Index];
+            LastStatuses[Index] = Result.status;
+            if (Result.status == EDriftHeartbeatStatus::Succeeded)
+            {
+                Scheduler->HeartbeatSucceeded(Now, Result.roundTripSeconds, Result.nextHeartbeatSeconds, Result.timeoutSeconds);
+            }
+            else
+            {
+                Scheduler->HeartbeatFailed(Now, 1.0f);
+            }
+        });
+        Handles.Add(Multiplexer->Register(MoveTemp(Participant)));
+    }
+
+    void Run(double Seconds)
+    {
+        for (const auto End = Now + Seconds; Now < End; Now += 0.1)
+        {
+            Multiplexer->SendDueHeartbeats(Now);
+        }
+    }
+
+    bool AnyTimedOut() const
+    {
+        return Schedulers.ContainsByPredicate([this](const TUniquePtr<FDriftHeartbeatScheduler>& Scheduler)
+        {
+            return Scheduler->IsTimedOut(Now);
+        });
+    }
+};
+
+
+BEGIN_DEFINE_SPEC(DriftHeartbeatMultiplexerSpec, "Game.Drift.HeartbeatMultiplexer", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(DriftHeartbeatMultiplexerSpec)
+
+void DriftHeartbeatMultiplexerSpec::Define()
+{
+    Describe("SendDueHeartbeats", [this]
+    {
+        It("should send about one request per interval for 500 instances", [this]
+        {
+            FHeartbeatMultiplexerHarness Harness;
+            for (auto Index = 0; Index < 500; ++Index)
+            {
+                // Logged in at different times over the first interval
+                Harness.AddInstance(Index * 0.02);
+            }
+
+            Harness.Run(600.0);
+
+            const auto Intervals = 600 / FHeartbeatMultiplexerHarness::NextHeartbeatSeconds;
+            TestTrue(FString::Printf(TEXT("%d requests for %d intervals"), Harness.Requests, Intervals), Harness.Requests <= Intervals + 2);
+            TestTrue(FString::Printf(TEXT("%d heartbeats"), Harness.Heartbeats), Harness.Heartbeats >= 500 * (Intervals - 2));
+            TestFalse("No session timed out", Harness.AnyTimedOut());
+        });
+
+        It("should not send anything before an instance is due", [this]
+        {
+            FHeartbeatMultiplexerHarness Harness;
+            Harness.AddInstance(0.0);
+            Harness.AddInstance(5.0);
+
+            Harness.Run(9.9);
+
+            TestEqual("Requests", Harness.Requests, 0);
+        });
+
+        It("should batch instances of different backends separately", [this]
+        {
+            FHeartbeatMultiplexerHarness Harness;
+            Harness.AddInstance(0.0, TEXT("https://one/heartbeats"));
+            Harness.AddInstance(0.0, TEXT("https://two/heartbeats"));
+
+            Harness.Run(10.1);
+
+            TestEqual("Requests", Harness.Requests, 2);
+            TestEqual("Heartbeats", Harness.Heartbeats, 2);
+        });
+    });
+
+    Describe("Unregister", [this]
+    {
+        It("should leave unregistered instances out of batches and results", [this]
+        {
+            FHeartbeatMultiplexerHarness Harness;
+            Harness.AddInstance(0.0);
+            Harness.AddInstance(0.0);
+            Harness.Multiplexer->Unregister(Harness.Handles[1]);
+
+            Harness.Run(10.1);
+
+            TestEqual("Heartbeats", Harness.Heartbeats, 1);
+            TestEqual("Results for the registered instance", Harness.ResultCounts[0], 1);
+            TestEqual("Results for the unregistered instance", Harness.ResultCounts[1], 0);
+        });
+    });
+
+    Describe("Results", [this]
+    {
+        It("should pass failures on to every instance in the batch", [this]
+        {
+            FHeartbeatMultiplexerHarness Harness;
+            Harness.StubStatus = EDriftHeartbeatStatus::Unsupported;
+            Harness.AddInstance(0.0);
+            Harness.AddInstance(0.0);
+
+            Harness.Run(10.1);
+
+            TestEqual("Requests", Harness.Requests, 1);
+            TestEqual("Results for the first instance", Harness.ResultCounts[0], 1);
+            TestEqual("Results for the second instance", Harness.ResultCounts[1], 1);
+        });
+
+        It("should give each instance the result of its own entry", [this]
+        {
+            FHeartbeatMultiplexerHarness Harness;
+            Harness.StubStatuses = { EDriftHeartbeatStatus::Succeeded, EDriftHeartbeatStatus::Rejected, EDriftHeartbeatStatus::Failed };
+            Harness.AddInstance(0.0);
+            Harness.AddInstance(0.0);
+            Harness.AddInstance(0.0);
+
+            Harness.Run(10.1);
+
+            TestEqual("Requests", Harness.Requests, 1);
+            TestTrue("Succeeded", Harness.LastStatuses[0] == EDriftHeartbeatStatus::Succeeded);
+            TestTrue("Rejected", Harness.LastStatuses[1] == EDriftHeartbeatStatus::Rejected);
+            TestTrue("Failed", Harness.LastStatuses[2] == EDriftHeartbeatStatus::Failed);
+        });
+
+        It("should post the batch with the shared request manager and each session's own authorization", [this]
+        {
+            FHeartbeatMultiplexerHarness Harness;
+            Harness.AddInstance(0.0);
+            Harness.AddInstance(0.0);
+
+            Harness.Run(10.1);
+
+            TestTrue("Request manager", Harness.LastRequestManager == Harness.BatchRequestManager);
+            TestEqual("Authorizations", Harness.LastAuthorizations.Num(), 2);
+            TestNotEqual("Each session's own", Harness.LastAuthorizations[0], Harness.LastAuthorizations[1]);
+            TestTrue("Has a token", Harness.LastAuthorizations[0].Contains(TEXT("token0")));
+        });
+
+        It("should send heartbeats individually when the batch is refused with 401", [this]
+        {
+            FHeartbeatMultiplexerHarness Harness;
+            Harness.StubResponseCode = static_cast<int32>(HttpStatusCodes::Unauthorized);
+            Harness.AddInstance(0.0);
+            Harness.AddInstance(0.0);
+
+            Harness.Run(10.1);
+
+            TestTrue("First instance on its own", Harness.LastStatuses[0] == EDriftHeartbeatStatus::Unsupported);
+            TestTrue("Second instance on its own", Harness.LastStatuses[1] == EDriftHeartbeatStatus::Unsupported);
+            TestTrue("Forbidden", FDriftHeartbeatMultiplexer::GetBatchFailureStatus(true, static_cast<int32>(HttpStatusCodes::Forbidden)) == EDriftHeartbeatStatus::Unsupported);
+            TestTrue("Server error", FDriftHeartbeatMultiplexer::GetBatchFailureStatus(true, static_cast<int32>(HttpStatusCodes::InternalServerError)) == EDriftHeartbeatStatus::Failed);
+            TestTrue("No response", FDriftHeartbeatMultiplexer::GetBatchFailureStatus(false, 0) == EDriftHeartbeatStatus::Failed);
+        });
+    });
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,194 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftHeartbeatScheduler.h"
+
+#include "Misc/AutomationTest.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Stands in for the request manager and the backend, on a clock the test controls.
+ * Heartbeats take a fixed round trip and reset the session timeout, unless the network is down.
+ */
+struct FFakeHeartbeatBackend
+{
+    static constexpr float NextHeartbeatSeconds = 10.0f;
+    static constexpr float TimeoutSeconds = 60.0f;
+    static constexpr float RoundTripSeconds = 0.2f;
+
+    FDriftHeartbeatScheduler Scheduler;
+    double Now = 0.0;
+    double SessionExpiresAt = TimeoutSeconds;
+    bool bNetworkDown = false;
+    /** Whether heartbeat responses say when the session times out */
+    bool bReportsTimeout = true;
+    bool bSessionLost = false;
+    bool bTimeoutDetected = false;
+    double TimeoutDetectedAt = 0.0;
+    int32 Heartbeats = 0;
+
+    FFakeHeartbeatBackend()
+    {
+        Scheduler.Start(Now, NextHeartbeatSeconds);
+    }
+
+    void Run(double Seconds, float TrafficIntervalSeconds)
+    {
+        const auto Step = 0.1;
+        auto NextTrafficAt = Now + TrafficIntervalSeconds;
+        for (const auto End = Now + Seconds; Now < End && !bTimeoutDetected; Now += Step)
+        {
+            if (Now > SessionExpiresAt)
+            {
+                bSessionLost = true;
+            }
+
+            if (Scheduler.IsTimedOut(Now))
+            {
+                bTimeoutDetected = true;
+                TimeoutDetectedAt = Now;
+                return;
+            }
+
+            if (TrafficIntervalSeconds > 0.0f && Now >= NextTrafficAt && !bNetworkDown)
+            {
+                Scheduler.RecordActivity(Now, RoundTripSeconds);
+                NextTrafficAt += TrafficIntervalSeconds;
+            }
+
+            if (Scheduler.IsHeartbeatDue(Now))
+            {
+                Scheduler.HeartbeatSent();
+                ++Heartbeats;
+                if (bNetworkDown)
+                {
+                    Scheduler.HeartbeatFailed(Now, 2.0f);
+                }
+                else
+                {
+                    SessionExpiresAt = Now + TimeoutSeconds;
+                    Scheduler.HeartbeatSucceeded(Now + RoundTripSeconds, RoundTripSeconds, NextHeartbeatSeconds, bReportsTimeout ? TimeoutSeconds : 0.0f);
+                }
+            }
+        }
+    }
+};
+
+
+BEGIN_DEFINE_SPEC(DriftHeartbeatSchedulerSpec, "Game.Drift.HeartbeatScheduler", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(DriftHeartbeatSchedulerSpec)
+
+void DriftHeartbeatSchedulerSpec::Define()
+{
+    Describe("IsHeartbeatDue", [this]
+    {
+        It("should heartbeat on the regular cadence when idle", [this]
+        {
+            FFakeHeartbeatBackend Backend;
+            Backend.Run(600.0, 0.0f);
+
+            // One per interval, plus the round trip before the next one is scheduled
+            TestTrue("Roughly one heartbeat per interval", Backend.Heartbeats >= 55 && Backend.Heartbeats <= 60);
+            TestFalse("Session stays alive", Backend.bSessionLost);
+            TestFalse("No timeout detected", Backend.bTimeoutDetected);
+        });
+
+        It("should send fewer heartbeats under steady traffic", [this]
+        {
+            FFakeHeartbeatBackend Idle;
+            Idle.Run(600.0, 0.0f);
+
+            FFakeHeartbeatBackend Busy;
+            Busy.Run(600.0, 2.0f);
+
+            TestTrue(FString::Printf(TEXT("%d heartbeats with traffic is well below %d without"), Busy.Heartbeats, Idle.Heartbeats), Busy.Heartbeats * 3 < Idle.Heartbeats);
+            TestFalse("Session stays alive", Busy.bSessionLost);
+            TestFalse("No timeout detected", Busy.bTimeoutDetected);
+        });
+
+        It("should send the first heartbeat on time when traffic starts before it", [this]
+        {
+            FDriftHeartbeatScheduler Scheduler;
+            Scheduler.Start(0.0, 10.0f);
+            for (auto Now = 0.0; Now < 10.0; Now += 0.5)
+            {
+                Scheduler.RecordActivity(Now, 0.1f);
+                TestFalse(FString::Printf(TEXT("Not due at %.1f"), Now), Scheduler.IsHeartbeatDue(Now));
+            }
+
+            TestTrue("Due after the interval", Scheduler.IsHeartbeatDue(10.0));
+        });
+
+        It("should keep to the regular cadence under traffic when the server doesn't say when it times out", [this]
+        {
+            FFakeHeartbeatBackend Backend;
+            Backend.bReportsTimeout = false;
+            Backend.Run(600.0, 2.0f);
+
+            TestTrue(FString::Printf(TEXT("%d heartbeats, roughly one per interval"), Backend.Heartbeats), Backend.Heartbeats >= 55 && Backend.Heartbeats <= 60);
+            TestFalse("Session stays alive", Backend.bSessionLost);
+        });
+
+        It("should let traffic postpone the first heartbeat when the timeout is known from the start", [this]
+        {
+            FDriftHeartbeatScheduler Scheduler;
+            Scheduler.Start(0.0, 10.0f, 60.0f);
+            for (auto Now = 0.0; Now < 20.0; Now += 0.5)
+            {
+                Scheduler.RecordActivity(Now, 0.1f);
+            }
+
+            TestFalse("Postponed past the interval", Scheduler.IsHeartbeatDue(20.0));
+            TestTrue("Due ahead of the timeout", Scheduler.GetNextHeartbeatAt() <= 60.0 - 10.0);
+        });
+
+        It("should not heartbeat early just because the timeout is short", [this]
+        {
+            FDriftHeartbeatScheduler Scheduler;
+            Scheduler.Start(0.0, 10.0f);
+            Scheduler.HeartbeatSent();
+            Scheduler.HeartbeatSucceeded(0.0, 0.1f, 10.0f, 12.0f);
+
+            TestFalse("Not due right after a heartbeat", Scheduler.IsHeartbeatDue(1.0));
+            TestTrue("Due after the interval", Scheduler.IsHeartbeatDue(10.0));
+        });
+    });
+
+    Describe("IsTimedOut", [this]
+    {
+        It("should detect the timeout before the server does when heartbeats fail", [this]
+        {
+            FFakeHeartbeatBackend Backend;
+            Backend.Run(120.0, 2.0f);
+            Backend.bNetworkDown = true;
+            Backend.Run(600.0, 2.0f);
+
+            TestTrue("Timeout detected", Backend.bTimeoutDetected);
+            TestTrue("Detected no later than the session expired", Backend.TimeoutDetectedAt <= Backend.SessionExpiresAt);
+            TestTrue("Detected within the safety margin", Backend.SessionExpiresAt - Backend.TimeoutDetectedAt <= Backend.Scheduler.GetSafetyMargin() + 1.0);
+        });
+
+        It("should adapt the safety margin to the round trip", [this]
+        {
+            FDriftHeartbeatScheduler Steady;
+            Steady.Start(0.0, 10.0f);
+            for (auto Index = 0; Index < 50; ++Index)
+            {
+                Steady.RecordActivity(Index, 0.1f);
+            }
+
+            FDriftHeartbeatScheduler Jittery;
+            Jittery.Start(0.0, 10.0f);
+            for (auto Index = 0; Index < 50; ++Index)
+            {
+                Jittery.RecordActivity(Index, Index % 2 ? 0.1f : 2.0f);
+            }
+
+            TestTrue("Steady connections get a small margin", Steady.GetSafetyMargin() < 5.0f);
+            TestTrue("Jittery connections get a larger margin", Jittery.GetSafetyMargin() > Steady.GetSafetyMargin());
+        });
+    });
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
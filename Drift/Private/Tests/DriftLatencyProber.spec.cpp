@@ -0,0 +1,231 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftLatencyProber.h"
+
+#include "Misc/AutomationTest.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Answers every probe on the spot instead of sending it, with whatever the test says the
+ * latency over that method is
+ */
+class FFakeLatencyProber : public FDriftLatencyProber
+{
+public:
+	using FDriftLatencyProber::FDriftLatencyProber;
+
+	/* Milliseconds, or less than zero for no reply */
+	TFunction<float(EDriftLatencyProbeMethod, const FString& /* Target */)> Latency = [](EDriftLatencyProbeMethod, const FString&) { return 50.0f; };
+	TSet<EDriftLatencyProbeMethod> NotImplemented;
+
+	TArray<EDriftLatencyProbeMethod> Sent;
+	int32 Depth = 0;
+	int32 MaxDepth = 0;
+
+protected:
+	void SendProbe(EDriftLatencyProbeMethod InMethod, const FString& Target, float Timeout, FProbeCompleted OnCompleted) override
+	{
+		Sent.Add(InMethod);
+		MaxDepth = FMath::Max(MaxDepth, ++Depth);
+
+		if (NotImplemented.Contains(InMethod))
+		{
+			OnCompleted(EProbeResult::NotImplemented, 0.0f);
+		}
+		else
+		{
+			const auto Milliseconds = Latency(InMethod, Target);
+			OnCompleted(Milliseconds < 0.0f ? EProbeResult::Failure : EProbeResult::Success, Milliseconds / 1000.0f);
+		}
+
+		--Depth;
+	}
+};
+
+
+struct FLatencyProberHarness
+{
+	TSharedRef<FFakeLatencyProber> Prober;
+	TMap<FString, int32> Latencies;
+	int32 Cycles = 0;
+
+	explicit FLatencyProberHarness(const TArray<FString>& Regions, int32 SamplesPerRegion = 3)
+		: Prober{ MakeShared<FFakeLatencyProber>(MakeSettings(SamplesPerRegion)) }
+	{
+		Prober->SetRegions(Regions);
+	}
+
+	static FDriftLatencyProbeSettings MakeSettings(int32 SamplesPerRegion)
+	{
+		FDriftLatencyProbeSettings Settings;
+		Settings.SamplesPerRegion = SamplesPerRegion;
+		return Settings;
+	}
+
+	bool RunCycle()
+	{
+		return Prober->StartCycle(FDriftLatencyProber::FCycleCompleted::CreateLambda([this](const TMap<FString, int32>& LatenciesByRegion)
+		{
+			Latencies = LatenciesByRegion;
+			++Cycles;
+		}));
+	}
+};
+
+
+BEGIN_DEFINE_SPEC(DriftLatencyProberSpec, "Game.Drift.LatencyProber", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(DriftLatencyProberSpec)
+
+void DriftLatencyProberSpec::Define()
+{
+	Describe("FDriftLatencyEstimate", [this]
+	{
+		It("should leave outliers out of the median and the jitter", [this]
+		{
+			FDriftLatencyEstimate Estimate;
+			for (const auto Sample : { 50.0f, 51.0f, 49.0f, 500.0f, 50.0f, 52.0f })
+			{
+				Estimate.AddSample(Sample);
+			}
+
+			TestEqual("Median", Estimate.GetMedian(), 50.5f);
+			TestEqual("Jitter", Estimate.GetJitter(), 0.9f, 0.01f);
+			TestEqual("Packet loss", Estimate.GetPacketLoss(), 0.0f);
+		});
+
+		It("should count probes without a reply as lost", [this]
+		{
+			FDriftLatencyEstimate Estimate;
+			Estimate.AddSample(50.0f);
+			Estimate.AddLoss();
+			Estimate.AddSample(50.0f);
+			Estimate.AddLoss();
+
+			TestEqual("Packet loss", Estimate.GetPacketLoss(), 0.5f);
+		});
+	});
+
+	Describe("StartCycle", [this]
+	{
+		It("should report the median of each region", [this]
+		{
+			FLatencyProberHarness Harness{ { TEXT("eu-west-1") }, 5 };
+			auto Probes = 0;
+			Harness.Prober->Latency = [&Probes](EDriftLatencyProbeMethod, const FString&)
+			{
+				return ++Probes == 2 ? 500.0f : 50.0f;
+			};
+
+			TestTrue("Started", Harness.RunCycle());
+
+			TestEqual("Cycles", Harness.Cycles, 1);
+			TestEqual("Latency", Harness.Latencies.FindRef(TEXT("eu-west-1")), 50);
+			TestFalse("Probing", Harness.Prober->IsProbing());
+		});
+
+		It("should send the next probe after one that completes right away without nesting", [this]
+		{
+			FLatencyProberHarness Harness{ { TEXT("eu-west-1"), TEXT("us-east-1"), TEXT("ap-south-1") }, 10 };
+
+			Harness.RunCycle();
+
+			TestEqual("Probes", Harness.Prober->Sent.Num(), 30);
+			TestEqual("Nesting", Harness.Prober->MaxDepth, 1);
+			TestEqual("Cycles", Harness.Cycles, 1);
+		});
+
+		It("should report regions that never replied as -1", [this]
+		{
+			FLatencyProberHarness Harness{ { TEXT("eu-west-1") } };
+			Harness.Prober->Latency = [](EDriftLatencyProbeMethod, const FString&) { return -1.0f; };
+
+			Harness.RunCycle();
+
+			TestEqual("Latency", Harness.Latencies.FindRef(TEXT("eu-west-1")), -1);
+		});
+	});
+
+	Describe("Packet loss", [this]
+	{
+		It("should count a region that is silent while others reply as losing probes", [this]
+		{
+			FLatencyProberHarness Harness{ { TEXT("eu-west-1"), TEXT("us-east-1") } };
+			Harness.Prober->Latency = [](EDriftLatencyProbeMethod, const FString& Target)
+			{
+				return Target.Contains(TEXT("us-east-1")) ? -1.0f : 50.0f;
+			};
+
+			Harness.RunCycle();
+
+			const auto Silent = Harness.Prober->GetEstimate(TEXT("us-east-1"));
+			TestTrue("Silent region", Silent && !Silent->HasSamples() && Silent->GetPacketLoss() == 1.0f);
+			TestEqual("Replying region", Harness.Prober->GetEstimate(TEXT("eu-west-1"))->GetPacketLoss(), 0.0f);
+		});
+
+		It("should not count probes lost when the method isn't getting through at all", [this]
+		{
+			FLatencyProberHarness Harness{ { TEXT("eu-west-1"), TEXT("us-east-1") } };
+			Harness.Prober->Latency = [](EDriftLatencyProbeMethod Method, const FString&)
+			{
+				return Method == EDriftLatencyProbeMethod::Http ? 80.0f : -1.0f;
+			};
+
+			for (auto Cycle = 0; Cycle < 4; ++Cycle)
+			{
+				Harness.RunCycle();
+			}
+
+			TestTrue("Method", Harness.Prober->GetMethod() == EDriftLatencyProbeMethod::Http);
+			TestEqual("Packet loss", Harness.Prober->GetEstimate(TEXT("eu-west-1"))->GetPacketLoss(), 0.0f);
+		});
+	});
+
+	Describe("Method", [this]
+	{
+		It("should fall back to the next method when one isn't implemented", [this]
+		{
+			FLatencyProberHarness Harness{ { TEXT("eu-west-1") } };
+			Harness.Prober->NotImplemented.Add(EDriftLatencyProbeMethod::Icmp);
+			Harness.Prober->Latency = [](EDriftLatencyProbeMethod Method, const FString&)
+			{
+				return Method == EDriftLatencyProbeMethod::Http ? 80.0f : 20.0f;
+			};
+
+			Harness.RunCycle();
+
+			// No UDP echo server is configured, so it goes straight to HTTP
+			TestTrue("Method", Harness.Prober->GetMethod() == EDriftLatencyProbeMethod::Http);
+			TestEqual("ICMP probes", Harness.Prober->Sent.FilterByPredicate([](EDriftLatencyProbeMethod Method) { return Method == EDriftLatencyProbeMethod::Icmp; }).Num(), 1);
+			TestEqual("Latency", Harness.Latencies.FindRef(TEXT("eu-west-1")), 80);
+		});
+
+		It("should set a method aside after cycles without replies and try it again later", [this]
+		{
+			FLatencyProberHarness Harness{ { TEXT("eu-west-1") } };
+			Harness.Prober->Latency = [](EDriftLatencyProbeMethod Method, const FString&)
+			{
+				return Method == EDriftLatencyProbeMethod::Http ? 80.0f : -1.0f;
+			};
+
+			Harness.RunCycle();
+			Harness.RunCycle();
+			TestTrue("Method after two failed cycles", Harness.Prober->GetMethod() == EDriftLatencyProbeMethod::Icmp);
+
+			Harness.RunCycle();
+			Harness.RunCycle();
+			TestTrue("Method once set aside", Harness.Prober->GetMethod() == EDriftLatencyProbeMethod::Http);
+			TestEqual("Latency", Harness.Latencies.FindRef(TEXT("eu-west-1")), 80);
+
+			for (auto Cycle = 0; Cycle < 10; ++Cycle)
+			{
+				Harness.RunCycle();
+			}
+			TestTrue("Method after a while", Harness.Prober->GetMethod() == EDriftLatencyProbeMethod::Icmp);
+			TestTrue("Probed over ICMP", Harness.Prober->Sent.Last() == EDriftLatencyProbeMethod::Icmp);
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,240 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftLatencyReporter.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static FString LatencyReporterTestFile()
+{
+	return FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("DriftLatencies.json"));
+}
+
+
+/**
+ * Stands in for the backend, which keeps the last few latencies reported for each region
+ * and matches on their average, returning the averages of all regions with every report
+ */
+struct FLatencyAveragingBackend
+{
+	static constexpr int32 Window = 3;
+
+	TMap<FString, TArray<int32>> Reports;
+	int32 Patches = 0;
+
+	TMap<FString, int32> Patch(const TMap<FString, int32>& Latencies)
+	{
+		++Patches;
+		for (const auto& Latency : Latencies)
+		{
+			auto& Recent = Reports.FindOrAdd(Latency.Key);
+			Recent.Add(Latency.Value);
+			if (Recent.Num() > Window)
+			{
+				Recent.RemoveAt(0);
+			}
+		}
+
+		TMap<FString, int32> Averages;
+		for (const auto& Region : Reports)
+		{
+			Averages.Add(Region.Key, GetAverage(Region.Key));
+		}
+		return Averages;
+	}
+
+	int32 GetAverage(const FString& Region) const
+	{
+		const auto Recent = Reports.Find(Region);
+		if (!Recent || Recent->Num() == 0)
+		{
+			return 0;
+		}
+
+		auto Sum = 0;
+		for (const auto Latency : *Recent)
+		{
+			Sum += Latency;
+		}
+		return FMath::RoundToInt(Sum / static_cast<float>(Recent->Num()));
+	}
+};
+
+
+BEGIN_DEFINE_SPEC(DriftLatencyReporterSpec, "Game.Drift.LatencyReporter", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+	FDateTime Start{ 2026, 1, 1 };
+END_DEFINE_SPEC(DriftLatencyReporterSpec)
+
+void DriftLatencyReporterSpec::Define()
+{
+	BeforeEach([this]
+	{
+		IFileManager::Get().Delete(*LatencyReporterTestFile());
+	});
+
+	AfterEach([this]
+	{
+		IFileManager::Get().Delete(*LatencyReporterTestFile());
+	});
+
+	Describe("Update", [this]
+	{
+		It("should report regions that are new, have moved past the threshold, or are getting old", [this]
+		{
+			FDriftLatencyReporter Reporter{ LatencyReporterTestFile() };
+			FDriftLatencyReportSettings Settings;
+			Settings.ThresholdMs = 10;
+			Settings.FreshnessSeconds = 60.0f;
+			Reporter.SetSettings(Settings);
+
+			auto ToReport = Reporter.Update({ { TEXT("eu-west-1"), 40 }, { TEXT("us-east-1"), 110 }, { TEXT("ap-east-1"), -1 } }, Start);
+			TestEqual("Reported at first", ToReport.Num(), 2);
+			Reporter.ReportSucceeded(ToReport, ToReport, Start);
+
+			ToReport = Reporter.Update({ { TEXT("eu-west-1"), 48 }, { TEXT("us-east-1"), 125 } }, Start + FTimespan::FromSeconds(2.0));
+			TestTrue("Reported after a move", ToReport.Num() == 1 && ToReport.Contains(TEXT("us-east-1")));
+			Reporter.ReportSucceeded(ToReport, ToReport, Start + FTimespan::FromSeconds(2.0));
+
+			ToReport = Reporter.Update({ { TEXT("eu-west-1"), 48 }, { TEXT("us-east-1"), 125 } }, Start + FTimespan::FromSeconds(60.0));
+			TestTrue("Reported once old", ToReport.Num() == 1 && ToReport.Contains(TEXT("eu-west-1")));
+		});
+
+		It("should keep reporting what the backend never accepted", [this]
+		{
+			FDriftLatencyReporter Reporter{ LatencyReporterTestFile() };
+
+			Reporter.Update({ { TEXT("eu-west-1"), 40 } }, Start);
+			const auto ToReport = Reporter.Update({ { TEXT("eu-west-1"), 40 } }, Start + FTimespan::FromSeconds(2.0));
+
+			TestEqual("Reported again", ToReport.Num(), 1);
+		});
+
+		It("should keep reporting a region until the backend's average is within the threshold", [this]
+		{
+			FDriftLatencyReporter Reporter{ LatencyReporterTestFile() };
+			FLatencyAveragingBackend Backend;
+
+			auto Now = Start;
+			for (auto Cycle = 0; Cycle < 3; ++Cycle, Now += FTimespan::FromSeconds(2.0))
+			{
+				const auto ToReport = Reporter.Update({ { TEXT("eu-west-1"), 40 } }, Now);
+				if (ToReport.Num() > 0)
+				{
+					Reporter.ReportSucceeded(ToReport, Backend.Patch(ToReport), Now);
+				}
+			}
+			TestEqual("Reports before the move", Backend.Patches, 1);
+
+			// After a move, the average of what was reported lags behind for a few reports
+			TArray<int32> Averages;
+			for (auto Cycle = 0; Cycle < 5; ++Cycle, Now += FTimespan::FromSeconds(2.0))
+			{
+				const auto ToReport = Reporter.Update({ { TEXT("eu-west-1"), 100 } }, Now);
+				if (ToReport.Num() > 0)
+				{
+					Reporter.ReportSucceeded(ToReport, Backend.Patch(ToReport), Now);
+					Averages.Add(Backend.GetAverage(TEXT("eu-west-1")));
+				}
+			}
+
+			TestTrue("Reported until caught up", Averages == TArray<int32>{ 70, 80, 100 });
+		});
+
+		It("should send far fewer reports for a scripted series while the backend stays within the threshold", [this]
+		{
+			FDriftLatencyReporter Reporter{ LatencyReporterTestFile() };
+			FDriftLatencyReportSettings Settings;
+			Settings.ThresholdMs = 10;
+			Settings.FreshnessSeconds = 60.0f;
+			Reporter.SetSettings(Settings);
+
+			// Twenty minutes of measurements every two seconds: jitter everywhere, a step up and a
+			// step down, and a slow drift
+			constexpr int32 Cycles = 600;
+			const TArray<FString> Regions{ TEXT("eu-west-1"), TEXT("us-east-1"), TEXT("ap-east-1") };
+			FRandomStream Noise{ 1234 };
+			const auto MeasuredAt = [&Noise](int32 Region, int32 Cycle)
+			{
+				const auto Jitter = Noise.RandRange(-3, 3);
+				switch (Region)
+				{
+					case 0: return 40 + (Cycle >= 200 ? 40 : 0) + Jitter;
+					case 1: return 120 - (Cycle >= 400 ? 25 : 0) + Jitter;
+					default: return 200 + Cycle / 20 + Jitter;
+				}
+			};
+
+			FLatencyAveragingBackend Backend;
+			TMap<FString, int32> CyclesOff;
+			auto MaxCyclesOff = 0;
+			for (auto Cycle = 0; Cycle < Cycles; ++Cycle)
+			{
+				const auto Now = Start + FTimespan::FromSeconds(Cycle * 2.0);
+
+				TMap<FString, int32> Latencies;
+				for (auto Region = 0; Region < Regions.Num(); ++Region)
+				{
+					Latencies.Add(Regions[Region], MeasuredAt(Region, Cycle));
+				}
+
+				const auto ToReport = Reporter.Update(Latencies, Now);
+				if (ToReport.Num() > 0)
+				{
+					Reporter.ReportSucceeded(ToReport, Backend.Patch(ToReport), Now);
+				}
+
+				for (const auto& Latency : Latencies)
+				{
+					auto& Off = CyclesOff.FindOrAdd(Latency.Key);
+					Off = FMath::Abs(Backend.GetAverage(Latency.Key) - Latency.Value) > Settings.ThresholdMs ? Off + 1 : 0;
+					MaxCyclesOff = FMath::Max(MaxCyclesOff, Off);
+				}
+			}
+
+			AddInfo(FString::Printf(TEXT("%d reports in %d cycles, backend average off by more than the threshold for at most %d cycles in a row"),
+				Backend.Patches, Cycles, MaxCyclesOff));
+			TestTrue("Less than a tenth of the reports", Backend.Patches * 10 < Cycles);
+			// Every report moves the average, so it takes fewer reports than it averages over to catch up
+			TestTrue("Backend back within the threshold", MaxCyclesOff < FLatencyAveragingBackend::Window);
+		});
+	});
+
+	Describe("GetSeed", [this]
+	{
+		It("should start the next session with recent measurements", [this]
+		{
+			{
+				FDriftLatencyReporter Reporter{ LatencyReporterTestFile() };
+				Reporter.Update({ { TEXT("eu-west-1"), 40 } }, Start);
+				Reporter.Update({ { TEXT("us-east-1"), 110 } }, Start + FTimespan::FromDays(10.0));
+			}
+
+			FDriftLatencyReporter Reporter{ LatencyReporterTestFile() };
+			const auto Seed = Reporter.GetSeed(Start + FTimespan::FromDays(10.5));
+
+			TestEqual("Seeded regions", Seed.Num(), 1);
+			TestEqual("Seeded latency", Seed.FindRef(TEXT("us-east-1")), 110);
+		});
+
+		It("should not save seeded latencies as new measurements", [this]
+		{
+			{
+				FDriftLatencyReporter Reporter{ LatencyReporterTestFile() };
+				Reporter.Update({ { TEXT("eu-west-1"), 40 } }, Start);
+			}
+			{
+				FDriftLatencyReporter Reporter{ LatencyReporterTestFile() };
+				Reporter.Update(Reporter.GetSeed(Start + FTimespan::FromDays(6.0)), Start + FTimespan::FromDays(6.0), false);
+			}
+
+			FDriftLatencyReporter Reporter{ LatencyReporterTestFile() };
+			TestEqual("Seeded regions", Reporter.GetSeed(Start + FTimespan::FromDays(8.0)).Num(), 0);
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,162 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftLobbyEventSequencer.h"
+
+#include "Misc/AutomationTest.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * A lobby reduced to a few slots, where the event at revision N sets slot N % 4 to N. The end
+ * state depends on the order events are applied in, so it shows up anything applied out of turn.
+ */
+struct FLobbyEventSequencerHarness
+{
+	static constexpr int32 NumSlots = 4;
+
+	FString LobbyId = TEXT("lobby");
+	TArray<int64> Slots;
+	int32 Resyncs = 0;
+	FDriftLobbyEventSequencer Sequencer;
+
+	FLobbyEventSequencerHarness()
+		: Sequencer{
+			[this](const FDriftSocialEvent& Event)
+			{
+				const auto Revision = Event.Lobby.revision;
+				Slots[Revision % NumSlots] = Revision;
+			},
+			[this]()
+			{
+				++Resyncs;
+			}}
+	{
+		Slots.Init(0, NumSlots);
+		Sequencer.SnapshotApplied(LobbyId, 0);
+	}
+
+	static TArray<int64> ServerStateAt(int64 Revision)
+	{
+		TArray<int64> State;
+		State.Init(0, NumSlots);
+		for (int64 Applied = 1; Applied <= Revision; ++Applied)
+		{
+			State[Applied % NumSlots] = Applied;
+		}
+		return State;
+	}
+
+	void Receive(int64 Revision)
+	{
+		FDriftSocialEvent Event;
+		Event.Lobby.lobby_id = LobbyId;
+		Event.Lobby.revision = Revision;
+		Sequencer.Receive(Event);
+	}
+
+	void Receive(std::initializer_list<int64> Revisions)
+	{
+		for (const auto Revision : Revisions)
+		{
+			Receive(Revision);
+		}
+	}
+
+	void FinishResync(int64 SnapshotRevision)
+	{
+		Slots = ServerStateAt(SnapshotRevision);
+		Sequencer.SnapshotApplied(LobbyId, SnapshotRevision);
+		Sequencer.ResyncFinished(true);
+	}
+};
+
+
+BEGIN_DEFINE_SPEC(DriftLobbyEventSequencerSpec, "Game.Drift.LobbyEventSequencer", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(DriftLobbyEventSequencerSpec)
+
+void DriftLobbyEventSequencerSpec::Define()
+{
+	Describe("Receive", [this]
+	{
+		It("should apply events in order and drop duplicates without syncing up", [this]
+		{
+			FLobbyEventSequencerHarness Harness;
+
+			Harness.Receive({ 1, 2, 2, 3, 1, 4, 5, 5 });
+
+			TestEqual("Resyncs", Harness.Resyncs, 0);
+			TestEqual("Applied revision", Harness.Sequencer.GetAppliedRevision(), 5ll);
+			TestTrue("Lobby state", Harness.Slots == FLobbyEventSequencerHarness::ServerStateAt(5));
+		});
+
+		It("should converge on shuffled, duplicated and missing events with exactly one resync", [this]
+		{
+			FLobbyEventSequencerHarness Harness;
+
+			// 5 and 9 never arrive, 6 reveals the gap
+			Harness.Receive({ 1, 2, 3, 2, 4, 6, 1, 7, 8, 6, 10, 12, 11, 10, 4 });
+			TestTrue("Resync in flight", Harness.Sequencer.IsResyncInFlight());
+
+			// Events keep coming while the lobby is being queried, some of them out of order
+			Harness.Receive({ 13, 15, 14, 13, 16 });
+
+			Harness.FinishResync(12);
+			TestFalse("Resync in flight", Harness.Sequencer.IsResyncInFlight());
+			TestTrue("Lobby state after the resync", Harness.Slots == FLobbyEventSequencerHarness::ServerStateAt(16));
+
+			Harness.Receive({ 17, 18, 18, 19, 16, 20 });
+
+			TestEqual("Resyncs", Harness.Resyncs, 1);
+			TestEqual("Applied revision", Harness.Sequencer.GetAppliedRevision(), 20ll);
+			TestTrue("Lobby state", Harness.Slots == FLobbyEventSequencerHarness::ServerStateAt(20));
+		});
+
+		It("should apply events without a revision as they come", [this]
+		{
+			auto Applied = 0;
+			FDriftLobbyEventSequencer Sequencer{ [&Applied](const FDriftSocialEvent&) { ++Applied; }, [] {} };
+
+			FDriftSocialEvent Event;
+			Event.Lobby.lobby_id = TEXT("lobby");
+			Sequencer.Receive(Event);
+			Sequencer.Receive(Event);
+
+			TestEqual("Applied", Applied, 2);
+		});
+	});
+
+	Describe("ResyncFinished", [this]
+	{
+		It("should sync up again if the snapshot doesn't close the gap", [this]
+		{
+			FLobbyEventSequencerHarness Harness;
+
+			Harness.Receive({ 1, 3 });
+			Harness.Receive(6);
+
+			// The snapshot was taken before 4 and 5 happened
+			Harness.FinishResync(3);
+			TestEqual("Resyncs", Harness.Resyncs, 2);
+			TestTrue("Resync in flight", Harness.Sequencer.IsResyncInFlight());
+
+			Harness.FinishResync(6);
+			TestEqual("Resyncs", Harness.Resyncs, 2);
+			TestTrue("Lobby state", Harness.Slots == FLobbyEventSequencerHarness::ServerStateAt(6));
+		});
+
+		It("should start over from the next event if the resync failed", [this]
+		{
+			FLobbyEventSequencerHarness Harness;
+
+			Harness.Receive({ 1, 3 });
+			Harness.Sequencer.ResyncFinished(false);
+			Harness.Receive(4);
+
+			TestEqual("Resyncs", Harness.Resyncs, 1);
+			TestEqual("Applied revision", Harness.Sequencer.GetAppliedRevision(), 4ll);
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,335 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftLobbyState.h"
+
+#include "Misc/AutomationTest.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+struct FLobbyStateTestMember
+{
+	int32 PlayerId = 0;
+	FString TeamName;
+	bool bReady = false;
+	bool bHost = false;
+};
+
+static JsonValue MakeLobbyMembers(const TArray<FLobbyStateTestMember>& Members)
+{
+	JsonValue Data{ rapidjson::kArrayType };
+	for (const auto& Member : Members)
+	{
+		const JsonValue Ready{ Member.bReady ? rapidjson::kTrueType : rapidjson::kFalseType };
+		const JsonValue Host{ Member.bHost ? rapidjson::kTrueType : rapidjson::kFalseType };
+
+		JsonValue Element{ rapidjson::kObjectType };
+		Element.SetField(TEXT("player_id"), Member.PlayerId);
+		Element.SetField(TEXT("player_name"), FString::Printf(TEXT("Player %d"), Member.PlayerId));
+		Element.SetField(TEXT("team_name"), Member.TeamName);
+		Element.SetField(TEXT("ready"), Ready);
+		Element.SetField(TEXT("host"), Host);
+		Element.SetField(TEXT("lobby_member_url"), FString::Printf(TEXT("https://stub/lobbies/lobby/members/%d"), Member.PlayerId));
+		Data.PushBack(Element);
+	}
+	return Data;
+}
+
+static bool HasLobbyMemberChange(const TArray<FDriftLobbyMemberChange>& Changes, int32 PlayerId, EDriftLobbyMemberChange Change)
+{
+	return Changes.ContainsByPredicate([PlayerId, Change](const FDriftLobbyMemberChange& Candidate)
+	{
+		return Candidate.PlayerId == PlayerId && Candidate.Change == Change;
+	});
+}
+
+static void StartLobby(FDriftLobbyState& State)
+{
+	FDriftLobbyResponse Response;
+	Response.LobbyId = TEXT("lobby");
+	Response.TeamNames = { TEXT("red"), TEXT("blue") };
+	Response.TeamCapacity = 32;
+
+	TArray<FDriftLobbyMemberChange> Changes;
+	State.SetLocalPlayerId(1);
+	State.ApplySnapshot(Response, EDriftLobbyStatus::Idle, Changes);
+}
+
+static TSharedPtr<FDriftLobbyMember> FindLobbyMember(const FDriftLobbyState& State, int32 PlayerId)
+{
+	const auto Member = State.GetLobby()->Members.FindByPredicate([PlayerId](const TSharedPtr<FDriftLobbyMember>& Candidate)
+	{
+		return Candidate->PlayerId == PlayerId;
+	});
+	return Member ? *Member : nullptr;
+}
+
+/**
+ * How member events were handled before the lobby was patched in place: every member is parsed
+ * from its own JSON string, and the member list is rebuilt with new objects.
+ */
+static bool RebuildLobbyMembers(FDriftLobby& Lobby, const JsonValue& MembersData, int32 LocalPlayerId)
+{
+	bool bAllTeamMembersReady = true;
+	TSharedPtr<FDriftLobbyMember> LocalMember;
+	TArray<TSharedPtr<FDriftLobbyMember>> Members;
+	for (const auto& Elem : MembersData.GetArray())
+	{
+		FDriftLobbyResponseMember LobbyResponseMember{};
+		if (!LobbyResponseMember.FromJson(Elem.ToString()))
+		{
+			return false;
+		}
+
+		const auto Member = MakeShared<FDriftLobbyMember>(
+			LobbyResponseMember.PlayerId,
+			LobbyResponseMember.PlayerName,
+			LobbyResponseMember.TeamName,
+			LobbyResponseMember.bReady,
+			LobbyResponseMember.bHost,
+			LobbyResponseMember.PlayerId == LocalPlayerId,
+			LobbyResponseMember.LobbyMemberURL
+		);
+
+		if (!LobbyResponseMember.bReady && !LobbyResponseMember.TeamName.IsEmpty())
+		{
+			bAllTeamMembersReady = false;
+		}
+
+		if (Member->bLocalPlayer)
+		{
+			LocalMember = Member;
+		}
+
+		Members.Emplace(Member);
+	}
+
+	Lobby.Members = MoveTemp(Members);
+	Lobby.bAllTeamMembersReady = bAllTeamMembersReady;
+	Lobby.LocalPlayerMember = LocalMember;
+	return true;
+}
+
+/* Member objects in Members that weren't in Previous, each of them a heap allocation */
+static int32 CountNewLobbyMembers(const TArray<TSharedPtr<FDriftLobbyMember>>& Previous, const TArray<TSharedPtr<FDriftLobbyMember>>& Members)
+{
+	return Members.FilterByPredicate([&Previous](const TSharedPtr<FDriftLobbyMember>& Member)
+	{
+		return !Previous.Contains(Member);
+	}).Num();
+}
+
+/* A 64 player lobby filling up, picking teams, readying up, passing on the host and emptying again */
+static TArray<JsonValue> RecordLobbyEventStream()
+{
+	constexpr int32 NumPlayers = 64;
+
+	TArray<JsonValue> Events;
+	TArray<FLobbyStateTestMember> Members;
+	for (int32 PlayerId = 1; PlayerId <= NumPlayers; ++PlayerId)
+	{
+		Members.Add({ PlayerId, {}, false, PlayerId == 1 });
+		Events.Add(MakeLobbyMembers(Members));
+	}
+	for (auto& Member : Members)
+	{
+		Member.TeamName = Member.PlayerId % 2 ? TEXT("red") : TEXT("blue");
+		Events.Add(MakeLobbyMembers(Members));
+	}
+	for (auto& Member : Members)
+	{
+		Member.bReady = true;
+		Events.Add(MakeLobbyMembers(Members));
+	}
+	Members[0].bHost = false;
+	Members[1].bHost = true;
+	Events.Add(MakeLobbyMembers(Members));
+	while (Members.Num() > 1)
+	{
+		Members.RemoveAt(0);
+		Events.Add(MakeLobbyMembers(Members));
+	}
+	return Events;
+}
+
+
+BEGIN_DEFINE_SPEC(DriftLobbyStateSpec, "Game.Drift.LobbyState", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(DriftLobbyStateSpec)
+
+void DriftLobbyStateSpec::Define()
+{
+	Describe("ApplyMembers", [this]
+	{
+		It("should report members joining and leaving", [this]
+		{
+			FDriftLobbyState State;
+			StartLobby(State);
+			TArray<FDriftLobbyMemberChange> Changes;
+
+			TestTrue("Applied", State.ApplyMembers(MakeLobbyMembers({ { 1 }, { 2 } }), Changes));
+			TestEqual("Changes on joining", Changes.Num(), 2);
+			TestTrue("One joined", HasLobbyMemberChange(Changes, 1, EDriftLobbyMemberChange::Joined));
+			TestTrue("Two joined", HasLobbyMemberChange(Changes, 2, EDriftLobbyMemberChange::Joined));
+			TestTrue("Local player", State.GetLobby()->LocalPlayerMember == FindLobbyMember(State, 1));
+			Changes.Reset();
+
+			TestTrue("Applied", State.ApplyMembers(MakeLobbyMembers({ { 2 }, { 3 } }), Changes));
+			TestEqual("Changes on leaving", Changes.Num(), 2);
+			TestTrue("One left", HasLobbyMemberChange(Changes, 1, EDriftLobbyMemberChange::Left));
+			TestTrue("Three joined", HasLobbyMemberChange(Changes, 3, EDriftLobbyMemberChange::Joined));
+			TestEqual("Members", State.GetLobby()->Members.Num(), 2);
+			TestFalse("No local player", State.GetLobby()->LocalPlayerMember.IsValid());
+		});
+
+		It("should report changes to ready, team and host", [this]
+		{
+			FDriftLobbyState State;
+			StartLobby(State);
+			TArray<FDriftLobbyMemberChange> Changes;
+			State.ApplyMembers(MakeLobbyMembers({ { 1, {}, false, true }, { 2 } }), Changes);
+			Changes.Reset();
+
+			State.ApplyMembers(MakeLobbyMembers({ { 1, TEXT("red"), false, true }, { 2 } }), Changes);
+			TestEqual("Changes on picking a team", Changes.Num(), 1);
+			TestTrue("Team", HasLobbyMemberChange(Changes, 1, EDriftLobbyMemberChange::TeamChanged));
+			Changes.Reset();
+
+			State.ApplyMembers(MakeLobbyMembers({ { 1, TEXT("red"), true, true }, { 2 } }), Changes);
+			TestEqual("Changes on readying", Changes.Num(), 1);
+			TestTrue("Ready", HasLobbyMemberChange(Changes, 1, EDriftLobbyMemberChange::ReadyChanged));
+			Changes.Reset();
+
+			State.ApplyMembers(MakeLobbyMembers({ { 1, TEXT("red"), true, false }, { 2, {}, false, true } }), Changes);
+			TestEqual("Changes on passing on the host", Changes.Num(), 2);
+			TestTrue("Old host", HasLobbyMemberChange(Changes, 1, EDriftLobbyMemberChange::HostChanged));
+			TestTrue("New host", HasLobbyMemberChange(Changes, 2, EDriftLobbyMemberChange::HostChanged));
+			Changes.Reset();
+
+			State.ApplyMembers(MakeLobbyMembers({ { 1, TEXT("red"), true, false }, { 2, {}, false, true } }), Changes);
+			TestEqual("Changes when nothing changed", Changes.Num(), 0);
+		});
+
+		It("should keep member objects for as long as the player is in the lobby", [this]
+		{
+			FDriftLobbyState State;
+			StartLobby(State);
+			TArray<FDriftLobbyMemberChange> Changes;
+			State.ApplyMembers(MakeLobbyMembers({ { 1 }, { 2 } }), Changes);
+			const auto Lobby = State.GetLobby();
+			const auto One = FindLobbyMember(State, 1);
+			const auto Two = FindLobbyMember(State, 2);
+
+			State.ApplyMembers(MakeLobbyMembers({ { 3 }, { 2, TEXT("blue"), true }, { 1, TEXT("red") } }), Changes);
+
+			TestTrue("Same lobby", State.GetLobby() == Lobby);
+			TestTrue("Same first member", FindLobbyMember(State, 1) == One);
+			TestTrue("Same second member", FindLobbyMember(State, 2) == Two);
+			TestTrue("Updated in place", Two->bReady && Two->TeamName == FString{ TEXT("blue") });
+
+			State.ApplyMembers(MakeLobbyMembers({ { 3 } }), Changes);
+			State.ApplyMembers(MakeLobbyMembers({ { 3 }, { 1 } }), Changes);
+
+			TestTrue("New object for a member who came back", FindLobbyMember(State, 1) != One);
+		});
+
+		It("should keep whether all team members are ready up to date after each change", [this]
+		{
+			FDriftLobbyState State;
+			StartLobby(State);
+			TArray<FDriftLobbyMemberChange> Changes;
+			const auto AllReady = [&State] { return State.GetLobby()->bAllTeamMembersReady; };
+
+			State.ApplyMembers(MakeLobbyMembers({ { 1 }, { 2 } }), Changes);
+			TestTrue("Without teams", AllReady());
+
+			State.ApplyMembers(MakeLobbyMembers({ { 1, TEXT("red") }, { 2 } }), Changes);
+			TestFalse("After picking a team", AllReady());
+
+			State.ApplyMembers(MakeLobbyMembers({ { 1, TEXT("red"), true }, { 2 } }), Changes);
+			TestTrue("After readying", AllReady());
+
+			State.ApplyMembers(MakeLobbyMembers({ { 1, TEXT("red"), true }, { 2 }, { 3, TEXT("blue") } }), Changes);
+			TestFalse("After someone unready joined a team", AllReady());
+
+			State.ApplyMembers(MakeLobbyMembers({ { 1, TEXT("red"), true }, { 2 }, { 3 } }), Changes);
+			TestTrue("After they left the team", AllReady());
+
+			State.ApplyMembers(MakeLobbyMembers({ { 1, TEXT("red"), true }, { 2, TEXT("blue") } }), Changes);
+			TestFalse("After another picked a team", AllReady());
+
+			State.ApplyMembers(MakeLobbyMembers({ { 1, TEXT("red"), true } }), Changes);
+			TestTrue("After they left", AllReady());
+
+			State.ApplyMembers(MakeLobbyMembers({ { 1, TEXT("red"), false } }), Changes);
+			TestFalse("After unreadying", AllReady());
+		});
+
+		It("should leave the lobby untouched when the member list is malformed", [this]
+		{
+			FDriftLobbyState State;
+			StartLobby(State);
+			TArray<FDriftLobbyMemberChange> Changes;
+			State.ApplyMembers(MakeLobbyMembers({ { 1, TEXT("red") }, { 2 } }), Changes);
+			const auto One = FindLobbyMember(State, 1);
+			Changes.Reset();
+
+			auto Malformed = MakeLobbyMembers({ { 1, TEXT("red"), true } });
+			JsonValue WithoutPlayerId{ rapidjson::kObjectType };
+			WithoutPlayerId.SetField(TEXT("player_name"), FString{ TEXT("Nobody") });
+			Malformed.PushBack(WithoutPlayerId);
+
+			TestFalse("Member without a player id", State.ApplyMembers(Malformed, Changes));
+			TestFalse("Not a list", State.ApplyMembers(JsonValue{ rapidjson::kObjectType }, Changes));
+			TestEqual("Changes", Changes.Num(), 0);
+			TestEqual("Members", State.GetLobby()->Members.Num(), 2);
+			TestTrue("Same member", FindLobbyMember(State, 1) == One);
+			TestFalse("Not ready", One->bReady);
+			TestFalse("All team members ready", State.GetLobby()->bAllTeamMembersReady);
+		});
+
+		It("should replay a 64 member event stream with fewer allocations than rebuilding the lobby", [this]
+		{
+			const auto Events = RecordLobbyEventStream();
+
+			FDriftLobbyState State;
+			StartLobby(State);
+			TArray<FDriftLobbyMemberChange> Changes;
+			auto PatchedAllocations = 0;
+			auto PatchedSeconds = 0.0;
+			for (const auto& Event : Events)
+			{
+				const auto Previous = State.GetLobby()->Members;
+				const auto Start = FPlatformTime::Seconds();
+				Changes.Reset();
+				State.ApplyMembers(Event, Changes);
+				PatchedSeconds += FPlatformTime::Seconds() - Start;
+				PatchedAllocations += CountNewLobbyMembers(Previous, State.GetLobby()->Members);
+			}
+
+			FDriftLobbyState Rebuilt;
+			StartLobby(Rebuilt);
+			auto& RebuiltLobby = *Rebuilt.GetLobby();
+			auto RebuiltAllocations = 0;
+			auto RebuiltSeconds = 0.0;
+			for (const auto& Event : Events)
+			{
+				const auto Previous = RebuiltLobby.Members;
+				const auto Start = FPlatformTime::Seconds();
+				RebuildLobbyMembers(RebuiltLobby, Event, 1);
+				RebuiltSeconds += FPlatformTime::Seconds() - Start;
+				RebuiltAllocations += CountNewLobbyMembers(Previous, RebuiltLobby.Members);
+			}
+
+			AddInfo(FString::Printf(TEXT("%d events: patched in %.2f ms with %d member allocations, rebuilt in %.2f ms with %d"),
+				Events.Num(), PatchedSeconds * 1000.0, PatchedAllocations, RebuiltSeconds * 1000.0, RebuiltAllocations));
+
+			TestEqual("One allocation per join", PatchedAllocations, 64);
+			TestTrue("Fewer allocations", PatchedAllocations * 10 < RebuiltAllocations);
+			TestEqual("Same members", State.GetLobby()->Members.Num(), RebuiltLobby.Members.Num());
+			TestEqual("Same readiness", State.GetLobby()->bAllTeamMembersReady, RebuiltLobby.bAllTeamMembersReady);
+			TestTrue("Same host", FindLobbyMember(State, 64)->bHost == RebuiltLobby.Members[0]->bHost);
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,208 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftMatchPlacementCache.h"
+
+#include "Misc/AutomationTest.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static FDriftPublicMatchPlacementResponse MakePublicMatchPlacement(const FString& PlacementId, int32 MaxPlayers = 8, const FString& Status = TEXT("completed"))
+{
+	FDriftPublicMatchPlacementResponse Response;
+	Response.placement_id = PlacementId;
+	Response.status = Status;
+	Response.map_name = TEXT("Arena");
+	Response.max_players = MaxPlayers;
+	return Response;
+}
+
+static bool HasChange(const TArray<FDriftPublicMatchPlacementChange>& Changes, const FString& PlacementId, EDriftPublicMatchPlacementChange Change)
+{
+	return Changes.ContainsByPredicate([&PlacementId, Change](const FDriftPublicMatchPlacementChange& Entry)
+	{
+		return Entry.MatchPlacementId == PlacementId && Entry.Change == Change;
+	});
+}
+
+
+BEGIN_DEFINE_SPEC(DriftMatchPlacementCacheSpec, "Game.Drift.MatchPlacementCache", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+	FDriftMatchPlacementCache Cache;
+	TArray<FDriftPublicMatchPlacementChange> Changes;
+	FDateTime Start{ 2026, 1, 1 };
+END_DEFINE_SPEC(DriftMatchPlacementCacheSpec)
+
+void DriftMatchPlacementCacheSpec::Define()
+{
+	BeforeEach([this]
+	{
+		Cache = FDriftMatchPlacementCache{};
+		Changes.Reset();
+
+		Cache.BeginRefresh();
+		Cache.ApplyPage({ MakePublicMatchPlacement(TEXT("a")), MakePublicMatchPlacement(TEXT("b")) }, Start, Changes);
+		Cache.ApplyPage({ MakePublicMatchPlacement(TEXT("c")) }, Start, Changes);
+		Cache.EndRefresh(Changes);
+	});
+
+	Describe("ApplyPage", [this]
+	{
+		It("should add new placements from every page", [this]
+		{
+			TestEqual("Placements", Cache.GetPlacements().Num(), 3);
+			TestEqual("Changes", Changes.Num(), 3);
+			TestTrue("Added", HasChange(Changes, TEXT("c"), EDriftPublicMatchPlacementChange::Added));
+		});
+
+		It("should report nothing when nothing changed", [this]
+		{
+			Changes.Reset();
+			Cache.BeginRefresh();
+			Cache.ApplyPage({ MakePublicMatchPlacement(TEXT("a")), MakePublicMatchPlacement(TEXT("b")), MakePublicMatchPlacement(TEXT("c")) }, Start, Changes);
+			Cache.EndRefresh(Changes);
+
+			TestEqual("Changes", Changes.Num(), 0);
+		});
+
+		It("should update placements in place", [this]
+		{
+			const auto Placement = Cache.FindPlacement(TEXT("b"));
+
+			Changes.Reset();
+			Cache.BeginRefresh();
+			Cache.ApplyPage({ MakePublicMatchPlacement(TEXT("b"), 16) }, Start, Changes);
+
+			TestTrue("Updated", Changes.Num() == 1 && HasChange(Changes, TEXT("b"), EDriftPublicMatchPlacementChange::Updated));
+			TestTrue("Same object", Cache.FindPlacement(TEXT("b")) == Placement);
+			TestEqual("Max players", Placement->GetMaxPlayers(), 16);
+		});
+
+		It("should remove placements that are no longer fulfilled", [this]
+		{
+			Changes.Reset();
+			Cache.BeginRefresh();
+			Cache.ApplyPage({ MakePublicMatchPlacement(TEXT("a"), 8, TEXT("cancelled")), MakePublicMatchPlacement(TEXT("d"), 8, TEXT("pending")) }, Start, Changes);
+
+			TestTrue("Removed", Changes.Num() == 1 && HasChange(Changes, TEXT("a"), EDriftPublicMatchPlacementChange::Removed));
+			TestEqual("Placements", Cache.GetPlacements().Num(), 2);
+		});
+	});
+
+	Describe("EndRefresh", [this]
+	{
+		It("should remove placements the refresh didn't list", [this]
+		{
+			Changes.Reset();
+			Cache.BeginRefresh();
+			Cache.ApplyPage({ MakePublicMatchPlacement(TEXT("a")), MakePublicMatchPlacement(TEXT("c")) }, Start, Changes);
+			Cache.EndRefresh(Changes);
+
+			TestTrue("Removed", Changes.Num() == 1 && HasChange(Changes, TEXT("b"), EDriftPublicMatchPlacementChange::Removed));
+			TestEqual("Placements", Cache.GetPlacements().Num(), 2);
+			TestFalse("Not found", Cache.FindPlacement(TEXT("b")).IsValid());
+		});
+	});
+
+	Describe("Expire", [this]
+	{
+		It("should remove placements not listed within the time to live", [this]
+		{
+			Cache.SetTimeToLive(60.0f);
+
+			// A refresh that never completes
+			Changes.Reset();
+			Cache.BeginRefresh();
+			Cache.ApplyPage({ MakePublicMatchPlacement(TEXT("a")) }, Start + FTimespan::FromSeconds(45.0), Changes);
+
+			Cache.Expire(Start + FTimespan::FromSeconds(59.0), Changes);
+			TestEqual("Kept within the time to live", Changes.Num(), 0);
+
+			Cache.Expire(Start + FTimespan::FromSeconds(61.0), Changes);
+			TestTrue("Expired", Changes.Num() == 2
+				&& HasChange(Changes, TEXT("b"), EDriftPublicMatchPlacementChange::Removed)
+				&& HasChange(Changes, TEXT("c"), EDriftPublicMatchPlacementChange::Removed));
+			TestTrue("Listed since", Cache.FindPlacement(TEXT("a")).IsValid());
+		});
+	});
+
+	Describe("Refresh", [this]
+	{
+		It("should do work in proportion to what changed in 5,000 placements", [this]
+		{
+			constexpr int32 NumPlacements = 5000;
+			constexpr int32 PageSize = 100;
+
+			const auto MakePlacements = [](int32 NumChanges)
+			{
+				// Changes alternate between updating, dropping and adding a placement
+				TArray<FDriftPublicMatchPlacementResponse> Placements;
+				for (int32 Index = 0; Index < NumPlacements; ++Index)
+				{
+					const auto bChanged = Index < NumChanges;
+					if (bChanged && Index % 3 == 1)
+					{
+						continue;
+					}
+					Placements.Add(MakePublicMatchPlacement(FString::Printf(TEXT("placement-%d"), Index), bChanged && Index % 3 == 0 ? 16 : 8));
+					if (bChanged && Index % 3 == 2)
+					{
+						Placements.Add(MakePublicMatchPlacement(FString::Printf(TEXT("new-%d"), Index)));
+					}
+				}
+				return Placements;
+			};
+
+			const auto Refresh = [this](const TArray<FDriftPublicMatchPlacementResponse>& Placements)
+			{
+				Cache.BeginRefresh();
+				for (int32 First = 0; First < Placements.Num(); First += PageSize)
+				{
+					Cache.ApplyPage(TArrayView<const FDriftPublicMatchPlacementResponse>{ Placements }.Slice(First, FMath::Min(PageSize, Placements.Num() - First)), Start, Changes);
+				}
+				Cache.EndRefresh(Changes);
+			};
+
+			for (const auto NumChanges : { 0, 10, 1000 })
+			{
+				Cache = FDriftMatchPlacementCache{};
+				Refresh(MakePlacements(0));
+				const auto Before = Cache.GetPlacements();
+				Changes.Reset();
+
+				const auto Placements = MakePlacements(NumChanges);
+				const auto RefreshStart = FPlatformTime::Seconds();
+				Refresh(Placements);
+				const auto RefreshSeconds = FPlatformTime::Seconds() - RefreshStart;
+
+				const auto NumNew = Cache.GetPlacements().FilterByPredicate([&Before](const TSharedPtr<IDriftMatchPlacement>& Placement)
+				{
+					return !Before.Contains(Placement);
+				}).Num();
+				const auto NumKept = Cache.GetPlacements().Num() - NumNew;
+
+				AddInfo(FString::Printf(TEXT("%d changes: %d reported, %d new placement objects, refreshed in %.2f ms"),
+					NumChanges, Changes.Num(), NumNew, RefreshSeconds * 1000.0));
+
+				const auto NumAdded = NumChanges / 3;
+				const auto NumRemoved = (NumChanges + 1) / 3;
+				TestEqual(FString::Printf(TEXT("Changes reported for %d changes"), NumChanges), Changes.Num(), NumChanges);
+				TestEqual(FString::Printf(TEXT("New objects for %d changes"), NumChanges), NumNew, NumAdded);
+				TestEqual(FString::Printf(TEXT("Objects kept for %d changes"), NumChanges), NumKept, NumPlacements - NumRemoved);
+			}
+		});
+	});
+
+	Describe("Reset", [this]
+	{
+		It("should remove every placement", [this]
+		{
+			Changes.Reset();
+			Cache.Reset(Changes);
+
+			TestEqual("Removed", Changes.Num(), 3);
+			TestEqual("Placements", Cache.GetPlacements().Num(), 0);
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
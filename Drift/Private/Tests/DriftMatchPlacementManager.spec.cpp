@@ -0,0 +1,182 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftMatchPlacementManager.h"
+
+#include "JWTRequestManager.h"
+
+#include "Misc/AutomationTest.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+class FFakeMatchPlacementMessageQueue : public IDriftMessageQueue
+{
+public:
+	void SendMessage(const FString& urlTemplate, const FString& queue, JsonValue&& message) override {}
+	void SendMessage(const FString& urlTemplate, const FString& queue, JsonValue&& message, int timeoutSeconds) override {}
+
+	FDriftMessageQueueDelegate& OnMessageQueueMessage(const FString& queue) override
+	{
+		return Delegates.FindOrAdd(queue);
+	}
+
+	TMap<FString, FDriftMessageQueueDelegate> Delegates;
+};
+
+
+struct FFetchResult
+{
+	int32 Calls = 0;
+	bool bSuccess = false;
+	int32 NumPlacements = INDEX_NONE;
+	FString Error;
+};
+
+
+/**
+ * A manager with a session, whose page requests wait for the test to answer them
+ */
+struct FMatchPlacementManagerHarness
+{
+	using FOnPageCompleted = TFunction<void(bool, const FDriftPublicMatchPlacementsPage&, const FString&)>;
+
+	struct FPendingPage
+	{
+		FString URL;
+		FOnPageCompleted OnCompleted;
+	};
+
+	TSharedPtr<FFakeMatchPlacementMessageQueue> MessageQueue = MakeShared<FFakeMatchPlacementMessageQueue>();
+	TUniquePtr<FDriftMatchPlacementManager> Manager = MakeUnique<FDriftMatchPlacementManager>(MessageQueue);
+	TArray<FPendingPage> Pending;
+	TArray<FDriftPublicMatchPlacementChange> Changes;
+
+	FMatchPlacementManagerHarness()
+	{
+		Manager->SetPublicMatchPlacementsPageFetcher([this](const TSharedPtr<JsonRequestManager>&, const FString& PageURL, FOnPageCompleted OnCompleted)
+		{
+			Pending.Add(FPendingPage{ PageURL, MoveTemp(OnCompleted) });
+			return true;
+		});
+		Manager->OnPublicMatchPlacementChanged().AddLambda([this](const FString& MatchPlacementId, EDriftPublicMatchPlacementChange Change)
+		{
+			Changes.Add({ MatchPlacementId, Change });
+		});
+
+		// Configured before it has a request manager, so it doesn't query the current placement
+		FDriftEndpointsResponse Endpoints;
+		Endpoints.match_placements = TEXT("https://stub/match-placements");
+		Endpoints.public_match_placements = TEXT("https://stub/match-placements/public");
+		Manager->ConfigureSession(Endpoints, 10);
+		Manager->SetRequestManager(MakeShared<JWTRequestManager>(TEXT("token")));
+	}
+
+	bool Fetch(FFetchResult& Result)
+	{
+		return Manager->FetchPublicMatchPlacements(FFetchPublicMatchPlacementsCompletedDelegate::CreateLambda([&Result](bool bSuccess, int32 NumPlacements, const FString& Error)
+		{
+			++Result.Calls;
+			Result.bSuccess = bSuccess;
+			Result.NumPlacements = NumPlacements;
+			Result.Error = Error;
+		}));
+	}
+
+	void Respond(int32 Index, const TArray<FString>& PlacementIds, const FString& NextCursor = {})
+	{
+		FDriftPublicMatchPlacementsPage Page;
+		for (const auto& PlacementId : PlacementIds)
+		{
+			auto& Placement = Page.placements.AddDefaulted_GetRef();
+			Placement.placement_id = PlacementId;
+			Placement.status = TEXT("completed");
+			Placement.max_players = 8;
+		}
+		Page.next_cursor = NextCursor;
+
+		// Answering may request the next page
+		const auto OnCompleted = MoveTemp(Pending[Index].OnCompleted);
+		OnCompleted(true, Page, {});
+	}
+
+	void Fail(int32 Index, const FString& Error)
+	{
+		const auto OnCompleted = MoveTemp(Pending[Index].OnCompleted);
+		OnCompleted(false, {}, Error);
+	}
+};
+
+
+BEGIN_DEFINE_SPEC(DriftMatchPlacementManagerSpec, "Game.Drift.MatchPlacementManager", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(DriftMatchPlacementManagerSpec)
+
+void DriftMatchPlacementManagerSpec::Define()
+{
+	Describe("FetchPublicMatchPlacements", [this]
+	{
+		It("should follow the cursor through every page", [this]
+		{
+			FMatchPlacementManagerHarness Harness;
+			FFetchResult Result;
+
+			TestTrue("Started", Harness.Fetch(Result));
+			TestFalse("No cursor for the first page", Harness.Pending[0].URL.Contains(TEXT("cursor")));
+			Harness.Respond(0, { TEXT("a"), TEXT("b") }, TEXT("next"));
+
+			TestEqual("Requests", Harness.Pending.Num(), 2);
+			TestTrue("Cursor", Harness.Pending.Last().URL.Contains(TEXT("cursor=next")));
+			TestEqual("Not done yet", Result.Calls, 0);
+			TestEqual("Changes from the first page", Harness.Changes.Num(), 2);
+
+			Harness.Respond(1, { TEXT("c") });
+
+			TestEqual("Calls", Result.Calls, 1);
+			TestTrue("Succeeded", Result.bSuccess);
+			TestEqual("Placements", Result.NumPlacements, 3);
+			TestEqual("Cached", Harness.Manager->GetCachedPublicMatchPlacements().Num(), 3);
+			TestEqual("Changes", Harness.Changes.Num(), 3);
+		});
+
+		It("should let a newer fetch supersede one in flight", [this]
+		{
+			FMatchPlacementManagerHarness Harness;
+			FFetchResult First;
+			FFetchResult Second;
+
+			Harness.Fetch(First);
+			Harness.Fetch(Second);
+			Harness.Respond(1, { TEXT("a") });
+			Harness.Respond(0, { TEXT("x"), TEXT("y") }, TEXT("next"));
+
+			TestEqual("First calls", First.Calls, 1);
+			TestFalse("First succeeded", First.bSuccess);
+			TestEqual("First error", First.Error, FString{ TEXT("Superseded") });
+			TestEqual("No page requested for the superseded fetch", Harness.Pending.Num(), 2);
+
+			TestEqual("Second calls", Second.Calls, 1);
+			TestTrue("Second succeeded", Second.bSuccess);
+			TestEqual("Cached", Harness.Manager->GetCachedPublicMatchPlacements().Num(), 1);
+		});
+
+		It("should report a page that failed along with what is still cached", [this]
+		{
+			FMatchPlacementManagerHarness Harness;
+			FFetchResult First;
+			FFetchResult Second;
+
+			Harness.Fetch(First);
+			Harness.Respond(0, { TEXT("a"), TEXT("b") });
+
+			Harness.Fetch(Second);
+			Harness.Respond(1, { TEXT("a") }, TEXT("next"));
+			Harness.Fail(2, TEXT("Failed to parse public match placements"));
+
+			TestEqual("Calls", Second.Calls, 1);
+			TestFalse("Succeeded", Second.bSuccess);
+			TestEqual("Error", Second.Error, FString{ TEXT("Failed to parse public match placements") });
+			TestEqual("Placements", Second.NumPlacements, 2);
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
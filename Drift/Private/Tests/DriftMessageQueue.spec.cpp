@@ -0,0 +1,211 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftMessageQueue.h"
+
+#include "DriftMessageTransport.h"
+#include "JWTRequestManager.h"
+
+#include "Misc/AutomationTest.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * A message queue with batching turned on, posting to a stub backend that records what it was sent
+ */
+struct FMessageQueueHarness
+{
+    struct FPost
+    {
+        FString url;
+        JsonValue payload;
+    };
+
+    TSharedRef<FDriftMessageQueue> queue = MakeShared<FDriftMessageQueue>();
+    TSharedRef<JsonRequestManager> requestManager = MakeShared<JWTRequestManager>(TEXT("token"));
+    TArray<FPost> posts;
+
+    FMessageQueueHarness()
+    {
+        queue->SetRequestManager(requestManager);
+        queue->SetBatchSend(true);
+        queue->SetSender([this](const TSharedPtr<JsonRequestManager>&, const FString& url, const JsonValue& payload,
+            TFunction<void(int32, const FString&)>)
+        {
+            posts.Add(FPost{ url, JsonValue{ payload } });
+        });
+    }
+
+    void Send(const FString& urlTemplate, const FString& queueName)
+    {
+        JsonValue message{ rapidjson::kObjectType };
+        queue->SendMessage(urlTemplate, queueName, MoveTemp(message));
+    }
+};
+
+
+/**
+ * Hands over whatever batches the test gives it
+ */
+class FFakeMessageTransport : public IDriftMessageTransport
+{
+public:
+    FString GetName() const override { return TEXT("fake"); }
+    void Start(const FString& messageQueueUrl, int32 lastMessageNumber) override {}
+    void Stop() override {}
+    void SetCursor(int32 lastMessageNumber) override {}
+
+    void Deliver(FDriftMessageQueueBatch& queues)
+    {
+        OnMessages.ExecuteIfBound(queues);
+    }
+};
+
+
+/** Queue after queue of messages, with the message numbers of all queues interleaved. Without ids, so nothing is dropped as a duplicate */
+static FDriftMessageQueueBatch MakeMessageBatch(int32 numQueues, int32 messagesPerQueue, int32 firstMessageNumber)
+{
+    FDriftMessageQueueBatch queues;
+    for (int32 queueIndex = 0; queueIndex < numQueues; ++queueIndex)
+    {
+        auto& messages = queues.AddDefaulted_GetRef();
+        for (int32 index = 0; index < messagesPerQueue; ++index)
+        {
+            auto& message = messages.AddDefaulted_GetRef();
+            message.queue = FString::Printf(TEXT("queue%d"), queueIndex);
+            message.message_number = firstMessageNumber + index * numQueues + queueIndex;
+        }
+    }
+    return queues;
+}
+
+
+/**
+ * How batches were handled before they were merged: every message is copied into one list,
+ * which is sorted, and each message's handler is looked up on its own. Sorts pointers rather
+ * than the entries themselves, so if anything it flatters the old way.
+ */
+static void HandleMessagesBySorting(const FDriftMessageQueueBatch& queues, TMap<FString, FDriftMessageQueueDelegate>& handlers)
+{
+    TArray<FMessageQueueEntry> flattened;
+    for (const auto& messages : queues)
+    {
+        for (const auto& message : messages)
+        {
+            flattened.Add(message);
+        }
+    }
+
+    TArray<const FMessageQueueEntry*> sorted;
+    for (const auto& message : flattened)
+    {
+        sorted.Add(&message);
+    }
+    sorted.Sort([](const FMessageQueueEntry& lhs, const FMessageQueueEntry& rhs) { return lhs.message_number < rhs.message_number; });
+
+    for (const auto message : sorted)
+    {
+        if (const auto handler = handlers.Find(message->queue))
+        {
+            handler->Broadcast(*message);
+        }
+    }
+}
+
+
+BEGIN_DEFINE_SPEC(DriftMessageQueueSpec, "Game.Drift.MessageQueue", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(DriftMessageQueueSpec)
+
+void DriftMessageQueueSpec::Define()
+{
+    Describe("SendMessage", [this]
+    {
+        It("should batch messages to queues on the same exchange", [this]
+        {
+            FMessageQueueHarness harness;
+
+            harness.Send(TEXT("https://stub/players/1/messages/{queue}"), TEXT("party"));
+            harness.Send(TEXT("https://stub/players/1/messages/{queue}"), TEXT("lobby"));
+            harness.queue->Tick(0.0f);
+
+            TestEqual("Requests", harness.posts.Num(), 1);
+            TestEqual("URL", harness.posts[0].url, FString{ TEXT("https://stub/players/1/messages") });
+            TestTrue("Batched", harness.posts[0].payload.HasField(TEXT("messages")));
+            TestEqual("Messages", harness.posts[0].payload[TEXT("messages")].GetArray().Num(), 2);
+        });
+
+        It("should send messages on their own when the queue isn't the last part of the URL", [this]
+        {
+            FMessageQueueHarness harness;
+
+            harness.Send(TEXT("https://stub/messages/{queue}/players/1"), TEXT("party"));
+            harness.Send(TEXT("https://stub/messages/{queue}/players/1"), TEXT("party"));
+            harness.queue->Tick(0.0f);
+
+            TestEqual("Requests", harness.posts.Num(), 2);
+            for (const auto& post : harness.posts)
+            {
+                TestEqual("URL", post.url, FString{ TEXT("https://stub/messages/party/players/1") });
+                TestTrue("Single message", post.payload.HasField(TEXT("message")) && !post.payload.HasField(TEXT("messages")));
+            }
+        });
+    });
+
+    Describe("HandleMessages", [this]
+    {
+        It("should deliver queues merged in message order, and report how that compares to sorting", [this]
+        {
+            constexpr int32 messagesPerQueue = 256;
+            constexpr int32 batchesPerRun = 8;
+
+            for (const auto numQueues : { 1, 8, 32 })
+            {
+                const auto queue = MakeShared<FDriftMessageQueue>();
+                auto transport = MakeUnique<FFakeMessageTransport>();
+                auto* fakeTransport = transport.Get();
+                queue->SetTransport(MoveTemp(transport));
+
+                TMap<FString, FDriftMessageQueueDelegate> sortingHandlers;
+                TArray<int32> merged;
+                TArray<int32> sorted;
+                for (int32 queueIndex = 0; queueIndex < numQueues; ++queueIndex)
+                {
+                    const auto queueName = FString::Printf(TEXT("queue%d"), queueIndex);
+                    queue->OnMessageQueueMessage(queueName).AddLambda([&merged](const FMessageQueueEntry& message)
+                    {
+                        merged.Add(message.message_number);
+                    });
+                    sortingHandlers.Add(queueName).AddLambda([&sorted](const FMessageQueueEntry& message)
+                    {
+                        sorted.Add(message.message_number);
+                    });
+                }
+
+                auto mergedSeconds = 0.0;
+                auto sortedSeconds = 0.0;
+                for (int32 batch = 0; batch < batchesPerRun; ++batch)
+                {
+                    // Numbers keep going up, as they would from the backend
+                    const auto firstMessageNumber = 1 + batch * numQueues * messagesPerQueue;
+                    auto queues = MakeMessageBatch(numQueues, messagesPerQueue, firstMessageNumber);
+
+                    auto start = FPlatformTime::Seconds();
+                    HandleMessagesBySorting(queues, sortingHandlers);
+                    sortedSeconds += FPlatformTime::Seconds() - start;
+
+                    start = FPlatformTime::Seconds();
+                    fakeTransport->Deliver(queues);
+                    mergedSeconds += FPlatformTime::Seconds() - start;
+                }
+
+                AddInfo(FString::Printf(TEXT("%d queues of %d messages, %d batches: merged in %.2f ms, sorted in %.2f ms"),
+                    numQueues, messagesPerQueue, batchesPerRun, mergedSeconds * 1000.0, sortedSeconds * 1000.0));
+
+                TestEqual(FString::Printf(TEXT("Messages delivered from %d queues"), numQueues), merged.Num(), numQueues * messagesPerQueue * batchesPerRun);
+                TestTrue(FString::Printf(TEXT("Same order as sorting for %d queues"), numQueues), merged == sorted);
+            }
+        });
+    });
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
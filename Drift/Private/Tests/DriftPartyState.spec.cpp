@@ -0,0 +1,180 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftPartyState.h"
+
+#include "Algo/Reverse.h"
+#include "Misc/AutomationTest.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static FDriftPartyResponseMember MakePartyMember(int32 PlayerId, const FString& PlayerName)
+{
+	FDriftPartyResponseMember Member;
+	Member.Id = PlayerId;
+	Member.PlayerName = PlayerName;
+	return Member;
+}
+
+static bool HasPartyMemberChange(const TArray<FDriftPartyMemberChange>& Changes, int32 PlayerId, EDriftPartyMemberChange Change)
+{
+	return Changes.ContainsByPredicate([PlayerId, Change](const FDriftPartyMemberChange& Candidate)
+	{
+		return Candidate.PlayerId == PlayerId && Candidate.Change == Change;
+	});
+}
+
+
+BEGIN_DEFINE_SPEC(DriftPartyStateSpec, "Game.Drift.PartyState", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(DriftPartyStateSpec)
+
+void DriftPartyStateSpec::Define()
+{
+	Describe("ApplySnapshot", [this]
+	{
+		It("should report everyone as joined for a new party", [this]
+		{
+			FDriftPartyState State;
+			TArray<FDriftPartyMemberChange> Changes;
+
+			const auto bChanged = State.ApplySnapshot(1, { MakePartyMember(10, TEXT("Ten")), MakePartyMember(20, TEXT("Twenty")) }, Changes);
+
+			TestTrue("Changed", bChanged);
+			TestEqual("Changes", Changes.Num(), 2);
+			TestTrue("Ten joined", HasPartyMemberChange(Changes, 10, EDriftPartyMemberChange::Joined));
+			TestTrue("Twenty joined", HasPartyMemberChange(Changes, 20, EDriftPartyMemberChange::Joined));
+			TestEqual("Members", State.GetParty()->Members.Num(), 2);
+		});
+
+		It("should report nothing and keep the same objects when the party is unchanged", [this]
+		{
+			FDriftPartyState State;
+			TArray<FDriftPartyMemberChange> Changes;
+			State.ApplySnapshot(1, { MakePartyMember(10, TEXT("Ten")), MakePartyMember(20, TEXT("Twenty")) }, Changes);
+			const auto Party = State.GetParty();
+			const auto Member = Party->Members[0];
+			Changes.Reset();
+
+			// Same members, different order
+			const auto bChanged = State.ApplySnapshot(1, { MakePartyMember(20, TEXT("Twenty")), MakePartyMember(10, TEXT("Ten")) }, Changes);
+
+			TestFalse("Changed", bChanged);
+			TestEqual("Changes", Changes.Num(), 0);
+			TestTrue("Same party", State.GetParty() == Party);
+			TestTrue("Same member", State.GetParty()->Members[0] == Member);
+		});
+
+		It("should report only what changed when members join, leave and are renamed", [this]
+		{
+			FDriftPartyState State;
+			TArray<FDriftPartyMemberChange> Changes;
+			State.ApplySnapshot(1, { MakePartyMember(10, TEXT("Ten")), MakePartyMember(20, TEXT("Twenty")), MakePartyMember(30, TEXT("Thirty")) }, Changes);
+			const auto Party = State.GetParty();
+			Changes.Reset();
+
+			const auto bChanged = State.ApplySnapshot(1, { MakePartyMember(10, TEXT("Ten")), MakePartyMember(30, TEXT("Thirty-one")), MakePartyMember(40, TEXT("Forty")) }, Changes);
+
+			TestTrue("Changed", bChanged);
+			TestEqual("Changes", Changes.Num(), 3);
+			TestTrue("Twenty left", HasPartyMemberChange(Changes, 20, EDriftPartyMemberChange::Left));
+			TestTrue("Thirty renamed", HasPartyMemberChange(Changes, 30, EDriftPartyMemberChange::Renamed));
+			TestTrue("Forty joined", HasPartyMemberChange(Changes, 40, EDriftPartyMemberChange::Joined));
+			TestTrue("Same party", State.GetParty() == Party);
+			TestEqual("Members", State.GetParty()->Members.Num(), 3);
+
+			const auto Renamed = State.GetParty()->Members.FindByPredicate([](const TSharedPtr<IDriftPartyMember>& Member)
+			{
+				return Member->GetPlayerID() == 30;
+			});
+			TestTrue("Renamed member found", Renamed != nullptr);
+			if (Renamed)
+			{
+				TestEqual("New name", (*Renamed)->GetPlayerName(), FString{ TEXT("Thirty-one") });
+			}
+		});
+
+		It("should start over for a different party", [this]
+		{
+			FDriftPartyState State;
+			TArray<FDriftPartyMemberChange> Changes;
+			State.ApplySnapshot(1, { MakePartyMember(10, TEXT("Ten")) }, Changes);
+			const auto Party = State.GetParty();
+			Changes.Reset();
+
+			const auto bChanged = State.ApplySnapshot(2, { MakePartyMember(10, TEXT("Ten")) }, Changes);
+
+			TestTrue("Changed", bChanged);
+			TestTrue("Different party", State.GetParty() != Party);
+			TestEqual("Party id", State.GetParty()->GetPartyId(), 2);
+			TestTrue("Ten joined", HasPartyMemberChange(Changes, 10, EDriftPartyMemberChange::Joined));
+		});
+	});
+
+	Describe("RemoveMember", [this]
+	{
+		It("should remove a member once", [this]
+		{
+			FDriftPartyState State;
+			TArray<FDriftPartyMemberChange> Changes;
+			State.ApplySnapshot(1, { MakePartyMember(10, TEXT("Ten")), MakePartyMember(20, TEXT("Twenty")) }, Changes);
+			Changes.Reset();
+
+			TestTrue("Removed", State.RemoveMember(20, Changes));
+			TestFalse("Removed again", State.RemoveMember(20, Changes));
+			TestEqual("Changes", Changes.Num(), 1);
+			TestEqual("Members", State.GetParty()->Members.Num(), 1);
+
+			// A later query that agrees doesn't report the member leaving a second time
+			Changes.Reset();
+			TestFalse("Changed", State.ApplySnapshot(1, { MakePartyMember(10, TEXT("Ten")) }, Changes));
+		});
+	});
+
+	Describe("Scaling", [this]
+	{
+		It("should take time in proportion to the size of the party", [this]
+		{
+			// The same number of members go through each size, so per member times are comparable
+			constexpr int32 MembersPerRun = 32768;
+
+			TMap<int32, double> SecondsPerMember;
+			for (const auto NumMembers : { 8, 64, 512 })
+			{
+				TArray<FDriftPartyResponseMember> Members;
+				for (int32 Index = 0; Index < NumMembers; ++Index)
+				{
+					Members.Add(MakePartyMember(Index + 1, FString::Printf(TEXT("Player %d"), Index + 1)));
+				}
+				// Every snapshot after the first lists the members in a different order, with one renamed
+				auto Reordered = Members;
+				Algo::Reverse(Reordered);
+				Reordered[0].PlayerName = TEXT("Renamed");
+
+				FDriftPartyState State;
+				TArray<FDriftPartyMemberChange> Changes;
+				State.ApplySnapshot(1, Members, Changes);
+
+				auto BestSeconds = DBL_MAX;
+				for (int32 Run = 0; Run < 3; ++Run)
+				{
+					const auto Start = FPlatformTime::Seconds();
+					for (int32 Snapshot = 0; Snapshot < MembersPerRun / NumMembers; ++Snapshot)
+					{
+						Changes.Reset();
+						State.ApplySnapshot(1, Snapshot % 2 ? Members : Reordered, Changes);
+					}
+					BestSeconds = FMath::Min(BestSeconds, FPlatformTime::Seconds() - Start);
+				}
+				SecondsPerMember.Add(NumMembers, BestSeconds / MembersPerRun);
+
+				AddInfo(FString::Printf(TEXT("%d members: %.3f us per member"), NumMembers, BestSeconds / MembersPerRun * 1e6));
+			}
+
+			// Quadratic growth would make each member eight times slower for every eightfold increase
+			TestTrue("64 members scale linearly from 8", SecondsPerMember[64] < SecondsPerMember[8] * 4.0);
+			TestTrue("512 members scale linearly from 64", SecondsPerMember[512] < SecondsPerMember[64] * 4.0);
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,145 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftPayloadCompression.h"
+
+#include "DriftSchemas.h"
+#include "JsonArchive.h"
+
+#include "Misc/AutomationTest.h"
+#include "Misc/Compression.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Connection timeouts for a server full of players dropping at once, each with its own address and IDs */
+static TArray<FDriftLogMessage> MakeDisconnectBurst(int32 NumMessages)
+{
+    TArray<FDriftLogMessage> Logs;
+    const auto Start = FDateTime::UtcNow();
+    for (int32 Index = 0; Index < NumMessages; ++Index)
+    {
+        Logs.Emplace(FString::Printf(TEXT("UNetConnection::Tick: Connection TIMED OUT. Closing connection.. Elapsed: 30.%02d, Real: 30.%02d, Good: 30.%02d, ")
+            TEXT("DriverTime: %d.%03d, Threshold: 30.00, [UNetConnection] RemoteAddr: 10.0.%d.%d:7777, Name: IpConnection_%d, Driver: GameNetDriver IpNetDriver_0, ")
+            TEXT("IsServer: YES, PC: PlayerController_%d, Owner: PlayerController_%d, UniqueId: NULL:%08X"),
+            Index % 100, Index % 100, Index % 100, 1200 + Index, Index * 7 % 1000, Index / 256, Index % 256, 2000 + Index, Index, Index, 0x5EED0000 + Index * 17),
+            TEXT("Error"), FName{ TEXT("LogNet") }, Start + FTimespan::FromMilliseconds(Index * 3));
+    }
+    return Logs;
+}
+
+
+/** Failed ensures from a handful of places, each with its call stack, as a bad patch tends to produce */
+static TArray<FDriftLogMessage> MakeEnsureBurst(int32 NumMessages)
+{
+    static const TCHAR* Conditions[] =
+    {
+        TEXT("Component->IsRegistered()"),
+        TEXT("AbilitySpec != nullptr"),
+        TEXT("Index < Inventory.Num()"),
+        TEXT("!Pawn->IsPendingKill()"),
+    };
+
+    constexpr int32 NumConditions = UE_ARRAY_COUNT(Conditions);
+
+    TArray<FDriftLogMessage> Logs;
+    const auto Start = FDateTime::UtcNow();
+    for (int32 Index = 0; Index < NumMessages; ++Index)
+    {
+        const auto Place = Index % NumConditions;
+        FString Message = FString::Printf(TEXT("Ensure condition failed: %s [File:D:/Build/Game/Source/Game/Private/GameplaySystem%d.cpp] [Line: %d]\n"),
+            Conditions[Place], Place, 120 + Place * 37);
+        for (int32 Frame = 0; Frame < 12; ++Frame)
+        {
+            Message += FString::Printf(TEXT("[Callstack] 0x%016llx Game.exe!UGameplaySystem%d::Update%d() [D:/Build/Game/Source/Game/Private/GameplaySystem%d.cpp:%d]\n"),
+                0x00007FF6A0000000ull + Frame * 0x1F40 + Place * 0x10, Frame, Frame, Frame, 40 + Frame * 13);
+        }
+        Logs.Emplace(Message, TEXT("Error"), FName{ TEXT("LogOutputDevice") }, Start + FTimespan::FromMilliseconds(Index * 5));
+    }
+    return Logs;
+}
+
+
+BEGIN_DEFINE_SPEC(DriftPayloadCompressionSpec, "Game.Drift.PayloadCompression", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(DriftPayloadCompressionSpec)
+
+void DriftPayloadCompressionSpec::Define()
+{
+    Describe("Compress", [this]
+    {
+        It("should leave payloads too small to bother uncompressed", [this]
+        {
+            FString Payload;
+            JsonArchive::SaveObject(MakeDisconnectBurst(0), Payload);
+            TArray<uint8> Compressed;
+
+            TestFalse("Compressed", DriftPayloadCompression::Compress(Payload, Compressed));
+            TestEqual("Compressed bytes", Compressed.Num(), 0);
+        });
+
+        It("should gzip the UTF-8 encoding of the payload", [this]
+        {
+            FString Payload;
+            JsonArchive::SaveObject(MakeEnsureBurst(4), Payload);
+            TArray<uint8> Compressed;
+
+            TestTrue("Compressed", DriftPayloadCompression::Compress(Payload, Compressed));
+
+            const FTCHARToUTF8 Converter(*Payload);
+            TArray<uint8> Uncompressed;
+            Uncompressed.SetNumUninitialized(Converter.Length());
+            TestTrue("Uncompressed", FCompression::UncompressMemory(NAME_Gzip, Uncompressed.GetData(), Uncompressed.Num(), Compressed.GetData(), Compressed.Num()));
+            TestTrue("Same payload", FMemory::Memcmp(Uncompressed.GetData(), Converter.Get(), Converter.Length()) == 0);
+        });
+    });
+
+    Describe("Error bursts", [this]
+    {
+        It("should upload a fraction of the bytes, and report how long it takes", [this]
+        {
+            struct FBurst
+            {
+                const TCHAR* Name;
+                TArray<FDriftLogMessage> Logs;
+            };
+            // Up to the flush budget of the log forwarder
+            const TArray<FBurst> Bursts
+            {
+                { TEXT("8 disconnects"), MakeDisconnectBurst(8) },
+                { TEXT("100 disconnects"), MakeDisconnectBurst(100) },
+                { TEXT("16 ensures"), MakeEnsureBurst(16) },
+                { TEXT("40 ensures"), MakeEnsureBurst(40) },
+            };
+            constexpr int32 Runs = 20;
+
+            for (const auto& Burst : Bursts)
+            {
+                FString Payload;
+                TArray<uint8> Compressed;
+                auto SerializeSeconds = DBL_MAX;
+                auto CompressSeconds = DBL_MAX;
+                for (int32 Run = 0; Run < Runs; ++Run)
+                {
+                    auto Start = FPlatformTime::Seconds();
+                    Payload.Reset();
+                    JsonArchive::SaveObject(Burst.Logs, Payload);
+                    SerializeSeconds = FMath::Min(SerializeSeconds, FPlatformTime::Seconds() - Start);
+
+                    Start = FPlatformTime::Seconds();
+                    DriftPayloadCompression::Compress(Payload, Compressed);
+                    CompressSeconds = FMath::Min(CompressSeconds, FPlatformTime::Seconds() - Start);
+                }
+
+                // Before, the JSON was posted as it was
+                const auto UncompressedBytes = FTCHARToUTF8(*Payload).Length();
+                AddInfo(FString::Printf(TEXT("%s: %d bytes before, %d bytes gzipped (%.1fx), serialized in %.3f ms, compressed in %.3f ms"),
+                    Burst.Name, UncompressedBytes, Compressed.Num(), UncompressedBytes / static_cast<float>(FMath::Max(Compressed.Num(), 1)),
+                    SerializeSeconds * 1000.0, CompressSeconds * 1000.0));
+
+                TestTrue(FString::Printf(TEXT("%s compressed"), Burst.Name), Compressed.Num() > 0);
+                TestTrue(FString::Printf(TEXT("%s at least half the size"), Burst.Name), Compressed.Num() * 2 < UncompressedBytes);
+            }
+        });
+    });
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,171 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftRegionScoring.h"
+
+#include "DriftLatencyProber.h"
+
+#include "Misc/AutomationTest.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static FDriftRegionMeasurement MakeRegionMeasurement(const FString& Region, float LatencyMs, float JitterMs = 0.0f, float PacketLoss = 0.0f)
+{
+	FDriftRegionMeasurement Measurement;
+	Measurement.Region = Region;
+	Measurement.LatencyMs = LatencyMs;
+	Measurement.JitterMs = JitterMs;
+	Measurement.PacketLoss = PacketLoss;
+	return Measurement;
+}
+
+static TArray<FString> RankedRegionNames(const TArray<FDriftRegionScore>& Ranked)
+{
+	TArray<FString> Names;
+	for (const auto& RegionScore : Ranked)
+	{
+		Names.Add(RegionScore.Region);
+	}
+	return Names;
+}
+
+
+BEGIN_DEFINE_SPEC(DriftRegionScoringSpec, "Game.Drift.RegionScoring", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+	FDriftRegionScoringSettings Settings;
+END_DEFINE_SPEC(DriftRegionScoringSpec)
+
+void DriftRegionScoringSpec::Define()
+{
+	BeforeEach([this]
+	{
+		Settings = FDriftRegionScoringSettings{};
+		Settings.LatencyCeilingMs = 150.0f;
+		Settings.JitterWeight = 2.0f;
+		Settings.PacketLossPenaltyMs = 10.0f;
+		Settings.MaxPacketLoss = 0.5f;
+	});
+
+	Describe("Measure", [this]
+	{
+		It("should prefer the estimate over the server's average", [this]
+		{
+			FDriftLatencyEstimate Estimate;
+			Estimate.AddSample(40.0f);
+			Estimate.AddLoss();
+			const int32 ServerAverageMs = 70;
+
+			const auto Measurement = FDriftRegionScoring::Measure(TEXT("eu-west-1"), &Estimate, &ServerAverageMs);
+
+			TestTrue("Measured", Measurement.IsSet());
+			TestEqual("Latency", Measurement.Get({}).LatencyMs, 40.0f);
+			TestEqual("Packet loss", Measurement.Get({}).PacketLoss, 0.5f);
+		});
+
+		It("should fall back to the server's average without an estimate", [this]
+		{
+			const int32 ServerAverageMs = 70;
+
+			const auto Measurement = FDriftRegionScoring::Measure(TEXT("eu-west-1"), nullptr, &ServerAverageMs);
+
+			TestTrue("Measured", Measurement.IsSet());
+			TestEqual("Latency", Measurement.Get({}).LatencyMs, 70.0f);
+			TestTrue("Eligible", FDriftRegionScoring::Score(Measurement.Get({}), Settings).IsSet());
+			TestFalse("Nothing known", FDriftRegionScoring::Measure(TEXT("eu-west-1"), nullptr, nullptr).IsSet());
+		});
+
+		It("should not make a region whose probes all went unanswered eligible on the server's average", [this]
+		{
+			FDriftLatencyEstimate Estimate;
+			Estimate.AddLoss();
+			Estimate.AddLoss();
+			const int32 ServerAverageMs = 70;
+			Settings.MaxPacketLoss = 1.0f;
+
+			const auto Measurement = FDriftRegionScoring::Measure(TEXT("eu-west-1"), &Estimate, &ServerAverageMs);
+
+			TestTrue("Measured", Measurement.IsSet());
+			TestEqual("Packet loss", Measurement.Get({}).PacketLoss, 1.0f);
+			TestFalse("Eligible", FDriftRegionScoring::Score(Measurement.Get({}), Settings).IsSet());
+		});
+	});
+
+	Describe("Score", [this]
+	{
+		It("should add the jitter and packet loss penalties to the latency", [this]
+		{
+			const auto Score = FDriftRegionScoring::Score(MakeRegionMeasurement(TEXT("eu-west-1"), 40.0f, 5.0f, 0.1f), Settings);
+
+			TestTrue("Eligible", Score.IsSet());
+			TestEqual("Score", Score.Get(0.0f), 40.0f + 2.0f * 5.0f + 10.0f * 10.0f);
+		});
+
+		It("should apply the region weight", [this]
+		{
+			Settings.RegionWeights.Add(TEXT("eu-west-1"), 0.5f);
+
+			TestEqual("Weighted", FDriftRegionScoring::Score(MakeRegionMeasurement(TEXT("eu-west-1"), 80.0f), Settings).Get(0.0f), 40.0f);
+			TestEqual("Unweighted", FDriftRegionScoring::Score(MakeRegionMeasurement(TEXT("us-east-1"), 80.0f), Settings).Get(0.0f), 80.0f);
+		});
+
+		It("should leave out regions over the latency ceiling or losing too many probes", [this]
+		{
+			TestFalse("Over the ceiling", FDriftRegionScoring::Score(MakeRegionMeasurement(TEXT("eu-west-1"), 151.0f), Settings).IsSet());
+			TestTrue("At the ceiling", FDriftRegionScoring::Score(MakeRegionMeasurement(TEXT("eu-west-1"), 150.0f), Settings).IsSet());
+			TestFalse("Too much loss", FDriftRegionScoring::Score(MakeRegionMeasurement(TEXT("eu-west-1"), 40.0f, 0.0f, 0.6f), Settings).IsSet());
+
+			Settings.LatencyCeilingMs = 0.0f;
+			TestTrue("No ceiling", FDriftRegionScoring::Score(MakeRegionMeasurement(TEXT("eu-west-1"), 1000.0f), Settings).IsSet());
+		});
+	});
+
+	Describe("Rank", [this]
+	{
+		It("should rank regions by score", [this]
+		{
+			const auto Ranked = FDriftRegionScoring::Rank({
+				MakeRegionMeasurement(TEXT("us-east-1"), 90.0f),
+				// Lowest latency, but too jittery
+				MakeRegionMeasurement(TEXT("eu-west-1"), 30.0f, 40.0f),
+				MakeRegionMeasurement(TEXT("eu-central-1"), 45.0f, 2.0f),
+				MakeRegionMeasurement(TEXT("ap-east-1"), 240.0f),
+			}, Settings);
+
+			TestTrue("Order", RankedRegionNames(Ranked) == TArray<FString>{ TEXT("eu-central-1"), TEXT("us-east-1"), TEXT("eu-west-1") });
+			TestEqual("Best score", Ranked[0].Score, 49.0f);
+		});
+
+		It("should let weights reorder regions", [this]
+		{
+			Settings.RegionWeights.Add(TEXT("us-east-1"), 0.5f);
+
+			const auto Ranked = FDriftRegionScoring::Rank({
+				MakeRegionMeasurement(TEXT("eu-west-1"), 60.0f),
+				MakeRegionMeasurement(TEXT("us-east-1"), 100.0f),
+			}, Settings);
+
+			TestTrue("Order", RankedRegionNames(Ranked) == TArray<FString>{ TEXT("us-east-1"), TEXT("eu-west-1") });
+		});
+
+		It("should keep the original order for equal scores", [this]
+		{
+			const auto Ranked = FDriftRegionScoring::Rank({
+				MakeRegionMeasurement(TEXT("b"), 50.0f),
+				MakeRegionMeasurement(TEXT("a"), 50.0f),
+			}, Settings);
+
+			TestTrue("Order", RankedRegionNames(Ranked) == TArray<FString>{ TEXT("b"), TEXT("a") });
+		});
+
+		It("should be empty when no region is within the ceiling", [this]
+		{
+			const auto Ranked = FDriftRegionScoring::Rank({
+				MakeRegionMeasurement(TEXT("eu-west-1"), 200.0f),
+				MakeRegionMeasurement(TEXT("us-east-1"), 300.0f),
+			}, Settings);
+
+			TestEqual("Ranked", Ranked.Num(), 0);
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,287 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftSocialSession.h"
+
+#include "Misc/AutomationTest.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Hands out a delegate per queue for the test to broadcast synthetic messages on
+ */
+class FFakeSocialMessageQueue : public IDriftMessageQueue
+{
+public:
+	void SendMessage(const FString& urlTemplate, const FString& queue, JsonValue&& message) override {}
+	void SendMessage(const FString& urlTemplate, const FString& queue, JsonValue&& message, int timeoutSeconds) override {}
+
+	FDriftMessageQueueDelegate& OnMessageQueueMessage(const FString& queue) override
+	{
+		return Delegates.FindOrAdd(queue);
+	}
+
+	void Deliver(const FString& Queue, const FString& Event, const JsonValue& Data, int32 SenderId = SenderSystemID)
+	{
+		FMessageQueueEntry Message;
+		Message.queue = Queue;
+		Message.sender_id = SenderId;
+		Message.payload.SetField(TEXT("event"), Event);
+		if (Queue == TEXT("party_notification"))
+		{
+			// Party events carry their fields alongside the event name
+			for (const auto& Field : Data.GetInternalValue()->AsObject()->Values)
+			{
+				Message.payload.GetInternalValue()->AsObject()->SetField(Field.Key, Field.Value);
+			}
+		}
+		else
+		{
+			Message.payload.SetField(TEXT("data"), Data);
+		}
+		OnMessageQueueMessage(Queue).Broadcast(Message);
+	}
+
+	TMap<FString, FDriftMessageQueueDelegate> Delegates;
+};
+
+
+struct FSocialSessionHarness
+{
+	static constexpr int32 PlayerId = 10;
+
+	TSharedPtr<FFakeSocialMessageQueue> MessageQueue = MakeShared<FFakeSocialMessageQueue>();
+	TSharedPtr<FDriftSocialSession> Session = MakeShared<FDriftSocialSession>(MessageQueue);
+	TArray<EDriftSocialState> States;
+	TArray<EDriftSocialEvent> InvalidEvents;
+
+	FSocialSessionHarness()
+	{
+		Session->ConfigureSession(FDriftEndpointsResponse{}, PlayerId);
+		Session->OnStateChanged().AddLambda([this](EDriftSocialState OldState, EDriftSocialState NewState)
+		{
+			States.Add(NewState);
+		});
+		Session->OnInvalidTransition().AddLambda([this](EDriftSocialState State, EDriftSocialEvent Event)
+		{
+			InvalidEvents.Add(Event);
+		});
+	}
+
+	static JsonValue MakeData(const FString& LobbyId = TEXT("lobby"))
+	{
+		JsonValue Data{ rapidjson::kObjectType };
+		Data.SetField(TEXT("lobby_id"), LobbyId);
+		return Data;
+	}
+
+	static JsonValue MakePartyData(int32 PartyPlayerId)
+	{
+		JsonValue Data{ rapidjson::kObjectType };
+		Data.SetField(TEXT("party_id"), 1);
+		Data.SetField(TEXT("player_id"), PartyPlayerId);
+		return Data;
+	}
+
+	void Lobby(const FString& Event)
+	{
+		MessageQueue->Deliver(TEXT("lobby"), Event, MakeData());
+	}
+
+	void Party(const FString& Event, int32 PartyPlayerId = PlayerId)
+	{
+		MessageQueue->Deliver(TEXT("party_notification"), Event, MakePartyData(PartyPlayerId));
+	}
+
+	void Sandbox(const FString& Event)
+	{
+		MessageQueue->Deliver(TEXT("sandbox"), Event, JsonValue{ rapidjson::kObjectType });
+	}
+};
+
+
+BEGIN_DEFINE_SPEC(DriftSocialSessionSpec, "Game.Drift.SocialSession", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(DriftSocialSessionSpec)
+
+void DriftSocialSessionSpec::Define()
+{
+	Describe("Routing", [this]
+	{
+		It("should route events to their typed handler before the source handler", [this]
+		{
+			FSocialSessionHarness Harness;
+			TArray<EDriftSocialEvent> Typed;
+			TArray<EDriftSocialEvent> Source;
+			FString LobbyId;
+			Harness.Session->RegisterHandler(EDriftSocialEvent::LobbyMatchStarting, FDriftSocialEventDelegate::CreateLambda([&Typed, &LobbyId](const FDriftSocialEvent& Event)
+			{
+				Typed.Add(Event.Type);
+				LobbyId = Event.Lobby.lobby_id;
+			}));
+			Harness.Session->RegisterSourceHandler(EDriftSocialEventSource::Lobby, FDriftSocialEventDelegate::CreateLambda([&Source](const FDriftSocialEvent& Event)
+			{
+				Source.Add(Event.Type);
+			}));
+
+			Harness.Lobby(TEXT("LobbyUpdated"));
+			Harness.Lobby(TEXT("LobbyMatchStarting"));
+			Harness.Lobby(TEXT("SomethingNew"));
+
+			TestTrue("Typed", Typed == TArray<EDriftSocialEvent>{ EDriftSocialEvent::LobbyMatchStarting });
+			TestTrue("Source", Source == TArray<EDriftSocialEvent>{ EDriftSocialEvent::LobbyUpdated, EDriftSocialEvent::Unknown });
+			TestEqual("Decoded data", LobbyId, FString{ TEXT("lobby") });
+		});
+
+		It("should decode party events from the payload itself", [this]
+		{
+			FSocialSessionHarness Harness;
+			int32 JoinedPlayerId = INDEX_NONE;
+			Harness.Session->RegisterHandler(EDriftSocialEvent::PartyPlayerJoined, FDriftSocialEventDelegate::CreateLambda([&JoinedPlayerId](const FDriftSocialEvent& Event)
+			{
+				JoinedPlayerId = Event.Party.player_id;
+			}));
+
+			Harness.Party(TEXT("player_joined"), 20);
+
+			TestEqual("Joined player", JoinedPlayerId, 20);
+		});
+
+		It("should ignore lobby events from other players", [this]
+		{
+			FSocialSessionHarness Harness;
+			auto Handled = 0;
+			Harness.Session->RegisterSourceHandler(EDriftSocialEventSource::Lobby, FDriftSocialEventDelegate::CreateLambda([&Handled](const FDriftSocialEvent&)
+			{
+				++Handled;
+			}));
+
+			Harness.MessageQueue->Deliver(TEXT("lobby"), TEXT("LobbyUpdated"), FSocialSessionHarness::MakeData(), 99);
+			Harness.MessageQueue->Deliver(TEXT("lobby"), TEXT("LobbyUpdated"), FSocialSessionHarness::MakeData(), FSocialSessionHarness::PlayerId);
+
+			TestEqual("Handled", Handled, 1);
+			TestTrue("State", Harness.Session->GetState() == EDriftSocialState::InLobby);
+		});
+
+		It("should drop events it can't decode", [this]
+		{
+			FSocialSessionHarness Harness;
+			auto Handled = 0;
+			Harness.Session->RegisterSourceHandler(EDriftSocialEventSource::Lobby, FDriftSocialEventDelegate::CreateLambda([&Handled](const FDriftSocialEvent&)
+			{
+				++Handled;
+			}));
+
+			Harness.MessageQueue->Deliver(TEXT("lobby"), TEXT("LobbyUpdated"), JsonValue{ rapidjson::kArrayType });
+
+			TestEqual("Handled", Handled, 0);
+			TestTrue("State", Harness.Session->GetState() == EDriftSocialState::Idle);
+		});
+
+		It("should stop routing to handlers once unregistered", [this]
+		{
+			FSocialSessionHarness Harness;
+			auto Handled = 0;
+			const auto Owner = MakeShared<int32>(0);
+			Harness.Session->RegisterSourceHandler(EDriftSocialEventSource::Lobby, FDriftSocialEventDelegate::CreateSPLambda(Owner, [&Handled](const FDriftSocialEvent&)
+			{
+				++Handled;
+			}));
+
+			Harness.Lobby(TEXT("LobbyUpdated"));
+			Harness.Session->UnregisterHandlers(&Owner.Get());
+			Harness.Lobby(TEXT("LobbyUpdated"));
+
+			TestEqual("Handled", Handled, 1);
+		});
+	});
+
+	Describe("Lifecycle", [this]
+	{
+		It("should follow a party into a lobby, a match and back", [this]
+		{
+			FSocialSessionHarness Harness;
+
+			Harness.Party(TEXT("player_joined"));
+			Harness.Lobby(TEXT("LobbyUpdated"));
+			Harness.Lobby(TEXT("LobbyMemberJoined"));
+			Harness.Lobby(TEXT("LobbyMatchStarting"));
+			Harness.Lobby(TEXT("LobbyMatchStarted"));
+			Harness.Lobby(TEXT("LobbyDeleted"));
+
+			TestTrue("States", Harness.States == TArray<EDriftSocialState>{
+				EDriftSocialState::InParty,
+				EDriftSocialState::InLobby,
+				EDriftSocialState::MatchStarting,
+				EDriftSocialState::InMatch,
+				EDriftSocialState::InParty,
+			});
+			TestEqual("Invalid transitions", Harness.InvalidEvents.Num(), 0);
+		});
+
+		It("should go back to the lobby when the match is cancelled", [this]
+		{
+			FSocialSessionHarness Harness;
+
+			Harness.Lobby(TEXT("LobbyUpdated"));
+			Harness.Lobby(TEXT("LobbyMatchStarting"));
+			Harness.Lobby(TEXT("LobbyMatchCancelled"));
+
+			TestTrue("State", Harness.Session->GetState() == EDriftSocialState::InLobby);
+		});
+
+		It("should only leave the party when the player itself leaves", [this]
+		{
+			FSocialSessionHarness Harness;
+
+			Harness.Party(TEXT("player_joined"));
+			Harness.Party(TEXT("player_left"), 20);
+			TestTrue("State after someone else left", Harness.Session->GetState() == EDriftSocialState::InParty);
+
+			Harness.Party(TEXT("player_left"));
+			TestTrue("State after leaving", Harness.Session->GetState() == EDriftSocialState::Idle);
+		});
+
+		It("should leave the sandbox when the session couldn't be created", [this]
+		{
+			FSocialSessionHarness Harness;
+
+			Harness.Sandbox(TEXT("PlayerSessionReserved"));
+			TestTrue("State with a reserved session", Harness.Session->GetState() == EDriftSocialState::InSandbox);
+
+			Harness.Sandbox(TEXT("SessionCreationFailed"));
+			TestTrue("State after the failure", Harness.Session->GetState() == EDriftSocialState::Idle);
+			TestEqual("Invalid transitions", Harness.InvalidEvents.Num(), 0);
+		});
+
+		It("should report an event that doesn't fit the state and leave the state alone", [this]
+		{
+			FSocialSessionHarness Harness;
+			auto Handled = 0;
+			Harness.Session->RegisterSourceHandler(EDriftSocialEventSource::Lobby, FDriftSocialEventDelegate::CreateLambda([&Handled](const FDriftSocialEvent&)
+			{
+				++Handled;
+			}));
+
+			Harness.Lobby(TEXT("LobbyMatchStarted"));
+
+			TestTrue("State", Harness.Session->GetState() == EDriftSocialState::Idle);
+			TestTrue("Invalid transitions", Harness.InvalidEvents == TArray<EDriftSocialEvent>{ EDriftSocialEvent::LobbyMatchStarted });
+			TestEqual("Still routed", Handled, 1);
+		});
+
+		It("should take snapshots as they are", [this]
+		{
+			FSocialSessionHarness Harness;
+
+			Harness.Session->PartySnapshot(true);
+			Harness.Session->LobbySnapshot(true, EDriftLobbyStatus::Started);
+			TestTrue("State in a started lobby", Harness.Session->GetState() == EDriftSocialState::InMatch);
+
+			Harness.Session->LobbySnapshot(false, EDriftLobbyStatus::Unknown);
+			TestTrue("State after leaving the lobby", Harness.Session->GetState() == EDriftSocialState::InParty);
+			TestEqual("Invalid transitions", Harness.InvalidEvents.Num(), 0);
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
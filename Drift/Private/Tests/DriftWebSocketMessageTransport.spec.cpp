@@ -0,0 +1,151 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "DriftWebSocketMessageTransport.h"
+
+#include "DriftAPI.h"
+#include "JWTRequestManager.h"
+
+#include "Misc/AutomationTest.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Records the connections the transport opens instead of opening them, and lets the test
+ * play the part of the socket
+ */
+class FFakeWebSocketMessageTransport : public FDriftWebSocketMessageTransport
+{
+public:
+	using FDriftWebSocketMessageTransport::FDriftWebSocketMessageTransport;
+
+	void Connected() { HandleConnected(); }
+	void ConnectionError(const FString& Error) { HandleConnectionError(Error); }
+	void Closed(int32 StatusCode) { HandleClosed(StatusCode, TEXT(""), false); }
+	void Frame(const FString& Message) { HandleMessage(Message); }
+
+	TArray<FString> Urls;
+	TArray<TMap<FString, FString>> Headers;
+
+protected:
+	void OpenSocket(const FString& Url, const TMap<FString, FString>& InHeaders) override
+	{
+		Urls.Add(Url);
+		Headers.Add(InHeaders);
+	}
+};
+
+
+static const TCHAR* PartyFrame = TEXT(R"({"party": [{
+	"exchange_id": 1, "sender_id": 0, "message_number": 43, "message_id": "43", "exchange": "players", "queue": "party",
+	"timestamp": "2026-01-01T00:00:00.000Z", "expires": "2026-01-01T01:00:00.000Z", "payload": { "event": "invite" }
+}]})");
+
+
+BEGIN_DEFINE_SPEC(DriftWebSocketMessageTransportSpec, "Game.Drift.WebSocketMessageTransport", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+	TSharedPtr<JWTRequestManager> RequestManager;
+	TUniquePtr<FFakeWebSocketMessageTransport> Transport;
+END_DEFINE_SPEC(DriftWebSocketMessageTransportSpec)
+
+void DriftWebSocketMessageTransportSpec::Define()
+{
+	BeforeEach([this]
+	{
+		RequestManager = MakeShared<JWTRequestManager>(TEXT("token"));
+		Transport = MakeUnique<FFakeWebSocketMessageTransport>(RequestManager);
+	});
+
+	AfterEach([this]
+	{
+		Transport.Reset();
+		RequestManager.Reset();
+	});
+
+	Describe("Start", [this]
+	{
+		It("should connect to the stream URL with the request manager's headers", [this]
+		{
+			Transport->Start(TEXT("https://example.com/messages/10"), 42);
+
+			TestEqual("Connections", Transport->Urls.Num(), 1);
+			TestEqual("Url", Transport->Urls[0], FString{ TEXT("wss://example.com/messages/10?messages_after=42") });
+			TestEqual("Authorization", Transport->Headers[0].FindRef(TEXT("Authorization")), FString{ TEXT("Bearer token") });
+		});
+	});
+
+	Describe("HandleMessage", [this]
+	{
+		It("should deliver each frame as a batch", [this]
+		{
+			FDriftMessageQueueBatch Received;
+			Transport->OnMessages.BindLambda([&Received](FDriftMessageQueueBatch& Queues)
+			{
+				Received = MoveTemp(Queues);
+			});
+
+			Transport->Start(TEXT("https://example.com/messages/10"), 42);
+			Transport->Connected();
+			Transport->Frame(PartyFrame);
+
+			TestTrue("One queue", Received.Num() == 1 && Received[0].Num() == 1);
+			if (Received.Num() == 1 && Received[0].Num() == 1)
+			{
+				TestEqual("Queue", Received[0][0].queue, FString{ TEXT("party") });
+				TestEqual("Message number", Received[0][0].message_number, 43);
+			}
+		});
+
+		It("should ignore frames it can't parse", [this]
+		{
+			auto Batches = 0;
+			Transport->OnMessages.BindLambda([&Batches](FDriftMessageQueueBatch& Queues)
+			{
+				++Batches;
+			});
+
+			Transport->Start(TEXT("https://example.com/messages/10"), 42);
+			Transport->Connected();
+			Transport->Frame(TEXT("not json"));
+
+			TestEqual("Batches", Batches, 0);
+		});
+	});
+
+	Describe("Reconnect", [this]
+	{
+		It("should reconnect after the last processed message", [this]
+		{
+			Transport->Start(TEXT("https://example.com/messages/10"), 42);
+			Transport->Connected();
+			Transport->SetCursor(43);
+			Transport->Closed(1006);
+
+			Transport->Tick(0.5f);
+			TestEqual("Waits before reconnecting", Transport->Urls.Num(), 1);
+
+			Transport->Tick(0.5f);
+			TestEqual("Reconnected", Transport->Urls.Num(), 2);
+			TestEqual("Url", Transport->Urls.Last(), FString{ TEXT("wss://example.com/messages/10?messages_after=43") });
+		});
+
+		It("should give up if it never connected", [this]
+		{
+			TArray<FString> Failures;
+			Transport->OnFailed.BindLambda([&Failures](const FString& Error)
+			{
+				Failures.Add(Error);
+			});
+
+			Transport->Start(TEXT("https://example.com/messages/10"), 42);
+			Transport->ConnectionError(TEXT("refused"));
+			Transport->Tick(1.0f);
+			Transport->ConnectionError(TEXT("refused"));
+			Transport->Tick(10.0f);
+
+			TestEqual("Attempts", Transport->Urls.Num(), 2);
+			TestEqual("Failed", Failures.Num(), 1);
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
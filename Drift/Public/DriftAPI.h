@@ -23,6 +23,7 @@
 
 struct FRichPresence;
 class IDriftMessageQueue;
+class FDriftStaticDataView;
 
 /**
  * Fired when server registration has completed.
@@ -616,6 +617,7 @@ DECLARE_MULTICAST_DELEGATE_TwoParams(FDriftPlayerAuthenticatedDelegate, bool, co
 DECLARE_MULTICAST_DELEGATE_OneParam(FDriftConnectionStateChangedDelegate, EDriftConnectionState);
 DECLARE_MULTICAST_DELEGATE_TwoParams(FDriftStaticDataLoadedDelegate, bool, const FString&);
 DECLARE_MULTICAST_DELEGATE_TwoParams(FDriftStaticDataProgressDelegate, const FString&, int32);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FDriftStaticDataViewLoadedDelegate, bool, const TSharedPtr<FDriftStaticDataView>&);
 DECLARE_MULTICAST_DELEGATE_OneParam(FDriftGotActiveMatchesDelegate, bool);
 DECLARE_MULTICAST_DELEGATE_TwoParams(FDriftPlayerNameSetDelegate, bool, const FString&);
 DECLARE_MULTICAST_DELEGATE(FDriftStaticRoutesInitializedDelegate);
@@ -834,8 +836,9 @@ public:
 
     /**
      * Load static data from a CDN. Requires an authenticated player.
+     * Files are kept locally per commit, and only downloaded when the commit changes.
      * Fires OnStaticDataProgress() to report progress.
-     * Fires OnStaticDataLoaded() when finished.
+     * Fires OnStaticDataViewLoaded() and OnStaticDataLoaded() when finished.
      */
     virtual void LoadStaticData(const FString& name, const FString& ref) = 0;
 
@@ -1045,6 +1048,12 @@ public:
      * Fired when static data has finished downloading.
      */
     virtual FDriftStaticDataLoadedDelegate& OnStaticDataLoaded() = 0;
+    /**
+     * Fired when static data has finished downloading, with a memory mapped view of the file.
+     * Prefer this over OnStaticDataLoaded() for large files, which converts the whole file
+     * to a string, and only does so if someone is bound to it.
+     */
+    virtual FDriftStaticDataViewLoadedDelegate& OnStaticDataViewLoaded() = 0;
     /**
      * Fired when player stats have finished downloading.
      */
@@ -0,0 +1,49 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+
+/**
+ * Read-only view of a downloaded static data file.
+ * The file is memory mapped where the platform supports it, so the content is paged in
+ * on demand instead of being copied into a single large string.
+ */
+class DRIFT_API FDriftStaticDataView
+{
+public:
+    FDriftStaticDataView(const FString& InName, const FString& InCommit, const FString& InFilePath);
+    ~FDriftStaticDataView();
+
+    FDriftStaticDataView(const FDriftStaticDataView&) = delete;
+    FDriftStaticDataView& operator=(const FDriftStaticDataView&) = delete;
+
+    /** Map, or if mapping is not supported, load the file. Returns false if the file can't be read. */
+    bool Open();
+
+    const uint8* GetData() const;
+    int64 GetSize() const;
+
+    const FString& GetName() const { return Name; }
+    const FString& GetCommit() const { return Commit; }
+
+    /** Path of the file on disk, for callers that prefer to stream it themselves */
+    const FString& GetFilePath() const { return FilePath; }
+
+    /** Convert the UTF-8 content to a string. This copies the whole file, prefer GetData() for large files. */
+    FString ToString() const;
+
+private:
+    FString Name;
+    FString Commit;
+    FString FilePath;
+
+    TUniquePtr<IMappedFileHandle> MappedHandle;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+    TArray<uint8> Fallback;
+};
@@ -13,6 +13,15 @@ enum class EDriftLobbyStatus : uint8
 	Failed,
 };
 
+enum class EDriftLobbyMemberChange : uint8
+{
+	Joined,
+	Left,
+	ReadyChanged,
+	TeamChanged,
+	HostChanged,
+};
+
 class IDriftLobbyMember
 {
 public:
@@ -137,6 +146,7 @@ DECLARE_MULTICAST_DELEGATE_OneParam(FOnLobbyMemberUpdatedDelegate, const FString
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnLobbyMemberLeftDelegate, const FString& /* LobbyId */);
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnLobbyMemberKickedDelegate, const FString& /* LobbyId */);
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnLobbyStatusChangedDelegate, const FString& /* LobbyId */, EDriftLobbyStatus /* Status */);
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnLobbyMemberChangedDelegate, const FString& /* LobbyId */, int32 /* PlayerId */, EDriftLobbyMemberChange /* Change */);
 DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnLobbyMatchStartedDelegate, const FString& /* LobbyId */, const FString& /* ConnectionString */, const FString& /* ConnectionOptions */);
 
 class IDriftLobbyManager
@@ -187,6 +197,9 @@ public:
 	/* Raised when the host kicks a player from the lobby */
 	virtual FOnLobbyMemberKickedDelegate& OnLobbyMemberKicked() = 0;
 
+	/* Raised for each change to an individual member, whichever event caused it */
+	virtual FOnLobbyMemberChangedDelegate& OnLobbyMemberChanged() = 0;
+
 	/* Raised when the lobby status changes */
 	virtual FOnLobbyStatusChangedDelegate& OnLobbyStatusChanged() = 0;
 
@@ -12,6 +12,13 @@ enum class EDriftMatchPlacementStatus : uint8
     Failed,
 };
 
+enum class EDriftPublicMatchPlacementChange : uint8
+{
+    Added,
+    Updated,
+    Removed,
+};
+
 class IDriftMatchPlacement
 {
 public:
@@ -68,6 +75,17 @@ struct FDriftMatchPlacementProperties
 };
 
 
+struct FDriftPublicMatchPlacementsQuery
+{
+    /* Only placements on this map */
+    TOptional<FString> MapName;
+    /* Further filters, passed on to the backend as query parameters */
+    TMap<FString, FString> Filters;
+    /* Placements per page, or the backend default if unset */
+    TOptional<int32> PageSize;
+};
+
+
 struct FPlayerSessionInfo
 {
     FString PlayerSessionId;
@@ -87,6 +105,7 @@ DECLARE_DELEGATE_ThreeParams(FJoinMatchPlacementCompletedDelegate, bool /* bSucc
 DECLARE_DELEGATE_ThreeParams(FFetchPublicMatchPlacementsCompletedDelegate, bool /* bSuccess */, int32 /* Num of public placements fetched */, const FString& /* ErrorMessage */);
 
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnMatchPlacementStatusChangedDelegate, const FString& /* MatchPlacementId */, EDriftMatchPlacementStatus /* Status */);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnPublicMatchPlacementChangedDelegate, const FString& /* MatchPlacementId */, EDriftPublicMatchPlacementChange /* Change */);
 
 class IDriftMatchPlacementManager
 {
@@ -109,9 +128,15 @@ public:
     /* Get available public match placement ids and cache them */
     virtual bool FetchPublicMatchPlacements(FFetchPublicMatchPlacementsCompletedDelegate Delegate) = 0;
 
+    /* Get available public match placements matching the query, page by page, and merge them into the cache */
+    virtual bool FetchPublicMatchPlacements(const FDriftPublicMatchPlacementsQuery& Query, FFetchPublicMatchPlacementsCompletedDelegate Delegate) = 0;
+
     /* Get cached match placements */
     virtual TArray< TSharedPtr<IDriftMatchPlacement> >& GetCachedPublicMatchPlacements() = 0;
 
+    /* Raised for each cached public match placement that was added, updated or removed */
+    virtual FOnPublicMatchPlacementChangedDelegate& OnPublicMatchPlacementChanged() = 0;
+
 	/* Raised when the match placement status changes */
 	virtual FOnMatchPlacementStatusChangedDelegate& OnMatchPlacementStatusChanged() = 0;
 
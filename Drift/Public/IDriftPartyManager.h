@@ -3,6 +3,14 @@
 #pragma once
 
 
+enum class EDriftPartyMemberChange : uint8
+{
+	Joined,
+	Left,
+	Renamed,
+};
+
+
 class IDriftPartyMember
 {
 public:
@@ -51,6 +59,7 @@ DECLARE_MULTICAST_DELEGATE_TwoParams(FPartyMemberJoinedDelegate, int32 /* PartyI
 DECLARE_MULTICAST_DELEGATE_TwoParams(FPartyMemberLeftDelegate, int32 /* PartyId */, int32 /* LeavingPlayerId */);
 DECLARE_MULTICAST_DELEGATE_OneParam(FPartyDisbandedDelegate, int32 /* PartyId */);
 DECLARE_MULTICAST_DELEGATE_OneParam(FPartyUpdatedDelegate, int32 /* PartyId */);
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FPartyMemberChangedDelegate, int32 /* PartyId */, int32 /* PlayerId */, EDriftPartyMemberChange /* Change */);
 
 
 class IDriftPartyManager
@@ -107,5 +116,8 @@ public:
 	/* Raised when the party you're in has changed */
 	virtual FPartyUpdatedDelegate& OnPartyUpdated() = 0;
 
+	/* Raised for each member that joined, left or was renamed when the cached party is updated */
+	virtual FPartyMemberChangedDelegate& OnPartyMemberChanged() = 0;
+
 	virtual ~IDriftPartyManager() = default;
 };
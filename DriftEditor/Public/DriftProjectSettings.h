@@ -57,5 +57,88 @@ public:
     UPROPERTY(Config, EditAnywhere)
     FString DriftUrl;
 
+    /**
+     * Endpoints to fetch in parallel during login, as soon as their URLs are known, e.g. 'client_configs'.
+     * Names are looked up in the root endpoints and then in the player info. The first request for
+     * each of them after login is answered from memory.
+     */
+    UPROPERTY(Config, EditAnywhere)
+    TArray<FString> PrefetchEndpoints;
+
+    /**
+     * How to receive messages from the message queue: 'longpoll', or 'websocket' to stream them
+     * as they arrive. Streaming falls back to long polling if the backend doesn't support it.
+     */
+    UPROPERTY(Config, EditAnywhere)
+    FString MessageQueueTransport;
+
+    /** Send messages headed for the same player in a single request. Requires backend support. */
+    UPROPERTY(Config, EditAnywhere)
+    bool bMessageQueueBatchSend = false;
+
+    /** On dedicated servers, send all players' counters in bulk requests rather than one per player. Requires backend support. */
+    UPROPERTY(Config, EditAnywhere)
+    bool bServerCounterBulkFlush = false;
+
+    /** Largest player game state to download, in megabytes. Zero for no limit. */
+    UPROPERTY(Config, EditAnywhere)
+    int32 MaxGameStateSizeMB = 0;
+
+    /** Send the heartbeats of all Drift instances in the process together, when the backend supports it. Mostly useful for servers and bots hosting many instances. */
+    UPROPERTY(Config, EditAnywhere)
+    bool bHeartbeatBatching = false;
+
+    /** Host to ping for a region's latency, '{0}' is replaced with the region name. Empty to not use ICMP. */
+    UPROPERTY(Config, EditAnywhere)
+    FString LatencyProbeIcmpHost = TEXT("gamelift.{0}.amazonaws.com");
+
+    /** UDP echo server to probe a region with, as 'host:port' with '{0}' for the region name. Tried when ICMP isn't working. */
+    UPROPERTY(Config, EditAnywhere)
+    FString LatencyProbeUdpAddress;
+
+    /** URL to time a request to when neither ICMP nor UDP is working, '{0}' is replaced with the region name. */
+    UPROPERTY(Config, EditAnywhere)
+    FString LatencyProbeHttpUrl = TEXT("https://gamelift.{0}.amazonaws.com");
+
+    /** Probes sent to each region per measurement. */
+    UPROPERTY(Config, EditAnywhere)
+    int32 LatencyProbeSamplesPerRegion = 3;
+
+    /** Probes in flight at any one time. */
+    UPROPERTY(Config, EditAnywhere)
+    int32 LatencyProbeMaxConcurrent = 4;
+
+    /** Seconds to wait for a probe to be answered. */
+    UPROPERTY(Config, EditAnywhere)
+    float LatencyProbeTimeout = 2.0f;
+
+    /** Report a region's latency to the backend again once it has moved by more than this many milliseconds. */
+    UPROPERTY(Config, EditAnywhere)
+    int32 LatencyReportThresholdMs = 10;
+
+    /** Report a region's latency again when it hasn't been reported for this many seconds, even if it hasn't moved. */
+    UPROPERTY(Config, EditAnywhere)
+    float LatencyReportFreshnessSeconds = 60.0f;
+
+    /** Regions slower than this many milliseconds aren't matched in. Zero for no ceiling. */
+    UPROPERTY(Config, EditAnywhere)
+    float RegionLatencyCeilingMs = 250.0f;
+
+    /** Milliseconds added to a region's score per millisecond of jitter. */
+    UPROPERTY(Config, EditAnywhere)
+    float RegionJitterWeight = 2.0f;
+
+    /** Milliseconds added to a region's score per percent of packet loss. */
+    UPROPERTY(Config, EditAnywhere)
+    float RegionPacketLossPenaltyMs = 10.0f;
+
+    /** Regions losing more than this fraction of probes aren't matched in. */
+    UPROPERTY(Config, EditAnywhere)
+    float RegionMaxPacketLoss = 0.5f;
+
+    /** Multiplies the score of a region, as 'region:weight', e.g. 'eu-west-1:0.8'. Weights below 1 make a region more attractive. */
+    UPROPERTY(Config, EditAnywhere)
+    TArray<FString> RegionWeights;
+
     UDriftProjectSettings(const FObjectInitializer& ObjectInitializer);
 };
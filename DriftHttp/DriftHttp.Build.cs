@@ -67,5 +67,7 @@ public class DriftHttp : ModuleRules
                 "Json",
             }
         );
+
+        AddEngineThirdPartyPrivateStaticDependencies(TargetRules, "zlib");
     }
 }
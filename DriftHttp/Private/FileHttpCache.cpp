@@ -9,6 +9,7 @@
 #include "JsonArchive.h"
 #include "Details/DateHelper.h"
 
+#include "HAL/FileManager.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "Misc/SecureHash.h"
@@ -25,7 +26,7 @@ DEFINE_LOG_CATEGORY(LogHttpCache);
 
 
 const int32 MAX_INLINE_CACHED_CONTENT_SIZE = 1024;
-const int32 HTTP_CACHE_INDEX_VERSION = 1;
+const int32 HTTP_CACHE_INDEX_VERSION = 2;
 
 
 FString GetCachePath()
@@ -52,7 +53,7 @@ FileHttpCache::FileHttpCache()
 }
 
 
-void FileHttpCache::CacheResponse(const ResponseContext& context)
+void FileHttpCache::CacheResponse(const ResponseContext& context, const FString& partition)
 {
     auto cacheHeader = context.response->GetHeader(TEXT("Cache-Control"));
     if (!(cacheHeader.Contains(TEXT("no-cache")) || cacheHeader.Contains(TEXT("no-store"))))
@@ -70,9 +71,19 @@ void FileHttpCache::CacheResponse(const ResponseContext& context)
                     return;
                 }
 
+                TArray<FString> varyHeaders;
+                if (!ParseVaryHeaders(context.request, context.response, varyHeaders))
+                {
+                    UE_LOG(LogHttpCache, Verbose, TEXT("Response varies by '*', not safe to cache"));
+                    return;
+                }
+
                 auto url = context.request->GetURL();
-                auto& entry = data.Emplace(url);
+                const auto key = MakeCacheKey(context.request, varyHeaders, partition);
+                auto& entry = data.Emplace(key);
                 entry.url = url;
+                entry.key = key;
+                entry.varyHeaders = varyHeaders;
                 entry.headers = context.response->GetAllHeaders();
                 entry.maxAge = maxAge;
                 entry.date = dateValue;
@@ -82,19 +93,6 @@ void FileHttpCache::CacheResponse(const ResponseContext& context)
                 entry.contentType = context.response->GetContentType();
 
                 entry.correctedInitialAge = CalculateCorrectedInitialAge(context.response, entry).GetTotalSeconds();
-                
-                FString urlHash;
-                auto path = index.Find(url);
-                if (path)
-                {
-                    urlHash = *path;
-                }
-                else
-                {
-                    urlHash = FMD5::HashAnsiString(*url);
-                }
-
-                entry.urlHash = urlHash;
                 entry.contentHash = GetContentHash(context.response);
                 
                 if (context.response->GetContentLength() < MAX_INLINE_CACHED_CONTENT_SIZE)
@@ -104,20 +102,21 @@ void FileHttpCache::CacheResponse(const ResponseContext& context)
                 else
                 {
                     entry.onDisk = true;
-                    if (!SaveBody(urlHash, context.response->GetContent()))
+                    if (!SaveBody(key, context.response->GetContent()))
                     {
-                        UE_LOG(LogHttpCache, Error, TEXT("Failed to save cache body as '%s'"), *urlHash);
+                        UE_LOG(LogHttpCache, Error, TEXT("Failed to save cache body as '%s'"), *key);
                         return;
                     }
                 }
                 
-                if (!SaveResponse(urlHash, entry))
+                if (!SaveResponse(key, entry))
                 {
-                    UE_LOG(LogHttpCache, Error, TEXT("Failed to save cache entry as '%s.meta'"), *urlHash);
+                    UE_LOG(LogHttpCache, Error, TEXT("Failed to save cache entry as '%s.meta'"), *key);
                     return;
                 }
 
-                index.Add(url, urlHash);
+                index.Add(key, url);
+                vary.Add(url, varyHeaders);
                 
                 SaveIndex();
             }
@@ -126,22 +125,33 @@ void FileHttpCache::CacheResponse(const ResponseContext& context)
 }
 
 
-FHttpResponsePtr FileHttpCache::GetCachedResponse(const FString& url)
+FHttpResponsePtr FileHttpCache::GetCachedResponse(const FHttpRequestPtr& request, const FString& partition)
 {
-    // TODO: Consider invalidation by the Vary: header
-    const auto response = data.Find(url);
+    const auto url = request->GetURL();
+
+    /**
+     * The request headers that select a variant are only known from a previous response,
+     * so without one there's nothing to match against.
+     */
+    const auto varyHeaders = vary.Find(url);
+    if (!varyHeaders)
+    {
+        return nullptr;
+    }
+
+    const auto key = MakeCacheKey(request, *varyHeaders, partition);
+    const auto response = data.Find(key);
     if (response && response->valid && response->IsFresh())
     {
         return MakeResponse(*response);
     }
 
-    const auto responseFile = index.Find(url);
-    if (responseFile)
+    if (index.Contains(key))
     {
-        auto& entry = data.Emplace(url);
-        if (LoadResponse(*responseFile, entry))
+        auto& entry = data.Emplace(key);
+        if (LoadResponse(key, entry))
         {
-            if (entry.valid && entry.IsFresh())
+            if (entry.valid && entry.url == url && entry.IsFresh())
             {
                 return MakeResponse(entry);
             }
@@ -151,6 +161,32 @@ FHttpResponsePtr FileHttpCache::GetCachedResponse(const FString& url)
 }
 
 
+void FileHttpCache::Invalidate(const FString& url)
+{
+    if (vary.Remove(url) > 0)
+    {
+        UE_LOG(LogHttpCache, Verbose, TEXT("Invalidated cached responses for '%s'"), *url);
+
+        for (auto It = data.CreateIterator(); It; ++It)
+        {
+            if (It.Value().url == url)
+            {
+                It.RemoveCurrent();
+            }
+        }
+        for (auto It = index.CreateIterator(); It; ++It)
+        {
+            if (It.Value() == url)
+            {
+                It.RemoveCurrent();
+            }
+        }
+
+        SaveIndex();
+    }
+}
+
+
 void FileHttpCache::LoadCache()
 {
     const auto indexPath = FPaths::Combine(*cacheDir, TEXT("index.json"));
@@ -187,6 +223,17 @@ void FileHttpCache::LoadCache()
         UE_LOG(LogHttpCache, Error, TEXT("Cache index version is too high"));
         return;
     }
+    if (version < cacheVersion)
+    {
+        /**
+         * Older indices are keyed by URL alone, and may hold responses belonging to
+         * a different user. Start over rather than risk serving them, and delete their
+         * files, which nothing refers to any more.
+         */
+        UE_LOG(LogHttpCache, Log, TEXT("Discarding cache index version %d"), version);
+        DeleteCacheFiles();
+        return;
+    }
 
     auto entries = indexObject[TEXT("entries")];
     if (!entries.IsObject())
@@ -200,6 +247,16 @@ void FileHttpCache::LoadCache()
         index.Add(member.Key, member.Value.ToString());
     }
 
+    auto varyEntries = indexObject[TEXT("vary")];
+    if (varyEntries.IsObject())
+    {
+        for (auto& member : varyEntries.GetObject())
+        {
+            auto& headers = vary.Add(member.Key);
+            member.Value.ToString().ParseIntoArray(headers, TEXT(","));
+        }
+    }
+
     UE_LOG(LogHttpCache, Verbose, TEXT("Loaded %d cache entires"), entries.MemberCount());
 }
 
@@ -214,6 +271,12 @@ void FileHttpCache::SaveIndex()
         JsonArchive::AddMember(indexEntries, *entry.Key, *entry.Value);
     }
     JsonArchive::AddMember(indexObject, TEXT("entries"), indexEntries);
+    JsonValue varyEntries{ rapidjson::kObjectType };
+    for (const auto& entry : vary)
+    {
+        JsonArchive::AddMember(varyEntries, *entry.Key, *FString::Join(entry.Value, TEXT(",")));
+    }
+    JsonArchive::AddMember(indexObject, TEXT("vary"), varyEntries);
 
     const auto indexContent = JsonArchive::ToString(indexObject);
     const auto indexPath = FPaths::Combine(*cacheDir, TEXT("index.json"));
@@ -229,12 +292,77 @@ void FileHttpCache::SaveIndex()
 }
 
 
+void FileHttpCache::DeleteCacheFiles()
+{
+    if (!IFileManager::Get().DeleteDirectory(*cacheDir, false, true))
+    {
+        UE_LOG(LogHttpCache, Warning, TEXT("Failed to delete cache files in: %s"), *cacheDir);
+    }
+}
+
+
 FString FileHttpCache::MakeEntryPath(const FString &name) const
 {
     return FPaths::Combine(*cacheDir, *name.Left(2), *name.Mid(2, 2), *name);
 }
 
 
+FString FileHttpCache::MakeCacheKey(const FHttpRequestPtr& request, const TArray<FString>& varyHeaders, const FString& partition) const
+{
+    /**
+     * The key is hashed so that header values, such as bearer tokens, never end up on disk.
+     * When a partition is given it stands in for the Authorization header, which changes
+     * with every session while the user it identifies stays the same.
+     */
+    auto key = request->GetURL();
+    key += TEXT("\n");
+    key += partition;
+    for (const auto& header : varyHeaders)
+    {
+        key += TEXT("\n");
+        key += header;
+        key += TEXT(": ");
+        if (!partition.IsEmpty() && header == TEXT("authorization"))
+        {
+            continue;
+        }
+        key += request->GetHeader(header);
+    }
+    return FMD5::HashAnsiString(*key);
+}
+
+
+bool FileHttpCache::ParseVaryHeaders(const FHttpRequestPtr& request, const FHttpResponsePtr& response, TArray<FString>& varyHeaders) const
+{
+    TArray<FString> names;
+    response->GetHeader(TEXT("Vary")).ParseIntoArray(names, TEXT(","));
+    for (auto& name : names)
+    {
+        name.TrimStartAndEndInline();
+        if (name == TEXT("*"))
+        {
+            return false;
+        }
+        if (!name.IsEmpty())
+        {
+            varyHeaders.AddUnique(name.ToLower());
+        }
+    }
+
+    /**
+     * Authenticated responses are always treated as varying by user, even if the server
+     * doesn't say so, to prevent one user from being served another user's data.
+     */
+    if (!request->GetHeader(TEXT("Authorization")).IsEmpty())
+    {
+        varyHeaders.AddUnique(TEXT("authorization"));
+    }
+
+    varyHeaders.Sort();
+    return true;
+}
+
+
 bool FileHttpCache::LoadResponse(const FString &name, HttpCacheEntry& entry)
 {
     const auto fullPath = MakeEntryPath(name) + TEXT(".meta");
@@ -337,7 +465,7 @@ FHttpResponsePtr FileHttpCache::MakeResponse(HttpCacheEntry& entry)
     }
     else
     {
-        LoadBody(entry.urlHash, response->payload);
+        LoadBody(entry.key, response->payload);
     }
 
     const auto hash = GetContentHash(response);
@@ -12,14 +12,18 @@ class DRIFTHTTP_API FileHttpCache : public IHttpCache
 public:
     FileHttpCache();
 
-    void CacheResponse(const ResponseContext& context) override;
-    FHttpResponsePtr GetCachedResponse(const FString& url) override;
+    void CacheResponse(const ResponseContext& context, const FString& partition) override;
+    FHttpResponsePtr GetCachedResponse(const FHttpRequestPtr& request, const FString& partition) override;
+    void Invalidate(const FString& url) override;
 
 private:
     void LoadCache();
     void SaveIndex();
+    void DeleteCacheFiles();
     
     FString MakeEntryPath(const FString& name) const;
+    FString MakeCacheKey(const FHttpRequestPtr& request, const TArray<FString>& varyHeaders, const FString& partition) const;
+    bool ParseVaryHeaders(const FHttpRequestPtr& request, const FHttpResponsePtr& response, TArray<FString>& varyHeaders) const;
 
     bool LoadResponse(const FString& name, HttpCacheEntry& entry);
     bool SaveResponse(const FString& name, const HttpCacheEntry& entry);
@@ -32,7 +36,10 @@ private:
 
     FString cacheDir;
     TMap<FString, HttpCacheEntry> data;
+    /** Cache key -> URL of every entry stored on disk */
     TMap<FString, FString> index;
+    /** URL -> request headers the last cached response for it varied by */
+    TMap<FString, TArray<FString>> vary;
     
     int32 cacheVersion;
 };
@@ -36,7 +36,8 @@ bool HttpCacheEntry::Serialize(SerializationContext& context)
         && SERIALIZE_PROPERTY(context, contentType)
         && SERIALIZE_PROPERTY(context, responseCode)
         && SERIALIZE_PROPERTY(context, url)
-        && SERIALIZE_PROPERTY(context, urlHash)
+        && SERIALIZE_PROPERTY(context, key)
+        && SERIALIZE_PROPERTY(context, varyHeaders)
         && SERIALIZE_PROPERTY(context, contentHash)
         && SERIALIZE_PROPERTY(context, onDisk)
         && SERIALIZE_PROPERTY(context, valid);
@@ -24,7 +24,8 @@ public:
     int32 correctedInitialAge;
 
     FString url;
-    FString urlHash;
+    FString key;
+    TArray<FString> varyHeaders;
     FString contentHash;
     bool onDisk = false;
     bool valid = true;
@@ -18,6 +18,7 @@
 #include "JsonArchive.h"
 #include "JsonUtils.h"
 #include "ErrorResponse.h"
+#include "HttpResponseStream.h"
 #include "IErrorReporter.h"
 #include "RetryConfig.h"
 
@@ -48,6 +49,17 @@ void HttpRequest::SetCache(TSharedPtr<IHttpCache> cache)
 }
 
 
+void HttpRequest::SetResponseChunkHandler(const FHttpResponseChunkDelegate& handler)
+{
+	responseStream_ = MakeShared<HttpResponseStream>(handler);
+	expectJsonResponse_ = false;
+
+#if !UE_VERSION_OLDER_THAN(5, 3, 0)
+	wrappedRequest_->SetResponseBodyReceiveStream(responseStream_.ToSharedRef());
+#endif
+}
+
+
 void HttpRequest::BindActualRequest(FHttpRequestPtr request)
 {
 	wrappedRequest_ = request;
@@ -89,6 +101,12 @@ void HttpRequest::InternalRequestCompleted(FHttpRequestPtr request, FHttpRespons
         response = MakeShared<FFakeHttpResponse>(request->GetURL(), INDEX_NONE, TEXT("This is a fake response since the engine/OS returns null"));
     }
 
+	if (responseStream_.IsValid() && responseStream_->GetErrorBody().Num() > 0 && response->GetContent().Num() == 0)
+	{
+		// The error body went to the response stream, put it back for the error handlers
+		response = MakeShared<HttpResponseWithBody>(response, responseStream_->GetErrorBody());
+	}
+
 	ResponseContext context(request, response, sent_, false);
 
 #if UE_VERSION_OLDER_THAN(5, 4, 0)
@@ -105,6 +123,8 @@ void HttpRequest::InternalRequestCompleted(FHttpRequestPtr request, FHttpRespons
 			&& context.responseCode < static_cast<int32>(HttpStatusCodes::FirstClientError);
 		if (bStatusCodeIsSuccess)
 		{
+			serverResponded_ = true;
+
 			/**
 			 * We got a non-error response code
 			 */
@@ -145,10 +165,7 @@ void HttpRequest::InternalRequestCompleted(FHttpRequestPtr request, FHttpRespons
 					else
 					{
 						// All default validation passed, process response
-						if (cache_.IsValid() && request->GetVerb() == TEXT("GET"))
-						{
-							cache_->CacheResponse(context);
-						}
+						UpdateCache(context);
 						context.successful = true;
 						OnResponse.ExecuteIfBound(context, doc);
 						const auto deprecationHeader = response->GetHeader(TEXT("Drift-Feature-Deprecation"));
@@ -167,12 +184,9 @@ void HttpRequest::InternalRequestCompleted(FHttpRequestPtr request, FHttpRespons
 					context.error = FString::Printf(
 						TEXT("Expected '%i', but got '%i'"), expectedResponseCode_, context.responseCode);
 				}
-				else
+				else if (FinishResponseStream(context))
 				{
-					if (cache_.IsValid() && request->GetVerb() == TEXT("GET"))
-					{
-						cache_->CacheResponse(context);
-					}
+					UpdateCache(context);
 
 					context.successful = true;
 					JsonDocument doc;
@@ -219,6 +233,15 @@ void HttpRequest::InternalRequestCompleted(FHttpRequestPtr request, FHttpRespons
 	}
 	else
 	{
+		if (responseStream_.IsValid() && responseStream_->HasReceivedData() && CurrentRetry_ < MaxRetries_)
+		{
+			/**
+			 * The connection dropped in the middle of the body, pick up where it stopped.
+			 */
+			Retry();
+			return;
+		}
+
 		/**
 		 * The request failed to send, or return. Pass it through the error handling chain.
 		 */
@@ -233,6 +256,70 @@ void HttpRequest::InternalRequestCompleted(FHttpRequestPtr request, FHttpRespons
 }
 
 
+void HttpRequest::UpdateCache(ResponseContext& context)
+{
+	if (!cache_.IsValid())
+	{
+		return;
+	}
+
+	if (context.request->GetVerb() == TEXT("GET"))
+	{
+		// Partial responses only hold a slice of the resource, and are not keyed by range.
+		// Streamed responses don't keep their body around to cache.
+		if (context.responseCode != static_cast<int32>(HttpStatusCodes::PartialContent) && !responseStream_.IsValid())
+		{
+			cache_->CacheResponse(context, cachePartition_);
+		}
+	}
+	else if (context.request->GetVerb() != TEXT("HEAD") && context.request->GetVerb() != TEXT("OPTIONS"))
+	{
+		// A successful write means any cached read of the same resource is stale
+		cache_->Invalidate(context.request->GetURL());
+	}
+}
+
+
+void HttpRequest::PrepareResponseStream(int64 offset)
+{
+	if (offset > 0)
+	{
+		SetHeader(TEXT("Range"), FString::Printf(TEXT("bytes=%lld-"), offset));
+	}
+	if (acceptGzip_)
+	{
+		// Ranges of a compressed body can't be inflated on their own, so continue uncompressed
+		SetHeader(TEXT("Accept-Encoding"), offset > 0 ? TEXT("identity") : TEXT("gzip"));
+	}
+	if (responseStream_.IsValid())
+	{
+		responseStream_->Reset(wrappedRequest_.Get(), offset);
+	}
+}
+
+
+bool HttpRequest::FinishResponseStream(ResponseContext& context)
+{
+	if (!responseStream_.IsValid())
+	{
+		return true;
+	}
+
+#if UE_VERSION_OLDER_THAN(5, 3, 0)
+	// The engine can't stream the body, so pass it on in one piece now that it's complete
+	const auto& content = context.response->GetContent();
+	responseStream_->Write(content.GetData(), content.Num(), context.responseCode, context.response->GetHeader(TEXT("Content-Encoding")));
+#endif
+
+	if (!responseStream_->Finish())
+	{
+		context.error = responseStream_->GetError();
+		return false;
+	}
+	return true;
+}
+
+
 void HttpRequest::BroadcastError(ResponseContext& context)
 {
 	DefaultErrorHandler.ExecuteIfBound(context);
@@ -408,6 +495,11 @@ void HttpRequest::Retry()
 
 	UE_LOG(LogHttpClient, Verbose, TEXT("Scheduling retry for %s in %f seconds"), *GetAsDebugString(), Delay);
 
+	if (responseStream_.IsValid())
+	{
+		PrepareResponseStream(responseStream_->GetDeliveredBytes());
+	}
+
 	// Note that we explicitly set the request to be queued for retry
 	// the reason is that the internal HTTP processing logic will remove the current request from the system right after this point (Retry is called by the request finish handler)
 	// so the only way to make it work is to add the request back in the next tick (this is done automatically by the queue in the request manager)
@@ -419,40 +511,45 @@ bool HttpRequest::Dispatch()
 {
 	check(!wrappedRequest_->GetURL().IsEmpty());
 
-	if (cache_.IsValid() && wrappedRequest_->GetVerb() == TEXT("GET"))
+	PrepareResponseStream(resumeOffset_);
+
+	if (cache_.IsValid() && wrappedRequest_->GetVerb() == TEXT("GET") && !responseStream_.IsValid())
 	{
 		const auto header = wrappedRequest_->GetHeader(TEXT("Cache-Control"));
-		if (!(header.Contains(TEXT("no-cache")) || header.Contains(TEXT("max-age=0"))))
+		const auto bIsRangeRequest = !wrappedRequest_->GetHeader(TEXT("Range")).IsEmpty();
+		if (!(header.Contains(TEXT("no-cache")) || header.Contains(TEXT("max-age=0")) || bIsRangeRequest))
 		{
-			const auto cachedResponse = cache_->GetCachedResponse(wrappedRequest_->GetURL());
+			const auto cachedResponse = cache_->GetCachedResponse(wrappedRequest_, cachePartition_);
 			if (cachedResponse.IsValid())
 			{
-				ResponseContext context{ wrappedRequest_, cachedResponse, sent_, true };
-				JsonDocument doc;
-				doc.Parse(*cachedResponse->GetContentAsString());
-
-				OnResponse.ExecuteIfBound(context, doc);
-				OnCompleted.ExecuteIfBound(SharedThis(this));
+				CompleteFromCache(cachedResponse);
+				return true;
+			}
 
-				if (!context.error.IsEmpty() && !context.errorHandled)
+			const auto bWaiting = cache_->WaitForResponse(wrappedRequest_, cachePartition_, [self = SharedThis(this)](FHttpResponsePtr response)
+			{
+				if (response.IsValid())
 				{
-					/**
-					 * Otherwise, pass it through the error handling chain.
-					 */
-					BroadcastError(context);
-					LogError(context);
+					self->CompleteFromCache(response);
 				}
 				else
 				{
-					UE_LOG(LogHttpClient, Verbose, TEXT("'%s' SUCCEEDED from CACHE in %.3f seconds")
-					       , *GetAsDebugString(), (FDateTime::UtcNow() - sent_).GetTotalSeconds());
+					self->DispatchToNetwork();
 				}
-
+			});
+			if (bWaiting)
+			{
 				return true;
 			}
 		}
 	}
 
+	return DispatchToNetwork();
+}
+
+
+bool HttpRequest::DispatchToNetwork()
+{
 	if (OnDispatch.IsBound())
 	{
 		return OnDispatch.Execute(SharedThis(this));
@@ -461,6 +558,31 @@ bool HttpRequest::Dispatch()
 }
 
 
+void HttpRequest::CompleteFromCache(const FHttpResponsePtr& cachedResponse)
+{
+	ResponseContext context{ wrappedRequest_, cachedResponse, sent_, true };
+	JsonDocument doc;
+	doc.Parse(*cachedResponse->GetContentAsString());
+
+	OnResponse.ExecuteIfBound(context, doc);
+	OnCompleted.ExecuteIfBound(SharedThis(this));
+
+	if (!context.error.IsEmpty() && !context.errorHandled)
+	{
+		/**
+		 * Otherwise, pass it through the error handling chain.
+		 */
+		BroadcastError(context);
+		LogError(context);
+	}
+	else
+	{
+		UE_LOG(LogHttpClient, Verbose, TEXT("'%s' SUCCEEDED from CACHE in %.3f seconds")
+		       , *GetAsDebugString(), (FDateTime::UtcNow() - sent_).GetTotalSeconds());
+	}
+}
+
+
 bool HttpRequest::EnqueueWithDelay(float Delay)
 {
 	check(!wrappedRequest_->GetURL().IsEmpty());
@@ -0,0 +1,248 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#include "HttpResponseStream.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+
+static constexpr int32 INFLATE_BUFFER_SIZE = 16 * 1024;
+static constexpr int32 MAX_ERROR_BODY_SIZE = 64 * 1024;
+
+
+HttpResponseStream::HttpResponseStream(const FHttpResponseChunkDelegate& chunkHandler)
+    : chunkHandler_{ chunkHandler }
+{
+    SetIsSaving(true);
+}
+
+
+HttpResponseStream::~HttpResponseStream()
+{
+    EndInflate();
+}
+
+
+void HttpResponseStream::Reset(IHttpRequest* request, int64 offset)
+{
+    EndInflate();
+    ClearError();
+
+    request_ = request;
+    started_ = false;
+    ignored_ = false;
+    resumeOffset_ = offset;
+    deliveredBytes_ = offset;
+    skipBytes_ = 0;
+    error_.Empty();
+    errorBody_.Empty();
+}
+
+
+static bool IsGzipEncoding(const FString& contentEncoding)
+{
+    const auto encoding = contentEncoding.TrimStartAndEnd();
+    return encoding.Equals(TEXT("gzip"), ESearchCase::IgnoreCase) || encoding.Equals(TEXT("x-gzip"), ESearchCase::IgnoreCase);
+}
+
+
+void HttpResponseStream::Write(const uint8* data, int64 size, int32 responseCode, const FString& contentEncoding)
+{
+    if (IsError() || size <= 0)
+    {
+        return;
+    }
+
+    if (ignored_)
+    {
+        const auto kept = FMath::Min<int64>(size, MAX_ERROR_BODY_SIZE - errorBody_.Num());
+        if (kept > 0)
+        {
+            errorBody_.Append(data, static_cast<int32>(kept));
+        }
+        return;
+    }
+
+    if (!started_)
+    {
+        started_ = true;
+
+        if (responseCode != INDEX_NONE
+            && (responseCode < static_cast<int32>(HttpStatusCodes::Ok) || responseCode >= static_cast<int32>(HttpStatusCodes::FirstClientError)))
+        {
+            // Error bodies are not part of the resource, keep them for reporting instead
+            ignored_ = true;
+            Write(data, size, responseCode, contentEncoding);
+            return;
+        }
+
+        if (resumeOffset_ > 0 && responseCode != INDEX_NONE && responseCode != static_cast<int32>(HttpStatusCodes::PartialContent))
+        {
+            // The server ignored the Range header, drop what the handler already has
+            skipBytes_ = resumeOffset_;
+        }
+
+        if (IsGzipEncoding(contentEncoding))
+        {
+            inflater_ = new z_stream_s{};
+            if (inflateInit2(inflater_, 16 + MAX_WBITS) != Z_OK)
+            {
+                delete inflater_;
+                inflater_ = nullptr;
+                Fail(TEXT("Failed to initialize gzip decoder"));
+                return;
+            }
+        }
+    }
+
+    if (inflater_)
+    {
+        Inflate(data, size);
+    }
+    else
+    {
+        Deliver(data, size);
+    }
+}
+
+
+bool HttpResponseStream::Finish()
+{
+    if (IsError())
+    {
+        return false;
+    }
+    if (inflater_ && !inflaterDone_)
+    {
+        Fail(TEXT("Compressed response body was truncated"));
+        return false;
+    }
+    return true;
+}
+
+
+void HttpResponseStream::Serialize(void* data, int64 length)
+{
+    auto responseCode = INDEX_NONE;
+    FString contentEncoding;
+    if (request_)
+    {
+        const auto response = request_->GetResponse();
+        if (response.IsValid() && response->GetResponseCode() > 0)
+        {
+            responseCode = response->GetResponseCode();
+            contentEncoding = response->GetHeader(TEXT("Content-Encoding"));
+        }
+    }
+
+    Write(static_cast<const uint8*>(data), length, responseCode, contentEncoding);
+}
+
+
+bool HttpResponseStream::Deliver(const uint8* data, int64 size)
+{
+    if (skipBytes_ > 0)
+    {
+        const auto skipped = FMath::Min(skipBytes_, size);
+        skipBytes_ -= skipped;
+        data += skipped;
+        size -= skipped;
+        if (size == 0)
+        {
+            return true;
+        }
+    }
+
+    if (chunkHandler_.IsBound() && !chunkHandler_.Execute(data, size))
+    {
+        Fail(TEXT("Response body rejected by the chunk handler"));
+        return false;
+    }
+    deliveredBytes_ += size;
+    return true;
+}
+
+
+bool HttpResponseStream::Inflate(const uint8* data, int64 size)
+{
+    if (inflaterDone_)
+    {
+        // Anything after the end of the gzip member is padding
+        return true;
+    }
+
+    uint8 buffer[INFLATE_BUFFER_SIZE];
+    while (size > 0)
+    {
+        const auto slice = static_cast<uInt>(FMath::Min<int64>(size, MAX_int32));
+        inflater_->next_in = const_cast<Bytef*>(data);
+        inflater_->avail_in = slice;
+        data += slice;
+        size -= slice;
+
+        do
+        {
+            inflater_->next_out = buffer;
+            inflater_->avail_out = INFLATE_BUFFER_SIZE;
+
+            const auto result = inflate(inflater_, Z_NO_FLUSH);
+            if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR)
+            {
+                Fail(FString::Printf(TEXT("Failed to inflate response body, zlib error %d"), result));
+                return false;
+            }
+
+            const auto produced = INFLATE_BUFFER_SIZE - static_cast<int32>(inflater_->avail_out);
+            if (produced > 0 && !Deliver(buffer, produced))
+            {
+                return false;
+            }
+
+            if (result == Z_STREAM_END)
+            {
+                inflaterDone_ = true;
+                return true;
+            }
+            if (result == Z_BUF_ERROR)
+            {
+                break;
+            }
+        }
+        while (inflater_->avail_in > 0 || inflater_->avail_out == 0);
+    }
+    return true;
+}
+
+
+void HttpResponseStream::EndInflate()
+{
+    if (inflater_)
+    {
+        inflateEnd(inflater_);
+        delete inflater_;
+        inflater_ = nullptr;
+    }
+    inflaterDone_ = false;
+}
+
+
+void HttpResponseStream::Fail(const FString& error)
+{
+    error_ = error;
+    SetError();
+}
+
+
+HttpResponseWithBody::HttpResponseWithBody(FHttpResponsePtr response, TArray<uint8> body)
+    : response_{ MoveTemp(response) }
+    , body_{ MoveTemp(body) }
+{
+}
+
+
+FString HttpResponseWithBody::GetContentAsString() const
+{
+    const FUTF8ToTCHAR converted{ reinterpret_cast<const ANSICHAR*>(body_.GetData()), body_.Num() };
+    return FString(converted.Length(), converted.Get());
+}
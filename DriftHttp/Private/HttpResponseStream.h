@@ -0,0 +1,121 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#pragma once
+
+#include "HttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Serialization/Archive.h"
+
+
+struct z_stream_s;
+
+
+/**
+ * Receives the body of a response as it arrives, inflates it if it's gzipped,
+ * and hands it to the request's chunk handler, so the body is never held in memory in full.
+ *
+ * On engines that can stream the response body this is written to from the HTTP thread,
+ * otherwise the request feeds it the whole body once the response is complete.
+ */
+class HttpResponseStream : public FArchive
+{
+public:
+    explicit HttpResponseStream(const FHttpResponseChunkDelegate& chunkHandler);
+    ~HttpResponseStream();
+
+    /**
+     * Start receiving a new response.
+     * If offset is non-zero the request asked for the body starting at offset,
+     * and the start of the body is skipped if the server sends all of it anyway.
+     */
+    void Reset(IHttpRequest* request, int64 offset);
+
+    /**
+     * Consume part of the body, responseCode is INDEX_NONE if not yet known.
+     * The body is inflated if contentEncoding, from the response's Content-Encoding header, says it's gzipped.
+     */
+    void Write(const uint8* data, int64 size, int32 responseCode, const FString& contentEncoding);
+
+    /** Check that the whole body was received, returns false if the compressed stream was cut short */
+    bool Finish();
+
+    /** Number of decoded bytes handed to the chunk handler so far, including any resume offset */
+    int64 GetDeliveredBytes() const { return deliveredBytes_; }
+
+    /** True once any of the body of the current response has arrived */
+    bool HasReceivedData() const { return started_; }
+
+    /** The start of an error response body, which is kept here instead of going to the chunk handler */
+    const TArray<uint8>& GetErrorBody() const { return errorBody_; }
+
+    /** True if the body had to be inflated */
+    bool IsInflating() const { return inflater_ != nullptr; }
+
+    const FString& GetError() const { return error_; }
+
+    // FArchive API
+    void Serialize(void* data, int64 length) override;
+    FString GetArchiveName() const override { return TEXT("HttpResponseStream"); }
+
+private:
+    bool Deliver(const uint8* data, int64 size);
+    bool Inflate(const uint8* data, int64 size);
+    void EndInflate();
+    void Fail(const FString& error);
+
+    FHttpResponseChunkDelegate chunkHandler_;
+    IHttpRequest* request_ = nullptr;
+
+    z_stream_s* inflater_ = nullptr;
+    bool inflaterDone_ = false;
+    bool started_ = false;
+    bool ignored_ = false;
+
+    int64 deliveredBytes_ = 0;
+    int64 skipBytes_ = 0;
+    int64 resumeOffset_ = 0;
+
+    FString error_;
+    TArray<uint8> errorBody_;
+};
+
+
+/**
+ * A response with its body put back, for error responses whose body went to a response stream,
+ * so error handlers can still report it. Everything else comes from the original response.
+ */
+class HttpResponseWithBody : public IHttpResponse
+{
+public:
+    HttpResponseWithBody(FHttpResponsePtr response, TArray<uint8> body);
+
+    // IHttpResponse
+    int32 GetResponseCode() const override { return response_->GetResponseCode(); }
+    FString GetContentAsString() const override;
+    // !IHttpResponse
+
+    // IHttpBase
+    FString GetURL() const override { return response_->GetURL(); }
+    FString GetURLParameter(const FString& ParameterName) const override { return response_->GetURLParameter(ParameterName); }
+    FString GetHeader(const FString& HeaderName) const override { return response_->GetHeader(HeaderName); }
+    TArray<FString> GetAllHeaders() const override { return response_->GetAllHeaders(); }
+    FString GetContentType() const override { return response_->GetContentType(); }
+#if UE_VERSION_OLDER_THAN(5, 3, 0)
+    int32 GetContentLength() const override { return body_.Num(); }
+#else
+    uint64 GetContentLength() const override { return body_.Num(); }
+#endif
+    const TArray<uint8>& GetContent() const override { return body_; }
+
+#if !UE_VERSION_OLDER_THAN(5, 4, 0)
+    const FString& GetEffectiveURL() const override { return response_->GetEffectiveURL(); }
+    EHttpRequestStatus::Type GetStatus() const override { return response_->GetStatus(); }
+    EHttpFailureReason GetFailureReason() const override { return response_->GetFailureReason(); }
+#endif
+    // !IHttpBase
+
+private:
+    FHttpResponsePtr response_;
+    TArray<uint8> body_;
+};
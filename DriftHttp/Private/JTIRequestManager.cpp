@@ -10,9 +10,9 @@ JTIRequestManager::JTIRequestManager(const FString& jti)
 }
 
 
-void JTIRequestManager::AddCustomHeaders(TSharedRef<HttpRequest> request) const
+void JTIRequestManager::AddDefaultHeaders(TMap<FString, FString>& headers) const
 {
-    JsonRequestManager::AddCustomHeaders(request);
+    JsonRequestManager::AddDefaultHeaders(headers);
 
-    request->SetHeader(TEXT("Authorization"), headerValue);
+    headers.Add(TEXT("Authorization"), headerValue);
 }
@@ -20,9 +20,9 @@ JWTRequestManager::JWTRequestManager(const FString& token)
 }
 
 
-void JWTRequestManager::AddCustomHeaders(TSharedRef<HttpRequest> request) const
+void JWTRequestManager::AddDefaultHeaders(TMap<FString, FString>& headers) const
 {
-    JsonRequestManager::AddCustomHeaders(request);
+    JsonRequestManager::AddDefaultHeaders(headers);
     
-    request->SetHeader(TEXT("Authorization"), headerValue);
+    headers.Add(TEXT("Authorization"), headerValue);
 }
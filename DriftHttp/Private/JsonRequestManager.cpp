@@ -17,12 +17,18 @@
 void JsonRequestManager::AddCustomHeaders(TSharedRef<HttpRequest> request) const
 {
     RequestManager::AddCustomHeaders(request);
-    request->SetHeader(TEXT("Accept"), TEXT("application/json"));
+    request->SetContentType(TEXT("application/json"));
+}
+
+
+void JsonRequestManager::AddDefaultHeaders(TMap<FString, FString>& headers) const
+{
+    RequestManager::AddDefaultHeaders(headers);
+    headers.Add(TEXT("Accept"), TEXT("application/json"));
     if (!apiKey_.IsEmpty())
     {
-        request->SetHeader(TEXT("Drift-Api-Key"), apiKey_);
+        headers.Add(TEXT("Drift-Api-Key"), apiKey_);
     }
-    request->SetContentType(TEXT("application/json"));
 }
 
 
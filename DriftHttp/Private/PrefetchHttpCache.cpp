@@ -0,0 +1,184 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+
+#include "PrefetchHttpCache.h"
+
+#include "HttpRequest.h"
+
+
+PrefetchHttpCache::PrefetchHttpCache(TSharedPtr<IHttpCache> inner, float timeToLive)
+: inner{ inner }
+, timeToLive{ FTimespan::FromSeconds(timeToLive) }
+{
+}
+
+
+void PrefetchHttpCache::BeginPrefetch(const FString& url, const FString& partition)
+{
+    pending.Add(MakeKey(url, partition), PendingPrefetch{ url });
+}
+
+
+void PrefetchHttpCache::Park(const ResponseContext& context, const FString& partition)
+{
+    const auto url = context.request->GetURL();
+    const auto key = MakeKey(url, partition);
+
+    PendingPrefetch prefetch;
+    if (!pending.RemoveAndCopyValue(key, prefetch))
+    {
+        // Invalidated or cleared while it was on its way
+        return;
+    }
+
+    if (prefetch.waiting.Num() > 0)
+    {
+        UE_LOG(LogHttpCache, Verbose, TEXT("Handing prefetched response for '%s' to %d waiting requests"), *url, prefetch.waiting.Num());
+
+        hits += prefetch.waiting.Num();
+        Release(prefetch, context.response);
+        return;
+    }
+
+    const auto freshness = GetFreshness(context.response);
+    if (freshness <= FTimespan::Zero())
+    {
+        UE_LOG(LogHttpCache, Verbose, TEXT("Not parking prefetched response for '%s', its headers don't allow it"), *url);
+        return;
+    }
+
+    parked.Add(key, ParkedResponse{ url, context.response, FDateTime::UtcNow() + freshness });
+
+    UE_LOG(LogHttpCache, Verbose, TEXT("Parked prefetched response for '%s'"), *url);
+}
+
+
+void PrefetchHttpCache::Abandon(const FString& url, const FString& partition)
+{
+    PendingPrefetch prefetch;
+    if (pending.RemoveAndCopyValue(MakeKey(url, partition), prefetch))
+    {
+        Release(prefetch, nullptr);
+    }
+}
+
+
+void PrefetchHttpCache::Clear()
+{
+    parked.Empty();
+
+    auto released = MoveTemp(pending);
+    pending.Reset();
+    for (auto& prefetch : released)
+    {
+        Release(prefetch.Value, nullptr);
+    }
+}
+
+
+void PrefetchHttpCache::CacheResponse(const ResponseContext& context, const FString& partition)
+{
+    if (inner.IsValid())
+    {
+        inner->CacheResponse(context, partition);
+    }
+}
+
+
+FHttpResponsePtr PrefetchHttpCache::GetCachedResponse(const FHttpRequestPtr& request, const FString& partition)
+{
+    ParkedResponse entry;
+    if (parked.RemoveAndCopyValue(MakeKey(request->GetURL(), partition), entry))
+    {
+        if (entry.expires > FDateTime::UtcNow())
+        {
+            UE_LOG(LogHttpCache, Verbose, TEXT("Using prefetched response for '%s'"), *entry.url);
+
+            ++hits;
+            return entry.response;
+        }
+    }
+
+    return inner.IsValid() ? inner->GetCachedResponse(request, partition) : nullptr;
+}
+
+
+void PrefetchHttpCache::Invalidate(const FString& url)
+{
+    for (auto it = parked.CreateIterator(); it; ++it)
+    {
+        if (it.Value().url == url)
+        {
+            it.RemoveCurrent();
+        }
+    }
+
+    // Whatever is on its way may predate the write
+    TArray<PendingPrefetch> released;
+    for (auto it = pending.CreateIterator(); it; ++it)
+    {
+        if (it.Value().url == url)
+        {
+            released.Add(MoveTemp(it.Value()));
+            it.RemoveCurrent();
+        }
+    }
+    for (auto& prefetch : released)
+    {
+        Release(prefetch, nullptr);
+    }
+
+    if (inner.IsValid())
+    {
+        inner->Invalidate(url);
+    }
+}
+
+
+bool PrefetchHttpCache::WaitForResponse(const FHttpRequestPtr& request, const FString& partition, TFunction<void(FHttpResponsePtr)> onResponse)
+{
+    const auto prefetch = pending.Find(MakeKey(request->GetURL(), partition));
+    if (prefetch == nullptr)
+    {
+        return false;
+    }
+
+    UE_LOG(LogHttpCache, Verbose, TEXT("Waiting for prefetch of '%s'"), *prefetch->url);
+
+    prefetch->waiting.Add(MoveTemp(onResponse));
+    return true;
+}
+
+
+FString PrefetchHttpCache::MakeKey(const FString& url, const FString& partition)
+{
+    return partition + TEXT("|") + url;
+}
+
+
+void PrefetchHttpCache::Release(PendingPrefetch& prefetch, const FHttpResponsePtr& response)
+{
+    for (auto& onResponse : prefetch.waiting)
+    {
+        onResponse(response);
+    }
+    prefetch.waiting.Empty();
+}
+
+
+FTimespan PrefetchHttpCache::GetFreshness(const FHttpResponsePtr& response) const
+{
+    const auto cacheHeader = response->GetHeader(TEXT("Cache-Control"));
+    if (cacheHeader.Contains(TEXT("no-store")) || cacheHeader.Contains(TEXT("no-cache")))
+    {
+        return FTimespan::Zero();
+    }
+
+    int32 maxAge = 0;
+    if (FParse::Value(*cacheHeader, TEXT("max-age="), maxAge))
+    {
+        return FMath::Min(timeToLive, FTimespan::FromSeconds(FMath::Max(maxAge, 0)));
+    }
+
+    return timeToLive;
+}
@@ -139,6 +139,7 @@ TSharedRef<HttpRequest> RequestManager::CreateRequest(HttpMethods method, const
 	Wrapper->OnDriftDeprecationMessage = DefaultDriftDeprecationMessageHandler;
 
 	Wrapper->SetCache(cache_);
+	Wrapper->SetCachePartition(cachePartition_);
 
 	AddCustomHeaders(Wrapper);
 
@@ -206,6 +207,11 @@ void RequestManager::OnRequestFinished(TSharedRef<HttpRequest> request)
 	check(IsInGameThread());
 
 	activeRequests_.RemoveSingleSwap(request);
+
+	if (request->serverResponded_)
+	{
+		onServerResponded_.Broadcast(request->wrappedRequest_->GetElapsedTime());
+	}
 }
 
 
@@ -280,6 +286,29 @@ void RequestManager::SetCache(TSharedPtr<IHttpCache> cache)
 }
 
 
+void RequestManager::SetCachePartition(const FString& partition)
+{
+	cachePartition_ = partition;
+}
+
+
+TMap<FString, FString> RequestManager::GetDefaultHeaders() const
+{
+	TMap<FString, FString> headers;
+	AddDefaultHeaders(headers);
+	return headers;
+}
+
+
+void RequestManager::AddCustomHeaders(TSharedRef<HttpRequest> request) const
+{
+	for (const auto& header : GetDefaultHeaders())
+	{
+		request->SetHeader(header.Key, header.Value);
+	}
+}
+
+
 void RequestManager::SetLogContext(TMap<FString, FString>&& context)
 {
 	userContext_ = Forward<TMap<FString, FString>>(context);
@@ -15,8 +15,30 @@ class ResponseContext;
 class IHttpCache
 {
 public:
-    virtual void CacheResponse(const ResponseContext& context) = 0;
-    virtual FHttpResponsePtr GetCachedResponse(const FString& url) = 0;
+    /**
+     * Store the response if its headers allow it.
+     * partition separates otherwise identical requests made on behalf of different users,
+     * and replaces the Authorization header value when building the cache key.
+     */
+    virtual void CacheResponse(const ResponseContext& context, const FString& partition) = 0;
+
+    /**
+     * Find a fresh response matching the request URL, its partition and any request headers
+     * the original response listed in its Vary: header.
+     */
+    virtual FHttpResponsePtr GetCachedResponse(const FHttpRequestPtr& request, const FString& partition) = 0;
+
+    /**
+     * Drop all variants cached for the URL, typically after a successful write to it.
+     */
+    virtual void Invalidate(const FString& url) = 0;
+
+    /**
+     * If a response to the same request is already on its way, call onResponse with it once it
+     * arrives and return true. onResponse gets null if that response can't be used after all,
+     * and the request should then go over the wire itself.
+     */
+    virtual bool WaitForResponse(const FHttpRequestPtr& request, const FString& partition, TFunction<void(FHttpResponsePtr)> onResponse) { return false; }
     
     virtual ~IHttpCache() {}
 };
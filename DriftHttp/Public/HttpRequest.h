@@ -20,6 +20,7 @@
 
 class IHttpCache;
 class FRetryConfig;
+class HttpResponseStream;
 
 
 // based on http://www.w3.org/Protocols/rfc2616/rfc2616-sec10.html
@@ -29,6 +30,7 @@ enum class HttpStatusCodes
 	, Created = 201
 	, Accepted = 202
 	, NoContent = 204
+	, PartialContent = 206
 	, Moved = 301
 	, Found = 302
 	, SeeOther = 303
@@ -40,6 +42,8 @@ enum class HttpStatusCodes
 	, NotAllowed = 405
 	, NotAcceptable = 406
 	, Timeout = 408
+	, RangeNotSatisfiable = 416
+	, TooManyRequests = 429
 	, InternalServerError = 500
 	, NotImplemented = 501
 	, BadGateway = 502
@@ -54,6 +58,18 @@ enum class HttpStatusCodes
 };
 
 
+/**
+ * Client errors won't go away by trying again, anything else might.
+ * 429 Too Many Requests is the exception, it only asks the client to slow down.
+ */
+inline bool IsClientError(int32 responseCode)
+{
+	return responseCode >= static_cast<int32>(HttpStatusCodes::FirstClientError)
+		&& responseCode <= static_cast<int32>(HttpStatusCodes::LastClientError)
+		&& responseCode != static_cast<int32>(HttpStatusCodes::TooManyRequests);
+}
+
+
 DECLARE_LOG_CATEGORY_EXTERN(LogHttpClient, Log, All);
 
 
@@ -98,6 +114,7 @@ DECLARE_DELEGATE_OneParam(FProcessResponseDelegate, ResponseContext&);
 DECLARE_DELEGATE_RetVal_OneParam(bool, FDispatchRequestDelegate, TSharedRef<class HttpRequest>);
 DECLARE_DELEGATE_RetVal_TwoParams(bool, FRetryRequestDelegate, TSharedRef<class HttpRequest>, float);
 DECLARE_DELEGATE_OneParam(FRequestCompletedDelegate, TSharedRef<class HttpRequest>);
+DECLARE_DELEGATE_RetVal_TwoParams(bool, FHttpResponseChunkDelegate, const uint8* /* data */, int64 /* size */);
 
 
 class DRIFTHTTP_API HttpRequest : public TSharedFromThis<HttpRequest>
@@ -150,6 +167,13 @@ public:
 	}
 
 
+	/** Return all headers set on the request, as "Name: Value" */
+	TArray<FString> GetAllHeaders() const
+	{
+		return wrappedRequest_->GetAllHeaders();
+	}
+
+
 	void SetRetries(int32 retries) { MaxRetries_ = retries; }
 	void SetRetryConfig(const FRetryConfig& Config);
 
@@ -159,10 +183,27 @@ public:
 
 	void SetCache(TSharedPtr<IHttpCache> cache);
 
+	/** Set the partition used to keep cached responses for different users apart */
+	void SetCachePartition(const FString& partition) { cachePartition_ = partition; }
+
 	void SetShouldRetryDelegate(FShouldRetryDelegate Delegate) { shouldRetryDelegate_ = Delegate; }
 
 	void SetExpectJsonResponse(bool expectJsonResponse) { expectJsonResponse_ = expectJsonResponse; }
 
+	/**
+	 * Hand the response body to handler piece by piece as it arrives, instead of keeping it in the response.
+	 * The handler may be called from the HTTP thread, and returning false aborts the request.
+	 * The response passed to OnResponse will have an empty body, and is not cached.
+	 * Retries, including after a dropped connection, continue where the previous attempt left off.
+	 */
+	void SetResponseChunkHandler(const FHttpResponseChunkDelegate& handler);
+
+	/** Ask for a gzip encoded response, the body is inflated before it reaches the chunk handler */
+	void SetAcceptGzip(bool acceptGzip) { acceptGzip_ = acceptGzip; }
+
+	/** Request the body starting at offset, for continuing a download that was interrupted earlier */
+	void SetResumeOffset(int64 offset) { resumeOffset_ = offset; }
+
 	/** Used by the request manager to set the payload */
 	void SetPayload(const FString& content);
 
@@ -196,6 +237,11 @@ private:
 	void InternalRequestCompleted(FHttpRequestPtr request, FHttpResponsePtr response, bool bWasSuccessful);
 	void BroadcastError(ResponseContext& context);
 	void LogError(ResponseContext& context);
+	void UpdateCache(ResponseContext& context);
+	void PrepareResponseStream(int64 offset);
+	bool FinishResponseStream(ResponseContext& context);
+	bool DispatchToNetwork();
+	void CompleteFromCache(const FHttpResponsePtr& cachedResponse);
 
 protected:
 	friend class RequestManager;
@@ -228,9 +274,17 @@ protected:
 
 	int32 expectedResponseCode_;
 	bool discarded_ = false;
+
+	/** True once the server itself, not the cache, returned a success status */
+	bool serverResponded_ = false;
 	bool expectJsonResponse_ = true;
 
 	TSharedPtr<IHttpCache> cache_;
+	FString cachePartition_;
+
+	TSharedPtr<HttpResponseStream> responseStream_;
+	bool acceptGzip_ = false;
+	int64 resumeOffset_ = 0;
 };
 
 
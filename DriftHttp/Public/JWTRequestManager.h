@@ -21,7 +21,7 @@ public:
     JWTRequestManager(const FString& token);
 
 protected:
-    void AddCustomHeaders(TSharedRef<HttpRequest> request) const override;
+    void AddDefaultHeaders(TMap<FString, FString>& headers) const override;
 
 private:
     FString headerValue;
@@ -57,6 +57,7 @@ public:
 
 protected:
     virtual void AddCustomHeaders(TSharedRef<HttpRequest> request) const override;
+    virtual void AddDefaultHeaders(TMap<FString, FString>& headers) const override;
 
 private:
     FString apiKey_;
@@ -0,0 +1,69 @@
+// Copyright 2026 Directive Games Limited - All Rights Reserved
+
+#pragma once
+
+#include "DriftHttpCache.h"
+
+
+/**
+ * Holds on to responses that were fetched speculatively, so that the first real request
+ * for the same URL can be answered without going over the wire.
+ *
+ * A request made while the prefetch is still on its way waits for it instead of being sent
+ * again. Prefetched responses are kept in memory, used at most once, and forgotten after a
+ * short while, or sooner if their Cache-Control header says so. Responses marked no-store or
+ * no-cache are only handed to requests that were already waiting.
+ * Everything else is passed on to the wrapped cache, if any.
+ */
+class DRIFTHTTP_API PrefetchHttpCache : public IHttpCache
+{
+public:
+    explicit PrefetchHttpCache(TSharedPtr<IHttpCache> inner, float timeToLive = 60.0f);
+
+    /** A prefetch for the URL has been sent, requests for it wait until it's parked or abandoned */
+    void BeginPrefetch(const FString& url, const FString& partition);
+
+    /** Keep a prefetched response until it's asked for, or hand it to requests already waiting */
+    void Park(const ResponseContext& context, const FString& partition);
+
+    /** The prefetch failed, requests waiting for it go over the wire themselves */
+    void Abandon(const FString& url, const FString& partition);
+
+    /** Drop all prefetched responses, typically when the session ends */
+    void Clear();
+
+    /** How many requests were answered from prefetched responses */
+    int32 GetHits() const { return hits; }
+
+    // IHttpCache API
+    void CacheResponse(const ResponseContext& context, const FString& partition) override;
+    FHttpResponsePtr GetCachedResponse(const FHttpRequestPtr& request, const FString& partition) override;
+    void Invalidate(const FString& url) override;
+    bool WaitForResponse(const FHttpRequestPtr& request, const FString& partition, TFunction<void(FHttpResponsePtr)> onResponse) override;
+
+private:
+    struct ParkedResponse
+    {
+        FString url;
+        FHttpResponsePtr response;
+        FDateTime expires;
+    };
+
+    struct PendingPrefetch
+    {
+        FString url;
+        TArray<TFunction<void(FHttpResponsePtr)>> waiting;
+    };
+
+    static FString MakeKey(const FString& url, const FString& partition);
+    static void Release(PendingPrefetch& prefetch, const FHttpResponsePtr& response);
+
+    /** How long the response may be parked according to its headers, zero if not at all */
+    FTimespan GetFreshness(const FHttpResponsePtr& response) const;
+
+    TSharedPtr<IHttpCache> inner;
+    FTimespan timeToLive;
+    TMap<FString, ParkedResponse> parked;
+    TMap<FString, PendingPrefetch> pending;
+    int32 hits = 0;
+};
@@ -31,6 +31,9 @@ enum class HttpMethods
 };
 
 
+DECLARE_MULTICAST_DELEGATE_OneParam(FServerRespondedDelegate, float /* roundTripSeconds */);
+
+
 class DRIFTHTTP_API RequestManager : public TSharedFromThis<RequestManager>, public FTickableGameObject
 {
 public:
@@ -69,6 +72,20 @@ public:
 
 	void SetCache(TSharedPtr<IHttpCache> cache);
 
+	/**
+	 * Set the partition cached responses are stored under, e.g. the id of the user the requests
+	 * are made on behalf of. Requests with an Authorization header, but no partition, are
+	 * partitioned by the header value instead.
+	 */
+	void SetCachePartition(const FString& partition);
+	const FString& GetCachePartition() const { return cachePartition_; }
+
+	/**
+	 * Headers every request gets, such as credentials. For connections that are made outside the
+	 * request manager, but on behalf of the same user, e.g. WebSockets.
+	 */
+	TMap<FString, FString> GetDefaultHeaders() const;
+
 	void SetLogContext(TMap<FString, FString>&& context);
 	void UpdateLogContext(TMap<FString, FString>& context);
 
@@ -96,14 +113,23 @@ public:
 
 	FOnDriftDeprecationMessageDelegate DefaultDriftDeprecationMessageHandler;
 
+	/**
+	 * Called whenever the server returns a success status for one of our requests,
+	 * which also proves that the connection and any session behind it are alive.
+	 */
+	FServerRespondedDelegate& OnServerResponded() { return onServerResponded_; }
+
 protected:
 	friend class HttpRequest;
 
 	/** Called when a request finishes processing regardless of success or failure */
 	void OnRequestFinished(TSharedRef<HttpRequest> request);
 
-	/** Add custom headers before returning the request */
-	virtual void AddCustomHeaders(TSharedRef<HttpRequest> request) const
+	/** Add custom headers before returning the request, by default the ones from AddDefaultHeaders */
+	virtual void AddCustomHeaders(TSharedRef<HttpRequest> request) const;
+
+	/** Add the headers every request gets */
+	virtual void AddDefaultHeaders(TMap<FString, FString>& headers) const
 	{
 	}
 
@@ -115,6 +141,8 @@ protected:
 	bool EnqueueRequest(TSharedRef<HttpRequest> Request, float Delay);
 
 protected:
+	FServerRespondedDelegate onServerResponded_;
+
 	/** Requests waiting to be processed in linear mode */
 	TQueue<TSharedPtr<HttpRequest>> queuedRequests_;
 
@@ -134,4 +162,5 @@ protected:
 	TMap<FString, FString> userContext_;
 
 	TSharedPtr<IHttpCache> cache_;
+	FString cachePartition_;
 };
@@ -393,6 +393,96 @@ void JsonDocument::Parse(const FString& JsonString)
 	FJsonSerializer::Deserialize(Reader, InternalValue);
 }
 
+/**
+ * Decodes UTF-8 from another archive into the TCHARs the JSON reader asks for
+ */
+class FUTF8ToTCHARArchive : public FArchive
+{
+public:
+	explicit FUTF8ToTCHARArchive(FArchive& InInner)
+		: Inner(InInner)
+	{
+		SetIsLoading(true);
+	}
+
+	void Serialize(void* Data, int64 Length) override
+	{
+		auto Chars = static_cast<TCHAR*>(Data);
+		for (int64 Index = 0; Index < Length / static_cast<int64>(sizeof(TCHAR)); ++Index)
+		{
+			Chars[Index] = NextChar();
+		}
+	}
+
+	bool AtEnd() override
+	{
+		return PendingChar == 0 && Inner.AtEnd();
+	}
+
+	FString GetArchiveName() const override { return TEXT("FUTF8ToTCHARArchive"); }
+
+private:
+	TCHAR NextChar()
+	{
+		if (PendingChar != 0)
+		{
+			const auto Char = PendingChar;
+			PendingChar = 0;
+			return Char;
+		}
+
+		const auto Lead = NextByte();
+		const int32 NumTrailing = Lead < 0x80 ? 0 : Lead >= 0xF8 ? -1 : Lead >= 0xF0 ? 3 : Lead >= 0xE0 ? 2 : Lead >= 0xC0 ? 1 : -1;
+		if (NumTrailing < 0)
+		{
+			return ReplacementChar;
+		}
+
+		uint32 CodePoint = NumTrailing == 0 ? Lead : Lead & (0x3F >> NumTrailing);
+		for (int32 Trailing = 0; Trailing < NumTrailing; ++Trailing)
+		{
+			const auto Byte = NextByte();
+			if ((Byte & 0xC0) != 0x80)
+			{
+				return ReplacementChar;
+			}
+			CodePoint = (CodePoint << 6) | (Byte & 0x3F);
+		}
+
+		if (sizeof(TCHAR) == 2 && CodePoint > 0xFFFF)
+		{
+			// Outside the basic plane, so it takes a surrogate pair
+			CodePoint -= 0x10000;
+			PendingChar = static_cast<TCHAR>(0xDC00 + (CodePoint & 0x3FF));
+			return static_cast<TCHAR>(0xD800 + (CodePoint >> 10));
+		}
+		return static_cast<TCHAR>(CodePoint);
+	}
+
+	uint8 NextByte()
+	{
+		uint8 Byte = 0;
+		if (!Inner.AtEnd())
+		{
+			Inner.Serialize(&Byte, 1);
+		}
+		return Byte;
+	}
+
+	static constexpr TCHAR ReplacementChar = 0xFFFD;
+
+	FArchive& Inner;
+	TCHAR PendingChar = 0;
+};
+
+void JsonDocument::Parse(FArchive& UTF8Stream)
+{
+	InternalValue = nullptr;
+	FUTF8ToTCHARArchive Stream{ UTF8Stream };
+	const TSharedRef<TJsonReader<>>& Reader = TJsonReaderFactory<>::Create(&Stream);
+	FJsonSerializer::Deserialize(Reader, InternalValue);
+}
+
 bool JsonDocument::HasParseError()
 {
 	return IsNull();
@@ -13,6 +13,7 @@
 #include "JsonArchive.h"
 
 #include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
 #if WITH_EDITOR
 #include "Tests/AutomationEditorCommon.h"
 #endif
@@ -48,6 +49,22 @@ void DriftJsonArchiveSpec::Define()
         	TestEqual("Nullable datetime retains default value", Data.NullableDateTime, FDateTime{ 0 });
         });
 	});
+
+    Describe("LoadDocument", [this]
+    {
+        It("should decode UTF-8 as it reads it from an archive", [this]
+        {
+            const FString Expected{ TEXT("caf\u00e9 \u20ac \U0001F600") };
+            const FString JsonString = FString::Printf(TEXT("{\"data\": \"%s\"}"), *Expected);
+            const FTCHARToUTF8 Converter(*JsonString);
+            const TArray<uint8> Bytes{ reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length() };
+            FMemoryReader Reader{ Bytes };
+
+            JsonDocument Doc;
+            TestTrue("Parsed", JsonArchive::LoadDocument(Reader, Doc));
+            TestEqual("Data", Doc[TEXT("data")].GetString(), Expected);
+        });
+    });
 }
 
 #endif // WITH_DEV_AUTOMATION_TESTS
@@ -70,6 +70,15 @@ public:
 		return !document.HasParseError();
 	}
 
+	/**
+	 * Load UTF-8 json from an archive, such as a file reader, into a json document, return if the parsing succeeds
+	 */
+	static bool LoadDocument(FArchive& utf8Stream, JsonDocument& document)
+	{
+		document.Parse(utf8Stream);
+		return !document.HasParseError();
+	}
+
 	/**
 	 * Load a json string into a C++ object, return if the parsing succeeds
 	 */
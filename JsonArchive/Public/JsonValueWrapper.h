@@ -108,6 +108,8 @@ class JSONARCHIVE_API JsonDocument : public JsonValue
 {
 public:
 	void Parse(const FString& JsonString);
+	/** Parse UTF-8 JSON as it's read from the archive, without holding all of it as a string */
+	void Parse(FArchive& UTF8Stream);
 	bool HasParseError();
 
 	int GetErrorOffset() const { return 0; }